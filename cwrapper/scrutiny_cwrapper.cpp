@@ -84,6 +84,37 @@ extern "C"
         get_config(config)->set_buffers(rx_buffer, rx_buffer_size, tx_buffer, tx_buffer_size);
     }
 
+    void scrutiny_c_config_set_channel_buffers(
+        scrutiny_c_config_t *config,
+        uint_least8_t const channel,
+        unsigned char *rx_buffer,
+        uint16_t const rx_buffer_size,
+        unsigned char *tx_buffer,
+        uint16_t const tx_buffer_size)
+    {
+        get_config(config)->set_channel_buffers(channel, rx_buffer, rx_buffer_size, tx_buffer, tx_buffer_size);
+    }
+
+    void scrutiny_c_config_set_channel_jumbo_tx_buffer(
+        scrutiny_c_config_t *config,
+        uint_least8_t const channel,
+        unsigned char *jumbo_tx_buffer,
+        uint32_t const jumbo_tx_buffer_size)
+    {
+        get_config(config)->set_channel_jumbo_tx_buffer(channel, jumbo_tx_buffer, jumbo_tx_buffer_size);
+    }
+
+    void scrutiny_c_config_set_channel_fifos(
+        scrutiny_c_config_t *config,
+        uint_least8_t const channel,
+        unsigned char *rx_fifo_buffer,
+        uint16_t const rx_fifo_size,
+        unsigned char *tx_fifo_buffer,
+        uint16_t const tx_fifo_size)
+    {
+        get_config(config)->set_channel_fifos(channel, rx_fifo_buffer, rx_fifo_size, tx_fifo_buffer, tx_fifo_size);
+    }
+
 #if SCRUTINY_SUPPORT_PROTECTED_REGIONS
     void scrutiny_c_config_set_forbidden_address_range(
         scrutiny_c_config_t *config,
@@ -116,6 +147,12 @@ extern "C"
             reinterpret_cast<scrutiny::RpvWriteCallback>(reinterpret_cast<void *>(wr_cb))); // Expect signature to match
     }
 
+    void scrutiny_c_config_set_rpv_bulk_read_callback(scrutiny_c_config_t *config, scrutiny_c_rpv_bulk_read_callback_t const callback)
+    {
+        get_config(config)->set_rpv_bulk_read_callback(
+            reinterpret_cast<scrutiny::RpvBulkReadCallback>(reinterpret_cast<void *>(callback))); // Expect signature to match
+    }
+
     void scrutiny_c_config_set_loops(scrutiny_c_config_t *config, scrutiny_c_loop_handler_t **loops, uint_least8_t const loop_count)
     {
         get_config(config)->set_loops(reinterpret_cast<scrutiny::LoopHandler **>(loops), loop_count);
@@ -126,12 +163,43 @@ extern "C"
         get_config(config)->set_user_command_callback(reinterpret_cast<scrutiny::user_command_callback_t>(callback));
     }
 
+    void scrutiny_c_config_set_async_user_command_callback(scrutiny_c_config_t *config, scrutiny_c_async_user_command_callback_t callback)
+    {
+        get_config(config)->set_async_user_command_callback(reinterpret_cast<scrutiny::async_user_command_callback_t>(callback));
+    }
+
+    void scrutiny_c_config_set_staging_buffer(scrutiny_c_config_t *config, unsigned char *buffer, uint16_t const buffer_size)
+    {
+        get_config(config)->set_staging_buffer(buffer, buffer_size);
+    }
+
+    void scrutiny_c_config_set_compression_buffer(scrutiny_c_config_t *config, unsigned char *buffer, uint16_t const buffer_size)
+    {
+        get_config(config)->set_compression_buffer(buffer, buffer_size);
+    }
+
+    void scrutiny_c_config_set_watched_blocks(scrutiny_c_config_t *config, scrutiny_c_watched_memory_block_t *blocks, uint16_t const block_count)
+    {
+        get_config(config)->set_watched_blocks(reinterpret_cast<scrutiny::WatchedMemoryBlock *>(blocks), block_count);
+    }
+
 #if SCRUTINY_ENABLE_DATALOGGING == 1
     void scrutiny_c_config_set_datalogging_buffers(scrutiny_c_config_t *config, unsigned char *buffer, scrutiny_c_datalogging_buffer_size_t size)
     {
         get_config(config)->set_datalogging_buffers(buffer, size);
     }
 
+    void scrutiny_c_config_set_datalogging_external_storage(
+        scrutiny_c_config_t *config,
+        scrutiny_c_datalogging_storage_write_callback_t write_callback,
+        scrutiny_c_datalogging_storage_read_callback_t read_callback,
+        scrutiny_c_datalogging_buffer_size_t storage_size,
+        unsigned char *cache,
+        uint16_t cache_size)
+    {
+        get_config(config)->set_datalogging_external_storage(write_callback, read_callback, storage_size, cache, cache_size);
+    }
+
     void scrutiny_c_config_set_datalogging_trigger_callback(scrutiny_c_config_t *config, scrutiny_c_datalogging_trigger_callback_t callback)
     {
         get_config(config)->set_datalogging_trigger_callback(reinterpret_cast<scrutiny::datalogging::trigger_callback_t>(callback));
@@ -143,6 +211,11 @@ extern "C"
         get_config(config)->max_bitrate = bitrate;
     }
 
+    void scrutiny_c_config_enforce_max_bitrate(scrutiny_c_config_t *config, int const val)
+    {
+        get_config(config)->enforce_max_bitrate = static_cast<bool>(val);
+    }
+
     void scrutiny_c_config_set_session_counter_seed(scrutiny_c_config_t *config, uint32_t const seed)
     {
         get_config(config)->session_counter_seed = seed;
@@ -173,6 +246,49 @@ extern "C"
         return get_main_handler(mh)->data_to_send();
     }
 
+    void scrutiny_c_main_handler_receive_channel_data(
+        scrutiny_c_main_handler_t *mh,
+        unsigned char const *data,
+        uint16_t const len,
+        uint_least8_t const channel)
+    {
+        get_main_handler(mh)->receive_data(data, len, channel);
+    }
+
+    uint16_t scrutiny_c_main_handler_pop_channel_data(
+        scrutiny_c_main_handler_t *mh,
+        unsigned char *buffer,
+        uint16_t const len,
+        uint_least8_t const channel)
+    {
+        return get_main_handler(mh)->pop_data(buffer, len, channel);
+    }
+
+    uint16_t scrutiny_c_main_handler_channel_data_to_send(scrutiny_c_main_handler_t *mh, uint_least8_t const channel)
+    {
+        return get_main_handler(mh)->data_to_send(channel);
+    }
+
+    uint16_t scrutiny_c_main_handler_rx_fifo_write(
+        scrutiny_c_main_handler_t *mh,
+        unsigned char const *data,
+        uint16_t const len,
+        uint_least8_t const channel)
+    {
+        scrutiny::IPCByteFifo *const fifo = get_main_handler(mh)->rx_fifo(channel);
+        return (fifo == SCRUTINY_NULL) ? 0 : fifo->write(data, len);
+    }
+
+    uint16_t scrutiny_c_main_handler_tx_fifo_read(
+        scrutiny_c_main_handler_t *mh,
+        unsigned char *buffer,
+        uint16_t const len,
+        uint_least8_t const channel)
+    {
+        scrutiny::IPCByteFifo *const fifo = get_main_handler(mh)->tx_fifo(channel);
+        return (fifo == SCRUTINY_NULL) ? 0 : fifo->read(buffer, len);
+    }
+
     scrutiny_c_loop_handler_ff_t *scrutiny_c_loop_handler_fixed_freq_construct(
         void *mem,
         size_t const size,
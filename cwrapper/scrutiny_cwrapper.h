@@ -84,6 +84,61 @@ extern size_t const SCRUTINY_C_LOOP_HANDLER_VF_SIZE;
     /// @return Number of bytes available
     uint16_t scrutiny_c_main_handler_data_to_send(scrutiny_c_main_handler_t *main_handler);
 
+    /// @brief Wrapper for `MainHandler::receive_data()` on a given communication channel.
+    /// @param main_handler The `MainHandler` object to work on.
+    /// @param data Pointer to the data buffer
+    /// @param len Length of the data
+    /// @param channel The communication channel that received the data
+    void scrutiny_c_main_handler_receive_channel_data(
+        scrutiny_c_main_handler_t *main_handler,
+        unsigned char const *data,
+        uint16_t const len,
+        uint_least8_t const channel);
+
+    /// @brief Wrapper for `MainHandler::pop_data()` on a given communication channel.
+    /// @param main_handler The `MainHandler` object to work on.
+    /// @param buffer Buffer to write the data into
+    /// @param len Maximum length of the data to read
+    /// @param channel The communication channel to read from
+    /// @return Number of bytes actually read
+    uint16_t scrutiny_c_main_handler_pop_channel_data(
+        scrutiny_c_main_handler_t *main_handler,
+        unsigned char *buffer,
+        uint16_t const len,
+        uint_least8_t const channel);
+
+    /// @brief Wrapper for `MainHandler::data_to_send()` on a given communication channel.
+    /// @param main_handler The `MainHandler` object to work on.
+    /// @param channel The communication channel to check
+    /// @return Number of bytes available
+    uint16_t scrutiny_c_main_handler_channel_data_to_send(scrutiny_c_main_handler_t *main_handler, uint_least8_t const channel);
+
+    /// @brief Wrapper for `IPCByteFifo::write()` on `MainHandler::rx_fifo()`.
+    /// Adds data received from the server to the reception FIFO. Can be called from an interrupt
+    /// @param main_handler The `MainHandler` object to work on.
+    /// @param data Pointer to the data buffer
+    /// @param len Length of the data
+    /// @param channel The communication channel that received the data
+    /// @return Number of bytes added. Less than len if the FIFO is full or has no storage
+    uint16_t scrutiny_c_main_handler_rx_fifo_write(
+        scrutiny_c_main_handler_t *main_handler,
+        unsigned char const *data,
+        uint16_t const len,
+        uint_least8_t const channel);
+
+    /// @brief Wrapper for `IPCByteFifo::read()` on `MainHandler::tx_fifo()`.
+    /// Takes data to send to the server from the transmission FIFO. Can be called from an interrupt
+    /// @param main_handler The `MainHandler` object to work on.
+    /// @param buffer Buffer to write the data into
+    /// @param len Maximum length of the data to read
+    /// @param channel The communication channel to read from
+    /// @return Number of bytes actually read
+    uint16_t scrutiny_c_main_handler_tx_fifo_read(
+        scrutiny_c_main_handler_t *main_handler,
+        unsigned char *buffer,
+        uint16_t const len,
+        uint_least8_t const channel);
+
     // ==== Config ====
 
     /// @brief Wrapper for `Config::Config()`.
@@ -107,6 +162,50 @@ extern size_t const SCRUTINY_C_LOOP_HANDLER_VF_SIZE;
         unsigned char *tx_buffer,
         uint16_t const tx_buffer_size);
 
+    /// @brief Wrapper for `Config::set_channel_buffers()`
+    /// Set the buffers of an additional communication channel served by the same `MainHandler`.
+    /// @param config The `scrutiny::Config` to work on
+    /// @param channel The channel index. Must be less than SCRUTINY_COMM_CHANNEL_COUNT
+    /// @param rx_buffer Reception buffer
+    /// @param rx_buffer_size Reception buffer size
+    /// @param tx_buffer Transmission buffer
+    /// @param tx_buffer_size Transmission buffer size
+    void scrutiny_c_config_set_channel_buffers(
+        scrutiny_c_config_t *config,
+        uint_least8_t const channel,
+        unsigned char *rx_buffer,
+        uint16_t const rx_buffer_size,
+        unsigned char *tx_buffer,
+        uint16_t const tx_buffer_size);
+
+    /// @brief Wrapper for `Config::set_channel_jumbo_tx_buffer()`
+    /// Set the buffer that holds the responses of a session with jumbo frames. Must be bigger than the transmission buffer.
+    /// @param config The `scrutiny::Config` to work on
+    /// @param channel The channel index. Must be less than SCRUTINY_COMM_CHANNEL_COUNT
+    /// @param jumbo_tx_buffer Jumbo transmission buffer
+    /// @param jumbo_tx_buffer_size Jumbo transmission buffer size
+    void scrutiny_c_config_set_channel_jumbo_tx_buffer(
+        scrutiny_c_config_t *config,
+        uint_least8_t const channel,
+        unsigned char *jumbo_tx_buffer,
+        uint32_t const jumbo_tx_buffer_size);
+
+    /// @brief Wrapper for `Config::set_channel_fifos()`
+    /// Set the storage of the byte FIFOs that interrupts use to exchange data with the `MainHandler` of a communication channel.
+    /// @param config The `scrutiny::Config` to work on
+    /// @param channel The channel index. Must be less than SCRUTINY_COMM_CHANNEL_COUNT
+    /// @param rx_fifo_buffer Reception FIFO storage
+    /// @param rx_fifo_size Reception FIFO storage size
+    /// @param tx_fifo_buffer Transmission FIFO storage
+    /// @param tx_fifo_size Transmission FIFO storage size
+    void scrutiny_c_config_set_channel_fifos(
+        scrutiny_c_config_t *config,
+        uint_least8_t const channel,
+        unsigned char *rx_fifo_buffer,
+        uint16_t const rx_fifo_size,
+        unsigned char *tx_fifo_buffer,
+        uint16_t const tx_fifo_size);
+
     /// @brief Wrapper for `Config::set_forbidden_address_range()`
     /// Defines some memory sections that are to be left untouched
     /// @param config The `scrutiny::Config` object to work on
@@ -147,6 +246,12 @@ extern size_t const SCRUTINY_C_LOOP_HANDLER_VF_SIZE;
         scrutiny_c_rpv_read_callback_t const rd_cb,
         scrutiny_c_rpv_write_callback_t const wr_cb);
 
+    /// @brief Wrapper for `Config::set_rpv_bulk_read_callback()`
+    /// Sets a callback that reads several Runtime Published Values in one call.
+    /// @param config The `scrutiny::Config` object to work on
+    /// @param callback The bulk read callback
+    void scrutiny_c_config_set_rpv_bulk_read_callback(scrutiny_c_config_t *config, scrutiny_c_rpv_bulk_read_callback_t const callback);
+
     /// @brief Wrapper for `Config::set_loops()`
     /// Defines the different loops (tasks) in the application.
     /// @param config The `scrutiny::Config` object to work on
@@ -164,6 +269,34 @@ extern size_t const SCRUTINY_C_LOOP_HANDLER_VF_SIZE;
     /// @param callback The callback
     void scrutiny_c_config_set_user_command_callback(scrutiny_c_config_t *config, scrutiny_c_user_command_callback_t callback);
 
+    /// @brief Wrapper for `Config::set_async_user_command_callback()`
+    /// Sets a callback to be called by Scrutiny after a request to the UserCommand function. The callback can return
+    /// SCRUTINY_C_USER_COMMAND_PENDING to be called again with the same request on a later process, `new_request` being 0.
+    /// @param config The `scrutiny::Config` object to work on
+    /// @param callback The callback
+    void scrutiny_c_config_set_async_user_command_callback(scrutiny_c_config_t *config, scrutiny_c_async_user_command_callback_t callback);
+
+    /// @brief Wrapper for `Config::set_staging_buffer()`
+    /// Sets the staging buffer used by the snapshot reads and deferred writes. These operations are not supported if unset.
+    /// @param config The `scrutiny::Config` object to work on
+    /// @param buffer The staging buffer
+    /// @param buffer_size The staging buffer size
+    void scrutiny_c_config_set_staging_buffer(scrutiny_c_config_t *config, unsigned char *buffer, uint16_t const buffer_size);
+
+    /// @brief Wrapper for `Config::set_compression_buffer()`
+    /// Sets the work buffer of the payload compression. Compression is not offered to the server if unset.
+    /// @param config The `scrutiny::Config` object to work on
+    /// @param buffer The compression buffer
+    /// @param buffer_size The compression buffer size
+    void scrutiny_c_config_set_compression_buffer(scrutiny_c_config_t *config, unsigned char *buffer, uint16_t const buffer_size);
+
+    /// @brief Wrapper for `Config::set_watched_blocks()`
+    /// Sets the table used to send only the memory blocks that changed with the ReadChanged service. The service is not supported if unset.
+    /// @param config The `scrutiny::Config` object to work on
+    /// @param blocks Array of block states. Must stay allocated forever
+    /// @param block_count Number of entries in the array
+    void scrutiny_c_config_set_watched_blocks(scrutiny_c_config_t *config, scrutiny_c_watched_memory_block_t *blocks, uint16_t const block_count);
+
 #if SCRUTINY_ENABLE_DATALOGGING == 1
     /// @brief Wrapper for `Config::set_datalogging_buffers()`
     /// Sets the buffer used to store data when doing a datalogging acquisition
@@ -175,6 +308,22 @@ extern size_t const SCRUTINY_C_LOOP_HANDLER_VF_SIZE;
         unsigned char *buffer,
         scrutiny_c_datalogging_buffer_size_t buffer_size);
 
+    /// @brief Wrapper for `Config::set_datalogging_external_storage()`
+    /// Stores the datalogging data in an external memory accessed through callbacks instead of an internal buffer
+    /// @param config The `scrutiny::Config` object to work on
+    /// @param write_callback Writes a block of data to the external memory. Called from the loop that owns the datalogger
+    /// @param read_callback Reads a block of data from the external memory. Called from `scrutiny_c_main_handler_process()`
+    /// @param storage_size Size of the external memory region usable by the datalogger
+    /// @param cache Internal buffer used to group the writes and stream the data back. Must hold the biggest entry of an acquisition
+    /// @param cache_size Size of the cache
+    void scrutiny_c_config_set_datalogging_external_storage(
+        scrutiny_c_config_t *config,
+        scrutiny_c_datalogging_storage_write_callback_t write_callback,
+        scrutiny_c_datalogging_storage_read_callback_t read_callback,
+        scrutiny_c_datalogging_buffer_size_t storage_size,
+        unsigned char *cache,
+        uint16_t cache_size);
+
     /// @brief Wrapper for `Config::set_datalogging_trigger_callback()`
     /// Sets a callback to be called by Scrutiny when a datalogging trigger condition is met. This callback will be called from the
     /// context of the LoopHandler using the datalogger with no thread safety. This means that if data are to be passed to another task, it is
@@ -188,6 +337,11 @@ extern size_t const SCRUTINY_C_LOOP_HANDLER_VF_SIZE;
     /// @param bitrate The bitrate value
     void scrutiny_c_config_set_max_bitrate(scrutiny_c_config_t *config, uint32_t const bitrate);
 
+    /// @brief Setter for `Config::enforce_max_bitrate`
+    /// @param config The `scrutiny::Config` object to work on
+    /// @param val Enable value
+    void scrutiny_c_config_enforce_max_bitrate(scrutiny_c_config_t *config, int val);
+
     /// @brief Setter for `Config::session_counter_seed`
     /// @param config The `scrutiny::Config` object to work on
     /// @param seed The seed value
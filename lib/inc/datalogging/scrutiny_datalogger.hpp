@@ -62,6 +62,18 @@ namespace scrutiny
                 buffer_size_t const buffer_size,
                 trigger_callback_t trigger_callback = SCRUTINY_NULL_FN_PTR(trigger_callback_t));
 
+            /// @brief Initializes the datalogger so that it logs to an external storage
+            /// @param main_handler A pointer to the main handler to be used to access memory and RPVs
+            /// @param storage The external storage callbacks and cache. Copied
+            /// @param storage_size Size of the external storage, in char
+            /// @param trigger_callback A function pointer to call when the datalogging trigger condition trigs. Executed in the owner loop (no thread
+            /// safety)
+            Status::eStatus init(
+                MainHandler const *const main_handler,
+                ExternalStorage const *const storage,
+                buffer_size_t const storage_size,
+                trigger_callback_t trigger_callback = SCRUTINY_NULL_FN_PTR(trigger_callback_t));
+
             /// @brief Configure the datalogger with a configuration received by the server
             /// @param timebase The timebase used for time logging & trigger management
             /// @param config_id A configuration ID that will be attached to the acquisition for validation.
@@ -78,7 +90,7 @@ namespace scrutiny
             inline bool data_acquired(void) const { return m_state == State::AcquisitionCompleted; }
 
             /// @brief  Returns the acquisition ID of the last acquisition
-            inline uint16_t get_acquisition_id(void) const { return m_acquisition_id; }
+            inline uint16_t get_acquisition_id(void) const { return m_published.acquisition_id; }
 
             /// @brief Returns the configuration ID attached with the acquisition
             inline uint16_t get_config_id(void) const { return m_config_id; }
@@ -99,11 +111,21 @@ namespace scrutiny
             /// @return True if the condition is met
             bool check_trigger(void);
 
-            /// @brief Returns a DataReader object that will iterate through each samples
-            inline DataReader *get_reader(void) { return m_encoder.get_reader(); }
+            /// @brief Returns a DataReader object that will iterate through each samples of the last completed acquisition
+            inline DataReader *get_reader(void) { return m_read_encoder->get_reader(); }
+
+            /// @brief Returns the internal DataEncoder object that holds the last completed acquisition.
+            /// Same as the one writing the samples unless double buffering is enabled
+            inline DataEncoder *get_encoder(void) { return m_read_encoder; }
+
+            /// @brief Returns true when an acquisition can be read. With double buffering, the datalogger keeps acquiring in the other half meanwhile
+            inline bool acquisition_available(void) const { return m_double_buffering.enabled ? m_double_buffering.published : data_acquired(); }
 
-            /// @brief Returns the internal DataEncoder object used to write the samples in the datalogging buffer
-            inline DataEncoder *get_encoder(void) { return &m_encoder; }
+            /// @brief Returns true if the active configuration splits the buffer in two halves
+            inline bool double_buffering(void) const { return m_double_buffering.enabled; }
+
+            /// @brief Double buffering only. Tells that the acquisition given to the reader has been read and its half can be reused
+            void release_acquisition(void);
 
             /// @brief Returns a pointer to the internal configuration object
             inline Configuration *config(void) { return &m_config; }
@@ -115,7 +137,10 @@ namespace scrutiny
             inline bool config_valid(void) const { return m_config_valid; }
 
             /// @brief Returns the number of points after the trigger, indicating the exact position of the trigger point in an acquisition
-            inline buffer_size_t log_points_after_trigger(void) const { return m_log_points_after_trigger; }
+            inline buffer_size_t log_points_after_trigger(void) const { return m_published.log_points_after_trigger; }
+
+            /// @brief Returns the timestamp at which the trigger condition was fulfilled. Anchors the implicit time axis.
+            inline timestamp_t get_trigger_timestamp(void) const { return m_published.trigger_timestamp; }
 
             /// @brief Returns the number of bytes that needs to be acquired since trigger so that the acquisition is considered complete
             inline buffer_size_t get_bytes_to_acquire_from_trigger_to_completion(void) const
@@ -127,7 +152,7 @@ namespace scrutiny
             inline buffer_size_t data_counter_since_trigger(void) const
             {
                 // This counter gets reset when trigger happens.
-                return (m_state == State::Triggered) ? m_encoder.get_data_write_counter() : 0;
+                return (m_state == State::Triggered) ? m_write_encoder->get_data_write_counter() : 0;
             }
 
             /// @brief Return the LoopHandler that owns the datalogger. Null if owned by the MainHandler. This value is updated by the owner himself.
@@ -146,14 +171,21 @@ namespace scrutiny
 
           protected:
             void process_acquisition(void);
+            void init_encoders(void);
+            void publish_acquisition(void);
+            bool validate_item_options(uint_least8_t const index) const;
             void stamp_trigger_point(void);
             bool acquisition_completed(void);
             void write_uncompressed_entry(void);
             uint16_t read_next_entry_size(buffer_size_t *cursor);
 
-            Configuration m_config;      // The datalogger configuration object
-            DataEncoder m_encoder;       // The data encoder that reads the data and lay it into the datalogging buffer
-            buffer_size_t m_buffer_size; // The datalogging buffer size
+            Configuration m_config;        // The datalogger configuration object
+            DataEncoder m_encoders[2];     // The data encoders that lay the data into the datalogging buffer. 2nd one used for double buffering
+            DataEncoder *m_write_encoder;  // The encoder that writes the ongoing acquisition
+            DataEncoder *m_read_encoder;   // The encoder that holds the acquisition given to the reader
+            unsigned char *m_buffer;       // The datalogging buffer. nullptr when using an external storage
+            ExternalStorage m_storage;     // The external storage used instead of the buffer when a write callback is set
+            buffer_size_t m_buffer_size;   // The datalogging buffer size
             // A function pointer to be called when the trigger trigs. Executed in the owner loop (no thread safety)
             trigger_callback_t m_trigger_callback;
 
@@ -180,6 +212,19 @@ namespace scrutiny
                 bool previous_val;                           // Trigger condition result of the previous cycle
             } m_trigger;                                     // Data related to the graph trigger
 
+            struct
+            {
+                timestamp_t trigger_timestamp;          // Trigger timestamp of the acquisition given to the reader
+                buffer_size_t log_points_after_trigger; // Number of entries after the trigger of the acquisition given to the reader
+                uint16_t acquisition_id;                // ID of the acquisition given to the reader
+            } m_published; // Metadata of the acquisition given to the reader. Kept apart since a new acquisition may run with double buffering
+
+            struct
+            {
+                bool enabled;   // True when the buffer is split in two halves
+                bool published; // True when a half holds a completed acquisition that has not been released by the server
+            } m_double_buffering;
+
             union
             {
                 struct
@@ -67,24 +67,80 @@ namespace scrutiny
                 datalogging::Configuration const *const config,
                 unsigned char *const buffer,
                 datalogging::buffer_size_t const buffer_size);
+            void init(
+                MainHandler const *const main_handler,
+                datalogging::Configuration const *const config,
+                datalogging::ExternalStorage const *const storage,
+                datalogging::buffer_size_t const storage_size,
+                datalogging::buffer_size_t const storage_offset = 0);
             void encode_next_entry(LoopHandler *const caller);
+            void accumulate(LoopHandler *const caller);
             void reset(void);
-            inline void reset_write_counter(void) { m_entry_write_counter = 0; }
+            inline void reset_write_counter(void)
+            {
+                m_entry_write_counter = 0;
+                m_data_write_counter = 0;
+            }
             inline void set_timebase(Timebase const *const timebase) { m_timebase = timebase; }
             inline datalogging::buffer_size_t get_entry_write_counter(void) const { return m_entry_write_counter; }
-            inline datalogging::buffer_size_t get_data_write_counter(void) const { return m_entry_write_counter * m_entry_size; }
+            inline datalogging::buffer_size_t get_data_write_counter(void) const { return m_data_write_counter; }
             static inline datalogging::EncodingType::eEncodingType get_encoding(void) { return ENCODING; }
-            inline datalogging::buffer_size_t get_read_cursor(void) const { return m_first_valid_entry_index * m_entry_size; }
-            inline datalogging::buffer_size_t get_write_cursor(void) const { return m_next_entry_write_index * m_entry_size; }
+            inline datalogging::buffer_size_t get_read_cursor(void) const { return m_read_cursor; }
+            inline datalogging::buffer_size_t get_write_cursor(void) const { return m_write_cursor; }
             inline bool error(void) const { return m_error; }
-            inline datalogging::buffer_size_t get_entry_count(void) const { return (m_full) ? m_max_entries : m_next_entry_write_index; }
-            inline datalogging::buffer_size_t get_buffer_effective_size(void) const { return m_entry_size * m_max_entries; }
+            inline datalogging::buffer_size_t get_entry_count(void) const { return m_entry_count; }
+            /// @brief Returns the position in the buffer where valid data ends before wrapping back to the beginning
+            inline datalogging::buffer_size_t get_buffer_effective_size(void) const { return m_wrap_end; }
             inline bool buffer_full(void) const { return m_full; }
+            /// @brief Returns the size of the buffer given to the encoder, in char
+            inline datalogging::buffer_size_t get_buffer_size(void) const { return m_buffer_size; }
             datalogging::buffer_size_t remaining_bytes_to_full() const;
+            /// @brief Returns the number of chars of valid data in the buffer
+            datalogging::buffer_size_t get_data_size(void) const;
+
+            /// @brief Returns true when each entry starts with a bitmap telling which item is present. Happens with per-item decimation
+            inline bool variable_entries(void) const { return m_variable_entries.enabled; }
+            /// @brief Returns the size of the presence bitmap that precedes each entry, in char. 0 if not used
+            inline uint_least8_t get_presence_bitmap_size(void) const { return m_variable_entries.bitmap_size; }
+
+            /// @brief Returns true if the configuration requests an implicit time axis (no timestamp stored per entry)
+            inline bool implicit_time(void) const { return m_implicit_time.enabled; }
+            /// @brief Returns the absolute entry number of the oldest entry present in the buffer
+            inline uint32_t get_first_entry_counter(void) const { return m_implicit_time.total_entry_counter - get_entry_count(); }
+            /// @brief Returns the number of time checkpoints that refer to an entry still present in the buffer
+            uint_least8_t get_time_checkpoint_count(void) const;
+            /// @brief Returns a time checkpoint still present in the buffer. Index 0 is the oldest.
+            TimeCheckpoint get_time_checkpoint(uint_least8_t const index) const;
+
+            /// @brief Returns true when at least one item is a MemoryBit. Their bits are packed together at the end of each entry
+            inline bool packed_bits(void) const { return m_packed_bits.enabled; }
+            /// @brief Returns the number of char needed to store some packed bits. Packed bits are stored in 8 bits bytes, MSB first
+            static inline uint16_t get_packed_bits_size_char(uint16_t const bitcount)
+            {
+                return static_cast<uint16_t>((((bitcount + 7u) / 8u) + (CHAR_BIT / 8) - 1u) / (CHAR_BIT / 8));
+            }
+
+            /// @brief Returns true when at least one floating point item is stored in a reduced precision format
+            inline bool converted_items(void) const { return m_converted_items; }
+            /// @brief Returns true when at least one item is reduced over the decimation window. accumulate() must then be called every cycle
+            inline bool reductions_enabled(void) const { return m_reduction.enabled; }
+
+            /// @brief Returns true when the data is written to an external storage through callbacks instead of an internal buffer
+            inline bool external_storage(void) const { return m_storage.write != SCRUTINY_NULL_FN_PTR(storage_write_callback_t); }
+            void flush(void);
 
             RawFormatReader *get_reader(void) { return &m_reader; };
 
           protected:
+            uint16_t compute_entry_size(uint16_t const *const phases) const;
+            void advance_phases(uint16_t *const phases) const;
+            void drop_oldest_entry(void);
+            uint16_t write_packed_bits(unsigned char *const dst) const;
+            void accumulate_item(uint_fast8_t const index, LoopHandler *const caller);
+            uint_least8_t write_reduced_item(uint_fast8_t const index, unsigned char *const dst, LoopHandler *const caller);
+            bool read_item_value(uint_fast8_t const index, AnyType *const val, LoopHandler *const caller) const;
+            uint_least8_t write_item_value(uint_fast8_t const index, AnyType const &val, unsigned char *const dst) const;
+
             unsigned char *m_buffer;
             datalogging::buffer_size_t m_buffer_size;
             datalogging::Configuration const *m_config;
@@ -92,14 +148,69 @@ namespace scrutiny
             MainHandler const *m_main_handler;
             Timebase const *m_timebase;
 
-            datalogging::buffer_size_t m_max_entries;
-            datalogging::buffer_size_t m_next_entry_write_index;
-            datalogging::buffer_size_t m_first_valid_entry_index;
-            datalogging::buffer_size_t m_entry_write_counter;
-            uint16_t m_entry_size;
+            datalogging::buffer_size_t m_read_cursor;         // Start of the oldest entry
+            datalogging::buffer_size_t m_write_cursor;        // Where the next entry will be written
+            datalogging::buffer_size_t m_wrap_end;            // End of valid data when the write cursor wrapped before the read cursor
+            datalogging::buffer_size_t m_entry_count;         // Number of entries in the buffer
+            datalogging::buffer_size_t m_entry_write_counter; // Number of entries written since last call to reset_write_counter()
+            datalogging::buffer_size_t m_data_write_counter;  // Number of char written since last call to reset_write_counter()
+            uint16_t m_entry_size;                            // Size of an entry. Largest possible size with variable entries
 
+            bool m_wrapped; // True when valid data is split in 2 parts : [read_cursor, wrap_end[ and [0, write_cursor[
             bool m_full;
             bool m_error;
+
+            struct
+            {
+                uint16_t head_phases[SCRUTINY_DATALOGGING_MAX_SIGNAL];     // Decimation phase of each item for the next entry to write
+                uint16_t tail_phases[SCRUTINY_DATALOGGING_MAX_SIGNAL];     // Decimation phase of each item for the oldest entry
+                uint_least8_t item_sizes[SCRUTINY_DATALOGGING_MAX_SIGNAL]; // Size of each item in char
+                uint_least8_t bitmap_size;                                 // Size of the presence bitmap, in char
+                bool enabled;                                              // True when at least one item has its own decimation
+            } m_variable_entries;
+
+            struct
+            {
+                TimeCheckpoint checkpoints[SCRUTINY_DATALOGGING_TIME_CHECKPOINTS]; // Circular list of timestamps taken every few entries
+                uint32_t total_entry_counter;                        // Number of entries written since reset. Not reset at trigger time.
+                datalogging::buffer_size_t interval;                 // Number of entries between 2 checkpoints
+                datalogging::buffer_size_t entries_since_checkpoint; // Counts up to interval
+                uint_least8_t next_checkpoint_index;                 // Write position in the checkpoint list
+                uint_least8_t checkpoint_count;                      // Number of valid checkpoints in the list
+                bool enabled;                                        // True when at least one item is an implicit time axis
+            } m_implicit_time;
+
+            struct
+            {
+                uint_least8_t item_bits[SCRUTINY_DATALOGGING_MAX_SIGNAL]; // Number of bits of each MemoryBit item. 0 for other items
+                bool enabled;                                             // True when at least one item is a MemoryBit
+            } m_packed_bits;
+
+            struct
+            {
+                AnyType mins[SCRUTINY_DATALOGGING_MAX_SIGNAL];           // MinMax: Smallest sample of the window
+                AnyType maxs[SCRUTINY_DATALOGGING_MAX_SIGNAL];           // MinMax: Biggest sample of the window
+                float_biggest_t sums[SCRUTINY_DATALOGGING_MAX_SIGNAL];   // Mean: Sum of the samples of the window
+                uint32_t sample_counts[SCRUTINY_DATALOGGING_MAX_SIGNAL]; // Number of samples accumulated in the window
+                bool enabled;                                            // True when at least one item is not ReductionMode::Last
+            } m_reduction;
+
+            struct
+            {
+                RuntimePublishedValue rpvs[SCRUTINY_DATALOGGING_MAX_SIGNAL]; // Rpv items read with the bulk read callback, in item order
+                uint_least8_t indexes[SCRUTINY_DATALOGGING_MAX_SIGNAL];      // Position of each Rpv item in the rpvs array
+                uint_least8_t count;                                         // Number of RPVs in the rpvs array
+                bool enabled;                                                // True when the RPVs are read with a single bulk read call
+            } m_rpv_bulk;
+
+            // Type of each Rpv item and of each Memory item that has a declared datatype. Unknown for the others
+            VariableType::eVariableType m_item_datatypes[SCRUTINY_DATALOGGING_MAX_SIGNAL];
+            bool m_converted_items; // True when at least one item is not stored with StorageFormat::Native
+
+            datalogging::ExternalStorage m_storage;      // External storage callbacks. Unused when writing to an internal buffer
+            datalogging::buffer_size_t m_storage_offset; // Location in the external storage of the first char of the encoder buffer
+            datalogging::buffer_size_t m_cache_address;  // Location in the encoder buffer of the first char of the cache
+            uint16_t m_cache_fill;                       // Number of char in the cache waiting to be written to the external storage
         };
 
         datalogging::buffer_size_t RawFormatReader::get_entry_count(void) const
@@ -41,6 +41,32 @@ namespace scrutiny
             Operand const *const operand,
             AnyValAndTypePair *const val_type_pair,
             LoopHandler *const caller);
+
+        /// @brief Reads a value of any supported numerical type and converts it to the biggest floating point type
+        /// @param val The value
+        /// @param vtype The type of the value
+        /// @return The value as a float. 0 if the type is not supported
+        float_biggest_t read_as_biggest_float(AnyType const &val, VariableType::eVariableType const vtype);
+
+        /// @brief Reads the raw bits of a value of any type, zero-extended to the biggest unsigned integer
+        /// @param val The value
+        /// @param vtype The type of the value. Only its size is used
+        /// @return The bits of the value. 0 if the type size is not supported
+        uint_biggest_t read_bits_as_biggest_uint(AnyType const &val, VariableType::eVariableType const vtype);
+
+        /// @brief Writes a floating point value into an AnyType, converted to the given type. Integers are rounded to the nearest value
+        /// and saturated to the range of the type. NaN gives 0.
+        /// @param fval The value to write
+        /// @param vtype The type of the output
+        /// @param val The output value
+        void write_from_biggest_float(float_biggest_t const fval, VariableType::eVariableType const vtype, AnyType *const val);
+
+        /// @brief Compares two values of the same type
+        /// @param a Left hand value
+        /// @param b Right hand value
+        /// @param vtype The type of both values
+        /// @return true if a < b
+        bool value_less_than(AnyType const &a, AnyType const &b, VariableType::eVariableType const vtype);
     } // namespace datalogging
 } // namespace scrutiny
 
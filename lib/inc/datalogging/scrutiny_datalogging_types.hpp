@@ -26,6 +26,9 @@ namespace scrutiny
 #if SCRUTINY_HAS_CPP11
         static_assert(SCRUTINY_DATALOGGING_MAX_SIGNAL <= 254, "SCRUTINY_DATALOGGING_MAX_SIGNAL is too big");
         static_assert(MAX_OPERANDS <= 254, "Too many operands. uint8 must be enough for iteration.");
+        static_assert(
+            SCRUTINY_DATALOGGING_TIME_CHECKPOINTS >= 2 && SCRUTINY_DATALOGGING_TIME_CHECKPOINTS <= 255,
+            "SCRUTINY_DATALOGGING_TIME_CHECKPOINTS must be between 2 and 255");
 #endif
 
         typedef ctypes::scrutiny_c_datalogging_buffer_size_t buffer_size_t;
@@ -153,7 +156,9 @@ namespace scrutiny
             {
                 Memory = 0,
                 Rpv = 1,
-                Time = 2
+                Time = 2,
+                ImplicitTime = 3, // No storage. Time axis is rebuilt from the loop timestep, the decimation and sparse checkpoints
+                MemoryBit = 4     // Bitfield or boolean. Only bitsize bits are stored, packed with the other MemoryBit items at the end of the entry
             };
             // clang-format on
         };
@@ -164,6 +169,8 @@ namespace scrutiny
             {
                 void *_pad1;
                 uint_least8_t _pad2;
+                uint_least8_t _pad3;
+                uint_least8_t _pad4;
                 LoggableType::eLoggableType type;
             } common;
             struct
@@ -172,6 +179,13 @@ namespace scrutiny
                 uint_least8_t size;
             } memory;
             struct
+            {
+                void *address;
+                VariableType::eVariableType datatype; // Type of the variable that contains the bits. Float are not allowed
+                uint_least8_t bitoffset;
+                uint_least8_t bitsize;
+            } memorybit;
+            struct
             {
                 uint16_t id;
             } rpv;
@@ -180,24 +194,100 @@ namespace scrutiny
             } time;
         };
 
+        /// @brief How the values of an item are combined over the decimation window before being written in the buffer
+        class ReductionMode
+        {
+          public:
+            // clang-format off
+            SCRUTINY_ENUM(eReductionMode, uint_least8_t)
+            {
+                Last = 0,   // Value at the end of the window. Other samples are dropped
+                Mean = 1,   // Average of all the samples of the window. Written with the item datatype
+                MinMax = 2  // Smallest then biggest sample of the window. Takes twice the space
+            };
+            // clang-format on
+        };
+
+        /// @brief How a floating point item is stored in the buffer. Reduced formats trade precision for a longer capture
+        class StorageFormat
+        {
+          public:
+            // clang-format off
+            SCRUTINY_ENUM(eStorageFormat, uint_least8_t)
+            {
+                Native = 0,     // Same type as the item
+                Float16 = 1,    // IEEE-754 half precision
+                ScaledInt16 = 2 // Signed 16 bits integer. value = stored * scale + offset
+            };
+            // clang-format on
+        };
+
+        /// @brief Per-item options that complement a LoggableItem definition. All zeros means default behavior.
+        struct LoggableItemOptions
+        {
+            uint16_t decimation;                     // Log the item once every N entries. 0 and 1 means every entry.
+            ReductionMode::eReductionMode reduction; // How the samples are combined over the decimation window
+            VariableType::eVariableType datatype;    // Type of a Memory item. Required when reduction is not Last or storage is not Native
+            StorageFormat::eStorageFormat storage;   // How the item is written in the buffer. Only floating point items can be converted
+            float scale;                             // ScaledInt16 only. Size of 1 LSB
+            float offset;                            // ScaledInt16 only. Value represented by 0
+        };
+
         struct Configuration
         {
+            Configuration() :
+                double_buffering(false)
+            {
+                clear_items_options();
+            }
+
             /// @brief Reads a configuration and makes a copy of it
             /// @param other The configuration to copy
             inline void copy_from(Configuration const *const other) { memcpy(this, other, sizeof(Configuration)); }
 
-            LoggableItem items_to_log[SCRUTINY_DATALOGGING_MAX_SIGNAL]; // Definitions of the items to log
+            /// @brief Put back all the per-item options to their default value
+            inline void clear_items_options(void) { memset(items_options, 0, sizeof(items_options)); }
+
+            LoggableItem items_to_log[SCRUTINY_DATALOGGING_MAX_SIGNAL];         // Definitions of the items to log
+            LoggableItemOptions items_options[SCRUTINY_DATALOGGING_MAX_SIGNAL]; // Options of the items to log. Same indexing as items_to_log
             TriggerConfig trigger;                                      // The trigger configuration
             uint32_t timeout_100ns;    // Time after which an acquisition is considered complete even if the buffer is not full
             uint16_t decimation;       // Decimation of the acquisition. Effectively reduce the sampling rate
             uint_least8_t items_count; // Number of items to log
             // A value indicating where the trigger should be located in the acquisition window. 0 means left, 255 means right. 128 = middle
             uint_least8_t probe_location;
+            // When true, the buffer is split in two halves. A new acquisition is taken in one half while the other is being read.
+            // Not supported with an external storage
+            bool double_buffering;
+        };
+
+        /// @brief A timestamp taken at a given entry while logging an implicit time axis.
+        /// Used by the server to validate the reconstructed time axis and detect loop overruns.
+        struct TimeCheckpoint
+        {
+            uint32_t entry_counter; // Absolute entry number since the encoder has been reset
+            uint32_t timestamp;     // Timebase value when the entry has been written
         };
 
         /// @brief Datalogging Trigger callback
         typedef ctypes::scrutiny_c_datalogging_trigger_callback_t trigger_callback_t;
 
+        /// @brief Writes a block of data into the external datalogging storage. Address and size are in char
+        typedef ctypes::scrutiny_c_datalogging_storage_write_callback_t storage_write_callback_t;
+        /// @brief Reads a block of data from the external datalogging storage. Address and size are in char
+        typedef ctypes::scrutiny_c_datalogging_storage_read_callback_t storage_read_callback_t;
+
+        /// @brief An external memory (e.g. SPI RAM) used to store the acquisition instead of an internal buffer.
+        /// The encoder accumulates the entries in the cache and writes them in blocks. The reader streams the data back through the same cache.
+        /// Reads and writes never overlap, therefore a configuration that requests double buffering is refused.
+        struct ExternalStorage
+        {
+            storage_write_callback_t write; // Called from the loop that owns the datalogger
+            storage_read_callback_t read;   // Called from MainHandler::process(), only once the acquisition is completed
+            unsigned char *cache;           // Internal staging buffer. Must be able to hold the biggest entry of an acquisition
+            uint16_t cache_size;            // Size of the cache, in char
+        };
+
     } // namespace datalogging
 } // namespace scrutiny
 
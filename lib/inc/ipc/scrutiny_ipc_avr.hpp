@@ -11,6 +11,7 @@
 #define ___SCRUTINY_IPC_AVR_H___
 
 #include "scrutiny_setup.hpp"
+#include <stdint.h>
 
 #if !SCRUTINY_BUILD_AVR_GCC
 #error "Can only be built for AVR GCC"
@@ -64,6 +65,37 @@ namespace scrutiny
         volatile bool m_written;
     };
 
+    /// @brief Index shared between two time domains, written by a single one of them.
+    /// A 16 bits access takes 2 instructions. Interrupts are held for its duration and restored as they were, so it can be used in an ISR
+    class IPCIndex
+    {
+      public:
+        IPCIndex() :
+            m_value(0)
+        {
+        }
+
+        inline uint16_t load(void) const
+        {
+            uint8_t sreg;
+            __asm__ __volatile__("in %0, __SREG__\n\tcli" : "=r"(sreg)::"memory");
+            uint16_t const value = m_value;
+            __asm__ __volatile__("out __SREG__, %0" ::"r"(sreg) : "memory");
+            return value;
+        }
+
+        inline void store(uint16_t const value)
+        {
+            uint8_t sreg;
+            __asm__ __volatile__("in %0, __SREG__\n\tcli" : "=r"(sreg)::"memory");
+            m_value = value;
+            __asm__ __volatile__("out __SREG__, %0" ::"r"(sreg) : "memory");
+        }
+
+      protected:
+        volatile uint16_t m_value;
+    };
+
 } // namespace scrutiny
 
 #endif // ___SCRUTINY_IPC_H___
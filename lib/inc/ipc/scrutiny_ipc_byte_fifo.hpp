@@ -0,0 +1,196 @@
+//    scrutiny_ipc_byte_fifo.hpp
+//        A lock-free byte FIFO between one producer and one consumer running in different time domains.
+//        Built on the IPCIndex of the IPC backend of the platform
+//
+//   - License : MIT - See LICENSE file
+//   - Project : Scrutiny Debugger (github.com/scrutinydebugger/scrutiny-embedded)
+//
+//    Copyright (c) 2021 Scrutiny Debugger
+
+#ifndef ___SCRUTINY_IPC_BYTE_FIFO_H___
+#define ___SCRUTINY_IPC_BYTE_FIFO_H___
+
+#include "scrutiny_setup.hpp"
+#include <stdint.h>
+#include <string.h>
+
+namespace scrutiny
+{
+    /// @brief Byte FIFO between one producer and one consumer, for instance a UART interrupt and the main loop.
+    /// Each index is written by a single side, so no lock nor critical section is needed around a transfer.
+    /// The producer only calls the write functions and the consumer only the read functions.
+    /// One byte of the storage is left unused to tell a full FIFO from an empty one.
+    class IPCByteFifo
+    {
+      public:
+        IPCByteFifo() :
+            m_buffer(SCRUTINY_NULL),
+            m_size(0),
+            m_head(),
+            m_tail()
+        {
+        }
+
+        /// @brief Gives a storage to the FIFO and empties it. Must be done before the producer and the consumer start
+        /// @param buffer The storage. The FIFO stays unusable if nullptr
+        /// @param size The storage size. The FIFO holds one byte less
+        inline void init(unsigned char *const buffer, uint16_t const size)
+        {
+            m_buffer = buffer;
+            m_size = (buffer == SCRUTINY_NULL || size < 2) ? 0 : size;
+            m_head.store(0);
+            m_tail.store(0);
+        }
+
+        /// @brief Returns true if the FIFO has a storage
+        inline bool is_set(void) const { return m_size != 0; }
+
+        /// @brief Returns the number of bytes that can be read
+        inline uint16_t count(void) const
+        {
+            uint16_t const head = m_head.load();
+            uint16_t const tail = m_tail.load();
+            return (head >= tail) ? static_cast<uint16_t>(head - tail) : static_cast<uint16_t>(m_size - tail + head);
+        }
+
+        // ===== Producer side =====
+
+        /// @brief Adds a byte. Meant to be used by the producer
+        /// @return false if the FIFO is full
+        inline bool push(unsigned char const c)
+        {
+            uint16_t const head = m_head.load();
+            uint16_t const next = next_index(head, 1);
+            if (m_size == 0 || next == m_tail.load())
+            {
+                return false;
+            }
+            m_buffer[head] = c;
+            m_head.store(next);
+            return true;
+        }
+
+        /// @brief Gives the largest contiguous free space, to be filled in place then committed with commit_write(). Meant to be used by
+        /// the producer
+        /// @param len Output. Size of the free space
+        /// @return The start of the free space. nullptr if the FIFO has no storage
+        inline unsigned char *write_region(uint16_t *const len) const
+        {
+            if (m_size == 0)
+            {
+                *len = 0;
+                return SCRUTINY_NULL;
+            }
+            uint16_t const head = m_head.load();
+            uint16_t const tail = m_tail.load();
+            if (head >= tail)
+            {
+                // Up to the end of the storage, but the last free byte stays unused
+                *len = static_cast<uint16_t>(((tail == 0) ? m_size - 1u : m_size) - head);
+            }
+            else
+            {
+                *len = static_cast<uint16_t>(tail - head - 1u);
+            }
+            return &m_buffer[head];
+        }
+
+        /// @brief Hands bytes written in the region given by write_region() to the consumer
+        /// @param len Number of bytes written. Not more than the size of the region
+        inline void commit_write(uint16_t const len) { m_head.store(next_index(m_head.load(), len)); }
+
+        /// @brief Adds as many bytes as possible. Meant to be used by the producer
+        /// @return The number of bytes added
+        inline uint16_t write(unsigned char const *const data, uint16_t const len)
+        {
+            uint16_t done = 0;
+            for (uint_least8_t i = 0; i < 2 && done < len; i++) // The free space is in 2 parts at most
+            {
+                uint16_t region_len;
+                unsigned char *const region = write_region(&region_len);
+                region_len = (region_len < len - done) ? region_len : static_cast<uint16_t>(len - done);
+                if (region_len == 0)
+                {
+                    break;
+                }
+                memcpy(region, &data[done], region_len);
+                commit_write(region_len);
+                done = static_cast<uint16_t>(done + region_len);
+            }
+            return done;
+        }
+
+        // ===== Consumer side =====
+
+        /// @brief Removes a byte. Meant to be used by the consumer
+        /// @param c Output. The byte removed
+        /// @return false if the FIFO is empty
+        inline bool pop(unsigned char *const c)
+        {
+            uint16_t const tail = m_tail.load();
+            if (tail == m_head.load())
+            {
+                return false;
+            }
+            *c = m_buffer[tail];
+            m_tail.store(next_index(tail, 1));
+            return true;
+        }
+
+        /// @brief Gives the largest contiguous span of readable bytes, to be used in place then released with commit_read(). Meant to be
+        /// used by the consumer
+        /// @param len Output. Size of the span
+        /// @return The first byte to read. nullptr if the FIFO has no storage
+        inline unsigned char const *read_region(uint16_t *const len) const
+        {
+            if (m_size == 0)
+            {
+                *len = 0;
+                return SCRUTINY_NULL;
+            }
+            uint16_t const head = m_head.load();
+            uint16_t const tail = m_tail.load();
+            *len = (head >= tail) ? static_cast<uint16_t>(head - tail) : static_cast<uint16_t>(m_size - tail);
+            return &m_buffer[tail];
+        }
+
+        /// @brief Gives back to the producer bytes of the span given by read_region()
+        /// @param len Number of bytes used. Not more than the size of the span
+        inline void commit_read(uint16_t const len) { m_tail.store(next_index(m_tail.load(), len)); }
+
+        /// @brief Removes as many bytes as possible. Meant to be used by the consumer
+        /// @return The number of bytes removed
+        inline uint16_t read(unsigned char *const data, uint16_t const len)
+        {
+            uint16_t done = 0;
+            for (uint_least8_t i = 0; i < 2 && done < len; i++) // The data is in 2 parts at most
+            {
+                uint16_t region_len;
+                unsigned char const *const region = read_region(&region_len);
+                region_len = (region_len < len - done) ? region_len : static_cast<uint16_t>(len - done);
+                if (region_len == 0)
+                {
+                    break;
+                }
+                memcpy(&data[done], region, region_len);
+                commit_read(region_len);
+                done = static_cast<uint16_t>(done + region_len);
+            }
+            return done;
+        }
+
+      protected:
+        inline uint16_t next_index(uint16_t const index, uint16_t const len) const
+        {
+            uint32_t const next = static_cast<uint32_t>(index) + len; // The sum can exceed 16 bits with a big storage
+            return static_cast<uint16_t>((next >= m_size) ? next - m_size : next);
+        }
+
+        unsigned char *m_buffer; // The storage
+        uint16_t m_size;         // The storage size. 0 when unusable
+        IPCIndex m_head;         // Next byte to write. Written by the producer only
+        IPCIndex m_tail;         // Next byte to read. Written by the consumer only
+    };
+} // namespace scrutiny
+
+#endif // ___SCRUTINY_IPC_BYTE_FIFO_H___
@@ -16,6 +16,7 @@
 #endif
 
 #include <atomic>
+#include <stdint.h>
 #include <utility>
 
 namespace scrutiny
@@ -67,6 +68,24 @@ namespace scrutiny
       protected:
         std::atomic<bool> m_written;
     };
+
+    /// @brief Index shared between two time domains, written by a single one of them.
+    /// What the writer did before a store is visible to the reader once it loads the stored value.
+    class IPCIndex
+    {
+      public:
+        IPCIndex() { store(0); }
+
+        /// @brief Reads the index with acquire semantic
+        inline uint16_t load(void) const { return m_value.load(std::memory_order_acquire); }
+
+        /// @brief Writes the index with release semantic
+        /// @param value The new index
+        inline void store(uint16_t const value) { m_value.store(value, std::memory_order_release); }
+
+      protected:
+        std::atomic<uint16_t> m_value;
+    };
 } // namespace scrutiny
 
 #endif // ___SCRUTINY_IPC_STD_ATOMIC_H___
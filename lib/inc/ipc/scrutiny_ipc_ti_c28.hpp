@@ -72,6 +72,31 @@ namespace scrutiny
       protected:
         volatile bool m_written;
     };
+
+    /// @brief Index shared between two time domains, written by a single one of them.
+    class IPCIndex
+    {
+      public:
+        IPCIndex() { store(0); }
+
+        inline uint16_t load(void) const
+        {
+            uint16_t primask = __disable_interrupts();
+            uint16_t const value = m_value;
+            __restore_interrupts(primask);
+            return value;
+        }
+
+        inline void store(uint16_t const value)
+        {
+            uint16_t primask = __disable_interrupts();
+            m_value = value;
+            __restore_interrupts(primask);
+        }
+
+      protected:
+        volatile uint16_t m_value;
+    };
 } // namespace scrutiny
 
 #endif // ___SCRUTINY_IPC_STD_ATOMIC_H___
@@ -67,6 +67,25 @@ namespace scrutiny
       protected:
         volatile uint32_t m_written;
     };
+
+    /// @brief Index shared between two time domains, written by a single one of them.
+    class IPCIndex
+    {
+      public:
+        IPCIndex() { store(0); }
+
+        inline uint16_t load(void) const
+        {
+            uint16_t const value = static_cast<uint16_t>(m_value);
+            __asm__ __volatile__("" ::: "memory");
+            return value;
+        }
+
+        inline void store(uint16_t const value) { _scrutiny_ldmst(&m_value, 0xFFFFFFFFu, value); }
+
+      protected:
+        volatile uint32_t m_value;
+    };
 } // namespace scrutiny
 
 #endif // ___SCRUTINY_IPC_TRICORE_H___
@@ -11,6 +11,7 @@
 #define ___SCRUTINY_IPC_X86_H___
 
 #include "scrutiny_setup.hpp"
+#include <stdint.h>
 
 #if !(SCRUTINY_BUILD_X64 || SCRUTINY_BUILD_X86)
 #error "Can only be run on x86 instruction set"
@@ -54,6 +55,33 @@ namespace scrutiny
         volatile bool m_written;
     };
 
+    /// @brief Index shared between two time domains, written by a single one of them.
+    /// x86 does not reorder a store with older stores nor a load with younger loads. Only the compiler has to be held back
+    class IPCIndex
+    {
+      public:
+        IPCIndex() :
+            m_value(0)
+        {
+        }
+
+        inline uint16_t load(void) const
+        {
+            uint16_t const value = m_value;
+            __asm__ __volatile__("" ::: "memory");
+            return value;
+        }
+
+        inline void store(uint16_t const value)
+        {
+            __asm__ __volatile__("" ::: "memory");
+            m_value = value;
+        }
+
+      protected:
+        volatile uint16_t m_value;
+    };
+
 } // namespace scrutiny
 
 #endif // ___SCRUTINY_IPC_H___
@@ -21,6 +21,10 @@
 #include "datalogging/scrutiny_datalogging_types.hpp"
 #endif
 
+#if SCRUTINY_ENABLE_STATISTICS
+#include "statistics/scrutiny_statistics.hpp"
+#endif
+
 namespace scrutiny
 {
     class MainHandler;
@@ -29,6 +33,7 @@ namespace scrutiny
     {
         SCRUTINY_CONSTEXPR unsigned int REQUEST_OVERHEAD = 8;         // Number of bytes in a request that are not part of the payload
         SCRUTINY_CONSTEXPR unsigned int RESPONSE_OVERHEAD = 9;        // Number of bytes in a response that are not part of the payload
+        SCRUTINY_CONSTEXPR unsigned int JUMBO_RESPONSE_OVERHEAD = 11; // Same as RESPONSE_OVERHEAD, with the 32 bits length of the jumbo frames
         SCRUTINY_CONSTEXPR unsigned int MAX_DISPLAY_NAME_LENGTH = 64; // Maximum length of a display name given on discover
         SCRUTINY_CONSTEXPR unsigned int MAX_LOOP_NAME_LENGTH = 32;    // Maximum length given to a loop
         SCRUTINY_CONSTEXPR unsigned int MINIMUM_RX_BUFFER_SIZE = 32;  // Minimum size of the reception buffer
@@ -36,25 +41,45 @@ namespace scrutiny
         SCRUTINY_CONSTEXPR uint16_t BUFFER_OVERFLOW_MARGIN = 16;      // This margin let us detect overflow in CommHandler with very few calculations.
         SCRUTINY_CONSTEXPR unsigned int MAXIMUM_RX_BUFFER_SIZE = 0xFFFF - BUFFER_OVERFLOW_MARGIN; // Maximum reception buffer size in bytes
         SCRUTINY_CONSTEXPR unsigned int MAXIMUM_TX_BUFFER_SIZE = 0xFFFF - BUFFER_OVERFLOW_MARGIN; // Maximum transmission buffer size in bytes
+        SCRUTINY_CONSTEXPR uint32_t MAXIMUM_JUMBO_TX_BUFFER_SIZE = 0xFFFFFFFFu - BUFFER_OVERFLOW_MARGIN; // Maximum jumbo transmission buffer size
+        SCRUTINY_CONSTEXPR uint_least8_t COMPRESSED_PAYLOAD_FLAG = 0x80; // Set in the response subfunction when the payload is compressed
+        SCRUTINY_CONSTEXPR uint16_t COMPRESSION_WINDOW_SIZE = 256;       // How far back a match can refer to. Fits the 8 bits offset
+        SCRUTINY_CONSTEXPR uint16_t COMPRESSION_MIN_MATCH = 3;           // Shorter matches cost more than the literals they replace
+        SCRUTINY_CONSTEXPR uint16_t COMPRESSION_MAX_MATCH = COMPRESSION_MIN_MATCH + 0xFF; // Longest match that fits the 8 bits length
+        SCRUTINY_CONSTEXPR uint16_t COMPRESSION_HASH_SIZE = 32;          // Number of hash chains used to find the matches. Power of 2
+        SCRUTINY_CONSTEXPR uint_least8_t COMPRESSION_MAX_CANDIDATES = 16; // Longest walk in a hash chain. Bounds the work per item
+        SCRUTINY_CONSTEXPR uint32_t TX_BURST_DURATION_US = 5000;         // Paced transmission: longest burst, in time at the max bitrate
+        SCRUTINY_CONSTEXPR uint32_t TX_BUCKET_MIN_SIZE = 16;             // Paced transmission: burst size at very low bitrates
+        SCRUTINY_CONSTEXPR unsigned char FRAME_DELIMITER = 0x00;         // Ends a COBS frame. Never part of the encoded data
+        SCRUTINY_CONSTEXPR uint_least8_t COBS_MAX_BLOCK_LENGTH = 254;    // Non-zero bytes that a COBS code byte can announce
+        SCRUTINY_CONSTEXPR unsigned int FRAMING_MAX_TX_BUFFER_SIZE = 0xFE00; // Bigger framed responses could not be counted with 16 bits
 
         class ResponseEncoderBase
         {
           public:
-            void init(Response *const response, uint16_t const max_size);
+            void init(Response *const response, uint32_t const max_size);
             inline bool overflow(void) const { return m_overflow; };
 
           protected:
             unsigned char *m_buffer;
             Response *m_response;
-            uint16_t m_cursor;
-            uint16_t m_size_limit;
+            uint32_t m_cursor;
+            uint32_t m_size_limit;
             bool m_overflow;
         };
 
         class ReadMemoryBlocksResponseEncoder : public ResponseEncoderBase
         {
           public:
+            void init(Response *const response, uint32_t const max_size);
             void write(MemoryBlock8Bits const *const memblock_8bits);
+            /// @brief Writes the block header and leaves room for the data, to be copied later. Returns nullptr on overflow
+            unsigned char *reserve(MemoryBlock8Bits const *const memblock_8bits);
+            /// @brief Removes the last block written or reserved from the response
+            void discard_last(void);
+
+          protected:
+            uint32_t m_last_block_cursor;
         };
         class WriteMemoryBlocksResponseEncoder : public ResponseEncoderBase
         {
@@ -71,7 +96,12 @@ namespace scrutiny
         class ReadRPVResponseEncoder : public ResponseEncoderBase
         {
           public:
+            /// @brief Values are copied in the device byte order when native_endian is true. IDs stay big endian
+            void init(Response *const response, uint16_t const max_size, bool const native_endian);
             void write(RuntimePublishedValue const *const rpv, AnyType const v);
+
+          protected:
+            bool m_native_endian;
         };
 
         class WriteRPVResponseEncoder : public ResponseEncoderBase
@@ -87,14 +117,14 @@ namespace scrutiny
             void next(MemoryBlock8Bits *const memblock_8bits);
             inline bool finished(void) const { return m_finished; };
             inline bool is_valid(void) const { return !m_invalid; };
-            inline uint16_t required_tx_buffer_size(void) const { return m_required_tx_buffer_size; }
+            inline uint32_t required_tx_buffer_size(void) const { return m_required_tx_buffer_size; }
             void reset(void);
 
           protected:
             unsigned char *m_buffer;
             uint16_t m_bytes_read;
             uint16_t m_request_datasize;
-            uint16_t m_required_tx_buffer_size;
+            uint32_t m_required_tx_buffer_size;
             bool m_finished;
             bool m_invalid;
         };
@@ -154,6 +184,55 @@ namespace scrutiny
             bool m_invalid;
         };
 
+        /// @brief Compresses the payload of a response with a LZSS scheme, a bounded number of items at a time.
+        /// Each group of up to 8 items is preceded by a flag byte, LSB first. A cleared bit is a literal byte.
+        /// A set bit is a match of 2 bytes: (offset - 1) and (length - COMPRESSION_MIN_MATCH).
+        /// Matches are found by walking the chain of the previous positions having the same hash of COMPRESSION_MIN_MATCH bytes.
+        class PayloadCompressor
+        {
+          public:
+            /// @brief Starts the compression of a response payload
+            /// @param response The response to compress. Its payload is replaced and COMPRESSED_PAYLOAD_FLAG is set in its subfunction
+            /// once compressed
+            /// @param work_buffer Buffer receiving the compressed payload before it is copied back in the response.
+            /// Compression is abandoned if the compressed payload does not fit
+            /// @param work_buffer_size Size of the work buffer
+            void init(Response *const response, unsigned char *const work_buffer, uint16_t const work_buffer_size);
+            /// @brief Encodes at most max_items items (literals or matches). Each item compares at most COMPRESSION_MAX_CANDIDATES candidates.
+            /// @return true when the compression is finished
+            bool process(uint16_t const max_items);
+            inline bool finished(void) const { return m_finished; }
+            /// @brief Returns true if the payload got compressed. The payload is left untouched if compression does not make it smaller.
+            inline bool compressed(void) const { return m_compressed; }
+            inline Response *response(void) const { return m_response; }
+            void reset(void);
+
+          protected:
+            /// @brief Adds the COMPRESSION_MIN_MATCH bytes starting at pos at the head of the chain of their hash
+            inline void insert(uint16_t const pos)
+            {
+                unsigned char const *const src = &m_response->data[pos];
+                uint_least8_t const hash = static_cast<uint_least8_t>(((src[0] << 4) ^ (src[1] << 2) ^ src[2]) & (COMPRESSION_HASH_SIZE - 1));
+                uint16_t const distance = static_cast<uint16_t>(pos + 1 - m_chain_heads[hash]);
+                m_chain_links[pos % COMPRESSION_WINDOW_SIZE] =
+                    (m_chain_heads[hash] != 0 && distance < COMPRESSION_WINDOW_SIZE) ? static_cast<uint_least8_t>(distance) : 0;
+                m_chain_heads[hash] = static_cast<uint16_t>(pos + 1);
+            }
+
+            Response *m_response;
+            unsigned char *m_work_buffer;
+            uint16_t m_length;    // Payload length
+            uint16_t m_max_size;  // Maximum size of the compressed payload
+            uint16_t m_in;        // Next payload byte to encode
+            uint16_t m_out;       // Compressed bytes written in the work buffer
+            uint16_t m_flags_pos; // Position of the flag byte of the current group
+            uint_least8_t m_item; // Items written after the last flag byte. 8 starts a new group
+            uint16_t m_chain_heads[COMPRESSION_HASH_SIZE];          // Position + 1 of the last occurrence of each hash. 0 when none
+            uint_least8_t m_chain_links[COMPRESSION_WINDOW_SIZE]; // Distance from a position to the previous one with the same hash. 0 when none
+            bool m_finished;
+            bool m_compressed;
+        };
+
         namespace ResponseData
         {
             namespace GetInfo
@@ -170,6 +249,10 @@ namespace scrutiny
                     bool datalogging;
                     bool user_command;
                     bool _64bits;
+                    bool native_endian;
+                    bool compression;
+                    bool memory_watch;
+                    bool statistics;
                 };
 
                 struct GetSpecialMemoryRegionCount
@@ -212,6 +295,11 @@ namespace scrutiny
                     uint_least8_t loop_name_length;
                     char const *loop_name;
                 };
+
+                struct GetConfigFingerprint
+                {
+                    uint32_t fingerprint;
+                };
             } // namespace GetInfo
 
             namespace CommControl
@@ -235,11 +323,14 @@ namespace scrutiny
                     uint32_t comm_rx_timeout;
                     uint_least8_t address_size;
                     uint_least8_t char_bit;
+                    uint32_t jumbo_tx_buffer_size; // 0 when jumbo frames are not offered. Left out of the response then
                 };
                 struct Connect
                 {
                     unsigned char magic[sizeof(protocol::CommControl::CONNECT_MAGIC)];
                     uint32_t session_id;
+                    uint_least8_t flags; // Accepted ConnectFlags. Only sent back if the request had flags
+                    bool has_flags;
                 };
             } // namespace CommControl
 
@@ -267,6 +358,7 @@ namespace scrutiny
                     uint32_t number_of_points;
                     uint32_t data_size;
                     uint32_t points_after_trigger;
+                    datalogging::Configuration const *config; // Used to list the items stored in a reduced precision format
                 };
 
                 struct ReadAcquisition
@@ -276,8 +368,27 @@ namespace scrutiny
                     datalogging::DataReader *reader;
                     uint32_t *crc;
                 };
+
+                struct GetTimeAxis
+                {
+                    uint32_t timestep_100ns;
+                    uint16_t decimation;
+                    uint32_t trigger_timestamp;
+                    uint32_t first_entry_counter;
+                    datalogging::DataEncoder const *encoder; // Source of the time checkpoints
+                };
             } // namespace DataLogControl
+#endif
 
+#if SCRUTINY_ENABLE_STATISTICS
+            namespace Statistics
+            {
+                struct GetSetup
+                {
+                    uint_least8_t channel_count;
+                    uint_least8_t max_bin_count;
+                };
+            } // namespace Statistics
 #endif
         } // namespace ResponseData
 
@@ -324,6 +435,8 @@ namespace scrutiny
                 struct Connect
                 {
                     unsigned char magic[sizeof(protocol::CommControl::CONNECT_MAGIC)];
+                    uint_least8_t flags; // Requested ConnectFlags. 0 if the request has only the magic
+                    bool has_flags;
                 };
 
                 struct Disconnect
@@ -344,6 +457,18 @@ namespace scrutiny
                 };
             } // namespace DataLogControl
 #endif
+
+#if SCRUTINY_ENABLE_STATISTICS
+            namespace Statistics
+            {
+                struct Configure
+                {
+                    uint_least8_t loop_id;
+                    uint_least8_t channel_count;
+                    // Channels are directly written to the statistics engine storage. So not in this struct.
+                };
+            } // namespace Statistics
+#endif
         } // namespace RequestData
 
         class CodecV1_0
@@ -371,6 +496,9 @@ namespace scrutiny
             ResponseCode::eResponseCode encode_response_get_loop_definition(
                 ResponseData::GetInfo::GetLoopDefinition const *const response_data,
                 Response *const response);
+            ResponseCode::eResponseCode encode_response_get_config_fingerprint(
+                ResponseData::GetInfo::GetConfigFingerprint const *const response_data,
+                Response *const response);
 
             ResponseCode::eResponseCode encode_response_comm_discover(
                 ResponseData::CommControl::Discover const *const response_data,
@@ -413,7 +541,7 @@ namespace scrutiny
                 parsers.m_memory_control_read_request_parser.init(request);
                 return &parsers.m_memory_control_read_request_parser;
             }
-            inline ReadMemoryBlocksResponseEncoder *encode_response_memory_control_read(Response *const response, uint16_t const max_size)
+            inline ReadMemoryBlocksResponseEncoder *encode_response_memory_control_read(Response *const response, uint32_t const max_size)
             {
                 response->data_length = 0;
                 encoders.m_memory_control_read_response_encoder.init(response, max_size);
@@ -438,10 +566,13 @@ namespace scrutiny
                 encoders.m_get_rpv_definition_response_encoder.init(response, max_size);
                 return &encoders.m_get_rpv_definition_response_encoder;
             }
-            inline ReadRPVResponseEncoder *encode_response_memory_control_read_rpv(Response *const response, uint16_t const max_size)
+            inline ReadRPVResponseEncoder *encode_response_memory_control_read_rpv(
+                Response *const response,
+                uint16_t const max_size,
+                bool const native_endian = false)
             {
                 response->data_length = 0;
-                encoders.m_read_rpv_response_encoder.init(response, max_size);
+                encoders.m_read_rpv_response_encoder.init(response, max_size, native_endian);
                 return &encoders.m_read_rpv_response_encoder;
             }
             inline ReadRPVRequestParser *decode_request_memory_control_read_rpv(Request const *const request)
@@ -476,13 +607,35 @@ namespace scrutiny
                 ResponseData::DataLogControl::ReadAcquisition const *const response_data,
                 Response *const response,
                 bool *const finished);
+            ResponseCode::eResponseCode encode_response_datalogging_get_time_axis(
+                ResponseData::DataLogControl::GetTimeAxis const *const response_data,
+                Response *const response);
             ResponseCode::eResponseCode decode_datalogging_configure_request(
                 Request const *const request,
                 RequestData::DataLogControl::Configure *const request_data,
                 datalogging::Configuration *const config);
 #endif
+#if SCRUTINY_ENABLE_STATISTICS
+            ResponseCode::eResponseCode encode_response_statistics_get_setup(
+                ResponseData::Statistics::GetSetup const *const response_data,
+                Response *const response);
+            ResponseCode::eResponseCode decode_statistics_configure_request(
+                Request const *const request,
+                RequestData::Statistics::Configure *const request_data,
+                statistics::Channel *const channels,
+                uint_least8_t const capacity);
+            ResponseCode::eResponseCode encode_response_statistics_read(
+                statistics::StatisticsEngine const *const statistics,
+                Response *const response);
+#endif
 
           protected:
+#if SCRUTINY_ENABLE_DATALOGGING
+            ResponseCode::eResponseCode decode_datalogging_operand(
+                Request const *const request,
+                uint16_t *const cursor,
+                datalogging::Operand *const operand) const;
+#endif
             union
             {
                 ReadMemoryBlocksRequestParser m_memory_control_read_request_parser;
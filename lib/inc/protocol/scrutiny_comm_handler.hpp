@@ -62,9 +62,22 @@ namespace scrutiny
             // Reads data from the scrutiny lib so that it can be sent to the outside world (to the server)
             uint16_t pop_data(unsigned char *const buffer, uint16_t len);
 
-            /// @brief Returns the number of bytes pending to be sent.
+            /// @brief Returns the number of bytes that can be sent right away. Less than the bytes pending when the transmission is paced
+            /// or when a jumbo frame has more than 0xFFFF bytes left.
             uint16_t data_to_send(void) const;
 
+            /// @brief Paces the transmission with a token bucket so that pop_data() never gives more than the given bitrate.
+            /// After an idle period, a burst of TX_BURST_DURATION_US worth of bytes can go at once, never more than a frame of the
+            /// session. 0 disables the pacing
+            /// @param bitrate The maximum bitrate in bit/sec
+            void set_max_bitrate(uint32_t const bitrate);
+
+            /// @brief Sets the buffer that holds the responses of a session with jumbo frames. Must be bigger than the transmission buffer,
+            /// otherwise jumbo frames are not offered
+            /// @param buffer The jumbo transmission buffer
+            /// @param buffer_size The jumbo transmission buffer size
+            void set_jumbo_tx_buffer(unsigned char *const buffer, uint32_t const buffer_size);
+
             // Writes the CRC property of the response based on the payload content.
             void add_crc(Response *const response) const;
 
@@ -123,12 +136,37 @@ namespace scrutiny
             /// @brief Returns the session ID given to the server upon connection
             inline uint32_t get_session_id(void) const { return m_session_id; }
 
+            /// @brief Sets the ConnectFlags accepted for the active session. Cleared when the session ends
+            inline void set_session_flags(uint_least8_t const flags) { m_session_flags = m_session_active ? flags : 0u; }
+
+            /// @brief Returns the ConnectFlags accepted for the active session
+            inline uint_least8_t get_session_flags(void) const { return m_session_flags; }
+
+            /// @brief Returns true if the values sent to the server of the active session can be in the device byte order
+            inline bool native_endian(void) const { return (m_session_flags & CommControl::ConnectFlags::NativeEndian) != 0; }
+
+            /// @brief Returns true if the server of the active session accepts compressed payloads
+            inline bool compression(void) const { return (m_session_flags & CommControl::ConnectFlags::Compression) != 0; }
+
+            /// @brief Returns true if the frames of the active session are COBS encoded. Applies from the request that follows the connection
+            inline bool framing(void) const { return (m_session_flags & CommControl::ConnectFlags::Framing) != 0; }
+
+            /// @brief Returns true if the responses of the active session have a 32 bits length. Applies from the request that follows the connection
+            inline bool jumbo_frames(void) const { return (m_session_flags & CommControl::ConnectFlags::JumboFrames) != 0; }
+
             /// @brief Returns the size of the reception buffer
             inline uint16_t rx_buffer_size(void) const { return m_rx_buffer_size; }
 
             /// @brief Returns the size of the transmission buffer
             inline uint16_t tx_buffer_size(void) const { return m_tx_buffer_size; }
 
+            /// @brief Returns the size of the jumbo transmission buffer. 0 if jumbo frames are not offered
+            inline uint32_t jumbo_tx_buffer_size(void) const { return m_jumbo_tx_buffer_size; }
+
+            /// @brief Returns the maximum payload size of the response to the request being processed.
+            /// Bigger than tx_buffer_size() in a session with jumbo frames
+            inline uint32_t response_max_length(void) const { return m_rx_jumbo ? m_jumbo_tx_buffer_size : m_tx_buffer_size; }
+
           protected:
             void process_active_request(void);
             bool received_discover_request(void) const;
@@ -166,11 +204,22 @@ namespace scrutiny
 
             void reset_rx();
             void reset_tx();
+            void receive_frame_bytes(unsigned char const *const data, uint16_t const len);
+            void receive_cobs_data(unsigned char const *const data, uint16_t const len);
+            uint16_t pop_cobs_data(unsigned char *const buffer, uint16_t const len);
+            unsigned char tx_raw_byte(uint32_t const index) const;
+            inline uint_least8_t tx_header_size(void) const { return m_tx_jumbo ? 7u : 5u; } // cmd8 + subfn8 + code8 + len16 or len32
+            uint_least8_t cobs_block_length(uint16_t const raw_index) const;
+            uint16_t cobs_encoded_size(void) const;
+            uint32_t compute_tx_tokens(uint32_t *const credit_remainder) const;
+            void refill_tx_tokens(void);
+            uint32_t tx_bucket_size(void) const;
 
             Timebase const *m_timebase;          // Pointer to the timebase given by the MainHandler
             timestamp_t m_heartbeat_timestamp;   // Timestamp of the last heartbeat gotten
             uint32_t m_session_id;               // Actual session ID
             uint16_t m_last_heartbeat_challenge; // Challenge received by the last heartbeat
+            uint_least8_t m_session_flags;       // ConnectFlags accepted for the active session
             State::eState m_state;               // Internal state, idle, receiving, transmitting
             bool m_enabled;                      // Enable flag
             bool m_session_active;               // Flag indicating if a session is active with the server
@@ -186,6 +235,8 @@ namespace scrutiny
             bool m_request_received;            // Flag indicating if a full request has been received
             RxFSMState::eRxFSMState m_rx_state; // Reception Finite State Machine state
             RxError::eRxError m_rx_error;       // Last reception error code
+            bool m_rx_framed;                   // The request is COBS encoded. Latched when waiting for a request
+            bool m_rx_jumbo;                    // The request is answered with a jumbo frame. Latched when waiting for a request
             union
             {
                 uint16_t data_bytes_received;        // Number of bytes part of the data payload received up to now
@@ -196,9 +247,36 @@ namespace scrutiny
             // Transmission
             Response m_active_response;   // The response being transmitted
             uint32_t m_crc;               // CRC of the incoming data computed has bytes come in
-            uint16_t m_nbytes_to_send;    // Number of bytes to send in this response
-            uint16_t m_nbytes_sent;       // Number of bytes sent up to now. Includes headers and CRC
+            uint32_t m_nbytes_to_send;    // Number of bytes to send in this response
+            uint32_t m_nbytes_sent;       // Number of bytes sent up to now. Includes headers and CRC
             TxError::eTxError m_tx_error; // Last Transmission error code
+            bool m_tx_framed;             // The response is COBS encoded, like the request it answers
+            bool m_tx_jumbo;              // The response has a 32 bits length
+            uint32_t m_nbytes_raw;        // Number of bytes in the response before the COBS encoding
+
+            // Jumbo frames
+            unsigned char *m_jumbo_tx_buffer; // The transmission buffer of a session with jumbo frames
+            uint32_t m_jumbo_tx_buffer_size;  // The jumbo transmission buffer size. 0 when jumbo frames are not offered
+
+            // COBS framing
+            struct
+            {
+                uint_least8_t remaining; // Data bytes left in the block being decoded. The next byte is a code byte when 0
+                bool pending_zero;       // The block being decoded is followed by a zero, unless the frame ends first
+            } m_cobs_rx;
+            struct
+            {
+                uint16_t raw_index;            // Index of the next response byte to encode
+                uint_least8_t block_remaining; // Data bytes of the block being encoded that are not sent yet
+                bool skip_zero;                // The block being encoded ends with a zero that the code byte stands for
+                bool need_block;               // A code byte must be sent before the delimiter
+            } m_cobs_tx;
+
+            // Pacing
+            uint32_t m_max_bitrate;            // Maximum bitrate of the transmission in bit/sec. 0 when not paced
+            uint32_t m_tx_tokens;              // Number of bytes that can be given by pop_data() right away
+            uint32_t m_tx_credit_remainder;    // Fraction of a byte earned since the last refill, in bit*100ns
+            timestamp_t m_tx_tokens_timestamp; // Timestamp of the last refill
 
           private:
             static uint32_t s_session_counter; // A counter to generate session ID
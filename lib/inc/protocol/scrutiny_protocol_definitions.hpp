@@ -49,8 +49,8 @@ namespace scrutiny
             uint_least8_t command_id;
             uint_least8_t subfunction_id;
             uint_least8_t response_code;
-            uint16_t data_length;
-            uint16_t data_max_length;
+            uint32_t data_length; // Above 16 bits only in a session with jumbo frames
+            uint32_t data_max_length;
             unsigned char *data;
             uint32_t crc;
         };
@@ -65,7 +65,8 @@ namespace scrutiny
                 CommControl = 0x02,
                 MemoryControl = 0x03,
                 UserCommand = 0x04,
-                DataLogControl = 0x05
+                DataLogControl = 0x05,
+                Statistics = 0x06
             };
             // clang-format on
         };
@@ -139,7 +140,8 @@ namespace scrutiny
                     GetRuntimePublishedValuesCount = 6,
                     GetRuntimePublishedValuesDefinition = 7,
                     GetLoopCount = 8,
-                    GetLoopDefinition = 9
+                    GetLoopDefinition = 9,
+                    GetConfigFingerprint = 10
                 };
                 // clang-format on
             };
@@ -176,6 +178,21 @@ namespace scrutiny
                 };
                 // clang-format on
             };
+
+            /// @brief Options requested by the server in the optional byte that follows the Connect magic
+            class ConnectFlags
+            {
+              public:
+                // clang-format off
+                SCRUTINY_ENUM(eConnectFlags, uint_least8_t)
+                {
+                    NativeEndian = 0x01, // RPV values are sent in the device byte order instead of big endian
+                    Compression = 0x02,  // Memory reads and datalogging acquisition payloads may be compressed
+                    Framing = 0x04,      // Frames following the connection are COBS encoded and end with a 0x00 delimiter
+                    JumboFrames = 0x08   // Responses following the connection have a 32 bits length and can use the jumbo transmission buffer
+                };
+                // clang-format on
+            };
         } // namespace CommControl
 
         namespace MemoryControl
@@ -190,7 +207,14 @@ namespace scrutiny
                     Write = 2,
                     WriteMasked = 3,
                     ReadRPV = 4,
-                    WriteRPV = 5
+                    WriteRPV = 5,
+                    ReadSnapshot = 6,         // Same as Read, prefixed with a loop ID. Data is copied by the loop at its next iteration
+                    ReadRPVSnapshot = 7,      // Same as ReadRPV, prefixed with a loop ID. Values are read by the loop at its next iteration
+                    WriteDeferred = 8,        // Same as Write, prefixed with a loop ID. Data is written by the loop at its next iteration
+                    WriteMaskedDeferred = 9,  // Same as WriteMasked, prefixed with a loop ID. Data is written by the loop at its next iteration
+                    WriteRPVDeferred = 10,    // Same as WriteRPV, prefixed with a loop ID. Values are written by the loop at its next iteration
+                    ReadChanged = 11          // Same as Read, prefixed with the sequence number of the last response received. Only the
+                                              // blocks that changed since the acknowledged response are sent, after a new sequence number
                 };
                 // clang-format on
             };
@@ -211,12 +235,46 @@ namespace scrutiny
                     GetStatus = 5,
                     GetAcquisitionMetadata = 6,
                     ReadAcquisition = 7,
-                    ResetDatalogger = 8
+                    ResetDatalogger = 8,
+                    GetTimeAxis = 9,
+                    ReleaseAcquisition = 10
+                };
+                // clang-format on
+            };
+
+            /// @brief Optional blocks that can be appended after the list of items in a ConfigureDatalog request.
+            /// Each block starts with its ID, followed by a payload that depends on the block type.
+            class ConfigureExtension
+            {
+              public:
+                // clang-format off
+                SCRUTINY_ENUM(eConfigureExtension, uint_least8_t)
+                {
+                    ItemDecimation = 1, // 16 bits decimation for each item
+                    ItemReduction = 2,  // 8 bits reduction mode + 8 bits datatype for each item. Datatype is used by memory items only
+                    ItemStorage = 3,    // 8 bits storage format + 8 bits datatype + float32 scale + float32 offset for each item
+                    DoubleBuffering = 4 // No payload. Enables the double buffering mode
                 };
                 // clang-format on
             };
         } // namespace DataLogControl
 
+        namespace Statistics
+        {
+            class Subfunction
+            {
+              public:
+                // clang-format off
+                SCRUTINY_ENUM(eSubfunction, uint_least8_t)
+                {
+                    GetSetup = 1,  // Number of channels and maximum number of histogram bins
+                    Configure = 2, // Chooses the loop and the values to monitor. Restarts the statistics. No channel stops them
+                    Read = 3       // Statistics of each channel, as of the next iteration of the loop
+                };
+                // clang-format on
+            };
+        } // namespace Statistics
+
     } // namespace protocol
 } // namespace scrutiny
 
@@ -13,6 +13,7 @@
 #include "scrutiny_main_handler.hpp"
 #include "scrutiny_setup.hpp"
 #include "scrutiny_software_id.hpp"
+#include "scrutiny_static_config.hpp"
 #include "scrutiny_timebase.hpp"
 #include "scrutiny_tools.hpp"
 #include "scrutiny_types.hpp"
@@ -21,6 +22,10 @@
 #include "datalogging/scrutiny_datalogging.hpp"
 #endif
 
+#if SCRUTINY_ENABLE_STATISTICS
+#include "statistics/scrutiny_statistics.hpp"
+#endif
+
 #include "protocol/scrutiny_protocol.hpp"
 
 #endif
@@ -19,6 +19,22 @@ typedef void (*scrutiny_c_user_command_callback_t)(
     uint16_t *response_data_length,
     uint16_t const response_max_data_length);
 
+typedef enum
+{
+    SCRUTINY_C_USER_COMMAND_DONE,
+    SCRUTINY_C_USER_COMMAND_PENDING,
+    SCRUTINY_C_USER_COMMAND_FAILED
+} scrutiny_c_user_command_status_e;
+
+typedef scrutiny_c_user_command_status_e (*scrutiny_c_async_user_command_callback_t)(
+    uint_least8_t const subfunction,
+    unsigned char const *request_data,
+    uint16_t const request_data_length,
+    unsigned char *response_data,
+    uint16_t *response_data_length,
+    uint16_t const response_max_data_length,
+    uint_least8_t const new_request);
+
 typedef enum
 {
     SCRUTINY_C_ENDIANNESS_LITTLE,
@@ -37,6 +53,16 @@ typedef struct
     void *end;
 } scrutiny_c_address_range_t;
 
+typedef struct
+{
+    void *start_address;
+    uint32_t hash;         // Hash of the data the server has acknowledged
+    uint32_t pending_hash; // Hash of the data sent in the last response, until the server acknowledges it
+    uint16_t length;
+    uint_least8_t valid;
+    uint_least8_t pending;
+} scrutiny_c_watched_memory_block_t;
+
 typedef uint32_t scrutiny_c_timediff_t;
 
 typedef enum
@@ -166,6 +192,12 @@ typedef struct
 
 /// @brief Callback called on Runtime Published Value read
 typedef int (*scrutiny_c_rpv_read_callback_t)(scrutiny_c_runtime_published_value_t const rpv, scrutiny_c_any_type_t *outval, void *const caller);
+/// @brief Callback called to read several Runtime Published Values in a single call. Fills outvals[i] with the value of rpvs[i].
+typedef int (*scrutiny_c_rpv_bulk_read_callback_t)(
+    scrutiny_c_runtime_published_value_t const *rpvs,
+    scrutiny_c_any_type_t *outvals,
+    uint16_t const count,
+    void *const caller);
 /// @brief Callback called on Runtime Published Value write
 typedef int (
     *scrutiny_c_rpv_write_callback_t)(scrutiny_c_runtime_published_value_t const rpv, scrutiny_c_any_type_t const *inval, void *const caller);
@@ -177,4 +209,14 @@ typedef uint32_t scrutiny_c_datalogging_buffer_size_t;
 #else
 typedef uint16_t scrutiny_c_datalogging_buffer_size_t;
 #endif
+/// @brief Callback that writes a block of data into an external datalogging storage. Address and size are in char
+typedef void (*scrutiny_c_datalogging_storage_write_callback_t)(
+    scrutiny_c_datalogging_buffer_size_t const address,
+    unsigned char const *data,
+    scrutiny_c_datalogging_buffer_size_t const size);
+/// @brief Callback that reads a block of data from an external datalogging storage. Address and size are in char
+typedef void (*scrutiny_c_datalogging_storage_read_callback_t)(
+    scrutiny_c_datalogging_buffer_size_t const address,
+    unsigned char *data,
+    scrutiny_c_datalogging_buffer_size_t const size);
 #endif
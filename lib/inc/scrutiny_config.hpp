@@ -36,6 +36,55 @@ namespace scrutiny
         /// @param tx_buffer_size Transmission buffer size
         void set_buffers(unsigned char *rx_buffer, uint16_t const rx_buffer_size, unsigned char *tx_buffer, uint16_t const tx_buffer_size);
 
+        /// @brief Set the buffers of an additional communication channel. Each channel has its own buffers and session and is
+        /// served by the same MainHandler. Channel 0 is the one configured by set_buffers(). Channels without buffers are disabled.
+        /// @param channel The channel index. Must be less than SCRUTINY_COMM_CHANNEL_COUNT
+        /// @param rx_buffer Reception buffer
+        /// @param rx_buffer_size Reception buffer size
+        /// @param tx_buffer Transmission buffer
+        /// @param tx_buffer_size Transmission buffer size
+        void set_channel_buffers(
+            uint_least8_t const channel,
+            unsigned char *rx_buffer,
+            uint16_t const rx_buffer_size,
+            unsigned char *tx_buffer,
+            uint16_t const tx_buffer_size);
+
+        /// @brief Set the buffer that holds the responses when the server asks for jumbo frames at connection. Responses then have a
+        /// 32 bits length and memory reads and datalogging acquisitions can go beyond the 16 bits limit of the regular frames.
+        /// Jumbo frames are offered only if this buffer is bigger than the transmission buffer given to set_buffers().
+        /// @param jumbo_tx_buffer Jumbo transmission buffer
+        /// @param jumbo_tx_buffer_size Jumbo transmission buffer size
+        void set_jumbo_tx_buffer(unsigned char *jumbo_tx_buffer, uint32_t const jumbo_tx_buffer_size);
+
+        /// @brief Same as set_jumbo_tx_buffer() for an additional communication channel
+        /// @param channel The channel index. Must be less than SCRUTINY_COMM_CHANNEL_COUNT
+        /// @param jumbo_tx_buffer Jumbo transmission buffer
+        /// @param jumbo_tx_buffer_size Jumbo transmission buffer size
+        void set_channel_jumbo_tx_buffer(uint_least8_t const channel, unsigned char *jumbo_tx_buffer, uint32_t const jumbo_tx_buffer_size);
+
+        /// @brief Set the storage of the byte FIFOs placed in front of the communication stream. An interrupt can then push the received
+        /// bytes in MainHandler::rx_fifo() and pop the bytes to send from MainHandler::tx_fifo() without a lock, while process() moves
+        /// them in bulk. A FIFO without storage is not used.
+        /// @param rx_fifo_buffer Reception FIFO storage
+        /// @param rx_fifo_size Reception FIFO storage size
+        /// @param tx_fifo_buffer Transmission FIFO storage
+        /// @param tx_fifo_size Transmission FIFO storage size
+        void set_fifos(unsigned char *rx_fifo_buffer, uint16_t const rx_fifo_size, unsigned char *tx_fifo_buffer, uint16_t const tx_fifo_size);
+
+        /// @brief Same as set_fifos() for an additional communication channel
+        /// @param channel The channel index. Must be less than SCRUTINY_COMM_CHANNEL_COUNT
+        /// @param rx_fifo_buffer Reception FIFO storage
+        /// @param rx_fifo_size Reception FIFO storage size
+        /// @param tx_fifo_buffer Transmission FIFO storage
+        /// @param tx_fifo_size Transmission FIFO storage size
+        void set_channel_fifos(
+            uint_least8_t const channel,
+            unsigned char *rx_fifo_buffer,
+            uint16_t const rx_fifo_size,
+            unsigned char *tx_fifo_buffer,
+            uint16_t const tx_fifo_size);
+
 #if SCRUTINY_SUPPORT_PROTECTED_REGIONS
         /// @brief Define some memory sections that are to be left untouched
         /// @param range Array of ranges represented by the `AddressRange` object.
@@ -64,6 +113,37 @@ namespace scrutiny
             RpvReadCallback const rd_cb = SCRUTINY_NULL_FN_PTR(RpvReadCallback),
             RpvWriteCallback const wr_cb = SCRUTINY_NULL_FN_PTR(RpvWriteCallback));
 
+        /// @brief Same as set_published_values() for a table validated at compile time with SCRUTINY_STATIC_CHECK_RPV_TABLE
+        /// (see scrutiny_static_config.hpp). Such a table can be declared constexpr and live in read-only memory.
+        /// The RPVs are found by ID with a binary search. MainHandler::init() fails if the IDs are not strictly increasing.
+        /// @param array Array of RPV sorted by ID.
+        /// @param nbr Number of RPV in the array
+        /// @param rd_cb Callback to call to read a RPV
+        /// @param wr_cb Callback to call to write a RPV
+        void set_static_published_values(
+            RuntimePublishedValue const *array,
+            uint16_t const nbr,
+            RpvReadCallback const rd_cb = SCRUTINY_NULL_FN_PTR(RpvReadCallback),
+            RpvWriteCallback const wr_cb = SCRUTINY_NULL_FN_PTR(RpvWriteCallback));
+
+        /// @brief Sets the value returned by GetConfigFingerprint so that MainHandler::init() does not compute it from the definitions.
+        /// It must change whenever the RPVs, the loops or the protected regions change, e.g. a hash generated by the build.
+        /// @param fingerprint The configuration fingerprint
+        inline void set_config_fingerprint(uint32_t const fingerprint)
+        {
+            m_config_fingerprint = fingerprint;
+            m_config_fingerprint_set = true;
+        }
+
+        /// @brief Sets a callback that reads several Runtime Published Values in one call. When set, it is used instead of the
+        /// per-value read callback wherever more than one RPV is read at once (ReadRPV requests, datalogging entries).
+        /// Can be used without a per-value read callback.
+        /// @param callback The bulk read callback
+        inline void set_rpv_bulk_read_callback(RpvBulkReadCallback callback)
+        {
+            m_rpv_bulk_read_callback = callback;
+        }
+
         /// @brief Defines the different loops (tasks) in the application.
         /// @param loops Array of pointers to the `scrutiny::LoopHandler`.
         /// This array must be allocated outside of Scrutiny and stay
@@ -87,6 +167,73 @@ namespace scrutiny
             return m_user_command_callback;
         };
 
+        /// @brief Sets a callback to be called by Scrutiny after a request to the UserCommand function that can complete over several
+        /// calls to `MainHandler::process()`. The callback returns PENDING until the response is ready and is then polled again with the same
+        /// request, `new_request` being 0. A command that stays pending for too long is answered with FailureToProceed and the callback is
+        /// not told; the next call with `new_request` set to 1 means that any work left in progress must be dropped.
+        /// Takes precedence over the callback given to `set_user_command_callback()`
+        /// @param callback The callback
+        inline void set_async_user_command_callback(async_user_command_callback_t callback)
+        {
+            m_async_user_command_callback = callback;
+        };
+
+        /// @brief Returns the actual asynchronous user command callback. nullptr if unset
+        /// @return The callback
+        inline async_user_command_callback_t get_async_user_command_callback(void)
+        {
+            return m_async_user_command_callback;
+        };
+
+        /// @brief Sets the staging buffer used by the operations executed by a LoopHandler at its next iteration: snapshot reads
+        /// (ReadSnapshot, ReadRPVSnapshot) and deferred writes (WriteDeferred, WriteMaskedDeferred, WriteRPVDeferred).
+        /// These operations are not supported if unset.
+        /// @param buffer The staging buffer
+        /// @param buffer_size The staging buffer size. A read response or a write request bigger than this buffer is reported as an overflow
+        inline void set_staging_buffer(unsigned char *buffer, uint16_t const buffer_size)
+        {
+            m_staging_buffer = buffer;
+            m_staging_buffer_size = buffer_size;
+        }
+
+        /// @brief Returns true if a staging buffer has been given for the snapshot reads and deferred writes
+        inline bool is_staging_buffer_set(void) const
+        {
+            return m_staging_buffer != SCRUTINY_NULL && m_staging_buffer_size > 0;
+        }
+
+        /// @brief Sets the work buffer of the payload compression. Compression is offered to the server only if set.
+        /// Memory reads and datalogging acquisition payloads are compressed in it, then copied back in the Tx buffer.
+        /// @param buffer The compression buffer
+        /// @param buffer_size The compression buffer size. Payloads that do not compress below this size are sent uncompressed
+        inline void set_compression_buffer(unsigned char *buffer, uint16_t const buffer_size)
+        {
+            m_compression_buffer = buffer;
+            m_compression_buffer_size = buffer_size;
+        }
+
+        /// @brief Returns true if a work buffer has been given for the payload compression
+        inline bool is_compression_buffer_set(void) const
+        {
+            return m_compression_buffer != SCRUTINY_NULL && m_compression_buffer_size > 0;
+        }
+
+        /// @brief Sets the table that keeps a hash of the memory blocks read with the MemoryControl ReadChanged service, so that
+        /// only the blocks that changed since the last read acknowledged by the server are sent. The ReadChanged service is not supported if unset.
+        /// @param blocks Array of block states. Must stay allocated forever. Content is initialized by the MainHandler
+        /// @param block_count Number of entries in the array. Blocks past this count are sent on every read
+        inline void set_watched_blocks(WatchedMemoryBlock *blocks, uint16_t const block_count)
+        {
+            m_watched_blocks = blocks;
+            m_watched_block_count = block_count;
+        }
+
+        /// @brief Returns true if a table has been given for the change detection of memory blocks
+        inline bool is_watched_blocks_set(void) const
+        {
+            return m_watched_blocks != SCRUTINY_NULL && m_watched_block_count > 0;
+        }
+
 #if SCRUTINY_ENABLE_DATALOGGING
 
         /// @brief Sets the buffer used to store data when doing a datalogging acquisition
@@ -94,6 +241,20 @@ namespace scrutiny
         /// @param buffer_size The datalogging buffer size
         void set_datalogging_buffers(unsigned char *buffer, datalogging::buffer_size_t const buffer_size);
 
+        /// @brief Stores the datalogging data in an external memory (e.g. SPI RAM) accessed through callbacks instead of an internal buffer.
+        /// Replaces the buffer given to set_datalogging_buffers()
+        /// @param write_callback Writes a block of data to the external memory. Called from the loop that owns the datalogger
+        /// @param read_callback Reads a block of data from the external memory. Called from `MainHandler::process()`
+        /// @param storage_size Size of the external memory region usable by the datalogger, in char
+        /// @param cache Internal buffer used to group the writes and stream the data back. Must hold the biggest entry of an acquisition
+        /// @param cache_size Size of the cache, in char
+        void set_datalogging_external_storage(
+            datalogging::storage_write_callback_t write_callback,
+            datalogging::storage_read_callback_t read_callback,
+            datalogging::buffer_size_t const storage_size,
+            unsigned char *cache,
+            uint16_t const cache_size);
+
         /// @brief Sets a callback to be called by Scrutiny when a datalogging trigger condition is triggered. This callback will be called from the
         /// context of the LoopHandler using the datalogger with no thread safety. This means that if data are to be passed to another task, it is
         /// the integrator responsibility to ensure thread safety
@@ -102,6 +263,18 @@ namespace scrutiny
         {
             m_datalogger_trigger_callback = callback;
         };
+#endif
+#if SCRUTINY_ENABLE_STATISTICS
+
+        /// @brief Sets the storage of the statistics engine, which computes the count, min, max, mean, mean square and histogram of
+        /// values chosen by the server at each iteration of a loop. The statistics feature is not supported if unset.
+        /// @param channels Array of channels. Must stay allocated forever. Content is managed by the MainHandler
+        /// @param channel_count Number of channels in the array. This is the maximum number of values that can be monitored at once
+        inline void set_statistics_channels(statistics::Channel *channels, uint_least8_t const channel_count)
+        {
+            m_statistics_channels = channels;
+            m_statistics_channel_count = channel_count;
+        }
 #endif
         /// @brief Returns true if a callback has been set to support the UserCallback service call
         inline bool is_user_command_callback_set(void) const
@@ -109,10 +282,16 @@ namespace scrutiny
             return m_user_command_callback != SCRUTINY_NULL_FN_PTR(user_command_callback_t);
         }
 
+        /// @brief Returns true if a callback has been set to support the UserCallback service call asynchronously
+        inline bool is_async_user_command_callback_set(void) const
+        {
+            return m_async_user_command_callback != SCRUTINY_NULL_FN_PTR(async_user_command_callback_t);
+        }
+
         /// @brief Returns true if the communication buffers were set
         inline bool is_buffer_set(void) const
         {
-            return (m_rx_buffer != SCRUTINY_NULL) && (m_tx_buffer != SCRUTINY_NULL);
+            return (m_channels[0].rx_buffer != SCRUTINY_NULL) && (m_channels[0].tx_buffer != SCRUTINY_NULL);
         }
 #if SCRUTINY_SUPPORT_PROTECTED_REGIONS
         /// @brief Returns true if forbidden regions have been defined
@@ -151,10 +330,12 @@ namespace scrutiny
             return m_readonly_range_count;
         }
 #endif
-        /// @brief Returns true if Runtime Published Values (RPV) were defined and a Read callback has been given
+        /// @brief Returns true if Runtime Published Values (RPV) were defined and a Read callback (single or bulk) has been given
         inline bool is_read_published_values_configured(void) const
         {
-            return (m_rpv_read_callback != SCRUTINY_NULL_FN_PTR(RpvReadCallback) && m_rpvs != SCRUTINY_NULL && m_rpv_count > 0);
+            bool const callback_set = m_rpv_read_callback != SCRUTINY_NULL_FN_PTR(RpvReadCallback) ||
+                                      m_rpv_bulk_read_callback != SCRUTINY_NULL_FN_PTR(RpvBulkReadCallback);
+            return (callback_set && m_rpvs != SCRUTINY_NULL && m_rpv_count > 0);
         };
 
         /// @brief Returns true if Runtime Published Values (RPV) were defined and a Write callback has been given
@@ -173,12 +354,22 @@ namespace scrutiny
         /// @brief Returns true if the datalogging feature has been configured to a working point.
         inline bool is_datalogging_configured(void) const
         {
-            return (m_datalogger_buffer != SCRUTINY_NULL && m_datalogger_buffer_size != 0);
+            bool const storage_set =
+                m_datalogger_buffer != SCRUTINY_NULL || m_datalogger_storage.write != SCRUTINY_NULL_FN_PTR(datalogging::storage_write_callback_t);
+            return (storage_set && m_datalogger_buffer_size != 0);
         };
 
         /// @brief Returns true if at least one loop support datalogging
         bool has_at_least_one_loop_with_datalogging(void) const;
 #endif
+#if SCRUTINY_ENABLE_STATISTICS
+
+        /// @brief Returns true if a storage has been given to the statistics engine
+        inline bool is_statistics_configured(void) const
+        {
+            return m_statistics_channels != SCRUTINY_NULL && m_statistics_channel_count > 0;
+        }
+#endif
 
         /// @brief Returns the pointer to the array of Runtime Published Values (RPV)
         inline RuntimePublishedValue const *get_rpvs_array(void) const
@@ -186,6 +377,24 @@ namespace scrutiny
             return m_rpvs;
         }
 
+        /// @brief Returns true if the Runtime Published Values were given with set_static_published_values() and are sorted by ID
+        inline bool is_static_published_values(void) const
+        {
+            return m_static_rpvs;
+        }
+
+        /// @brief Returns true if a fingerprint was given with set_config_fingerprint()
+        inline bool is_config_fingerprint_set(void) const
+        {
+            return m_config_fingerprint_set;
+        }
+
+        /// @brief Returns the fingerprint given with set_config_fingerprint()
+        inline uint32_t get_config_fingerprint(void) const
+        {
+            return m_config_fingerprint;
+        }
+
         /// @brief  Return the number of Runtime Published Values (RPV) configured
         inline uint16_t get_rpv_count(void) const
         {
@@ -198,15 +407,26 @@ namespace scrutiny
             return m_rpv_read_callback;
         }
 
+        /// @brief Return the Runtime Published Value (RPV) bulk read callback
+        inline RpvBulkReadCallback get_rpv_bulk_read_callback(void) const
+        {
+            return m_rpv_bulk_read_callback;
+        }
+
         /// @brief Return the Runtime Published Value (RPV) write callback
         inline RpvWriteCallback get_rpv_write_callback(void) const
         {
             return m_rpv_write_callback;
         }
 
-        /// @brief Maximum bitrate in bit/sec. This value is given to the server and enforced by the server only.
+        /// @brief Maximum bitrate in bit/sec. This value is given to the server and enforced by the server. Also enforced by the device
+        /// when enforce_max_bitrate is true. 0 means no limit
         uint32_t max_bitrate;
 
+        /// @brief When true, the data given by MainHandler::pop_data() is paced so that max_bitrate is never exceeded.
+        /// Useful when the link is shared with other traffic. The pacing resolution is the period of MainHandler::process()
+        bool enforce_max_bitrate;
+
         /// @brief A seed to initialize the session counter to avoid having collision in case multiple scrutiny enabled devices uses the same
         /// communication channel
         uint32_t session_counter_seed;
@@ -218,29 +438,55 @@ namespace scrutiny
         bool memory_write_enable;
 
       private:
-        unsigned char *m_rx_buffer; // The comm Rx buffer
-        unsigned char *m_tx_buffer; // The comm Tx buffer
+        struct CommChannelBuffers
+        {
+            unsigned char *rx_buffer;       // The comm Rx buffer
+            unsigned char *tx_buffer;       // The comm Tx buffer
+            uint16_t rx_buffer_size;        // The comm Rx buffer size
+            uint16_t tx_buffer_size;        // The comm Tx buffer size
+            unsigned char *jumbo_tx_buffer; // The comm Tx buffer of the jumbo frames. nullptr if unset
+            uint32_t jumbo_tx_buffer_size;  // The comm Tx buffer size of the jumbo frames
+            unsigned char *rx_fifo_buffer;  // The storage of the Rx FIFO. nullptr if unset
+            unsigned char *tx_fifo_buffer;  // The storage of the Tx FIFO. nullptr if unset
+            uint16_t rx_fifo_size;          // The storage size of the Rx FIFO
+            uint16_t tx_fifo_size;          // The storage size of the Tx FIFO
+        };
 
-#if SCRUTINY_SUPPORT_PROTECTED_REGIONS                  // The comm Tx buffer size
+        CommChannelBuffers m_channels[SCRUTINY_COMM_CHANNEL_COUNT]; // Buffers of each communication channel
+#if SCRUTINY_SUPPORT_PROTECTED_REGIONS
         AddressRange const *m_forbidden_address_ranges; // The forbidden address range array pointer. nullptr if unset
         AddressRange const *m_readonly_address_ranges;  // The read-only address range array pointer. nullptr if unset
         uint_least8_t m_forbidden_range_count;          // The forbidden address range count
         uint_least8_t m_readonly_range_count;           // The read-only address range count
 #endif
-        RuntimePublishedValue const *m_rpvs;             // The array of Runtime Published Values. nullptr if unset
-        RpvReadCallback m_rpv_read_callback;             // The callback to perform read operation on a Runtime Published Value (RPV)
-        RpvWriteCallback m_rpv_write_callback;           // The callback to perform write operation on a Runtime Published Value (RPV)
-        user_command_callback_t m_user_command_callback; // Callback to call when a User Command service call is requested by the server
-        LoopHandler **m_loops;                           // The array of Loop Handler pointers
-        uint16_t m_rx_buffer_size;                       // The comm Rx buffer size
-        uint16_t m_tx_buffer_size;
-        uint16_t m_rpv_count;       // The number of Runtime Published Values in the RPV array
-        uint_least8_t m_loop_count; // Number of Loop Handler in the array
+        RuntimePublishedValue const *m_rpvs;                         // The array of Runtime Published Values. nullptr if unset
+        RpvReadCallback m_rpv_read_callback;                         // The callback to perform read operation on a Runtime Published Value (RPV)
+        RpvBulkReadCallback m_rpv_bulk_read_callback;                // The callback to read many Runtime Published Values (RPV) in one call
+        RpvWriteCallback m_rpv_write_callback;                       // The callback to perform write operation on a Runtime Published Value (RPV)
+        user_command_callback_t m_user_command_callback;             // Callback to call when a User Command service call is requested by the server
+        async_user_command_callback_t m_async_user_command_callback; // Same as m_user_command_callback, but can complete later
+        LoopHandler **m_loops;                                       // The array of Loop Handler pointers
+        unsigned char *m_staging_buffer;                             // Staging buffer of the snapshot reads and deferred writes. nullptr if unset
+        uint16_t m_staging_buffer_size;                              // Size of the staging buffer
+        unsigned char *m_compression_buffer;                         // Work buffer of the payload compression. nullptr if unset
+        uint16_t m_compression_buffer_size;                          // Size of the compression work buffer
+        WatchedMemoryBlock *m_watched_blocks;                        // State of the blocks read with ReadChanged. nullptr if unset
+        uint16_t m_watched_block_count;                              // Number of entries in m_watched_blocks
+        uint16_t m_rpv_count;          // The number of Runtime Published Values in the RPV array
+        uint_least8_t m_loop_count;    // Number of Loop Handler in the array
+        uint32_t m_config_fingerprint; // Fingerprint given by the user. Used instead of the computed one when m_config_fingerprint_set is true
+        bool m_config_fingerprint_set; // True when the user gave a configuration fingerprint
+        bool m_static_rpvs;            // True when the RPV table was validated at compile time and is sorted by ID
 
 #if SCRUTINY_ENABLE_DATALOGGING
         unsigned char *m_datalogger_buffer;                            // Buffer that stores the datalogging data
         datalogging::buffer_size_t m_datalogger_buffer_size;           // size of the datalogging buffer
+        datalogging::ExternalStorage m_datalogger_storage;             // External storage used instead of the buffer when a write callback is set
         datalogging::trigger_callback_t m_datalogger_trigger_callback; // Callback to call upon datalogging acquisition triggers
+#endif
+#if SCRUTINY_ENABLE_STATISTICS
+        statistics::Channel *m_statistics_channels; // Storage of the statistics engine. nullptr if unset
+        uint_least8_t m_statistics_channel_count;   // Number of channels in m_statistics_channels
 #endif
     };
 } // namespace scrutiny
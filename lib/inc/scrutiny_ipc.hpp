@@ -21,3 +21,5 @@
 #else
 #error "No IPC capabilities"
 #endif
+
+#include "ipc/scrutiny_ipc_byte_fifo.hpp"
@@ -21,6 +21,10 @@
 #include "datalogging/scrutiny_datalogging.hpp"
 #endif
 
+#if SCRUTINY_ENABLE_STATISTICS
+#include "statistics/scrutiny_statistics.hpp"
+#endif
+
 namespace scrutiny
 {
     class MainHandler;
@@ -52,8 +56,15 @@ namespace scrutiny
                 RELEASE_DATALOGGER_OWNERSHIP,
                 TAKE_DATALOGGER_OWNERSHIP,
                 DATALOGGER_ARM_TRIGGER,
-                DATALOGGER_DISARM_TRIGGER
+                DATALOGGER_DISARM_TRIGGER,
+                DATALOGGER_RELEASE_ACQUISITION,
+#endif
+#if SCRUTINY_ENABLE_STATISTICS
+                STATISTICS_START,
+                STATISTICS_STOP,
+                STATISTICS_SNAPSHOT,
 #endif
+                PROCESS_STAGED_OPERATION
             };
             // clang-format on
         };
@@ -68,8 +79,14 @@ namespace scrutiny
                 DATALOGGER_OWNERSHIP_TAKEN,
                 DATALOGGER_OWNERSHIP_RELEASED,
                 DATALOGGER_DATA_ACQUIRED,
-                DATALOGGER_STATUS_UPDATE
+                DATALOGGER_STATUS_UPDATE,
+                DATALOGGER_ACQUISITION_RELEASED,
 #endif
+#if SCRUTINY_ENABLE_STATISTICS
+                STATISTICS_STOPPED,
+                STATISTICS_SNAPSHOT_TAKEN,
+#endif
+                STAGED_OPERATION_DONE
             };
         };
 
@@ -88,16 +105,23 @@ namespace scrutiny
                     datalogging::DataLogger::State::eState state;
                     datalogging::buffer_size_t bytes_to_acquire_from_trigger_to_completion;
                     datalogging::buffer_size_t write_counter_since_trigger;
+                    bool acquisition_available;
                 } datalogger_status_update;
 #endif
             } data;
         };
 
         LoopHandler(char const *name = "") :
+            m_main_handler(static_cast<MainHandler *>(SCRUTINY_NULL)),
             m_name(name)
 #if SCRUTINY_ENABLE_DATALOGGING
             ,
-            m_datalogger(static_cast<scrutiny::datalogging::DataLogger *>(SCRUTINY_NULL)), m_datalogger_data_acquired(false), m_support_datalogging(true)
+            m_datalogger(static_cast<scrutiny::datalogging::DataLogger *>(SCRUTINY_NULL)), m_datalogger_data_acquired(false),
+            m_support_datalogging(true)
+#endif
+#if SCRUTINY_ENABLE_STATISTICS
+            ,
+            m_statistics(static_cast<scrutiny::statistics::StatisticsEngine *>(SCRUTINY_NULL)), m_statistics_running(false)
 #endif
         {
         }
@@ -153,6 +177,14 @@ namespace scrutiny
             return (m_datalogger->get_owner() == this);
         }
 #endif
+#if SCRUTINY_ENABLE_STATISTICS
+
+        /// @brief Returns true if this loop runs the statistics engine
+        inline bool runs_statistics(void) const
+        {
+            return m_statistics_running;
+        }
+#endif
 
       protected:
         /// @brief Initialize the Loop Handler
@@ -168,6 +200,8 @@ namespace scrutiny
         scrutiny::IPCMessage<Main2LoopMessage> m_main2loop_msg;
         /// @brief  Atomic message transferred from the Loop Handler to the Main Handler
         scrutiny::IPCMessage<Loop2MainMessage> m_loop2main_msg;
+        /// @brief The Main Handler this loop is attached to
+        MainHandler *m_main_handler;
         char const *m_name;
 
 #if SCRUTINY_ENABLE_DATALOGGING
@@ -177,6 +211,12 @@ namespace scrutiny
         bool m_datalogger_data_acquired;
         /// @brief Indicates if this loop can do datalogging
         bool m_support_datalogging;
+#endif
+#if SCRUTINY_ENABLE_STATISTICS
+        /// @brief A pointer to the statistics engine part of the Main Handler
+        statistics::StatisticsEngine *m_statistics;
+        /// @brief Indicates if this loop runs the statistics engine
+        bool m_statistics_running;
 #endif
     };
 
@@ -13,19 +13,27 @@
 
 #include "protocol/scrutiny_protocol.hpp"
 #include "scrutiny_config.hpp"
+#include "scrutiny_ipc.hpp"
 #include "scrutiny_loop_handler.hpp"
 #include "scrutiny_setup.hpp"
 #include "scrutiny_timebase.hpp"
+#include "scrutiny_tools.hpp"
 
 #if SCRUTINY_ENABLE_DATALOGGING
 #include "datalogging/scrutiny_datalogging.hpp"
 #endif
 
+#if SCRUTINY_ENABLE_STATISTICS
+#include "statistics/scrutiny_statistics.hpp"
+#endif
+
 namespace scrutiny
 {
     // cppcheck-suppress[noConstructor]
     class MainHandler
     {
+        friend class LoopHandler;
+
       public:
         MainHandler(void);
 
@@ -40,6 +48,21 @@ namespace scrutiny
         /// @return true if the RPV has been found, false otherwise
         bool get_rpv(uint16_t const id, RuntimePublishedValue *const rpv) const;
 
+        /// @brief Reads a Runtime Published Value through the read callback, or the bulk read callback if no single read callback is set.
+        /// @param rpv The RPV to read
+        /// @param outval The output value
+        /// @param caller The loop that reads the value. nullptr when called from the main handler
+        /// @return true on success
+        bool read_rpv(RuntimePublishedValue const rpv, AnyType *const outval, LoopHandler *const caller) const;
+
+        /// @brief Reads many Runtime Published Values at once. Uses the bulk read callback if set, otherwise calls the read callback once per RPV
+        /// @param rpvs The RPVs to read
+        /// @param outvals The output values. One per RPV
+        /// @param count Number of RPVs to read
+        /// @param caller The loop that reads the values. nullptr when called from the main handler
+        /// @return true on success
+        bool read_rpvs(RuntimePublishedValue const *const rpvs, AnyType *const outvals, uint16_t const count, LoopHandler *const caller) const;
+
         /// @brief Tells if a Runtime Published Values with the given ID has been defined.
         /// @param id The RPV ID
         /// @return True if RPV exists in configuration.
@@ -57,22 +80,56 @@ namespace scrutiny
         /// @brief Pass data received from the server to the scrutiny-embedded lib input stream.
         /// @param data Pointer to the data buffer
         /// @param len Length of the data
-        inline void receive_data(unsigned char const *const data, uint16_t const len) { m_comm_handler.receive_data(data, len); }
+        /// @param channel The communication channel that received the data
+        inline void receive_data(unsigned char const *const data, uint16_t const len, uint_least8_t const channel = 0)
+        {
+            if (channel < SCRUTINY_COMM_CHANNEL_COUNT)
+            {
+                m_channels[channel].comm_handler.receive_data(data, len);
+            }
+        }
 
         /// @brief Reads data from the scrutiny-embedded lib output stream so it can be sent to the server
         /// @param buffer Buffer to write the data into
         /// @param len Maximum length of the data to read
+        /// @param channel The communication channel to read from
         /// @return Number of bytes actually read
-        inline uint16_t pop_data(unsigned char *const buffer, uint16_t const len)
+        inline uint16_t pop_data(unsigned char *const buffer, uint16_t const len, uint_least8_t const channel = 0)
         {
-            uint16_t const size = m_comm_handler.pop_data(buffer, len);
-            check_finished_sending();
+            if (channel >= SCRUTINY_COMM_CHANNEL_COUNT)
+            {
+                return 0;
+            }
+            uint16_t const size = m_channels[channel].comm_handler.pop_data(buffer, len);
+            check_finished_sending(channel);
             return size;
         }
 
         /// @brief Tells how much data is available in the scrutiny-embedded lib output stream
+        /// @param channel The communication channel to check
         /// @return Number of bytes available
-        inline uint16_t data_to_send(void) const { return m_comm_handler.data_to_send(); }
+        inline uint16_t data_to_send(uint_least8_t const channel = 0) const
+        {
+            return (channel < SCRUTINY_COMM_CHANNEL_COUNT) ? m_channels[channel].comm_handler.data_to_send() : 0;
+        }
+
+        /// @brief Returns the FIFO that an interrupt fills with the data received from the server. Emptied by process().
+        /// Only usable if a storage is given with Config::set_fifos(). Only one producer is allowed
+        /// @param channel The communication channel
+        /// @return The FIFO. nullptr if the channel does not exist
+        inline IPCByteFifo *rx_fifo(uint_least8_t const channel = 0)
+        {
+            return (channel < SCRUTINY_COMM_CHANNEL_COUNT) ? &m_channels[channel].rx_fifo : SCRUTINY_NULL;
+        }
+
+        /// @brief Returns the FIFO that an interrupt empties to send the data to the server. Filled by process().
+        /// Only usable if a storage is given with Config::set_fifos(). Only one consumer is allowed
+        /// @param channel The communication channel
+        /// @return The FIFO. nullptr if the channel does not exist
+        inline IPCByteFifo *tx_fifo(uint_least8_t const channel = 0)
+        {
+            return (channel < SCRUTINY_COMM_CHANNEL_COUNT) ? &m_channels[channel].tx_fifo : SCRUTINY_NULL;
+        }
 
 #if SCRUTINY_ENABLE_DATALOGGING
         /// @brief Returns the state of the datalogger. Thread safe
@@ -84,7 +141,7 @@ namespace scrutiny
         /// @brief  Returns true if the datalogger has data available. Thread safe
         inline bool datalogging_data_available(void) const
         {
-            return m_datalogging.threadsafe_data.datalogger_state == datalogging::DataLogger::State::AcquisitionCompleted; // Thread safe.
+            return m_datalogging.threadsafe_data.acquisition_available; // Thread safe.
         }
 
         /// @brief Returns true if the datalogger is in an error state. Thread safe
@@ -142,6 +199,13 @@ namespace scrutiny
         {
             return &m_datalogging.datalogger;
         }
+#endif
+#if SCRUTINY_ENABLE_STATISTICS
+        /// @brief Returns a pointer to the statistics engine
+        inline statistics::StatisticsEngine *statistics(void)
+        {
+            return &m_statistics.engine;
+        }
 #endif
         /// @brief Return the Runtime Published Value (RPV) read callback
         inline RpvReadCallback get_rpv_read_callback(void) const
@@ -149,10 +213,18 @@ namespace scrutiny
             return m_config.get_rpv_read_callback();
         }
 
-        /// @brief Returns a pointer to the communication handler
-        inline protocol::CommHandler *comm(void)
+        /// @brief Returns a CRC32 of everything the server discovers on connect: the Runtime Published Values table,
+        /// the loop definitions and the protected memory regions. Computed once by init().
+        /// A server that cached these definitions can skip the discovery when the fingerprint is unchanged.
+        inline uint32_t config_fingerprint(void) const
+        {
+            return m_config_fingerprint;
+        }
+
+        /// @brief Returns a pointer to the communication handler of a channel. nullptr if the channel does not exist
+        inline protocol::CommHandler *comm(uint_least8_t const channel = 0)
         {
-            return &m_comm_handler;
+            return (channel < SCRUTINY_COMM_CHANNEL_COUNT) ? &m_channels[channel].comm_handler : SCRUTINY_NULL;
         }
 
         /// @brief Returns a pointer to the given configuration
@@ -169,7 +241,17 @@ namespace scrutiny
 
       private:
         void process_loops(void);
-        void check_finished_sending(void);
+        void process_active_channel(void);
+        void check_finished_sending(uint_least8_t const channel_index);
+        void drain_rx_fifo(uint_least8_t const channel_index);
+        void fill_tx_fifo(uint_least8_t const channel_index);
+        void write_memory_block(MemoryBlock8Bits const *const block, bool const masked) const;
+        protocol::ResponseCode::eResponseCode process_read_changed(protocol::Request const *const request, protocol::Response *const response);
+        void invalidate_watched_blocks(void);
+        protocol::ResponseCode::eResponseCode process_staged_operation(protocol::Request const *const request, protocol::Response *const response);
+        protocol::ResponseCode::eResponseCode stage_operation(protocol::Request const *const request, protocol::Response *const response);
+        protocol::ResponseCode::eResponseCode encode_staged_operation_response(protocol::Response *const response);
+        void execute_staged_operation(LoopHandler *const caller);
         void process_request(protocol::Request const *const request, protocol::Response *const response);
         protocol::ResponseCode::eResponseCode process_get_info(protocol::Request const *const request, protocol::Response *const response);
         protocol::ResponseCode::eResponseCode process_comm_control(protocol::Request const *const request, protocol::Response *const response);
@@ -181,6 +263,10 @@ namespace scrutiny
         void process_datalogging_loop_msg(LoopHandler *const sender, LoopHandler::Loop2MainMessage *const msg);
         void process_datalogging_logic(void);
 #endif
+#if SCRUTINY_ENABLE_STATISTICS
+        protocol::ResponseCode::eResponseCode process_statistics(protocol::Request const *const request, protocol::Response *const response);
+        void process_statistics_loop_msg(LoopHandler *const sender, LoopHandler::Loop2MainMessage *const msg);
+#endif
 #if SCRUTINY_SUPPORT_PROTECTED_REGIONS
         bool touches_forbidden_region(void const *const addr_start, size_t const length_char) const;
         bool touches_readonly_region(void const *const addr_start, size_t const length_char) const;
@@ -203,21 +289,78 @@ namespace scrutiny
         }
 #endif
         Status::eStatus check_config(void);
+        uint32_t compute_config_fingerprint(void) const;
+
+        /// @brief Returns true if the response payload is compressed when the session accepts compression
+        bool is_compressible_response(protocol::Response const *const response) const;
+        /// @brief Continues the compression of the response of the active channel and sends it once compressed
+        void compress_active_response(void);
+
+        /// @brief Returns true if the values can be sent in the device byte order. Big endian is already the protocol byte order,
+        /// so this is only offered by little endian devices with 8 bits char, where the values can be copied without being swapped.
+        inline bool native_endian_supported(void) const
+        {
+            return CHAR_BIT == 8 && tools::is_little_endian();
+        }
+
+        /// @brief Returns the communication handler of the channel whose request is being processed
+        inline protocol::CommHandler *active_comm(void)
+        {
+            return &m_channels[m_active_channel].comm_handler;
+        }
 
 #if SCRUTINY_ACTUAL_PROTOCOL_VERSION == SCRUTINY_PROTOCOL_VERSION(1, 0)
         protocol::CodecV1_0 m_codec; // Communication protocol Codec
 #else
 #error Unsupported codec
 #endif
-        Config m_config;                       // The configuration
-        protocol::CommHandler m_comm_handler;  // The communication handler that parses the request and manages the buffers
-        Timebase m_timebase;                   // Timebase to keep track of time
-        timestamp_t m_process_again_timestamp; // Timestamp at which the first ProcessAgain code has been returned to ensure timeout
-        bool m_processing_request;             // True when a request is being processed
-        bool m_disconnect_pending;             // Indicates that a disconnect request has been received and must be processed right away
-        bool m_enabled;                        // Indicates that scrutiny is enabled. Will be disabled if the configuration is wrong.
-        bool m_process_again_timestamp_taken;  // Indicates that a timestamp has been taken on ProcessAgain response code, meaning that the timestamp
-                                               // should not be updated on subsequent ProcessAgain code
+        struct CommChannel
+        {
+            protocol::CommHandler comm_handler; // The communication handler that parses the request and manages the buffers
+            bool processing_request;            // True when a request is being processed
+            bool disconnect_pending;            // Indicates that a disconnect request has been received and must be processed right away
+            IPCByteFifo rx_fifo;                // Received bytes waiting to be given to the comm handler. Unused without storage
+            IPCByteFifo tx_fifo;                // Bytes taken from the comm handler, waiting to be sent. Unused without storage
+        };
+
+        Config m_config;                                     // The configuration
+        CommChannel m_channels[SCRUTINY_COMM_CHANNEL_COUNT]; // The communication channels. They share everything but their buffers and session
+        uint_least8_t m_active_channel;                      // Channel whose request is processed. Kept while the request returns ProcessAgain
+        Timebase m_timebase;                                 // Timebase to keep track of time
+        timestamp_t m_process_again_timestamp;               // Timestamp at which the first ProcessAgain code has been returned to ensure timeout
+        bool m_enabled;                                      // Indicates that scrutiny is enabled. Will be disabled if the configuration is wrong.
+        uint32_t m_config_fingerprint;                       // CRC32 of the RPVs, loops and protected regions definitions. Computed at init
+        bool m_process_again_timestamp_taken;                // Indicates that a timestamp has been taken on ProcessAgain response code, meaning
+                                                             // that the timestamp should not be updated on subsequent ProcessAgain code
+        uint_least8_t m_watched_blocks_channel;              // Channel that owns the state of the blocks read with ReadChanged
+        uint_least8_t m_read_changed_sequence;               // Sequence number of the last ReadChanged response
+        protocol::PayloadCompressor m_compressor;            // Compresses the response of the active channel over several process() calls
+        bool m_compressing_response;                         // The active channel is kept until its response is compressed and sent
+
+        class StagedOperationState
+        {
+          public:
+            // clang-format off
+            SCRUTINY_ENUM(eStagedOperationState, uint_least8_t)
+            {
+                Idle,      // No operation in progress
+                Requested, // The operation is validated and staged. Waiting on the loop to execute it
+                Done       // The loop executed the operation. The response can be sent
+            };
+            // clang-format on
+        };
+
+        struct
+        {
+            protocol::Request request;   // Deferred writes: copy of the write request, stored in the staging buffer
+            protocol::Response response; // Snapshot reads: response laid out in the staging buffer. Only the values are written by the loop
+            LoopHandler *loop;           // The loop that executes the operation
+            protocol::MemoryControl::Subfunction::eSubfunction subfunction; // The operation to execute
+            StagedOperationState::eStagedOperationState state;              // Written by the Main Handler only
+            bool success;                // Written by the loop. False if a value could not be read or written
+            bool stale;                  // The request that started the operation timed out. Its result must be dropped
+            bool native_endian;          // Snapshot reads: the values are written in the device byte order
+        } m_staged_operation;            // Snapshot reads and deferred writes executed by a loop
 
 #if SCRUTINY_ENABLE_DATALOGGING
 
@@ -239,6 +382,7 @@ namespace scrutiny
             datalogging::buffer_size_t bytes_to_acquire_from_trigger_to_completion;
             datalogging::buffer_size_t write_counter_since_trigger;
             datalogging::DataLogger::State::eState datalogger_state;
+            bool acquisition_available; // An acquisition can be read. Not always in AcquisitionCompleted state with double buffering
         };
 
         struct
@@ -256,8 +400,20 @@ namespace scrutiny
             bool request_disarm_trigger;                    // Flag indicating that a request has been made to disarm the trigger
             bool pending_ownership_release;                 // Flag indicating that a request for ownership release is presently being processed
             bool reading_in_progress;                       // Flag indicating that the datalogging data is presently being read by the user.
+            bool request_release_acquisition;               // Flag indicating that the server released the acquisition (double buffering)
+            bool pending_acquisition_release;               // Flag indicating that the owner has not yet acknowledged the acquisition release
         } m_datalogging;                                    // All data related to the datalogging feature
 #endif
+
+#if SCRUTINY_ENABLE_STATISTICS
+        struct
+        {
+            statistics::StatisticsEngine engine;                  // The statistics engine. Its channels are given by the configuration
+            LoopHandler *owner;                                   // LoopHandler that runs the statistics. nullptr when stopped
+            bool stop_requested;                                  // A stop has been sent to the owner and is not yet acknowledged
+            StagedOperationState::eStagedOperationState snapshot; // State of the snapshot requested to the owner by a Read request
+        } m_statistics;                                           // All data related to the statistics feature
+#endif
     };
 } // namespace scrutiny
 
@@ -22,6 +22,22 @@
 
 #include "scrutiny_compiler.hpp"
 
+#ifndef SCRUTINY_COMM_CHANNEL_COUNT
+#define SCRUTINY_COMM_CHANNEL_COUNT 1u // Build configurations predating multi-channel support
+#endif
+
+#ifndef SCRUTINY_READ_RPV_CHUNK_SIZE
+#define SCRUTINY_READ_RPV_CHUNK_SIZE 8u // Build configurations predating this option
+#endif
+
+#ifndef SCRUTINY_COMPRESSION_ITEMS_PER_PROCESS
+#define SCRUTINY_COMPRESSION_ITEMS_PER_PROCESS 64u // Build configurations predating this option
+#endif
+
+#ifndef SCRUTINY_ENABLE_STATISTICS
+#define SCRUTINY_ENABLE_STATISTICS 0 // Build configurations predating this option
+#endif
+
 // ================================
 
 // ========== Macros ==========
@@ -41,6 +57,22 @@
 #error Unsupported protocol version
 #endif
 
+#if SCRUTINY_COMM_CHANNEL_COUNT < 1 || SCRUTINY_COMM_CHANNEL_COUNT > 255
+#error Invalid number of communication channels
+#endif
+
+#if SCRUTINY_READ_RPV_CHUNK_SIZE < 1 || SCRUTINY_READ_RPV_CHUNK_SIZE > 255
+#error Invalid RPV read chunk size
+#endif
+
+#if SCRUTINY_COMPRESSION_ITEMS_PER_PROCESS < 1 || SCRUTINY_COMPRESSION_ITEMS_PER_PROCESS > 0xFFFF
+#error Invalid number of compression items per process
+#endif
+
+#if SCRUTINY_ENABLE_STATISTICS && !SCRUTINY_ENABLE_DATALOGGING
+#error The statistics read their values with the datalogging operands. SCRUTINY_ENABLE_DATALOGGING is required
+#endif
+
 #if SCRUTINY_BUILD_WINDOWS && SCRUTINY_BUILD_AVR_GCC
 #error Bad detection of build environment
 #endif
@@ -0,0 +1,103 @@
+//    scrutiny_static_config.hpp
+//        Compile-time validation of the configuration tables so that they can be declared constexpr,
+//        placed in read-only memory and used by the MainHandler without any validation at init.
+//
+//   - License : MIT - See LICENSE file
+//   - Project : Scrutiny Debugger (github.com/scrutinydebugger/scrutiny-embedded)
+//
+//    Copyright (c) 2021 Scrutiny Debugger
+
+#ifndef ___SCRUTINY_STATIC_CONFIG_H___
+#define ___SCRUTINY_STATIC_CONFIG_H___
+
+#include "protocol/scrutiny_protocol.hpp"
+#include "scrutiny_setup.hpp"
+#include "scrutiny_types.hpp"
+#include <stddef.h>
+
+#if SCRUTINY_HAS_CPP11
+
+namespace scrutiny
+{
+    namespace static_config
+    {
+        // The functions below are C++11 constexpr (single return statement). Tables are walked by splitting them in halves
+        // so that the recursion depth stays at log2(N) and does not hit the compiler constexpr depth limit on big tables.
+
+        /// @brief Constant expression equivalent of tools::is_supported_type()
+        constexpr bool is_supported_type(VariableType::eVariableType const vt)
+        {
+            return (vt == VariableType::boolean) ? true
+                   : ((static_cast<unsigned int>(vt) & 0xF) > (SCRUTINY_SUPPORT_64BITS ? 3u : 2u)) ? false // Size bigger than 8 or 4 bytes
+                   : (CHAR_BIT > 8 && (static_cast<unsigned int>(vt) & 0xF) == 0)                  ? false // 8 bits types on 16 bits char
+                   : ((static_cast<unsigned int>(vt) & 0xF0) == VariableTypeType::_boolean)
+                       ? ((1u << (static_cast<unsigned int>(vt) & 0xF)) == sizeof(bool) * (CHAR_BIT / 8)) // Only the native bool
+                   : ((static_cast<unsigned int>(vt) & 0xF0) == VariableTypeType::_float)
+                       ? ((static_cast<unsigned int>(vt) & 0xF) == 2 || (static_cast<unsigned int>(vt) & 0xF) == 3)
+                       : ((static_cast<unsigned int>(vt) & 0xF0) == VariableTypeType::_uint ||
+                          (static_cast<unsigned int>(vt) & 0xF0) == VariableTypeType::_sint);
+        }
+
+        /// @brief Returns true if all the Runtime Published Values in [start, end) have a type supported by this build
+        constexpr bool rpv_types_supported(RuntimePublishedValue const *const rpvs, size_t const start, size_t const end)
+        {
+            return (end - start == 0)   ? true
+                   : (end - start == 1) ? is_supported_type(rpvs[start].type)
+                                        : rpv_types_supported(rpvs, start, start + (end - start) / 2) &&
+                                              rpv_types_supported(rpvs, start + (end - start) / 2, end);
+        }
+
+        /// @brief Returns true if the IDs of the Runtime Published Values in [start, end) are strictly increasing.
+        /// Being sorted guarantees the IDs are unique and lets the MainHandler find an RPV with a binary search.
+        constexpr bool rpv_ids_sorted(RuntimePublishedValue const *const rpvs, size_t const start, size_t const end)
+        {
+            return (end - start < 2) ? true
+                                     : rpv_ids_sorted(rpvs, start, start + (end - start) / 2) &&
+                                           rpv_ids_sorted(rpvs, start + (end - start) / 2, end) &&
+                                           rpvs[start + (end - start) / 2 - 1].id < rpvs[start + (end - start) / 2].id;
+        }
+
+        /// @brief Returns true if the Runtime Published Value table can be given to Config::set_static_published_values()
+        template <size_t N> constexpr bool is_valid_rpv_table(RuntimePublishedValue const (&rpvs)[N])
+        {
+            return N <= 0xFFFF && rpv_types_supported(rpvs, 0, N) && rpv_ids_sorted(rpvs, 0, N);
+        }
+
+        /// @brief Returns true if the given address range bounds are ordered. Bounds are given as integers since pointers
+        /// to unrelated objects cannot be compared in a constant expression.
+        constexpr bool is_valid_address_range(uintptr_t const start, uintptr_t const end)
+        {
+            return start <= end;
+        }
+
+        /// @brief Returns true if the communication buffer sizes are accepted by the protocol
+        constexpr bool is_valid_rx_buffer_size(size_t const size)
+        {
+            return size >= protocol::MINIMUM_RX_BUFFER_SIZE && size <= protocol::MAXIMUM_RX_BUFFER_SIZE;
+        }
+
+        /// @brief Returns true if the communication buffer sizes are accepted by the protocol
+        constexpr bool is_valid_tx_buffer_size(size_t const size)
+        {
+            return size >= protocol::MINIMUM_TX_BUFFER_SIZE && size <= protocol::MAXIMUM_TX_BUFFER_SIZE;
+        }
+    } // namespace static_config
+} // namespace scrutiny
+
+/// @brief Validates a constexpr Runtime Published Value table at compile time. IDs must be sorted in strictly increasing order.
+#define SCRUTINY_STATIC_CHECK_RPV_TABLE(table)                                                                                                       \
+    static_assert(scrutiny::static_config::rpv_types_supported(table, 0, sizeof(table) / sizeof(table[0])), "Unsupported RPV type");               \
+    static_assert(scrutiny::static_config::rpv_ids_sorted(table, 0, sizeof(table) / sizeof(table[0])), "RPV IDs must be unique and sorted");      \
+    static_assert(sizeof(table) / sizeof(table[0]) <= 0xFFFF, "Too many RPVs")
+
+/// @brief Validates the size of the communication buffers at compile time
+#define SCRUTINY_STATIC_CHECK_BUFFERS(rx_buffer, tx_buffer)                                                                                          \
+    static_assert(scrutiny::static_config::is_valid_rx_buffer_size(sizeof(rx_buffer)), "Invalid Rx buffer size");                                  \
+    static_assert(scrutiny::static_config::is_valid_tx_buffer_size(sizeof(tx_buffer)), "Invalid Tx buffer size")
+
+/// @brief Validates the bounds of an address range at compile time
+#define SCRUTINY_STATIC_CHECK_ADDRESS_RANGE(start, end)                                                                                              \
+    static_assert(scrutiny::static_config::is_valid_address_range(start, end), "Address range end is before its start")
+
+#endif // SCRUTINY_HAS_CPP11
+#endif // ___SCRUTINY_STATIC_CONFIG_H___
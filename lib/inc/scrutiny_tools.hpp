@@ -73,6 +73,21 @@ namespace scrutiny
         /// @return The CRC32 value of the data
         uint32_t crc32(unsigned char const *data, uint32_t const size, uint32_t const start_value = 0);
 
+        /// @brief Writes the bits of a source buffer that are set in a mask buffer. Source and mask have 8 bits per char, like
+        /// memcpy_compress_from_8bits_native(). With 8 bits char, the destination is read-modify-written a machine word at a time where
+        /// it is aligned, and a byte at a time at the unaligned edges
+        /// @param dst Destination buffer
+        /// @param src Source buffer. Bits to write
+        /// @param mask Mask buffer. Only the bits set to 1 are written
+        /// @param nb_8bits Number of char in the source buffer
+        void masked_write_from_8bits_native(void *const dst, void const *const src, void const *const mask, size_t const nb_8bits);
+
+        /// @brief Converts a single precision float to an IEEE-754 half precision float. Rounds to nearest even.
+        /// Values too big become infinity, values too small become 0.
+        /// @param val The value to convert
+        /// @return The half precision float bits
+        uint16_t float32_to_float16(float const val);
+
         /// @brief Makes an address range (start/end address)
         /// @param start Start address
         /// @param end End address
@@ -344,6 +359,156 @@ namespace scrutiny
 #endif
         }
 
+        /// @brief Conversion between 16 bits elements and 8 bits per element buffers, as needed with 16 bits char.
+        /// T is the 16 bits element type: unsigned char on the target, any 16 bits integer when validating on a 8 bits char host.
+        namespace wide_char
+        {
+            /// @brief Reference implementation of dilate_16bits_to_8bits(). One element at a time. Kept for validation
+            /// @param dst Destination buffer. Receives nb_8bits elements holding 8 bits each
+            /// @param src Source buffer of nb_8bits / 2 elements
+            /// @param nb_8bits Number of elements to write in the destination buffer
+            /// @param big_endian Write the most significant 8 bits of each source element first when true
+            template <class T>
+            inline void dilate_16bits_to_8bits_reference(T *const dst, T const *const src, size_t const nb_8bits, bool const big_endian)
+            {
+                for (size_t i = 0; i < (nb_8bits >> 1); i++)
+                {
+                    T const msb = static_cast<T>((src[i] >> 8) & 0xFF);
+                    T const lsb = static_cast<T>(src[i] & 0xFF);
+                    dst[2 * i] = big_endian ? msb : lsb;
+                    dst[2 * i + 1] = big_endian ? lsb : msb;
+                }
+            }
+
+            /// @brief Reference implementation of compress_8bits_to_16bits(). One element at a time. Kept for validation
+            /// @param dst Destination buffer of nb_8bits / 2 elements
+            /// @param src Source buffer of nb_8bits elements holding 8 bits each
+            /// @param nb_8bits Number of elements in the source buffer
+            /// @param big_endian The first 8 bits of each pair are the most significant when true
+            template <class T>
+            inline void compress_8bits_to_16bits_reference(T *const dst, T const *const src, size_t const nb_8bits, bool const big_endian)
+            {
+                for (size_t i = 0; i < (nb_8bits >> 1); i++)
+                {
+                    T const first = static_cast<T>(src[2 * i] & 0xFF);
+                    T const second = static_cast<T>(src[2 * i + 1] & 0xFF);
+                    dst[i] = big_endian ? static_cast<T>((first << 8) | second) : static_cast<T>((second << 8) | first);
+                }
+            }
+
+            /// @brief Reads 2 consecutive elements in a single 32 bits access. The first element is in the lower half on a little
+            /// endian device and in the upper half on a big endian device. The callers handle both layouts so that no swap is needed
+            template <class T> inline uint32_t load_pair(T const *const p)
+            {
+                SCRUTINY_STATIC_ASSERT(2 * sizeof(T) == sizeof(uint32_t), "Expect T to be half a 32 bits word");
+                uint32_t word;
+                memcpy(&word, p, sizeof(uint32_t));
+                return word;
+            }
+
+            /// @brief Writes 2 consecutive elements in a single 32 bits access. Same layout as load_pair()
+            template <class T> inline void store_pair(T *const p, uint32_t const word)
+            {
+                SCRUTINY_STATIC_ASSERT(2 * sizeof(T) == sizeof(uint32_t), "Expect T to be half a 32 bits word");
+                memcpy(p, &word, sizeof(uint32_t));
+            }
+
+            /// @brief Splits each 16 bits element of the source buffer in 2 elements holding 8 bits.
+            /// Works on pairs of source elements with 32 bits loads and stores: 1 load and 2 stores for 4 output elements.
+            /// @param dst Destination buffer. Receives nb_8bits elements holding 8 bits each
+            /// @param src Source buffer of nb_8bits / 2 elements
+            /// @param nb_8bits Number of elements to write in the destination buffer
+            /// @param big_endian Write the most significant 8 bits of each source element first when true
+            template <class T> inline void dilate_16bits_to_8bits(T *const dst, T const *const src, size_t const nb_8bits, bool const big_endian)
+            {
+                size_t const nb_elements = nb_8bits >> 1;
+                bool const little_endian_device = is_little_endian();
+                size_t i = 0;
+                for (; i + 2 <= nb_elements; i += 2)
+                {
+                    uint32_t const word = load_pair(&src[i]);
+                    uint32_t first;
+                    uint32_t second;
+                    if (little_endian_device) // src[i] in bits 15..0, src[i+1] in bits 31..16
+                    {
+                        if (big_endian)
+                        {
+                            first = ((word >> 8) & 0xFFu) | ((word << 16) & 0x00FF0000u);
+                            second = ((word >> 24) & 0xFFu) | (word & 0x00FF0000u);
+                        }
+                        else
+                        {
+                            first = (word & 0xFFu) | ((word << 8) & 0x00FF0000u);
+                            second = ((word >> 16) & 0xFFu) | ((word >> 8) & 0x00FF0000u);
+                        }
+                    }
+                    else // src[i] in bits 31..16, src[i+1] in bits 15..0
+                    {
+                        if (big_endian)
+                        {
+                            first = ((word >> 8) & 0x00FF0000u) | ((word >> 16) & 0xFFu);
+                            second = ((word << 8) & 0x00FF0000u) | (word & 0xFFu);
+                        }
+                        else
+                        {
+                            first = (word & 0x00FF0000u) | ((word >> 24) & 0xFFu);
+                            second = ((word << 16) & 0x00FF0000u) | ((word >> 8) & 0xFFu);
+                        }
+                    }
+                    store_pair(&dst[2 * i], first);
+                    store_pair(&dst[2 * i + 2], second);
+                }
+                dilate_16bits_to_8bits_reference(&dst[2 * i], &src[i], 2 * (nb_elements - i), big_endian); // Odd element left
+            }
+
+            /// @brief Joins each pair of 8 bits elements of the source buffer into a single 16 bits element.
+            /// Works on 4 source elements at a time with 32 bits loads and stores: 2 loads and 1 store for 2 output elements.
+            /// @param dst Destination buffer of nb_8bits / 2 elements
+            /// @param src Source buffer of nb_8bits elements holding 8 bits each
+            /// @param nb_8bits Number of elements in the source buffer
+            /// @param big_endian The first 8 bits of each pair are the most significant when true
+            template <class T> inline void compress_8bits_to_16bits(T *const dst, T const *const src, size_t const nb_8bits, bool const big_endian)
+            {
+                size_t const nb_elements = nb_8bits >> 1;
+                bool const little_endian_device = is_little_endian();
+                size_t i = 0;
+                for (; i + 2 <= nb_elements; i += 2)
+                {
+                    uint32_t const pair1 = load_pair(&src[2 * i]);
+                    uint32_t const pair2 = load_pair(&src[2 * i + 2]);
+                    uint32_t word;
+                    if (little_endian_device) // First element of a pair in bits 7..0, second in bits 23..16. Upper bits are ignored
+                    {
+                        if (big_endian)
+                        {
+                            word = ((pair1 << 8) & 0xFF00u) | ((pair1 >> 16) & 0xFFu);
+                            word |= ((pair2 << 24) & 0xFF000000u) | (pair2 & 0x00FF0000u);
+                        }
+                        else
+                        {
+                            word = (pair1 & 0xFFu) | ((pair1 >> 8) & 0xFF00u);
+                            word |= ((pair2 << 16) & 0x00FF0000u) | ((pair2 << 8) & 0xFF000000u);
+                        }
+                    }
+                    else // First element of a pair in bits 23..16, second in bits 7..0. Upper bits are ignored
+                    {
+                        if (big_endian)
+                        {
+                            word = ((pair1 << 8) & 0xFF000000u) | ((pair1 << 16) & 0x00FF0000u);
+                            word |= ((pair2 >> 8) & 0xFF00u) | (pair2 & 0xFFu);
+                        }
+                        else
+                        {
+                            word = ((pair1 << 24) & 0xFF000000u) | (pair1 & 0x00FF0000u);
+                            word |= ((pair2 << 8) & 0xFF00u) | ((pair2 >> 16) & 0xFFu);
+                        }
+                    }
+                    store_pair(&dst[i], word);
+                }
+                compress_8bits_to_16bits_reference(&dst[i], &src[2 * i], 2 * (nb_elements - i), big_endian); // Odd element left
+            }
+        } // namespace wide_char
+
         /// @brief Take an array of char and copy to a destination buffer, making sure that there is only 8bits per char.
         /// translates to a memcpy on most platforms. Different behavior for 16bits char. Use big endianness
         /// @param dst Destination buffer
@@ -354,11 +519,7 @@ namespace scrutiny
 #if CHAR_BIT == 8
             memcpy(dst, src, nb_8bits);
 #elif CHAR_BIT == 16
-            for (size_t i = 0; i < (nb_8bits >> 1); i++)
-            {
-                static_cast<unsigned char *>(dst)[2 * i] = (static_cast<unsigned char const *>(src)[i] >> 8) & 0xFF;
-                static_cast<unsigned char *>(dst)[2 * i + 1] = (static_cast<unsigned char const *>(src)[i] & 0xFF);
-            }
+            wide_char::dilate_16bits_to_8bits(static_cast<unsigned char *>(dst), static_cast<unsigned char const *>(src), nb_8bits, true);
 #endif
         }
 
@@ -372,11 +533,7 @@ namespace scrutiny
 #if CHAR_BIT == 8
             memcpy(dst, src, nb_8bits);
 #elif CHAR_BIT == 16
-            for (size_t i = 0; i < (nb_8bits >> 1); i++)
-            {
-                static_cast<unsigned char *>(dst)[2 * i] = (static_cast<unsigned char const *>(src)[i] & 0xFF);
-                static_cast<unsigned char *>(dst)[2 * i + 1] = (static_cast<unsigned char const *>(src)[i] >> 8) & 0xFF;
-            }
+            wide_char::dilate_16bits_to_8bits(static_cast<unsigned char *>(dst), static_cast<unsigned char const *>(src), nb_8bits, false);
 #endif
         }
 
@@ -390,14 +547,11 @@ namespace scrutiny
 #if CHAR_BIT == 8
             memcpy(dst, src, nb_8bits);
 #elif CHAR_BIT == 16
-            if (is_little_endian())
-            {
-                memcpy_dilate_8bits_little_endian(dst, src, nb_8bits);
-            }
-            else
-            {
-                memcpy_dilate_8bits_big_endian(dst, src, nb_8bits);
-            }
+            wide_char::dilate_16bits_to_8bits(
+                static_cast<unsigned char *>(dst),
+                static_cast<unsigned char const *>(src),
+                nb_8bits,
+                !is_little_endian());
 #endif
         }
 
@@ -411,11 +565,7 @@ namespace scrutiny
 #if CHAR_BIT == 8
             memcpy(dst, src, nb_8bits);
 #elif CHAR_BIT == 16
-            for (size_t i = 0; i < (nb_8bits >> 1); i++)
-            {
-                static_cast<unsigned char *>(dst)[i] =
-                    (((static_cast<unsigned char const *>(src)[2 * i] & 0xFF) << 8) | (static_cast<unsigned char const *>(src)[2 * i + 1] & 0xFF));
-            }
+            wide_char::compress_8bits_to_16bits(static_cast<unsigned char *>(dst), static_cast<unsigned char const *>(src), nb_8bits, true);
 #endif
         }
 
@@ -429,11 +579,7 @@ namespace scrutiny
 #if CHAR_BIT == 8
             memcpy(dst, src, nb_8bits);
 #elif CHAR_BIT == 16
-            for (size_t i = 0; i < (nb_8bits >> 1); i++)
-            {
-                static_cast<unsigned char *>(dst)[i] =
-                    (((static_cast<unsigned char const *>(src)[2 * i + 1] & 0xFF) << 8) | (static_cast<unsigned char const *>(src)[2 * i] & 0xFF));
-            }
+            wide_char::compress_8bits_to_16bits(static_cast<unsigned char *>(dst), static_cast<unsigned char const *>(src), nb_8bits, false);
 #endif
         }
 
@@ -447,14 +593,11 @@ namespace scrutiny
 #if CHAR_BIT == 8
             memcpy(dst, src, nb_8bits);
 #elif CHAR_BIT == 16
-            if (is_little_endian())
-            {
-                memcpy_compress_from_8bits_little_endian(dst, src, nb_8bits);
-            }
-            else
-            {
-                memcpy_compress_from_8bits_big_endian(dst, src, nb_8bits);
-            }
+            wide_char::compress_8bits_to_16bits(
+                static_cast<unsigned char *>(dst),
+                static_cast<unsigned char const *>(src),
+                nb_8bits,
+                !is_little_endian());
 #endif
         }
 
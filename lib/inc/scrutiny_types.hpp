@@ -50,9 +50,29 @@ namespace scrutiny
     /// @brief Represents an address range with a start an a end.
     typedef ctypes::scrutiny_c_address_range_t AddressRange;
 
+    /// @brief Last known state of a memory block read with the ReadChanged service. Allocated by the integrator, owned by Scrutiny.
+    typedef ctypes::scrutiny_c_watched_memory_block_t WatchedMemoryBlock;
+
     /// @brief User Command Callback function
     typedef ctypes::scrutiny_c_user_command_callback_t user_command_callback_t;
 
+    /// @brief Status returned by an asynchronous User Command callback
+    class UserCommandStatus
+    {
+      public:
+        // clang-format off
+        SCRUTINY_ENUM(eUserCommandStatus, uint_least8_t)
+        {
+            DONE = ctypes::SCRUTINY_C_USER_COMMAND_DONE,       // The response data is ready
+            PENDING = ctypes::SCRUTINY_C_USER_COMMAND_PENDING, // Still working. The callback will be called again on a later process()
+            FAILED = ctypes::SCRUTINY_C_USER_COMMAND_FAILED    // The command could not be executed. Reported as FailureToProceed
+        };
+        // clang-format on
+    };
+
+    /// @brief Asynchronous User Command Callback function. Can return PENDING to be polled again on the next process() calls
+    typedef ctypes::scrutiny_c_async_user_command_callback_t async_user_command_callback_t;
+
     /// @brief Represent a type type, meaning a type without its size. uint8, uint16, int32 all have type type uint.
     class VariableTypeType
     {
@@ -175,7 +195,12 @@ namespace scrutiny
 
     /// @brief Callback called on Runtime Published Value read
     typedef bool (*RpvReadCallback)(RuntimePublishedValue const rpv, AnyType *outval, LoopHandler *const caller);
-    /// @brief Callback called on Runtime Published Value write
+    /// @brief Callback called to read several Runtime Published Values in a single call. Fills outvals[i] with the value of rpvs[i].
+    /// Returns false if the values could not be read.
+    typedef bool (*RpvBulkReadCallback)(RuntimePublishedValue const *rpvs, AnyType *outvals, uint16_t const count, LoopHandler *const caller);
+    /// @brief Callback called on Runtime Published Value write. Returns false if the value is refused.
+    /// For a deferred write (WriteRPVDeferred), the callback is called for every value of the request within the same loop iteration,
+    /// once the whole request is validated. A refused value is not rolled back nor does it stop the other writes; the request fails.
     typedef bool (*RpvWriteCallback)(RuntimePublishedValue const rpv, AnyType const *inval, LoopHandler *const caller);
 
     /// @brief Represents a memory block with data/mask pointer. Mainly used for memory write operations.
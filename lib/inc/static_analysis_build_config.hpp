@@ -18,6 +18,10 @@
 #define SCRUTINY_ENABLE_DATALOGGING 1
 #endif
 
+#ifndef SCRUTINY_ENABLE_STATISTICS
+#define SCRUTINY_ENABLE_STATISTICS SCRUTINY_ENABLE_DATALOGGING
+#endif
+
 #ifndef SCRUTINY_SUPPORT_PROTECTED_REGIONS
 #define SCRUTINY_SUPPORT_PROTECTED_REGIONS 1
 #endif
@@ -25,10 +29,14 @@
 #define SCRUTINY_REQUEST_MAX_PROCESS_TIME_US 100000u
 #define SCRUTINY_COMM_RX_TIMEOUT_US 50000u
 #define SCRUTINY_COMM_HEARTBEAT_TIMEOUT_US 5000000u
+#define SCRUTINY_COMM_CHANNEL_COUNT 1u
+#define SCRUTINY_READ_RPV_CHUNK_SIZE 8u
+#define SCRUTINY_COMPRESSION_ITEMS_PER_PROCESS 64u
 #define SCRUTINY_ACTUAL_PROTOCOL_VERSION SCRUTINY_PROTOCOL_VERSION(1, 0u)
 
 #if SCRUTINY_ENABLE_DATALOGGING
 #define SCRUTINY_DATALOGGING_MAX_SIGNAL 32u
+#define SCRUTINY_DATALOGGING_TIME_CHECKPOINTS 8u
 #define SCRUTINY_DATALOGGING_ENCODING SCRUTINY_DATALOGGING_ENCODING_RAW
 #define SCRUTINY_DATALOGGING_BUFFER_32BITS 1
 #endif
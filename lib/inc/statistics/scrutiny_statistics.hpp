@@ -0,0 +1,75 @@
+//    scrutiny_statistics.hpp
+//        The definition of the statistics engine that summarizes values in a loop instead of logging them
+//
+//   - License : MIT - See LICENSE file
+//   - Project : Scrutiny Debugger (github.com/scrutinydebugger/scrutiny-embedded)
+//
+//    Copyright (c) 2021 Scrutiny Debugger
+
+#ifndef ___SCRUTINY_STATISTICS_H___
+#define ___SCRUTINY_STATISTICS_H___
+
+#include "scrutiny_setup.hpp"
+#include "statistics/scrutiny_statistics_types.hpp"
+#include <stdint.h>
+
+#if SCRUTINY_ENABLE_STATISTICS == 0
+#error "Not enabled"
+#endif
+
+namespace scrutiny
+{
+    class MainHandler;
+    class LoopHandler;
+
+    namespace statistics
+    {
+        /// @brief Computes the count, min, max, mean, mean square and histogram of some values at each iteration of a loop.
+        /// The channels are configured by the MainHandler while no loop runs the statistics. Then, only the loop running the statistics
+        /// writes to them, and the MainHandler reads the snapshots that the loop takes on request.
+        class StatisticsEngine
+        {
+          public:
+            /// @brief Initializes the statistics engine with no active channel
+            /// @param main_handler A pointer to the main handler to be used to access memory and RPVs
+            /// @param channels The channels storage. nullptr if the feature is not used
+            /// @param capacity Number of channels in the storage
+            void init(MainHandler const *const main_handler, Channel *const channels, uint_least8_t const capacity);
+
+            /// @brief Sets the number of channels in use. The first channel_count channels must have been configured
+            void configure(uint_least8_t const channel_count);
+
+            /// @brief Clears the live statistics of the channels in use
+            void reset(void);
+
+            /// @brief Reads the value of each channel and updates the live statistics. To be called by the loop running the statistics
+            /// @param caller The calling LoopHandler
+            void process(LoopHandler *const caller);
+
+            /// @brief Copies the live statistics of each channel into its snapshot. To be called by the loop running the statistics
+            void take_snapshot(void);
+
+            /// @brief Returns the number of channels in the storage
+            inline uint_least8_t capacity(void) const { return m_capacity; }
+
+            /// @brief Returns the number of channels in use
+            inline uint_least8_t channel_count(void) const { return m_channel_count; }
+
+            /// @brief Returns the channels storage
+            inline Channel *channels(void) { return m_channels; }
+
+            /// @brief Returns a channel from the storage
+            inline Channel const *channel(uint_least8_t const index) const { return &m_channels[index]; }
+
+          protected:
+            void update(Channel *const channel, float_biggest_t const val);
+
+            MainHandler const *m_main_handler; // A pointer to the main handler
+            Channel *m_channels;               // The channels storage, given by the integrator
+            uint_least8_t m_capacity;          // Number of channels in the storage
+            uint_least8_t m_channel_count;     // Number of channels in use
+        };
+    } // namespace statistics
+} // namespace scrutiny
+
+#endif // ___SCRUTINY_STATISTICS_H___
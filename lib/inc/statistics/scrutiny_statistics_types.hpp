@@ -0,0 +1,52 @@
+//    scrutiny_statistics_types.hpp
+//        Types used by the statistics feature
+//
+//   - License : MIT - See LICENSE file
+//   - Project : Scrutiny Debugger (github.com/scrutinydebugger/scrutiny-embedded)
+//
+//    Copyright (c) 2021 Scrutiny Debugger
+
+#ifndef ___SCRUTINY_STATISTICS_TYPES_H___
+#define ___SCRUTINY_STATISTICS_TYPES_H___
+
+#include "datalogging/scrutiny_datalogging_types.hpp"
+#include "scrutiny_setup.hpp"
+#include "scrutiny_types.hpp"
+#include <stdint.h>
+
+#if SCRUTINY_ENABLE_STATISTICS == 0
+#error "Not enabled"
+#endif
+
+namespace scrutiny
+{
+    namespace statistics
+    {
+        static SCRUTINY_CONSTEXPR unsigned int MAX_BINS = 16; // Maximum number of bins in the histogram of a channel
+
+        /// @brief Running statistics of a value. The mean and the mean of the squares are updated incrementally so that they stay
+        /// accurate over a very large number of samples. The server computes the RMS, which is the square root of the mean of the squares.
+        struct Accumulator
+        {
+            uint32_t count;              // Number of samples. Saturates
+            float_biggest_t min;         // Smallest sample
+            float_biggest_t max;         // Biggest sample
+            float_biggest_t mean;        // Mean of the samples
+            float_biggest_t mean_square; // Mean of the squared samples
+            uint32_t bins[MAX_BINS];     // Histogram. Samples out of range are counted in the first or the last bin. Saturates
+        };
+
+        /// @brief A value whose statistics are computed by a loop. Allocated by the integrator, configured by the server.
+        struct Channel
+        {
+            datalogging::Operand operand; // The value. Read the same way as the datalogging trigger operands
+            float histogram_min;          // Lower bound of the first bin
+            float histogram_max;          // Upper bound of the last bin
+            uint_least8_t bin_count;      // Number of bins of the histogram. 0 if no histogram
+            Accumulator live;             // Updated by the loop at each iteration
+            Accumulator snapshot;         // Copy of the live statistics taken by the loop on request, then read by the MainHandler
+        };
+    } // namespace statistics
+} // namespace scrutiny
+
+#endif // ___SCRUTINY_STATISTICS_TYPES_H___
@@ -70,11 +70,40 @@ namespace scrutiny
         {
             m_timebase = SCRUTINY_NULL;
             m_main_handler = main_handler;
+            m_buffer = buffer;
             m_buffer_size = buffer_size;
+            m_storage.write = SCRUTINY_NULL_FN_PTR(storage_write_callback_t);
+            m_storage.read = SCRUTINY_NULL_FN_PTR(storage_read_callback_t);
+            m_storage.cache = SCRUTINY_NULL;
+            m_storage.cache_size = 0;
             m_trigger_callback = trigger_callback;
             m_owner = SCRUTINY_NULL;
 
-            m_encoder.init(main_handler, &m_config, buffer, buffer_size);
+            m_double_buffering.enabled = false;
+            init_encoders();
+            m_acquisition_id = 0;
+
+            reset();
+
+            return Status::SUCCESS;
+        }
+
+        Status::eStatus DataLogger::init(
+            MainHandler const *const main_handler,
+            ExternalStorage const *const storage,
+            buffer_size_t const storage_size,
+            trigger_callback_t trigger_callback)
+        {
+            m_timebase = SCRUTINY_NULL;
+            m_main_handler = main_handler;
+            m_buffer = SCRUTINY_NULL;
+            m_buffer_size = storage_size;
+            m_storage = *storage;
+            m_trigger_callback = trigger_callback;
+            m_owner = SCRUTINY_NULL;
+
+            m_double_buffering.enabled = false;
+            init_encoders();
             m_acquisition_id = 0;
 
             reset();
@@ -99,6 +128,66 @@ namespace scrutiny
 
             m_decimation_counter = 0;
             m_log_points_after_trigger = 0;
+
+            m_published.trigger_timestamp = 0;
+            m_published.log_points_after_trigger = 0;
+            m_published.acquisition_id = m_acquisition_id;
+            m_double_buffering.published = false;
+        }
+
+        /// @brief Gives the buffer to the encoders. Splits it in two halves when double buffering is enabled
+        void DataLogger::init_encoders(void)
+        {
+            uint_least8_t const count = m_double_buffering.enabled ? 2 : 1;
+            buffer_size_t const size = m_buffer_size / count;
+            for (uint_least8_t i = 0; i < count; i++)
+            {
+                if (m_storage.write != SCRUTINY_NULL_FN_PTR(storage_write_callback_t))
+                {
+                    m_encoders[i].init(m_main_handler, &m_config, &m_storage, size); // Never double buffered. See configure()
+                }
+                else
+                {
+                    m_encoders[i].init(m_main_handler, &m_config, (m_buffer == SCRUTINY_NULL) ? SCRUTINY_NULL : &m_buffer[i * size], size);
+                }
+                m_encoders[i].set_timebase(m_timebase);
+            }
+
+            m_write_encoder = &m_encoders[0];
+            m_read_encoder = &m_encoders[count - 1];
+        }
+
+        /// @brief Makes the last completed acquisition available to the reader.
+        /// In double buffering mode, the halves are swapped and a new acquisition starts right away in the free half
+        void DataLogger::publish_acquisition(void)
+        {
+            m_published.trigger_timestamp = m_trigger_timestamp;
+            m_published.log_points_after_trigger = m_log_points_after_trigger;
+            m_published.acquisition_id = m_acquisition_id;
+
+            if (m_double_buffering.enabled)
+            {
+                DataEncoder *const completed_encoder = m_write_encoder;
+                m_write_encoder = m_read_encoder;
+                m_read_encoder = completed_encoder;
+                m_write_encoder->reset();
+                m_double_buffering.published = true;
+                m_state = State::Armed;
+            }
+        }
+
+        void DataLogger::release_acquisition(void)
+        {
+            if (!m_double_buffering.enabled || !m_double_buffering.published)
+            {
+                return;
+            }
+
+            m_double_buffering.published = false;
+            if (m_state == State::AcquisitionCompleted)
+            {
+                publish_acquisition(); // An acquisition was waiting for a free half
+            }
         }
 
         void DataLogger::configure(Timebase *timebase, uint16_t config_id)
@@ -139,6 +228,13 @@ namespace scrutiny
                 m_config_valid = false;
             }
 
+            // Double buffering reads an acquisition while the next one is written. The external storage does not allow
+            // its read callback to overlap with its write callback.
+            if (m_config.double_buffering && m_storage.write != SCRUTINY_NULL_FN_PTR(storage_write_callback_t))
+            {
+                m_config_valid = false;
+            }
+
             // Size are consistent so far, we can read the operand and items definition without crashing anything
             if (m_config_valid)
             {
@@ -218,22 +314,47 @@ namespace scrutiny
                     {
                         // Nothing to validate
                     }
+                    else if (m_config.items_to_log[i].common.type == LoggableType::ImplicitTime)
+                    {
+                        // Nothing to validate. The main handler makes sure the owning loop runs at a fixed frequency.
+                    }
+                    else if (m_config.items_to_log[i].common.type == LoggableType::MemoryBit)
+                    {
+                        // Same rules as a VarBit operand. Float cannot be split in bits.
+                        VariableType::eVariableType const datatype = m_config.items_to_log[i].memorybit.datatype;
+                        if (!tools::is_supported_type(datatype) || tools::is_float_type(datatype))
+                        {
+                            m_config_valid = false;
+                        }
+
+                        if (m_config.items_to_log[i].memorybit.bitsize == 0 ||
+                            m_config.items_to_log[i].memorybit.bitoffset + m_config.items_to_log[i].memorybit.bitsize >
+                                tools::get_type_size_char(datatype) * CHAR_BIT)
+                        {
+                            m_config_valid = false;
+                        }
+                    }
                     else
                     {
                         m_config_valid = false;
                     }
+
+                    if (!validate_item_options(i))
+                    {
+                        m_config_valid = false;
+                    }
                 }
             }
 
             // The configuration is good. Let's initialize to start logging
             if (m_config_valid)
             {
-                m_encoder.set_timebase(m_timebase);
                 if (m_trigger.active_condition.reset_fn != SCRUTINY_NULL_FN_PTR(trigger::ResetFn))
                 {
                     m_trigger.active_condition.reset_fn(&m_trigger.condition_data);
                 }
-                m_encoder.reset();
+                m_double_buffering.enabled = m_config.double_buffering;
+                init_encoders();
                 m_state = State::Configured;
             }
             else
@@ -244,6 +365,11 @@ namespace scrutiny
 
         void DataLogger::arm_trigger(void)
         {
+            if (m_double_buffering.enabled && m_state == State::AcquisitionCompleted)
+            {
+                return; // Both halves are full. The datalogger rearms by itself once the server releases the acquisition it has read
+            }
+
             if (m_state == State::Configured || m_state == State::AcquisitionCompleted || m_state == State::Triggered)
             {
                 m_state = State::Armed;
@@ -272,7 +398,7 @@ namespace scrutiny
             case State::Configured:
             case State::Armed:
             case State::Triggered:
-                if (m_encoder.error())
+                if (m_write_encoder->error())
                 {
                     m_state = State::Error;
                 }
@@ -296,9 +422,14 @@ namespace scrutiny
                     {
                         if (acquisition_completed())
                         {
+                            m_write_encoder->flush(); // Data must be in the storage before the reader accesses it
                             m_acquisition_id++;
                             m_state = State::AcquisitionCompleted;
-                            m_log_points_after_trigger = m_encoder.get_entry_write_counter();
+                            m_log_points_after_trigger = m_write_encoder->get_entry_write_counter();
+                            if (!m_double_buffering.published)
+                            {
+                                publish_acquisition();
+                            }
                         }
                     }
                     break;
@@ -308,21 +439,22 @@ namespace scrutiny
 
         void DataLogger::stamp_trigger_point(void)
         {
-            m_trigger_cursor_location = m_encoder.get_write_cursor();
+            m_trigger_cursor_location = m_write_encoder->get_write_cursor();
             m_trigger_timestamp = m_timebase->get_timestamp();
-            m_encoder.reset_write_counter(); // Completion logic uses that counter directly without processing
+            m_write_encoder->reset_write_counter(); // Completion logic uses that counter directly without processing
 
+            buffer_size_t const buffer_size = m_write_encoder->get_buffer_size(); // Half of the buffer with double buffering
             uint64_t const multiplier = static_cast<uint64_t>((1 << (sizeof(m_config.probe_location) * 8)) - 1 - m_config.probe_location);
             m_remaining_data_to_write =
-                static_cast<buffer_size_t>((static_cast<uint64_t>(m_buffer_size) * multiplier) >> (sizeof(m_config.probe_location) * 8));
-            if (!m_encoder.buffer_full())
+                static_cast<buffer_size_t>((static_cast<uint64_t>(buffer_size) * multiplier) >> (sizeof(m_config.probe_location) * 8));
+            if (!m_write_encoder->buffer_full())
             {
-                m_remaining_data_to_write = SCRUTINY_MAX(m_remaining_data_to_write, m_encoder.remaining_bytes_to_full());
+                m_remaining_data_to_write = SCRUTINY_MAX(m_remaining_data_to_write, m_write_encoder->remaining_bytes_to_full());
             }
 
-            if (m_remaining_data_to_write > m_buffer_size)
+            if (m_remaining_data_to_write > buffer_size)
             {
-                m_remaining_data_to_write = m_buffer_size;
+                m_remaining_data_to_write = buffer_size;
             }
         }
 
@@ -343,7 +475,7 @@ namespace scrutiny
                     }
                 }
 
-                if (m_encoder.get_data_write_counter() >= m_remaining_data_to_write)
+                if (m_write_encoder->get_data_write_counter() >= m_remaining_data_to_write)
                 {
                     return true;
                 }
@@ -352,11 +484,90 @@ namespace scrutiny
             return false;
         }
 
+        /// @brief Validate the reduction mode and the storage format of an item. Expect the item definition to be valid
+        /// @param index Index of the item in the configuration
+        /// @return true if the options can be applied to the item
+        bool DataLogger::validate_item_options(uint_least8_t const index) const
+        {
+            LoggableItem const &item = m_config.items_to_log[index];
+            LoggableItemOptions const &options = m_config.items_options[index];
+            VariableType::eVariableType datatype = VariableType::unknown;
+
+            if (options.reduction == ReductionMode::Last && options.storage == StorageFormat::Native)
+            {
+                return true;
+            }
+
+            if (options.reduction != ReductionMode::Last && options.reduction != ReductionMode::Mean && options.reduction != ReductionMode::MinMax)
+            {
+                return false;
+            }
+
+            if (options.storage != StorageFormat::Native && options.storage != StorageFormat::Float16 &&
+                options.storage != StorageFormat::ScaledInt16)
+            {
+                return false;
+            }
+
+            if (item.common.type == LoggableType::Rpv)
+            {
+                RuntimePublishedValue rpv;
+                if (!m_main_handler->get_rpv(item.rpv.id, &rpv))
+                {
+                    return false;
+                }
+                datatype = rpv.type;
+            }
+            else if (item.common.type == LoggableType::Memory)
+            {
+                // Raw memory has no type. The server must tell us how to interpret it.
+                datatype = options.datatype;
+                if (tools::get_type_size_char(datatype) != item.memory.size)
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                return false; // Time axis and packed bits cannot be reduced or converted
+            }
+
+            if (!tools::is_supported_type(datatype))
+            {
+                return false;
+            }
+
+            if (options.reduction == ReductionMode::Mean && tools::get_var_type_type(datatype) == VariableTypeType::_boolean)
+            {
+                return false;
+            }
+
+            if (options.storage != StorageFormat::Native && !tools::is_float_type(datatype))
+            {
+                return false;
+            }
+
+            if (options.storage == StorageFormat::ScaledInt16)
+            {
+                if (!tools::is_float_finite(options.scale) || !tools::is_float_finite(options.offset) || options.scale == 0)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
         void DataLogger::process_acquisition(void)
         {
+            if (m_write_encoder->reductions_enabled())
+            {
+                m_write_encoder->accumulate(m_owner); // Every loop cycle sees the value, not only the ones that produce an entry
+            }
+
             if (++m_decimation_counter >= m_config.decimation)
             {
-                m_encoder.encode_next_entry(m_owner);
+                m_write_encoder->encode_next_entry(m_owner);
                 m_decimation_counter = 0;
             }
         }
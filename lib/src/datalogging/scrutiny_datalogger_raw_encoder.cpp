@@ -8,6 +8,7 @@
 //    Copyright (c) 2021 Scrutiny Debugger
 
 #include "datalogging/scrutiny_datalogger_raw_encoder.hpp"
+#include "datalogging/scrutiny_datalogging.hpp"
 #include "scrutiny_common_codecs.hpp"
 #include "scrutiny_main_handler.hpp"
 #include "scrutiny_setup.hpp"
@@ -57,6 +58,7 @@ namespace scrutiny
             // Will do a maximum of 2 loops only if there is a wrap in the buffer.
             // This will cause 2 memcpy   start to buffer_end & buffer start to end
             // Otherwise a 1 loop and 1 memcpy
+            // With an external storage, the data is streamed through the cache, which may take more loops.
             while (output_cursor_8bits < max_size_8bits)
             {
                 datalogging::buffer_size_t transfer_size_8bits;
@@ -64,7 +66,21 @@ namespace scrutiny
                 datalogging::buffer_size_t const right_hand_start_point = (write_cursor > m_read_cursor) ? write_cursor : buffer_end;
                 transfer_size_8bits = (right_hand_start_point - m_read_cursor) * (CHAR_BIT / 8);
                 transfer_size_8bits = SCRUTINY_MIN(transfer_size_8bits, new_max_8bits);
-                tools::memcpy_dilate_8bits_native(&buffer_8bits[output_cursor_8bits], &m_encoder->m_buffer[m_read_cursor], transfer_size_8bits);
+                unsigned char const *src;
+                if (m_encoder->external_storage())
+                {
+                    // The encoder flushed its cache when the acquisition completed. We can use it to read back.
+                    datalogging::ExternalStorage const &storage = m_encoder->m_storage;
+                    datalogging::buffer_size_t const cache_size_8bits = static_cast<datalogging::buffer_size_t>(storage.cache_size * (CHAR_BIT / 8));
+                    transfer_size_8bits = SCRUTINY_MIN(transfer_size_8bits, cache_size_8bits);
+                    storage.read(m_encoder->m_storage_offset + m_read_cursor, storage.cache, transfer_size_8bits / (CHAR_BIT / 8));
+                    src = storage.cache;
+                }
+                else
+                {
+                    src = &m_encoder->m_buffer[m_read_cursor];
+                }
+                tools::memcpy_dilate_8bits_native(&buffer_8bits[output_cursor_8bits], src, transfer_size_8bits);
                 m_read_cursor += transfer_size_8bits / (CHAR_BIT / 8);
                 m_read_started = true;
                 output_cursor_8bits += transfer_size_8bits;
@@ -94,7 +110,7 @@ namespace scrutiny
                 return 0;
             }
 
-            return m_encoder->get_entry_count() * m_encoder->m_entry_size;
+            return m_encoder->get_data_size();
         }
 
         /// @brief Reset the reader
@@ -112,14 +128,40 @@ namespace scrutiny
             m_reader(this),
             m_main_handler(SCRUTINY_NULL),
             m_timebase(SCRUTINY_NULL),
-            m_max_entries(0),
-            m_next_entry_write_index(0),
-            m_first_valid_entry_index(0),
+            m_read_cursor(0),
+            m_write_cursor(0),
+            m_wrap_end(0),
+            m_entry_count(0),
             m_entry_write_counter(0),
+            m_data_write_counter(0),
             m_entry_size(0),
+            m_wrapped(false),
             m_full(false),
-            m_error(false)
+            m_error(false),
+            m_converted_items(false),
+            m_storage_offset(0),
+            m_cache_address(0),
+            m_cache_fill(0)
         {
+            m_storage.write = SCRUTINY_NULL_FN_PTR(storage_write_callback_t);
+            m_storage.read = SCRUTINY_NULL_FN_PTR(storage_read_callback_t);
+            m_storage.cache = SCRUTINY_NULL;
+            m_storage.cache_size = 0;
+
+            m_variable_entries.bitmap_size = 0;
+            m_variable_entries.enabled = false;
+
+            m_implicit_time.total_entry_counter = 0;
+            m_implicit_time.interval = 1;
+            m_implicit_time.entries_since_checkpoint = 0;
+            m_implicit_time.next_checkpoint_index = 0;
+            m_implicit_time.checkpoint_count = 0;
+            m_implicit_time.enabled = false;
+
+            m_packed_bits.enabled = false;
+            m_reduction.enabled = false;
+            m_rpv_bulk.count = 0;
+            m_rpv_bulk.enabled = false;
         }
 
         /// @brief Takes a snapshot of the data to log and write it into the datalogger buffer
@@ -133,45 +175,99 @@ namespace scrutiny
                 return;
             }
 
-            if (m_next_entry_write_index == m_first_valid_entry_index && m_full)
+            uint16_t const entry_size = (m_variable_entries.enabled) ? compute_entry_size(m_variable_entries.head_phases) : m_entry_size;
+
+            // Make room for the new entry by discarding the oldest ones.
+            while (m_wrapped && m_entry_count > 0 && m_read_cursor < m_write_cursor + entry_size)
+            {
+                drop_oldest_entry();
+            }
+
+            // All the plain Rpv items are read in a single call, even those decimated out of this entry.
+            AnyType bulk_values[SCRUTINY_DATALOGGING_MAX_SIGNAL];
+            bool bulk_success = false;
+            if (m_rpv_bulk.enabled)
             {
-                m_first_valid_entry_index++;
-                if (m_first_valid_entry_index >= m_max_entries)
+                bulk_success = m_main_handler->read_rpvs(m_rpv_bulk.rpvs, bulk_values, m_rpv_bulk.count, caller);
+            }
+
+            // With an external storage, entries are staged in the cache and written in blocks.
+            unsigned char *const entry = external_storage() ? &m_storage.cache[m_cache_fill] : &m_buffer[m_write_cursor];
+            uint16_t cursor = 0;
+            if (m_variable_entries.enabled)
+            {
+                // Presence bitmap. Encoded with 8 bits per byte, item 0 is the MSB of the first byte.
+                unsigned char bitmap[(SCRUTINY_DATALOGGING_MAX_SIGNAL + 7) / 8 + 1];
+                memset(bitmap, 0, sizeof(bitmap));
+                for (uint_fast8_t i = 0; i < m_config->items_count; i++)
                 {
-                    m_first_valid_entry_index = 0;
+                    if (m_variable_entries.head_phases[i] == 0)
+                    {
+                        bitmap[i >> 3] |= static_cast<unsigned char>(0x80 >> (i & 0x7));
+                    }
                 }
+                tools::memcpy_compress_from_8bits_native(&entry[cursor], bitmap, m_variable_entries.bitmap_size * (CHAR_BIT / 8));
+                cursor += m_variable_entries.bitmap_size;
             }
 
-            datalogging::buffer_size_t cursor = m_next_entry_write_index * m_entry_size;
             for (uint_fast8_t i = 0; i < m_config->items_count; i++)
             {
+                if (m_variable_entries.enabled && m_variable_entries.head_phases[i] != 0)
+                {
+                    continue; // Item decimated out of this entry
+                }
+
+                if (m_reduction.enabled && m_config->items_options[i].reduction != ReductionMode::Last)
+                {
+                    cursor += write_reduced_item(i, &entry[cursor], caller);
+                    continue;
+                }
+
+                if (m_converted_items && m_config->items_options[i].storage != StorageFormat::Native)
+                {
+                    AnyType val;
+                    read_item_value(i, &val, caller);
+                    cursor += write_item_value(i, val, &entry[cursor]);
+                    continue;
+                }
+
                 LoggableItem const &item = m_config->items_to_log[i];
                 if (item.common.type == datalogging::LoggableType::Memory)
                 {
-                    m_main_handler->read_memory(&m_buffer[cursor], item.memory.address, item.memory.size);
+                    m_main_handler->read_memory(&entry[cursor], item.memory.address, item.memory.size);
                     cursor += item.memory.size; // We verified that this is not 0 in init
                 }
                 else if (item.common.type == datalogging::LoggableType::Rpv)
                 {
                     RuntimePublishedValue rpv;
                     AnyType outval;
-                    uint16_t const rpv_id = item.rpv.id;
-                    m_main_handler->get_rpv(rpv_id, &rpv); // assumed valid because of config validation
-                    // We assume that the callback is not nullptr. We rely on datalogger::configure to validate this.
-                    bool const success = m_main_handler->get_rpv_read_callback()(rpv, &outval, caller);
+                    bool success;
+                    if (m_rpv_bulk.enabled)
+                    {
+                        rpv = m_rpv_bulk.rpvs[m_rpv_bulk.indexes[i]];
+                        outval = bulk_values[m_rpv_bulk.indexes[i]];
+                        success = bulk_success;
+                    }
+                    else
+                    {
+                        uint16_t const rpv_id = item.rpv.id;
+                        m_main_handler->get_rpv(rpv_id, &rpv); // assumed valid because of config validation
+                        // We rely on datalogger::configure to validate that a read callback is set.
+                        success = m_main_handler->read_rpv(rpv, &outval, caller);
+                    }
 
                     if (!success)
                     {
                         tools::set_biggest_uint(outval, 0);
                     }
 #if CHAR_BIT == 8
-                    cursor += codecs::encode_anytype_big_endian_char(&outval, rpv.type, &m_buffer[cursor]);
+                    cursor += codecs::encode_anytype_big_endian_char(&outval, rpv.type, &entry[cursor]);
 #elif CHAR_BIT == 16
                     // Here we handle the case where data bits are little endian within a single char.
                     // We do a little work to put that in a usable format in every sample so we can dump fast
                     // when the server request to read.
                     uint16_t nb_8bits = codecs::encode_anytype_big_endian_8bits(&outval, rpv.type, tmp);
-                    tools::memcpy_compress_from_8bits_native(&m_buffer[cursor], tmp, nb_8bits);
+                    tools::memcpy_compress_from_8bits_native(&entry[cursor], tmp, nb_8bits);
                     cursor += nb_8bits / (CHAR_BIT / 8);
 #endif
                 }
@@ -180,27 +276,377 @@ namespace scrutiny
                     // No check for m_timebase == nullptr.
                     // Expect the datalogger to set it.
 #if CHAR_BIT == 8
-                    codecs::encode_32_bits_big_endian_8bits(m_timebase->get_timestamp(), &m_buffer[cursor]);
+                    codecs::encode_32_bits_big_endian_8bits(m_timebase->get_timestamp(), &entry[cursor]);
 #elif CHAR_BIT == 16
                     // Here we handle the case where data bits are little endian within a single char.
                     // We do a little work to put that in a usable format in every sample so we can dump fast
                     // when the server request to read.
                     codecs::encode_32_bits_big_endian_8bits(m_timebase->get_timestamp(), tmp);
-                    tools::memcpy_compress_from_8bits_native(&m_buffer[cursor], tmp, sizeof(uint32_t) * (CHAR_BIT / 8));
+                    tools::memcpy_compress_from_8bits_native(&entry[cursor], tmp, sizeof(uint32_t) * (CHAR_BIT / 8));
 #endif
 
                     cursor += sizeof(scrutiny::timestamp_t);
                 }
+                // LoggableType::ImplicitTime takes no space in the entry.
+                // LoggableType::MemoryBit is written after all the other items.
             }
 
-            m_next_entry_write_index++;
-            if (m_next_entry_write_index >= m_max_entries)
+            if (m_packed_bits.enabled)
             {
-                m_full = true;
-                m_next_entry_write_index = 0;
+                cursor += write_packed_bits(&entry[cursor]);
+            }
+
+            if (m_implicit_time.enabled)
+            {
+                if (m_implicit_time.entries_since_checkpoint == 0)
+                {
+                    TimeCheckpoint &checkpoint = m_implicit_time.checkpoints[m_implicit_time.next_checkpoint_index];
+                    checkpoint.entry_counter = m_implicit_time.total_entry_counter;
+                    checkpoint.timestamp = m_timebase->get_timestamp();
+
+                    m_implicit_time.next_checkpoint_index++;
+                    if (m_implicit_time.next_checkpoint_index >= SCRUTINY_DATALOGGING_TIME_CHECKPOINTS)
+                    {
+                        m_implicit_time.next_checkpoint_index = 0;
+                    }
+
+                    if (m_implicit_time.checkpoint_count < SCRUTINY_DATALOGGING_TIME_CHECKPOINTS)
+                    {
+                        m_implicit_time.checkpoint_count++;
+                    }
+                }
+
+                m_implicit_time.entries_since_checkpoint++;
+                if (m_implicit_time.entries_since_checkpoint >= m_implicit_time.interval)
+                {
+                    m_implicit_time.entries_since_checkpoint = 0;
+                }
             }
+            m_implicit_time.total_entry_counter++;
 
+            m_write_cursor += cursor;
+            m_entry_count++;
             m_entry_write_counter++;
+            m_data_write_counter += entry_size;
+
+            uint16_t next_entry_size = m_entry_size;
+            if (m_variable_entries.enabled)
+            {
+                advance_phases(m_variable_entries.head_phases);
+                next_entry_size = compute_entry_size(m_variable_entries.head_phases);
+            }
+
+            // Wrap right away if the next entry cannot fit. Entries are never split across the end of the buffer.
+            if (m_write_cursor + next_entry_size > m_buffer_size)
+            {
+                // Entries located after the write cursor would be out of order once we restart from the beginning.
+                while (m_wrapped && m_entry_count > 0)
+                {
+                    drop_oldest_entry();
+                }
+
+                m_wrap_end = m_write_cursor;
+                m_write_cursor = 0;
+                m_wrapped = true;
+                m_full = true;
+            }
+
+            if (external_storage())
+            {
+                m_cache_fill = static_cast<uint16_t>(m_cache_fill + cursor);
+                // The cache holds contiguous data only. Write it when the next entry goes elsewhere or does not fit.
+                if (m_write_cursor != m_cache_address + m_cache_fill || m_cache_fill + next_entry_size > m_storage.cache_size)
+                {
+                    flush();
+                }
+            }
+        }
+
+        /// @brief Writes the content of the cache to the external storage. Does nothing when using an internal buffer.
+        /// Must be called before reading the data back.
+        void RawFormatEncoder::flush(void)
+        {
+            if (!external_storage() || m_error)
+            {
+                return;
+            }
+
+            if (m_cache_fill > 0)
+            {
+                m_storage.write(m_storage_offset + m_cache_address, m_storage.cache, m_cache_fill);
+            }
+            m_cache_address = m_write_cursor;
+            m_cache_fill = 0;
+        }
+
+        /// @brief Reads all the MemoryBit items present in the next entry and writes them back to back, MSB first.
+        /// The last 8 bits byte is padded with zeros.
+        /// @param dst Where to write in the buffer
+        /// @return Number of char written
+        uint16_t RawFormatEncoder::write_packed_bits(unsigned char *const dst) const
+        {
+            unsigned char staging[CHAR_BIT / 8]; // Completed 8 bits bytes waiting to be written as a full char
+            uint_fast8_t staged_count = 0;
+            uint_fast8_t accumulator = 0; // 8 bits byte being built
+            uint_fast8_t accumulated_bits = 0;
+            uint16_t size = 0;
+
+            for (uint_fast8_t i = 0; i < m_config->items_count; i++)
+            {
+                uint_fast8_t const bitsize = m_packed_bits.item_bits[i];
+                if (bitsize == 0 || (m_variable_entries.enabled && m_variable_entries.head_phases[i] != 0))
+                {
+                    continue;
+                }
+
+                LoggableItem const &item = m_config->items_to_log[i];
+                AnyValAndTypePair val_type_pair;
+                uint_biggest_t bits = 0;
+                if (m_main_handler->fetch_variable_bitfield(
+                        item.memorybit.address,
+                        tools::get_var_type_type(item.memorybit.datatype),
+                        item.memorybit.bitoffset,
+                        bitsize,
+                        &val_type_pair))
+                {
+                    bits = read_bits_as_biggest_uint(val_type_pair.val, val_type_pair.valtype);
+                }
+
+                for (uint_fast8_t n = bitsize; n > 0; n--)
+                {
+                    accumulator = static_cast<uint_fast8_t>(((accumulator << 1) | ((bits >> (n - 1)) & 1u)) & 0xFFu);
+                    accumulated_bits++;
+                    if (accumulated_bits == 8)
+                    {
+                        staging[staged_count++] = static_cast<unsigned char>(accumulator);
+                        accumulator = 0;
+                        accumulated_bits = 0;
+                        if (staged_count == (CHAR_BIT / 8))
+                        {
+                            tools::memcpy_compress_from_8bits_native(&dst[size++], staging, CHAR_BIT / 8);
+                            staged_count = 0;
+                        }
+                    }
+                }
+            }
+
+            if (accumulated_bits > 0)
+            {
+                staging[staged_count++] = static_cast<unsigned char>((accumulator << (8u - accumulated_bits)) & 0xFFu);
+            }
+
+            if (staged_count > 0)
+            {
+                while (staged_count < (CHAR_BIT / 8))
+                {
+                    staging[staged_count++] = 0;
+                }
+                tools::memcpy_compress_from_8bits_native(&dst[size++], staging, CHAR_BIT / 8);
+            }
+
+            return size;
+        }
+
+        /// @brief Feeds the current value of every reduced item to its reduction. To be called at every loop cycle, even when no entry is written.
+        void RawFormatEncoder::accumulate(LoopHandler *const caller)
+        {
+            if (m_error)
+            {
+                return;
+            }
+
+            for (uint_fast8_t i = 0; i < m_config->items_count; i++)
+            {
+                if (m_config->items_options[i].reduction != ReductionMode::Last)
+                {
+                    accumulate_item(i, caller);
+                }
+            }
+        }
+
+        /// @brief Reads the value of an item and add it to the reduction of its window
+        /// @param index The item index
+        /// @param caller The loop that calls the datalogger
+        void RawFormatEncoder::accumulate_item(uint_fast8_t const index, LoopHandler *const caller)
+        {
+            VariableType::eVariableType const datatype = m_item_datatypes[index];
+            AnyType val;
+            read_item_value(index, &val, caller);
+
+            uint32_t &count = m_reduction.sample_counts[index];
+            if (m_config->items_options[index].reduction == ReductionMode::Mean)
+            {
+                float_biggest_t const fval = read_as_biggest_float(val, datatype);
+                m_reduction.sums[index] = (count == 0) ? fval : m_reduction.sums[index] + fval;
+            }
+            else // MinMax
+            {
+                if (count == 0 || value_less_than(val, m_reduction.mins[index], datatype))
+                {
+                    m_reduction.mins[index] = val;
+                }
+                if (count == 0 || value_less_than(m_reduction.maxs[index], val, datatype))
+                {
+                    m_reduction.maxs[index] = val;
+                }
+            }
+            count++;
+        }
+
+        /// @brief Writes the result of the reduction of an item in the buffer then starts a new window
+        /// @param index The item index
+        /// @param dst Where to write in the buffer
+        /// @param caller The loop that calls the datalogger
+        /// @return Number of char written
+        uint_least8_t RawFormatEncoder::write_reduced_item(uint_fast8_t const index, unsigned char *const dst, LoopHandler *const caller)
+        {
+            if (m_reduction.sample_counts[index] == 0)
+            {
+                accumulate_item(index, caller); // accumulate() has not been called. Reduce on the current value only
+            }
+
+            uint_least8_t size;
+            VariableType::eVariableType const datatype = m_item_datatypes[index];
+            if (m_config->items_options[index].reduction == ReductionMode::Mean)
+            {
+                AnyType mean;
+                float_biggest_t const count = static_cast<float_biggest_t>(m_reduction.sample_counts[index]);
+                write_from_biggest_float(m_reduction.sums[index] / count, datatype, &mean);
+                size = write_item_value(index, mean, dst);
+            }
+            else // MinMax
+            {
+                size = write_item_value(index, m_reduction.mins[index], dst);
+                size = static_cast<uint_least8_t>(size + write_item_value(index, m_reduction.maxs[index], &dst[size]));
+            }
+
+            m_reduction.sample_counts[index] = 0;
+            return size;
+        }
+
+        /// @brief Reads the current value of a typed item (Rpv or Memory with a datatype)
+        /// @param index The item index
+        /// @param val The output value. Set to 0 on failure
+        /// @param caller The loop that calls the datalogger
+        /// @return true on success
+        bool RawFormatEncoder::read_item_value(uint_fast8_t const index, AnyType *const val, LoopHandler *const caller) const
+        {
+            LoggableItem const &item = m_config->items_to_log[index];
+            bool success;
+            if (item.common.type == datalogging::LoggableType::Rpv)
+            {
+                RuntimePublishedValue rpv;
+                rpv.id = item.rpv.id;
+                rpv.type = m_item_datatypes[index];
+                success = m_main_handler->read_rpv(rpv, val, caller);
+            }
+            else
+            {
+                success = m_main_handler->fetch_variable(item.memory.address, m_item_datatypes[index], val);
+            }
+
+            if (!success)
+            {
+                tools::set_biggest_uint(*val, 0);
+            }
+            return success;
+        }
+
+        /// @brief Writes a single value of a typed item in the buffer, converted to the storage format of the item.
+        /// Native format is the same as a plain item of the same kind.
+        /// @param index The item index
+        /// @param val The value to write
+        /// @param dst Where to write in the buffer
+        /// @return Number of char written
+        uint_least8_t RawFormatEncoder::write_item_value(uint_fast8_t const index, AnyType const &val, unsigned char *const dst) const
+        {
+            LoggableItemOptions const &options = m_config->items_options[index];
+            VariableType::eVariableType datatype = m_item_datatypes[index];
+            AnyType converted;
+            AnyType const *output = &val;
+            if (options.storage == StorageFormat::Float16)
+            {
+                converted.uint16 = tools::float32_to_float16(static_cast<float>(read_as_biggest_float(val, datatype)));
+                datatype = VariableType::uint16;
+                output = &converted;
+            }
+            else if (options.storage == StorageFormat::ScaledInt16)
+            {
+                float_biggest_t const scaled = (read_as_biggest_float(val, datatype) - options.offset) / options.scale;
+                write_from_biggest_float(scaled, VariableType::sint16, &converted);
+                datatype = VariableType::sint16;
+                output = &converted;
+            }
+
+            if (m_config->items_to_log[index].common.type == datalogging::LoggableType::Memory)
+            {
+                // Memory items are a copy of the memory. AnyType members all start at offset 0 so the native representation is at the start.
+                uint_least8_t const size = tools::get_type_size_char(datatype);
+                memcpy(dst, output, size);
+                return size;
+            }
+
+#if CHAR_BIT == 8
+            return codecs::encode_anytype_big_endian_char(output, datatype, dst);
+#elif CHAR_BIT == 16
+            unsigned char tmp[sizeof(scrutiny::uint_biggest_t) * (CHAR_BIT / 8)];
+            uint16_t nb_8bits = codecs::encode_anytype_big_endian_8bits(output, datatype, tmp);
+            tools::memcpy_compress_from_8bits_native(dst, tmp, nb_8bits);
+            return static_cast<uint_least8_t>(nb_8bits / (CHAR_BIT / 8));
+#endif
+        }
+
+        /// @brief Computes the size of an entry given the decimation phase of each item
+        /// @param phases The decimation phase of each item. An item is present when its phase is 0
+        /// @return Size of the entry in char
+        uint16_t RawFormatEncoder::compute_entry_size(uint16_t const *const phases) const
+        {
+            uint16_t size = m_variable_entries.bitmap_size;
+            uint16_t bitcount = 0;
+            for (uint_fast8_t i = 0; i < m_config->items_count; i++)
+            {
+                if (phases[i] == 0)
+                {
+                    size += m_variable_entries.item_sizes[i];
+                    bitcount += m_packed_bits.item_bits[i];
+                }
+            }
+            return size + get_packed_bits_size_char(bitcount);
+        }
+
+        /// @brief Move the decimation phase of each item to the next entry
+        /// @param phases The decimation phase of each item
+        void RawFormatEncoder::advance_phases(uint16_t *const phases) const
+        {
+            for (uint_fast8_t i = 0; i < m_config->items_count; i++)
+            {
+                phases[i]++;
+                if (phases[i] >= m_config->items_options[i].decimation)
+                {
+                    phases[i] = 0;
+                }
+            }
+        }
+
+        /// @brief Discard the oldest entry of the buffer to make some space
+        void RawFormatEncoder::drop_oldest_entry(void)
+        {
+            if (m_variable_entries.enabled)
+            {
+                m_read_cursor += compute_entry_size(m_variable_entries.tail_phases);
+                advance_phases(m_variable_entries.tail_phases);
+            }
+            else
+            {
+                m_read_cursor += m_entry_size;
+            }
+            m_entry_count--;
+
+            if (m_wrapped && m_read_cursor >= m_wrap_end)
+            {
+                m_read_cursor = 0;
+                m_wrapped = false;
+            }
         }
 
         /// @brief  Init the encoder
@@ -214,6 +660,30 @@ namespace scrutiny
             m_config = config;
             m_buffer = buffer;
             m_buffer_size = buffer_size;
+            m_storage.write = SCRUTINY_NULL_FN_PTR(storage_write_callback_t);
+            m_storage.read = SCRUTINY_NULL_FN_PTR(storage_read_callback_t);
+            m_storage.cache = SCRUTINY_NULL;
+            m_storage.cache_size = 0;
+            m_storage_offset = 0;
+
+            reset();
+        }
+
+        /// @brief  Init the encoder so that it writes to an external storage instead of an internal buffer.
+        /// The encoder uses the region [storage_offset, storage_offset + storage_size[ of the storage
+        void RawFormatEncoder::init(
+            MainHandler const *const main_handler,
+            datalogging::Configuration const *const config,
+            datalogging::ExternalStorage const *const storage,
+            datalogging::buffer_size_t const storage_size,
+            datalogging::buffer_size_t const storage_offset)
+        {
+            m_main_handler = main_handler;
+            m_config = config;
+            m_buffer = SCRUTINY_NULL;
+            m_buffer_size = storage_size;
+            m_storage = *storage;
+            m_storage_offset = storage_offset;
 
             reset();
         }
@@ -222,25 +692,67 @@ namespace scrutiny
         {
             reset_write_counter();
             m_error = false;
-            m_next_entry_write_index = 0;
-            m_first_valid_entry_index = 0;
+            m_read_cursor = 0;
+            m_write_cursor = 0;
+            m_wrap_end = 0;
+            m_entry_count = 0;
             m_entry_size = 0;
+            m_wrapped = false;
             m_full = false;
-            m_max_entries = 0;
 
-            if (m_buffer == SCRUTINY_NULL || m_buffer_size == 0)
+            m_variable_entries.bitmap_size = 0;
+            m_variable_entries.enabled = false;
+
+            m_implicit_time.total_entry_counter = 0;
+            m_implicit_time.interval = 1;
+            m_implicit_time.entries_since_checkpoint = 0;
+            m_implicit_time.next_checkpoint_index = 0;
+            m_implicit_time.checkpoint_count = 0;
+            m_implicit_time.enabled = false;
+
+            m_packed_bits.enabled = false;
+            m_reduction.enabled = false;
+            m_rpv_bulk.count = 0;
+            m_rpv_bulk.enabled = false;
+            m_converted_items = false;
+            m_cache_address = 0;
+            m_cache_fill = 0;
+
+            if (external_storage())
+            {
+                if (m_storage.read == SCRUTINY_NULL_FN_PTR(storage_read_callback_t) || m_storage.cache == SCRUTINY_NULL)
+                {
+                    m_error = true;
+                }
+            }
+            else if (m_buffer == SCRUTINY_NULL)
+            {
+                m_error = true;
+            }
+
+            if (m_buffer_size == 0)
             {
                 m_error = true;
             }
 
+            // Average entry size in 1/256 of char. Only used to spread the time checkpoints across the buffer.
+            uint32_t average_entry_size_x256 = 0;
+            uint16_t total_bitcount = 0;
             for (uint_fast8_t i = 0; i < m_config->items_count; i++)
             {
                 LoggableItem const &item = m_config->items_to_log[i];
+                m_variable_entries.item_sizes[i] = 0;
+                m_variable_entries.head_phases[i] = 0;
+                m_variable_entries.tail_phases[i] = 0;
+                m_packed_bits.item_bits[i] = 0;
+                m_reduction.sample_counts[i] = 0;
+                m_item_datatypes[i] = VariableType::unknown;
                 if (m_error)
                 {
                     break;
                 }
                 uint_fast8_t elem_size = 0;
+                uint_fast8_t elem_bits = 0;
                 if (item.common.type == datalogging::LoggableType::Memory)
                 {
                     elem_size = item.memory.size; // Size in char
@@ -256,36 +768,137 @@ namespace scrutiny
                     else
                     {
                         elem_size = tools::get_type_size_char(rpv.type); // Size in char
+                        m_item_datatypes[i] = rpv.type;
+                        LoggableItemOptions const &options = m_config->items_options[i];
+                        if (options.reduction == ReductionMode::Last && options.storage == StorageFormat::Native)
+                        {
+                            m_rpv_bulk.indexes[i] = m_rpv_bulk.count;
+                            m_rpv_bulk.rpvs[m_rpv_bulk.count++] = rpv;
+                        }
                     }
                 }
                 else if (item.common.type == datalogging::LoggableType::Time)
                 {
                     elem_size = sizeof(scrutiny::timestamp_t); // Size in char
                 }
+                else if (item.common.type == datalogging::LoggableType::ImplicitTime)
+                {
+                    m_implicit_time.enabled = true;
+                    continue; // Nothing stored in the buffer
+                }
+                else if (item.common.type == datalogging::LoggableType::MemoryBit)
+                {
+                    elem_bits = item.memorybit.bitsize; // Packed with the other bits at the end of the entry
+                    m_packed_bits.enabled = true;
+                }
+
+                LoggableItemOptions const &options = m_config->items_options[i];
+                if (options.reduction != ReductionMode::Last || options.storage != StorageFormat::Native)
+                {
+                    if (item.common.type == datalogging::LoggableType::Memory)
+                    {
+                        m_item_datatypes[i] = options.datatype;
+                    }
+
+                    // The datalogger validates the configuration. Just make sure we never write more than the declared size.
+                    if (elem_size == 0 || tools::get_type_size_char(m_item_datatypes[i]) != elem_size)
+                    {
+                        m_error = true;
+                    }
+
+                    if (options.storage != StorageFormat::Native)
+                    {
+                        if (!tools::is_float_type(m_item_datatypes[i]))
+                        {
+                            m_error = true;
+                        }
+                        elem_size = tools::get_type_size_char(VariableType::uint16); // Both formats are 16 bits
+                        m_converted_items = true;
+                    }
+
+                    if (options.reduction != ReductionMode::Last)
+                    {
+                        if (options.reduction == ReductionMode::MinMax)
+                        {
+                            elem_size *= 2; // Min then max
+                        }
+                        m_reduction.enabled = true;
+                    }
+                }
 
-                if (elem_size == 0 && !m_error)
+                if (elem_size == 0 && elem_bits == 0 && !m_error)
                 {
                     m_error = true;
                 }
                 else
                 {
+                    uint16_t const decimation = m_config->items_options[i].decimation;
+                    // Size in 1/256 of char. Packed bits are counted individually, the padding is ignored.
+                    uint32_t const elem_size_x256 = (static_cast<uint32_t>(elem_size) << 8) + ((static_cast<uint32_t>(elem_bits) << 8) / CHAR_BIT);
+                    m_variable_entries.item_sizes[i] = static_cast<uint_least8_t>(elem_size);
+                    m_packed_bits.item_bits[i] = static_cast<uint_least8_t>(elem_bits);
                     m_entry_size += elem_size;
+                    total_bitcount += elem_bits;
+                    if (decimation > 1)
+                    {
+                        m_variable_entries.enabled = true;
+                        average_entry_size_x256 += elem_size_x256 / decimation;
+                    }
+                    else
+                    {
+                        average_entry_size_x256 += elem_size_x256;
+                    }
                 }
             }
 
+            m_entry_size += get_packed_bits_size_char(total_bitcount);
+            m_rpv_bulk.enabled =
+                m_rpv_bulk.count > 0 && m_main_handler->get_config_ro()->get_rpv_bulk_read_callback() != SCRUTINY_NULL_FN_PTR(RpvBulkReadCallback);
+
+            if (m_variable_entries.enabled)
+            {
+                // Presence bitmap is made of 8 bits bytes, rounded up to a full char.
+                uint_least8_t const bitmap_size_8bits = static_cast<uint_least8_t>((m_config->items_count + 7) / 8);
+                m_variable_entries.bitmap_size = static_cast<uint_least8_t>((bitmap_size_8bits + (CHAR_BIT / 8) - 1) / (CHAR_BIT / 8));
+                m_entry_size += m_variable_entries.bitmap_size;
+                average_entry_size_x256 += static_cast<uint32_t>(m_variable_entries.bitmap_size) << 8;
+            }
+
+            datalogging::buffer_size_t max_entries = 0;
             if (m_entry_size > 0)
             {
-                m_max_entries = m_buffer_size / m_entry_size;
+                max_entries = m_buffer_size / m_entry_size;
             }
             else
             {
                 m_error = true;
             }
 
-            if (m_max_entries == 0)
+            if (max_entries == 0)
             {
                 m_error = true;
             }
+            else if (external_storage() && m_entry_size > m_storage.cache_size)
+            {
+                m_error = true; // An entry is always written in a single block
+            }
+            else
+            {
+                if (m_variable_entries.enabled && average_entry_size_x256 > 0)
+                {
+                    max_entries = static_cast<datalogging::buffer_size_t>((static_cast<uint32_t>(m_buffer_size) << 8) / average_entry_size_x256);
+                }
+
+                // Spread the checkpoints so that they cover the whole buffer once it wraps.
+                m_implicit_time.interval = max_entries / (SCRUTINY_DATALOGGING_TIME_CHECKPOINTS - 1);
+                if (m_implicit_time.interval == 0)
+                {
+                    m_implicit_time.interval = 1;
+                }
+            }
+
+            // Fixed size entries stop at a multiple of the entry size. Variable entries can use the whole buffer.
+            m_wrap_end = (m_variable_entries.enabled || m_entry_size == 0) ? m_buffer_size : (max_entries * m_entry_size);
             m_reader.reset();
         }
 
@@ -298,5 +911,48 @@ namespace scrutiny
 
             return get_buffer_effective_size() - get_write_cursor();
         }
+
+        datalogging::buffer_size_t RawFormatEncoder::get_data_size(void) const
+        {
+            if (m_entry_count == 0)
+            {
+                return 0;
+            }
+
+            if (m_write_cursor > m_read_cursor)
+            {
+                return m_write_cursor - m_read_cursor;
+            }
+
+            return (m_wrap_end - m_read_cursor) + m_write_cursor;
+        }
+
+        uint_least8_t RawFormatEncoder::get_time_checkpoint_count(void) const
+        {
+            uint32_t const first_entry_counter = get_first_entry_counter();
+            uint32_t const entry_count = static_cast<uint32_t>(get_entry_count());
+            uint_least8_t count = 0;
+            // Checkpoints are kept in chronological order. Only the oldest ones can refer to an entry that has been overwritten.
+            for (uint_least8_t i = 0; i < m_implicit_time.checkpoint_count; i++)
+            {
+                uint_least8_t const index =
+                    static_cast<uint_least8_t>((m_implicit_time.next_checkpoint_index + SCRUTINY_DATALOGGING_TIME_CHECKPOINTS - 1 - i) %
+                                               SCRUTINY_DATALOGGING_TIME_CHECKPOINTS);
+                if (m_implicit_time.checkpoints[index].entry_counter - first_entry_counter >= entry_count) // Wrap safe
+                {
+                    break;
+                }
+                count++;
+            }
+            return count;
+        }
+
+        TimeCheckpoint RawFormatEncoder::get_time_checkpoint(uint_least8_t const index) const
+        {
+            uint_least8_t const count = get_time_checkpoint_count();
+            uint_least8_t const ring_index = static_cast<uint_least8_t>(
+                (m_implicit_time.next_checkpoint_index + SCRUTINY_DATALOGGING_TIME_CHECKPOINTS - count + index) % SCRUTINY_DATALOGGING_TIME_CHECKPOINTS);
+            return m_implicit_time.checkpoints[ring_index];
+        }
     } // namespace datalogging
 } // namespace scrutiny
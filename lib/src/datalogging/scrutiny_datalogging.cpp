@@ -121,7 +121,7 @@ namespace scrutiny
             {
                 RuntimePublishedValue rpv;
                 main_handler->get_rpv(operand->rpv.id, &rpv);
-                success = main_handler->get_rpv_read_callback()(rpv, &val_type_pair->val, caller);
+                success = main_handler->read_rpv(rpv, &val_type_pair->val, caller);
                 val_type_pair->valtype = rpv.type;
             }
             else if (operand->common.type == OperandType::Var)
@@ -151,5 +151,210 @@ namespace scrutiny
 
             return success;
         }
+
+        float_biggest_t read_as_biggest_float(AnyType const &val, VariableType::eVariableType const vtype)
+        {
+            switch (vtype)
+            {
+#if SCRUTINY_SUPPORT_64BITS
+            case VariableType::float64:
+                return static_cast<float_biggest_t>(val.float64);
+            case VariableType::sint64:
+                return static_cast<float_biggest_t>(val.sint64);
+            case VariableType::uint64:
+            case VariableType::boolean64:
+                return static_cast<float_biggest_t>(val.uint64);
+#endif
+            case VariableType::float32:
+                return static_cast<float_biggest_t>(val.float32);
+#if CHAR_BIT == 8
+            case VariableType::sint8:
+                return static_cast<float_biggest_t>(val.sint8);
+            case VariableType::uint8:
+            case VariableType::boolean8:
+                return static_cast<float_biggest_t>(val.uint8);
+#endif
+            case VariableType::sint16:
+                return static_cast<float_biggest_t>(val.sint16);
+            case VariableType::sint32:
+                return static_cast<float_biggest_t>(val.sint32);
+            case VariableType::uint16:
+            case VariableType::boolean16:
+                return static_cast<float_biggest_t>(val.uint16);
+            case VariableType::uint32:
+            case VariableType::boolean32:
+                return static_cast<float_biggest_t>(val.uint32);
+            case VariableType::boolean:
+                return static_cast<float_biggest_t>(val.boolean ? 1 : 0);
+            default:
+                return 0;
+            }
+        }
+
+        uint_biggest_t read_bits_as_biggest_uint(AnyType const &val, VariableType::eVariableType const vtype)
+        {
+            switch (tools::get_type_size_8bits(vtype))
+            {
+#if CHAR_BIT == 8
+            case 1:
+                return static_cast<uint_biggest_t>(val.uint8);
+#endif
+            case 2:
+                return static_cast<uint_biggest_t>(val.uint16);
+            case 4:
+                return static_cast<uint_biggest_t>(val.uint32);
+#if SCRUTINY_SUPPORT_64BITS
+            case 8:
+                return static_cast<uint_biggest_t>(val.uint64);
+#endif
+            default:
+                return 0;
+            }
+        }
+
+        void write_from_biggest_float(float_biggest_t const fval, VariableType::eVariableType const vtype, AnyType *const val)
+        {
+            memset(val, 0, sizeof(AnyType));
+            if (tools::is_float_type(vtype))
+            {
+#if SCRUTINY_SUPPORT_64BITS
+                if (vtype == VariableType::float64)
+                {
+                    val->float64 = static_cast<double>(fval);
+                    return;
+                }
+#endif
+                val->float32 = static_cast<float>(fval);
+                return;
+            }
+
+            uint_least8_t const size_bits = static_cast<uint_least8_t>(tools::get_type_size_8bits(vtype) * 8u);
+            if (size_bits == 0 || size_bits > sizeof(uint_biggest_t) * 8u || fval != fval) // NaN gives 0
+            {
+                return;
+            }
+
+            if (tools::is_sint_type(vtype))
+            {
+                int_biggest_t const max_val = static_cast<int_biggest_t>((static_cast<uint_biggest_t>(1) << (size_bits - 1u)) - 1u);
+                int_biggest_t const min_val = -max_val - 1;
+                float_biggest_t const rounded = (fval >= 0) ? fval + static_cast<float_biggest_t>(0.5) : fval - static_cast<float_biggest_t>(0.5);
+                int_biggest_t ival;
+                if (rounded >= static_cast<float_biggest_t>(max_val)) // Float limit may be rounded up. Never cast it back.
+                {
+                    ival = max_val;
+                }
+                else if (rounded <= static_cast<float_biggest_t>(min_val))
+                {
+                    ival = min_val;
+                }
+                else
+                {
+                    ival = static_cast<int_biggest_t>(rounded);
+                }
+
+                switch (size_bits)
+                {
+#if CHAR_BIT == 8
+                case 8:
+                    val->sint8 = static_cast<int8_t>(ival);
+                    break;
+#endif
+                case 16:
+                    val->sint16 = static_cast<int16_t>(ival);
+                    break;
+                case 32:
+                    val->sint32 = static_cast<int32_t>(ival);
+                    break;
+#if SCRUTINY_SUPPORT_64BITS
+                case 64:
+                    val->sint64 = static_cast<int64_t>(ival);
+                    break;
+#endif
+                default:
+                    break;
+                }
+            }
+            else // uint and boolean
+            {
+                uint_biggest_t const max_val = (size_bits >= sizeof(uint_biggest_t) * 8u) ? static_cast<uint_biggest_t>(-1)
+                                                                                          : (static_cast<uint_biggest_t>(1) << size_bits) - 1u;
+                float_biggest_t const rounded = fval + static_cast<float_biggest_t>(0.5);
+                uint_biggest_t uval;
+                if (rounded <= 0)
+                {
+                    uval = 0;
+                }
+                else if (rounded >= static_cast<float_biggest_t>(max_val))
+                {
+                    uval = max_val;
+                }
+                else
+                {
+                    uval = static_cast<uint_biggest_t>(rounded);
+                }
+
+                switch (size_bits)
+                {
+#if CHAR_BIT == 8
+                case 8:
+                    val->uint8 = static_cast<uint8_t>(uval);
+                    break;
+#endif
+                case 16:
+                    val->uint16 = static_cast<uint16_t>(uval);
+                    break;
+                case 32:
+                    val->uint32 = static_cast<uint32_t>(uval);
+                    break;
+#if SCRUTINY_SUPPORT_64BITS
+                case 64:
+                    val->uint64 = static_cast<uint64_t>(uval);
+                    break;
+#endif
+                default:
+                    break;
+                }
+            }
+        }
+
+        bool value_less_than(AnyType const &a, AnyType const &b, VariableType::eVariableType const vtype)
+        {
+            switch (vtype)
+            {
+#if SCRUTINY_SUPPORT_64BITS
+            case VariableType::float64:
+                return a.float64 < b.float64;
+            case VariableType::sint64:
+                return a.sint64 < b.sint64;
+            case VariableType::uint64:
+            case VariableType::boolean64:
+                return a.uint64 < b.uint64;
+#endif
+            case VariableType::float32:
+                return a.float32 < b.float32;
+#if CHAR_BIT == 8
+            case VariableType::sint8:
+                return a.sint8 < b.sint8;
+            case VariableType::uint8:
+            case VariableType::boolean8:
+                return a.uint8 < b.uint8;
+#endif
+            case VariableType::sint16:
+                return a.sint16 < b.sint16;
+            case VariableType::sint32:
+                return a.sint32 < b.sint32;
+            case VariableType::uint16:
+            case VariableType::boolean16:
+                return a.uint16 < b.uint16;
+            case VariableType::uint32:
+            case VariableType::boolean32:
+                return a.uint32 < b.uint32;
+            case VariableType::boolean:
+                return !a.boolean && b.boolean;
+            default:
+                return false;
+            }
+        }
     } // namespace datalogging
 } // namespace scrutiny
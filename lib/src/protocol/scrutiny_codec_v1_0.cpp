@@ -79,7 +79,9 @@ namespace scrutiny
             }
 #endif
 
-            if (static_cast<uint32_t>(addr_size) + 2u + length_8bits > static_cast<uint16_t>(MAXIMUM_TX_BUFFER_SIZE - m_required_tx_buffer_size))
+            // A single block always fits a regular frame. Only the sum of the blocks can go beyond, with jumbo frames
+            uint32_t const block_size = static_cast<uint32_t>(addr_size) + 2u + length_8bits;
+            if (block_size > MAXIMUM_TX_BUFFER_SIZE || block_size > MAXIMUM_JUMBO_TX_BUFFER_SIZE - m_required_tx_buffer_size)
             {
                 m_invalid = true;
                 m_finished = true;
@@ -335,7 +337,7 @@ namespace scrutiny
         //==============================================================
 
         // =================== Encoders ===============
-        void ResponseEncoderBase::init(Response *const response, uint16_t const max_size)
+        void ResponseEncoderBase::init(Response *const response, uint32_t const max_size)
         {
             m_size_limit = max_size;
             m_buffer = response->data;
@@ -344,35 +346,58 @@ namespace scrutiny
             m_overflow = false;
         }
 
+        void ReadMemoryBlocksResponseEncoder::init(Response *const response, uint32_t const max_size)
+        {
+            ResponseEncoderBase::init(response, max_size);
+            m_last_block_cursor = 0;
+        }
+
         void ReadMemoryBlocksResponseEncoder::write(MemoryBlock8Bits const *const memblock_8bits)
+        {
+            unsigned char *const data = reserve(memblock_8bits);
+            if (data != SCRUTINY_NULL)
+            {
+                tools::memcpy_dilate_8bits_native(data, memblock_8bits->start_address, memblock_8bits->length);
+            }
+        }
+
+        unsigned char *ReadMemoryBlocksResponseEncoder::reserve(MemoryBlock8Bits const *const memblock_8bits)
         {
             SCRUTINY_CONSTEXPR unsigned int addr_size = SIZEOF_8BITS(void *);
 
             if (memblock_8bits->length > MAXIMUM_TX_BUFFER_SIZE - addr_size - 2) // Make sure that the addition below doesn't blow up
             {
                 m_overflow = true;
-                return;
+                return SCRUTINY_NULL;
             }
 
-            if (addr_size + 2 + memblock_8bits->length > static_cast<uint16_t>(m_size_limit - m_cursor))
+            if (addr_size + 2 + memblock_8bits->length > m_size_limit - m_cursor)
             {
                 m_overflow = true;
-                return;
+                return SCRUTINY_NULL;
             }
 
+            m_last_block_cursor = m_cursor;
             m_cursor += codecs::encode_address_big_endian_8bits(memblock_8bits->start_address, &m_buffer[m_cursor]);
             m_cursor += codecs::encode_16_bits_big_endian_8bits(memblock_8bits->length, &m_buffer[m_cursor]);
-            tools::memcpy_dilate_8bits_native(&m_buffer[m_cursor], memblock_8bits->start_address, memblock_8bits->length);
+            unsigned char *const data = &m_buffer[m_cursor];
             m_cursor += memblock_8bits->length;
 
             m_response->data_length = m_cursor;
+            return data;
+        }
+
+        void ReadMemoryBlocksResponseEncoder::discard_last(void)
+        {
+            m_cursor = m_last_block_cursor;
+            m_response->data_length = m_cursor;
         }
 
         void WriteMemoryBlocksResponseEncoder::write(MemoryBlock8Bits const *const memblock_8bits)
         {
             SCRUTINY_CONSTEXPR unsigned int addr_size = SIZEOF_8BITS(void *);
 
-            if (addr_size + 2u > static_cast<uint16_t>(m_size_limit - m_cursor))
+            if (addr_size + 2u > m_size_limit - m_cursor)
             {
                 m_overflow = true;
                 return;
@@ -380,13 +405,13 @@ namespace scrutiny
 
             m_cursor += codecs::encode_address_big_endian_8bits(memblock_8bits->start_address, &m_buffer[m_cursor]);
             m_cursor += codecs::encode_16_bits_big_endian_8bits(memblock_8bits->length, &m_buffer[m_cursor]);
-            m_response->data_length = static_cast<uint16_t>(m_cursor);
+            m_response->data_length = m_cursor;
         }
 
         void GetRPVDefinitionResponseEncoder::write(RuntimePublishedValue const *const rpv)
         {
             // id (2) + type (1) + address size (2,4,8)
-            if (2u + 1u > static_cast<uint16_t>(m_size_limit - m_cursor))
+            if (2u + 1u > m_size_limit - m_cursor)
             {
                 m_overflow = true;
                 return;
@@ -405,11 +430,17 @@ namespace scrutiny
             m_response->data_length = m_cursor;
         }
 
+        void ReadRPVResponseEncoder::init(Response *const response, uint16_t const max_size, bool const native_endian)
+        {
+            ResponseEncoderBase::init(response, max_size);
+            m_native_endian = native_endian;
+        }
+
         void ReadRPVResponseEncoder::write(RuntimePublishedValue const *const rpv, AnyType const v)
         {
             uint_least8_t const typesize = tools::get_type_size_8bits(rpv->type);
             // id (2) + type (1)
-            if (2u + typesize > static_cast<uint16_t>(m_size_limit - m_cursor))
+            if (2u + typesize > m_size_limit - m_cursor)
             {
                 m_overflow = true;
                 return;
@@ -426,7 +457,14 @@ namespace scrutiny
             )
             {
                 m_cursor += codecs::encode_16_bits_big_endian_8bits(rpv->id, &m_buffer[m_cursor]);
-                m_cursor += codecs::encode_anytype_big_endian_8bits(&v, typesize, &m_buffer[m_cursor]);
+                if (m_native_endian)
+                {
+                    m_cursor += codecs::encode_anytype_native_8bits(&v, typesize, &m_buffer[m_cursor]);
+                }
+                else
+                {
+                    m_cursor += codecs::encode_anytype_big_endian_8bits(&v, typesize, &m_buffer[m_cursor]);
+                }
                 m_response->data_length = m_cursor;
             }
         }
@@ -435,7 +473,7 @@ namespace scrutiny
         {
             uint_least8_t const typesize = tools::get_type_size_8bits(rpv->type);
             // id (2) + datalen (1)
-            if (2u + 1u > static_cast<uint16_t>(m_size_limit - m_cursor))
+            if (2u + 1u > m_size_limit - m_cursor)
             {
                 m_overflow = true;
                 return;
@@ -535,7 +573,9 @@ namespace scrutiny
             }
 
             response->data[0] = (response_data->memory_write ? 0x80u : 0u) | (response_data->datalogging ? 0x40u : 0u) |
-                                (response_data->user_command ? 0x20u : 0u) | (response_data->_64bits ? 0x10u : 0u);
+                                (response_data->user_command ? 0x20u : 0u) | (response_data->_64bits ? 0x10u : 0u) |
+                                (response_data->native_endian ? 0x08u : 0u) | (response_data->compression ? 0x04u : 0u) |
+                                (response_data->memory_watch ? 0x02u : 0u) | (response_data->statistics ? 0x01u : 0u);
 
             response->data_length = 1;
             return ResponseCode::OK;
@@ -622,7 +662,7 @@ namespace scrutiny
             switch (static_cast<scrutiny::LoopType::eLoopType>(response_data->loop_type))
             {
             case scrutiny::LoopType::FIXED_FREQ:
-                if (cursor + timestep_100ns_size > response->data_max_length)
+                if (static_cast<uint32_t>(cursor) + timestep_100ns_size > response->data_max_length)
                 {
                     return ResponseCode::Overflow;
                 }
@@ -638,7 +678,7 @@ namespace scrutiny
             uint_least8_t loop_name_length = response_data->loop_name_length;
             loop_name_length = (loop_name_length > MAX_LOOP_NAME_LENGTH) ? MAX_LOOP_NAME_LENGTH : loop_name_length;
 
-            if (cursor + name_length_size + loop_name_length > response->data_max_length)
+            if (static_cast<uint32_t>(cursor) + name_length_size + loop_name_length > response->data_max_length)
             {
                 return ResponseCode::Overflow;
             }
@@ -684,6 +724,22 @@ namespace scrutiny
             return ResponseCode::OK;
         }
 
+        ResponseCode::eResponseCode CodecV1_0::encode_response_get_config_fingerprint(
+            ResponseData::GetInfo::GetConfigFingerprint const *const response_data,
+            Response *const response)
+        {
+            SCRUTINY_CONSTEXPR uint16_t fingerprint_size = 4;
+            SCRUTINY_CONSTEXPR uint16_t datalen = fingerprint_size;
+            if (datalen > MINIMUM_TX_BUFFER_SIZE && datalen > response->data_max_length)
+            {
+                return ResponseCode::Overflow;
+            }
+
+            codecs::encode_32_bits_big_endian_8bits(response_data->fingerprint, &response->data[0]);
+            response->data_length = datalen;
+            return ResponseCode::OK;
+        }
+
         // ============================ CommunicationControl ============================
 
         ResponseCode::eResponseCode CodecV1_0::encode_response_comm_discover(
@@ -751,8 +807,11 @@ namespace scrutiny
             SCRUTINY_CONSTEXPR uint16_t comm_rx_timeout_size = 4;
             SCRUTINY_CONSTEXPR uint16_t address_size_size = 1;
             SCRUTINY_CONSTEXPR uint16_t char_bit_size = 1;
-            SCRUTINY_CONSTEXPR uint16_t datalen = rx_buffer_size_len + tx_buffer_size_len + max_bitrate_size + heartbeat_timeout_size +
-                                                  comm_rx_timeout_size + address_size_size + char_bit_size;
+            SCRUTINY_CONSTEXPR uint16_t jumbo_tx_buffer_size_len = 4;
+            SCRUTINY_CONSTEXPR uint16_t base_datalen = rx_buffer_size_len + tx_buffer_size_len + max_bitrate_size + heartbeat_timeout_size +
+                                                       comm_rx_timeout_size + address_size_size + char_bit_size;
+            bool const has_jumbo = response_data->jumbo_tx_buffer_size != 0;
+            uint16_t const datalen = base_datalen + (has_jumbo ? jumbo_tx_buffer_size_len : 0);
 
             SCRUTINY_CONSTEXPR uint16_t rx_buffer_size_pos = 0;
             SCRUTINY_CONSTEXPR uint16_t tx_buffer_size_pos = rx_buffer_size_pos + rx_buffer_size_len;
@@ -761,6 +820,7 @@ namespace scrutiny
             SCRUTINY_CONSTEXPR uint16_t comm_rx_timeout_pos = heartbeat_timeout_pos + heartbeat_timeout_size;
             SCRUTINY_CONSTEXPR uint16_t address_size_pos = comm_rx_timeout_pos + comm_rx_timeout_size;
             SCRUTINY_CONSTEXPR uint16_t char_bit_pos = address_size_pos + address_size_size;
+            SCRUTINY_CONSTEXPR uint16_t jumbo_tx_buffer_size_pos = char_bit_pos + char_bit_size;
 
             if (datalen > MINIMUM_TX_BUFFER_SIZE && datalen > response->data_max_length)
             {
@@ -776,6 +836,10 @@ namespace scrutiny
             codecs::encode_32_bits_big_endian_8bits(response_data->comm_rx_timeout, &response->data[comm_rx_timeout_pos]);
             codecs::encode_8_bits_8bits(response_data->address_size, &response->data[address_size_pos]);
             codecs::encode_8_bits_8bits(response_data->char_bit, &response->data[char_bit_pos]);
+            if (has_jumbo) // Older servers never see this field, as they do not ask for jumbo frames
+            {
+                codecs::encode_32_bits_big_endian_8bits(response_data->jumbo_tx_buffer_size, &response->data[jumbo_tx_buffer_size_pos]);
+            }
 
             return ResponseCode::OK;
         }
@@ -786,7 +850,8 @@ namespace scrutiny
         {
             SCRUTINY_CONSTEXPR uint16_t magic_size = sizeof(response_data->magic);
             SCRUTINY_CONSTEXPR uint16_t session_id_size = 4;
-            SCRUTINY_CONSTEXPR uint16_t datalen = magic_size + session_id_size;
+            SCRUTINY_CONSTEXPR uint16_t flags_size = 1;
+            uint16_t const datalen = magic_size + session_id_size + (response_data->has_flags ? flags_size : 0);
 
             SCRUTINY_STATIC_ASSERT(
                 sizeof(response_data->magic) == sizeof(CommControl::CONNECT_MAGIC),
@@ -799,6 +864,10 @@ namespace scrutiny
             response->data_length = datalen;
             memcpy(&response->data[0], response_data->magic, magic_size); // No need to dilate, array not packed
             codecs::encode_32_bits_big_endian_8bits(response_data->session_id, &response->data[magic_size]);
+            if (response_data->has_flags)
+            {
+                codecs::encode_8_bits_8bits(response_data->flags, &response->data[magic_size + session_id_size]);
+            }
 
             return ResponseCode::OK;
         }
@@ -849,14 +918,17 @@ namespace scrutiny
             RequestData::CommControl::Connect *const request_data)
         {
             SCRUTINY_CONSTEXPR uint16_t magic_size = sizeof(CommControl::CONNECT_MAGIC);
-            SCRUTINY_CONSTEXPR uint16_t datalen = magic_size;
+            SCRUTINY_CONSTEXPR uint16_t flags_size = 1;
 
-            if (request->data_length != datalen)
+            // The flags byte is optional so that servers that do not know about it can still connect.
+            if (request->data_length != magic_size && request->data_length != magic_size + flags_size)
             {
                 return ResponseCode::InvalidRequest;
             }
 
             memcpy(request_data->magic, request->data, magic_size); // No need to dilate, array not packed
+            request_data->has_flags = (request->data_length == magic_size + flags_size);
+            request_data->flags = request_data->has_flags ? request->data[magic_size] : 0u;
 
             return ResponseCode::OK;
         }
@@ -933,17 +1005,54 @@ namespace scrutiny
             SCRUTINY_CONSTEXPR uint16_t datalen =
                 acquisition_id_size + config_id_size + number_of_points_size + data_size_size + points_after_trigger_size;
 
+            SCRUTINY_CONSTEXPR uint16_t storage_item_size = 1 + 1 + 2 * SIZEOF_8BITS(float); // index, format, scale, offset
+
             if (datalen > MINIMUM_TX_BUFFER_SIZE && datalen > response->data_max_length)
             {
                 return ResponseCode::Overflow;
             }
 
+            // Items stored in a reduced precision format are listed at the end with their conversion parameters. Nothing if all are native.
+            uint_least8_t converted_count = 0;
+            datalogging::Configuration const *const config = response_data->config;
+            if (config != SCRUTINY_NULL)
+            {
+                for (uint_fast8_t i = 0; i < config->items_count; i++)
+                {
+                    if (config->items_options[i].storage != datalogging::StorageFormat::Native)
+                    {
+                        converted_count++;
+                    }
+                }
+            }
+
+            if (converted_count > 0 && static_cast<uint32_t>(datalen) + 1 + converted_count * storage_item_size > response->data_max_length)
+            {
+                return ResponseCode::Overflow;
+            }
+
             uint16_t cursor = 0;
             cursor += codecs::encode_16_bits_big_endian_8bits(response_data->acquisition_id, &response->data[cursor]);
             cursor += codecs::encode_16_bits_big_endian_8bits(response_data->config_id, &response->data[cursor]);
             cursor += codecs::encode_32_bits_big_endian_8bits(response_data->number_of_points, &response->data[cursor]);
             cursor += codecs::encode_32_bits_big_endian_8bits(response_data->data_size, &response->data[cursor]);
             cursor += codecs::encode_32_bits_big_endian_8bits(response_data->points_after_trigger, &response->data[cursor]);
+
+            if (converted_count > 0)
+            {
+                cursor += codecs::encode_8_bits_8bits(converted_count, &response->data[cursor]);
+                for (uint_fast8_t i = 0; i < config->items_count; i++)
+                {
+                    datalogging::LoggableItemOptions const &options = config->items_options[i];
+                    if (options.storage != datalogging::StorageFormat::Native)
+                    {
+                        cursor += codecs::encode_8_bits_8bits(static_cast<uint_least8_t>(i), &response->data[cursor]);
+                        cursor += codecs::encode_8_bits_8bits(static_cast<uint_least8_t>(options.storage), &response->data[cursor]);
+                        cursor += codecs::encode_float_big_endian_8bits(options.scale, &response->data[cursor]);
+                        cursor += codecs::encode_float_big_endian_8bits(options.offset, &response->data[cursor]);
+                    }
+                }
+            }
             response->data_length = cursor;
 
             return ResponseCode::OK;
@@ -964,8 +1073,10 @@ namespace scrutiny
             codecs::encode_8_bits_8bits(response_data->rolling_counter, &response->data[1]);
             codecs::encode_16_bits_big_endian_8bits(response_data->acquisition_id, &response->data[2]);
 
-            uint32_t const nread = response_data->reader->read_dilate_8bits(&response->data[4], response->data_max_length - 4);
-            response->data_length = static_cast<uint16_t>(nread + 4);
+            // The acquisition buffer cannot be bigger than what buffer_size_t can count. Only matters with jumbo frames
+            uint32_t const max_read = SCRUTINY_MIN(response->data_max_length - 4, static_cast<datalogging::buffer_size_t>(-1));
+            uint32_t const nread = response_data->reader->read_dilate_8bits(&response->data[4], static_cast<datalogging::buffer_size_t>(max_read));
+            response->data_length = nread + 4;
             *response_data->crc = tools::crc32(&response->data[4], nread, *response_data->crc);
 
             if (response_data->reader->finished() && response->data_length <= response->data_max_length - 4)
@@ -980,6 +1091,111 @@ namespace scrutiny
             return protocol::ResponseCode::OK;
         }
 
+        ResponseCode::eResponseCode CodecV1_0::encode_response_datalogging_get_time_axis(
+            ResponseData::DataLogControl::GetTimeAxis const *const response_data,
+            Response *const response)
+        {
+            SCRUTINY_CONSTEXPR uint16_t timestep_size = 4;
+            SCRUTINY_CONSTEXPR uint16_t decimation_size = 2;
+            SCRUTINY_CONSTEXPR uint16_t trigger_timestamp_size = 4;
+            SCRUTINY_CONSTEXPR uint16_t first_entry_counter_size = 4;
+            SCRUTINY_CONSTEXPR uint16_t checkpoint_count_size = 1;
+            SCRUTINY_CONSTEXPR uint16_t checkpoint_size = 4 + 4;
+
+            uint_least8_t const checkpoint_count = response_data->encoder->get_time_checkpoint_count();
+            uint16_t const datalen = timestep_size + decimation_size + trigger_timestamp_size + first_entry_counter_size + checkpoint_count_size +
+                                     static_cast<uint16_t>(checkpoint_count * checkpoint_size);
+
+            if (datalen > response->data_max_length)
+            {
+                return ResponseCode::Overflow;
+            }
+
+            uint16_t cursor = 0;
+            cursor += codecs::encode_32_bits_big_endian_8bits(response_data->timestep_100ns, &response->data[cursor]);
+            cursor += codecs::encode_16_bits_big_endian_8bits(response_data->decimation, &response->data[cursor]);
+            cursor += codecs::encode_32_bits_big_endian_8bits(response_data->trigger_timestamp, &response->data[cursor]);
+            cursor += codecs::encode_32_bits_big_endian_8bits(response_data->first_entry_counter, &response->data[cursor]);
+            cursor += codecs::encode_8_bits_8bits(checkpoint_count, &response->data[cursor]);
+            for (uint_least8_t i = 0; i < checkpoint_count; i++)
+            {
+                datalogging::TimeCheckpoint const checkpoint = response_data->encoder->get_time_checkpoint(i);
+                cursor += codecs::encode_32_bits_big_endian_8bits(checkpoint.entry_counter, &response->data[cursor]);
+                cursor += codecs::encode_32_bits_big_endian_8bits(checkpoint.timestamp, &response->data[cursor]);
+            }
+            response->data_length = cursor;
+
+            return ResponseCode::OK;
+        }
+
+        ResponseCode::eResponseCode CodecV1_0::decode_datalogging_operand(
+            Request const *const request,
+            uint16_t *const cursor,
+            datalogging::Operand *const operand) const
+        {
+            if (request->data_length < *cursor + 1)
+            {
+                return ResponseCode::InvalidRequest;
+            }
+
+            const datalogging::OperandType::eOperandType optype = static_cast<datalogging::OperandType::eOperandType>(request->data[*cursor]);
+            operand->common.type = optype;
+            (*cursor)++;
+
+            switch (optype)
+            {
+            case datalogging::OperandType::Literal:
+            {
+                if (request->data_length < *cursor + SIZEOF_8BITS(float))
+                {
+                    return ResponseCode::InvalidRequest;
+                }
+                operand->literal.val = codecs::decode_float_big_endian_8bits(&request->data[*cursor]);
+                *cursor += SIZEOF_8BITS(float);
+                break;
+            }
+            case datalogging::OperandType::Rpv:
+            {
+                if (request->data_length < *cursor + SIZEOF_8BITS(uint16_t))
+                {
+                    return ResponseCode::InvalidRequest;
+                }
+                operand->rpv.id = codecs::decode_16_bits_big_endian_8bits(&request->data[*cursor]);
+                *cursor += SIZEOF_8BITS(uint16_t);
+                break;
+            }
+            case datalogging::OperandType::Var:
+            {
+                if (request->data_length < *cursor + 1 + SIZEOF_8BITS(void *))
+                {
+                    return ResponseCode::InvalidRequest;
+                }
+                operand->var.datatype = static_cast<scrutiny::VariableType::eVariableType>(request->data[(*cursor)++]);
+                *cursor += codecs::decode_address_big_endian_8bits(&request->data[*cursor], reinterpret_cast<uintptr_t *>(&operand->var.addr));
+                break;
+            }
+            case datalogging::OperandType::VarBit:
+            {
+                if (request->data_length < *cursor + 3 + SIZEOF_8BITS(void *))
+                {
+                    return ResponseCode::InvalidRequest;
+                }
+
+                operand->varbit.datatype = static_cast<scrutiny::VariableType::eVariableType>(request->data[(*cursor)++]);
+                *cursor += codecs::decode_address_big_endian_8bits(&request->data[*cursor], reinterpret_cast<uintptr_t *>(&operand->varbit.addr));
+                operand->varbit.bitoffset = request->data[(*cursor)++] & 0xFF;
+                operand->varbit.bitsize = request->data[(*cursor)++] & 0xFF;
+                break;
+            }
+            default:
+            {
+                return ResponseCode::InvalidRequest;
+            }
+            }
+
+            return ResponseCode::OK;
+        }
+
         ResponseCode::eResponseCode CodecV1_0::decode_datalogging_configure_request(
             Request const *const request,
             RequestData::DataLogControl::Configure *const request_data,
@@ -1007,63 +1223,157 @@ namespace scrutiny
 
             uint16_t cursor = 16;
             for (uint_fast8_t i = 0; i < config->trigger.operand_count; i++)
+            {
+                ResponseCode::eResponseCode const code = decode_datalogging_operand(request, &cursor, &config->trigger.operands[i]);
+                if (code != ResponseCode::OK)
+                {
+                    return code;
+                }
+            }
+
+            if (request->data_length < cursor + 1)
+            {
+                return ResponseCode::InvalidRequest;
+            }
+
+            config->items_count = request->data[cursor++] & 0xFF;
+
+            if (config->items_count > SCRUTINY_DATALOGGING_MAX_SIGNAL)
+            {
+                return ResponseCode::Overflow;
+            }
+
+            for (uint_fast8_t i = 0; i < config->items_count; i++)
             {
                 if (request->data_length < cursor + 1)
                 {
                     return ResponseCode::InvalidRequest;
                 }
 
-                const datalogging::OperandType::eOperandType optype = static_cast<datalogging::OperandType::eOperandType>(request->data[cursor]);
-                config->trigger.operands[i].common.type = optype;
-                cursor++;
+                config->items_to_log[i].common.type = static_cast<datalogging::LoggableType::eLoggableType>(request->data[cursor++]);
 
-                switch (optype)
+                switch (config->items_to_log[i].common.type)
                 {
-                case datalogging::OperandType::Literal:
+                case datalogging::LoggableType::Memory:
                 {
-                    if (request->data_length < cursor + SIZEOF_8BITS(float))
+                    if (request->data_length < cursor + SIZEOF_8BITS(void *) + 1)
                     {
                         return ResponseCode::InvalidRequest;
                     }
-                    config->trigger.operands[i].literal.val = codecs::decode_float_big_endian_8bits(&request->data[cursor]);
-                    cursor += SIZEOF_8BITS(float);
+                    cursor += codecs::decode_address_big_endian_8bits(
+                        &request->data[cursor],
+                        reinterpret_cast<uintptr_t *>(&config->items_to_log[i].memory.address));
+                    config->items_to_log[i].memory.size = request->data[cursor++];
                     break;
                 }
-                case datalogging::OperandType::Rpv:
+                case datalogging::LoggableType::Rpv:
                 {
                     if (request->data_length < cursor + SIZEOF_8BITS(uint16_t))
                     {
                         return ResponseCode::InvalidRequest;
                     }
-                    config->trigger.operands[i].rpv.id = codecs::decode_16_bits_big_endian_8bits(&request->data[cursor]);
+
+                    config->items_to_log[i].rpv.id = codecs::decode_16_bits_big_endian_8bits(&request->data[cursor]);
                     cursor += SIZEOF_8BITS(uint16_t);
                     break;
                 }
-                case datalogging::OperandType::Var:
+                case datalogging::LoggableType::MemoryBit:
                 {
-                    if (request->data_length < cursor + 1 + SIZEOF_8BITS(void *))
+                    if (request->data_length < cursor + 1 + SIZEOF_8BITS(void *) + 2)
                     {
                         return ResponseCode::InvalidRequest;
                     }
-                    config->trigger.operands[i].var.datatype = static_cast<scrutiny::VariableType::eVariableType>(request->data[cursor++]);
+                    config->items_to_log[i].memorybit.datatype = static_cast<scrutiny::VariableType::eVariableType>(request->data[cursor++]);
                     cursor += codecs::decode_address_big_endian_8bits(
                         &request->data[cursor],
-                        reinterpret_cast<uintptr_t *>(&config->trigger.operands[i].var.addr));
+                        reinterpret_cast<uintptr_t *>(&config->items_to_log[i].memorybit.address));
+                    config->items_to_log[i].memorybit.bitoffset = request->data[cursor++] & 0xFF;
+                    config->items_to_log[i].memorybit.bitsize = request->data[cursor++] & 0xFF;
                     break;
                 }
-                case datalogging::OperandType::VarBit:
+                case datalogging::LoggableType::Time:
+                case datalogging::LoggableType::ImplicitTime:
                 {
-                    if (request->data_length < cursor + 3 + SIZEOF_8BITS(void *))
+                    break;
+                }
+                default:
+                {
+                    return ResponseCode::InvalidRequest;
+                }
+                }
+            }
+
+            config->clear_items_options();
+            config->double_buffering = false;
+            bool datatypes_given = false; // ItemReduction and ItemStorage both carry the item datatypes. They must agree
+            while (cursor < request->data_length)
+            {
+                DataLogControl::ConfigureExtension::eConfigureExtension const extension =
+                    static_cast<DataLogControl::ConfigureExtension::eConfigureExtension>(request->data[cursor++]);
+
+                switch (extension)
+                {
+                case DataLogControl::ConfigureExtension::ItemDecimation:
+                {
+                    if (request->data_length < cursor + config->items_count * SIZEOF_8BITS(uint16_t))
                     {
                         return ResponseCode::InvalidRequest;
                     }
 
-                    config->trigger.operands[i].varbit.datatype = static_cast<scrutiny::VariableType::eVariableType>(request->data[cursor++]);
-                    cursor += codecs::decode_address_big_endian_8bits(
-                        &request->data[cursor],
-                        reinterpret_cast<uintptr_t *>(&config->trigger.operands[i].varbit.addr));
-                    config->trigger.operands[i].varbit.bitoffset = request->data[cursor++] & 0xFF;
-                    config->trigger.operands[i].varbit.bitsize = request->data[cursor++] & 0xFF;
+                    for (uint_fast8_t i = 0; i < config->items_count; i++)
+                    {
+                        config->items_options[i].decimation = codecs::decode_16_bits_big_endian_8bits(&request->data[cursor]);
+                        cursor += SIZEOF_8BITS(uint16_t);
+                    }
+                    break;
+                }
+                case DataLogControl::ConfigureExtension::ItemReduction:
+                {
+                    if (request->data_length < cursor + config->items_count * 2u)
+                    {
+                        return ResponseCode::InvalidRequest;
+                    }
+
+                    for (uint_fast8_t i = 0; i < config->items_count; i++)
+                    {
+                        config->items_options[i].reduction = static_cast<datalogging::ReductionMode::eReductionMode>(request->data[cursor++]);
+                        VariableType::eVariableType const datatype = static_cast<VariableType::eVariableType>(request->data[cursor++]);
+                        if (datatypes_given && config->items_options[i].datatype != datatype)
+                        {
+                            return ResponseCode::InvalidRequest;
+                        }
+                        config->items_options[i].datatype = datatype;
+                    }
+                    datatypes_given = true;
+                    break;
+                }
+                case DataLogControl::ConfigureExtension::ItemStorage:
+                {
+                    if (request->data_length < cursor + config->items_count * (2u + 2u * SIZEOF_8BITS(float)))
+                    {
+                        return ResponseCode::InvalidRequest;
+                    }
+
+                    for (uint_fast8_t i = 0; i < config->items_count; i++)
+                    {
+                        config->items_options[i].storage = static_cast<datalogging::StorageFormat::eStorageFormat>(request->data[cursor++]);
+                        VariableType::eVariableType const datatype = static_cast<VariableType::eVariableType>(request->data[cursor++]);
+                        if (datatypes_given && config->items_options[i].datatype != datatype)
+                        {
+                            return ResponseCode::InvalidRequest;
+                        }
+                        config->items_options[i].datatype = datatype;
+                        config->items_options[i].scale = codecs::decode_float_big_endian_8bits(&request->data[cursor]);
+                        cursor += SIZEOF_8BITS(float);
+                        config->items_options[i].offset = codecs::decode_float_big_endian_8bits(&request->data[cursor]);
+                        cursor += SIZEOF_8BITS(float);
+                    }
+                    datatypes_given = true;
+                    break;
+                }
+                case DataLogControl::ConfigureExtension::DoubleBuffering:
+                {
+                    config->double_buffering = true;
                     break;
                 }
                 default:
@@ -1073,61 +1383,88 @@ namespace scrutiny
                 }
             }
 
-            if (request->data_length < cursor + 1)
+            if (cursor != request->data_length)
             {
                 return ResponseCode::InvalidRequest;
             }
 
-            config->items_count = request->data[cursor++] & 0xFF;
+            return ResponseCode::OK;
+        }
+#endif
 
-            if (config->items_count > SCRUTINY_DATALOGGING_MAX_SIGNAL)
+#if SCRUTINY_ENABLE_STATISTICS
+        ResponseCode::eResponseCode CodecV1_0::encode_response_statistics_get_setup(
+            ResponseData::Statistics::GetSetup const *const response_data,
+            Response *const response)
+        {
+            SCRUTINY_CONSTEXPR uint16_t datalen = 1 + 1;
+            if (datalen > MINIMUM_TX_BUFFER_SIZE && datalen > response->data_max_length)
             {
                 return ResponseCode::Overflow;
             }
+            uint16_t cursor = 0;
+            cursor += codecs::encode_8_bits_8bits(response_data->channel_count, &response->data[cursor]);
+            cursor += codecs::encode_8_bits_8bits(response_data->max_bin_count, &response->data[cursor]);
+            response->data_length = cursor;
 
-            for (uint_fast8_t i = 0; i < config->items_count; i++)
+            return ResponseCode::OK;
+        }
+
+        ResponseCode::eResponseCode CodecV1_0::decode_statistics_configure_request(
+            Request const *const request,
+            RequestData::Statistics::Configure *const request_data,
+            statistics::Channel *const channels,
+            uint_least8_t const capacity)
+        {
+            if (request->data_length < 2)
             {
-                if (request->data_length < cursor + 1)
-                {
-                    return ResponseCode::InvalidRequest;
-                }
+                return ResponseCode::InvalidRequest;
+            }
 
-                config->items_to_log[i].common.type = static_cast<datalogging::LoggableType::eLoggableType>(request->data[cursor++]);
+            request_data->loop_id = request->data[0] & 0xFF;
+            request_data->channel_count = request->data[1] & 0xFF;
 
-                switch (config->items_to_log[i].common.type)
-                {
-                case datalogging::LoggableType::Memory:
+            if (request_data->channel_count > capacity)
+            {
+                return ResponseCode::Overflow;
+            }
+
+            uint16_t cursor = 2;
+            for (uint_least8_t i = 0; i < request_data->channel_count; i++)
+            {
+                statistics::Channel *const channel = &channels[i];
+                ResponseCode::eResponseCode const code = decode_datalogging_operand(request, &cursor, &channel->operand);
+                if (code != ResponseCode::OK)
                 {
-                    if (request->data_length < cursor + SIZEOF_8BITS(void *) + 1)
-                    {
-                        return ResponseCode::InvalidRequest;
-                    }
-                    cursor += codecs::decode_address_big_endian_8bits(
-                        &request->data[cursor],
-                        reinterpret_cast<uintptr_t *>(&config->items_to_log[i].memory.address));
-                    config->items_to_log[i].memory.size = request->data[cursor++];
-                    break;
+                    return code;
                 }
-                case datalogging::LoggableType::Rpv:
+
+                if (channel->operand.common.type == datalogging::OperandType::Literal) // Nothing to monitor
                 {
-                    if (request->data_length < cursor + SIZEOF_8BITS(uint16_t))
-                    {
-                        return ResponseCode::InvalidRequest;
-                    }
+                    return ResponseCode::InvalidRequest;
+                }
 
-                    config->items_to_log[i].rpv.id = codecs::decode_16_bits_big_endian_8bits(&request->data[cursor]);
-                    cursor += SIZEOF_8BITS(uint16_t);
-                    break;
+                if (request->data_length < cursor + 1 + 2 * SIZEOF_8BITS(float))
+                {
+                    return ResponseCode::InvalidRequest;
                 }
-                case datalogging::LoggableType::Time:
+
+                channel->bin_count = request->data[cursor++] & 0xFF;
+                channel->histogram_min = codecs::decode_float_big_endian_8bits(&request->data[cursor]);
+                cursor += SIZEOF_8BITS(float);
+                channel->histogram_max = codecs::decode_float_big_endian_8bits(&request->data[cursor]);
+                cursor += SIZEOF_8BITS(float);
+
+                if (channel->bin_count > statistics::MAX_BINS)
                 {
-                    break;
+                    return ResponseCode::Overflow;
                 }
-                default:
+
+                // Written that way so that NaN bounds are refused
+                if (channel->bin_count > 0 && !(channel->histogram_max > channel->histogram_min))
                 {
                     return ResponseCode::InvalidRequest;
                 }
-                }
             }
 
             if (cursor != request->data_length)
@@ -1137,6 +1474,173 @@ namespace scrutiny
 
             return ResponseCode::OK;
         }
+
+        ResponseCode::eResponseCode CodecV1_0::encode_response_statistics_read(
+            statistics::StatisticsEngine const *const statistics,
+            Response *const response)
+        {
+            SCRUTINY_CONSTEXPR uint16_t channel_header_size = 4 + 4 * SIZEOF_8BITS(float) + 1; // count, min, max, mean, mean square, bin count
+            uint16_t datalen = 1;
+            for (uint_least8_t i = 0; i < statistics->channel_count(); i++)
+            {
+                datalen = static_cast<uint16_t>(datalen + channel_header_size + 4 * statistics->channel(i)->bin_count);
+            }
+
+            if (datalen > response->data_max_length)
+            {
+                return ResponseCode::Overflow;
+            }
+
+            uint16_t cursor = 0;
+            cursor += codecs::encode_8_bits_8bits(statistics->channel_count(), &response->data[cursor]);
+            for (uint_least8_t i = 0; i < statistics->channel_count(); i++)
+            {
+                statistics::Channel const *const channel = statistics->channel(i);
+                statistics::Accumulator const *const acc = &channel->snapshot;
+                cursor += codecs::encode_32_bits_big_endian_8bits(acc->count, &response->data[cursor]);
+                cursor += codecs::encode_float_big_endian_8bits(static_cast<float>(acc->min), &response->data[cursor]);
+                cursor += codecs::encode_float_big_endian_8bits(static_cast<float>(acc->max), &response->data[cursor]);
+                cursor += codecs::encode_float_big_endian_8bits(static_cast<float>(acc->mean), &response->data[cursor]);
+                cursor += codecs::encode_float_big_endian_8bits(static_cast<float>(acc->mean_square), &response->data[cursor]);
+                cursor += codecs::encode_8_bits_8bits(channel->bin_count, &response->data[cursor]);
+                for (uint_least8_t bin = 0; bin < channel->bin_count; bin++)
+                {
+                    cursor += codecs::encode_32_bits_big_endian_8bits(acc->bins[bin], &response->data[cursor]);
+                }
+            }
+            response->data_length = cursor;
+
+            return ResponseCode::OK;
+        }
 #endif
+
+        void PayloadCompressor::init(Response *const response, unsigned char *const work_buffer, uint16_t const work_buffer_size)
+        {
+            reset();
+            m_response = response;
+            m_work_buffer = work_buffer;
+            if (response->data_length == 0 || response->data_length > 0xFFFF) // Jumbo payloads are sent as is
+            {
+                m_finished = true;
+                return;
+            }
+            m_length = static_cast<uint16_t>(response->data_length);
+            m_max_size = SCRUTINY_MIN(work_buffer_size, static_cast<uint16_t>(m_length - 1)); // Not worth it unless at least one byte is saved
+        }
+
+        void PayloadCompressor::reset(void)
+        {
+            m_response = SCRUTINY_NULL;
+            m_work_buffer = SCRUTINY_NULL;
+            m_length = 0;
+            m_max_size = 0;
+            m_in = 0;
+            m_out = 0;
+            m_flags_pos = 0;
+            m_item = 8;
+            m_finished = false;
+            m_compressed = false;
+            memset(m_chain_heads, 0, sizeof(m_chain_heads));
+        }
+
+        bool PayloadCompressor::process(uint16_t const max_items)
+        {
+            unsigned char const *const src = m_response->data;
+            for (uint16_t n = 0; n < max_items && !m_finished; n++)
+            {
+                if (m_in >= m_length)
+                {
+                    memcpy(m_response->data, m_work_buffer, m_out);
+                    m_response->data_length = m_out;
+                    m_response->subfunction_id = static_cast<uint_least8_t>(m_response->subfunction_id | COMPRESSED_PAYLOAD_FLAG);
+                    m_compressed = true;
+                    m_finished = true;
+                    break;
+                }
+
+                if (m_item == 8)
+                {
+                    if (m_out >= m_max_size)
+                    {
+                        m_finished = true;
+                        break;
+                    }
+                    m_flags_pos = m_out;
+                    m_work_buffer[m_out++] = 0;
+                    m_item = 0;
+                }
+
+                // Only the previous positions with the same hash are compared, the closest first. A match can overlap the data
+                // being encoded, so a run of identical bytes is a single match.
+                uint16_t const max_length = SCRUTINY_MIN(static_cast<uint16_t>(m_length - m_in), COMPRESSION_MAX_MATCH);
+                uint16_t best_length = 0;
+                uint16_t best_offset = 0;
+                if (max_length >= COMPRESSION_MIN_MATCH)
+                {
+                    insert(m_in);
+                    uint16_t offset = 0;
+                    for (uint_least8_t i = 0; i < COMPRESSION_MAX_CANDIDATES && best_length < max_length; i++)
+                    {
+                        uint_least8_t const link = m_chain_links[(m_in - offset) % COMPRESSION_WINDOW_SIZE];
+                        offset = static_cast<uint16_t>(offset + link);
+                        if (link == 0 || offset >= COMPRESSION_WINDOW_SIZE)
+                        {
+                            break; // Links of the positions out of the window are overwritten
+                        }
+
+                        unsigned char const *const candidate = &src[m_in - offset];
+                        if (candidate[best_length] != src[m_in + best_length])
+                        {
+                            continue; // Cannot be longer than the best match
+                        }
+
+                        uint16_t match_length = 0;
+                        while (match_length < max_length && candidate[match_length] == src[m_in + match_length])
+                        {
+                            match_length++;
+                        }
+
+                        if (match_length > best_length)
+                        {
+                            best_length = match_length;
+                            best_offset = offset;
+                        }
+                    }
+                }
+
+                if (best_length >= COMPRESSION_MIN_MATCH)
+                {
+                    if (m_out + 2u > m_max_size)
+                    {
+                        m_finished = true;
+                        break;
+                    }
+                    m_work_buffer[m_flags_pos] = static_cast<unsigned char>(m_work_buffer[m_flags_pos] | (1u << m_item));
+                    m_work_buffer[m_out++] = static_cast<unsigned char>(best_offset - 1);
+                    m_work_buffer[m_out++] = static_cast<unsigned char>(best_length - COMPRESSION_MIN_MATCH);
+                    uint16_t const match_end = static_cast<uint16_t>(m_in + best_length);
+                    uint16_t const last_hashable = static_cast<uint16_t>(m_length - COMPRESSION_MIN_MATCH);
+                    for (m_in++; m_in < match_end; m_in++)
+                    {
+                        if (m_in <= last_hashable)
+                        {
+                            insert(m_in); // Keeps the chains complete for the bytes covered by the match
+                        }
+                    }
+                }
+                else
+                {
+                    if (m_out >= m_max_size)
+                    {
+                        m_finished = true;
+                        break;
+                    }
+                    m_work_buffer[m_out++] = src[m_in++];
+                }
+                m_item++;
+            }
+
+            return m_finished;
+        }
     } // namespace protocol
 } // namespace scrutiny
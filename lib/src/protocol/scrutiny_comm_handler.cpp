@@ -40,6 +40,16 @@ namespace scrutiny
             m_active_response.data_max_length = m_tx_buffer_size;
             m_enabled = true;
             m_crc = 0;
+            m_rx_framed = false;
+            m_tx_framed = false;
+            m_rx_jumbo = false;
+            m_tx_jumbo = false;
+            m_nbytes_raw = 0;
+            m_cobs_rx.remaining = 0;
+            m_cobs_rx.pending_zero = false;
+            m_jumbo_tx_buffer = SCRUTINY_NULL;
+            m_jumbo_tx_buffer_size = 0;
+            set_max_bitrate(0);
 
             if (m_rx_buffer_size < MINIMUM_RX_BUFFER_SIZE || m_rx_buffer_size > MAXIMUM_RX_BUFFER_SIZE)
             {
@@ -56,8 +66,6 @@ namespace scrutiny
 
         void CommHandler::receive_data(unsigned char const *const data, uint16_t const len)
         {
-            uint16_t i = 0;
-
             if (m_enabled == false)
             {
                 m_rx_error = RxError::Disabled;
@@ -70,14 +78,80 @@ namespace scrutiny
             }
 
             // Handle rx timeouts. Start a new reception if no data for too long
-            if (len != 0)
+            if (len != 0 && m_timebase->has_expired(m_last_rx_timestamp, SCRUTINY_COMM_RX_TIMEOUT_US * 10))
+            {
+                reset_rx();
+                m_state = State::Idle;
+            }
+
+            if (m_rx_framed)
+            {
+                receive_cobs_data(data, len);
+            }
+            else
+            {
+                receive_frame_bytes(data, len);
+            }
+        }
+
+        void CommHandler::receive_cobs_data(unsigned char const *const data, uint16_t const len)
+        {
+            uint16_t i = 0;
+            while (i < len)
             {
-                if (m_timebase->has_expired(m_last_rx_timestamp, SCRUTINY_COMM_RX_TIMEOUT_US * 10))
+                if (data[i] == FRAME_DELIMITER)
                 {
-                    reset_rx();
-                    m_state = State::Idle;
+                    // Resynchronize right away on a frame boundary instead of waiting for the timeout
+                    if (!m_request_received)
+                    {
+                        reset_rx();
+                    }
+                    m_cobs_rx.remaining = 0;
+                    m_cobs_rx.pending_zero = false;
+                    i++;
+                }
+                else if (m_cobs_rx.remaining == 0) // Code byte
+                {
+                    if (m_cobs_rx.pending_zero && !m_request_received)
+                    {
+                        unsigned char const zero = 0;
+                        receive_frame_bytes(&zero, 1);
+                    }
+                    m_cobs_rx.pending_zero = (data[i] != COBS_MAX_BLOCK_LENGTH + 1);
+                    m_cobs_rx.remaining = static_cast<uint_least8_t>(data[i] - 1);
+                    i++;
                 }
+                else
+                {
+                    uint16_t n = static_cast<uint16_t>(len - i);
+                    if (n > m_cobs_rx.remaining)
+                    {
+                        n = m_cobs_rx.remaining;
+                    }
+                    // A delimiter inside a block means the frame got truncated. It is processed on the next iteration
+                    void const *const delimiter = memchr(&data[i], FRAME_DELIMITER, n);
+                    if (delimiter != SCRUTINY_NULL)
+                    {
+                        n = static_cast<uint16_t>(static_cast<unsigned char const *>(delimiter) - &data[i]);
+                    }
 
+                    // Decoder state is updated first. The request parser may reset it on error
+                    unsigned char const *const block_data = &data[i];
+                    m_cobs_rx.remaining = static_cast<uint_least8_t>(m_cobs_rx.remaining - n);
+                    i = static_cast<uint16_t>(i + n);
+                    if (!m_request_received) // Anything after a complete request is garbage
+                    {
+                        receive_frame_bytes(block_data, n);
+                    }
+                }
+            }
+        }
+
+        void CommHandler::receive_frame_bytes(unsigned char const *const data, uint16_t const len)
+        {
+            uint16_t i = 0;
+            if (len != 0)
+            {
                 // Update rx timestamp
                 m_last_rx_timestamp = m_timebase->get_timestamp();
 
@@ -252,6 +326,8 @@ namespace scrutiny
         Response *CommHandler::prepare_response(void)
         {
             m_active_response.reset();
+            m_active_response.data = m_rx_jumbo ? m_jumbo_tx_buffer : m_tx_buffer;
+            m_active_response.data_max_length = response_max_length();
             return &m_active_response;
         }
 
@@ -270,7 +346,7 @@ namespace scrutiny
                 return false; // Half duplex comm. Discard data;
             }
 
-            if (response->data_length > m_tx_buffer_size)
+            if (response->data_length > response_max_length())
             {
                 reset_tx();
                 m_tx_error = TxError::Overflow;
@@ -283,10 +359,22 @@ namespace scrutiny
             m_active_response.data_length = response->data_length;
             m_active_response.data = response->data;
 
+            m_tx_jumbo = m_rx_jumbo;
             add_crc(&m_active_response);
 
-            // cmd8 + subfn8 + code8 + len16 + data + crc32
-            m_nbytes_to_send = 1u + 1u + 1u + 2u + m_active_response.data_length + 4u;
+            // cmd8 + subfn8 + code8 + len16 + data + crc32. len32 with jumbo frames
+            m_nbytes_raw = tx_header_size() + m_active_response.data_length + 4u;
+            m_nbytes_to_send = m_nbytes_raw;
+
+            m_tx_framed = m_rx_framed; // The server expects the response in the same framing as its request
+            if (m_tx_framed)
+            {
+                m_nbytes_to_send = cobs_encoded_size();
+                m_cobs_tx.raw_index = 0;
+                m_cobs_tx.block_remaining = 0;
+                m_cobs_tx.skip_zero = false;
+                m_cobs_tx.need_block = true;
+            }
 
             m_state = State::Transmitting;
             return true;
@@ -294,7 +382,9 @@ namespace scrutiny
 
         uint16_t CommHandler::pop_data(unsigned char *const buffer, uint16_t len)
         {
-            SCRUTINY_STATIC_ASSERT(protocol::MAXIMUM_TX_BUFFER_SIZE <= 0xFFFF - 9, "Cannot parse successfully with 16bits counters");
+            SCRUTINY_STATIC_ASSERT(
+                protocol::MAXIMUM_JUMBO_TX_BUFFER_SIZE <= 0xFFFFFFFFu - JUMBO_RESPONSE_OVERHEAD,
+                "Cannot parse successfully with 32bits counters");
 
             if (m_state != State::Transmitting)
             {
@@ -303,56 +393,58 @@ namespace scrutiny
 
             uint16_t i = 0u;
 
-            uint16_t const nbytes_to_send = static_cast<uint16_t>(m_nbytes_to_send - m_nbytes_sent);
+            uint32_t const nbytes_to_send = m_nbytes_to_send - m_nbytes_sent;
             if (len > nbytes_to_send)
             {
-                len = nbytes_to_send;
+                len = static_cast<uint16_t>(nbytes_to_send);
             }
 
-            while (m_nbytes_sent < 5 && i < len)
+            if (m_max_bitrate != 0)
             {
-                if (m_nbytes_sent == 0u)
-                {
-                    buffer[i] = m_active_response.command_id & 0xFFu;
-                }
-                else if (m_nbytes_sent == 1u)
-                {
-                    buffer[i] = m_active_response.subfunction_id & 0xFFu;
-                }
-                else if (m_nbytes_sent == 2u)
-                {
-                    buffer[i] = m_active_response.response_code & 0xFFu;
-                }
-                else if (m_nbytes_sent == 3u)
+                refill_tx_tokens();
+                if (len > m_tx_tokens)
                 {
-                    buffer[i] = static_cast<unsigned char>((m_active_response.data_length >> 8) & 0xFFu);
+                    len = static_cast<uint16_t>(m_tx_tokens);
                 }
-                else if (m_nbytes_sent == 4u) // cppcheck-suppress[knownConditionTrueFalse]
+                m_tx_tokens -= len;
+            }
+
+            if (m_tx_framed)
+            {
+                i = pop_cobs_data(buffer, len);
+                if (m_nbytes_sent >= m_nbytes_to_send)
                 {
-                    buffer[i] = static_cast<unsigned char>(m_active_response.data_length & 0xFFu);
+                    reset_tx();
+                    wait_next_request();
                 }
+                return i;
+            }
 
+            uint_least8_t const header_size = tx_header_size();
+            while (m_nbytes_sent < header_size && i < len)
+            {
+                buffer[i] = tx_raw_byte(m_nbytes_sent);
                 i++;
                 m_nbytes_sent++;
             }
 
-            if (m_nbytes_sent >= 5u && i < len)
+            if (m_nbytes_sent >= header_size && i < len)
             {
-                uint16_t const data_byte_sent = (m_nbytes_sent - 5);
+                uint32_t const data_byte_sent = m_nbytes_sent - header_size;
                 if (data_byte_sent < m_active_response.data_length)
                 {
-                    uint16_t const remaining_data_bytes = m_active_response.data_length - (m_nbytes_sent - 5);
+                    uint32_t const remaining_data_bytes = m_active_response.data_length - data_byte_sent;
                     uint16_t const user_request_remaining = (len - i);
                     // Don't read more than available.
                     uint16_t const data_bytes_to_copy =
-                        (user_request_remaining < remaining_data_bytes) ? user_request_remaining : remaining_data_bytes;
-                    memcpy(&buffer[i], &m_active_response.data[m_active_response.data_length - remaining_data_bytes], data_bytes_to_copy);
+                        (user_request_remaining < remaining_data_bytes) ? user_request_remaining : static_cast<uint16_t>(remaining_data_bytes);
+                    memcpy(&buffer[i], &m_active_response.data[data_byte_sent], data_bytes_to_copy);
 
                     i += data_bytes_to_copy;
                     m_nbytes_sent += data_bytes_to_copy;
                 }
 
-                uint16_t const crc_position = m_active_response.data_length + 5u; // Will fit as per SCRUTINY_STATIC_ASSERT above.
+                uint32_t const crc_position = m_active_response.data_length + header_size; // Will fit as per SCRUTINY_STATIC_ASSERT above.
                 while (i < len)
                 {
                     if (m_nbytes_sent == crc_position)
@@ -389,6 +481,111 @@ namespace scrutiny
             return i;
         }
 
+        uint16_t CommHandler::pop_cobs_data(unsigned char *const buffer, uint16_t const len)
+        {
+            uint16_t const data_end = static_cast<uint16_t>(5u + m_active_response.data_length);
+            uint16_t i = 0;
+            while (i < len)
+            {
+                if (m_cobs_tx.block_remaining > 0)
+                {
+                    uint16_t n = 1;
+                    if (m_cobs_tx.raw_index >= 5u && m_cobs_tx.raw_index < data_end) // Copy the payload part of the block at once
+                    {
+                        n = static_cast<uint16_t>(len - i);
+                        n = (n < m_cobs_tx.block_remaining) ? n : m_cobs_tx.block_remaining;
+                        n = (n < data_end - m_cobs_tx.raw_index) ? n : static_cast<uint16_t>(data_end - m_cobs_tx.raw_index);
+                        memcpy(&buffer[i], &m_active_response.data[m_cobs_tx.raw_index - 5u], n);
+                    }
+                    else
+                    {
+                        buffer[i] = tx_raw_byte(m_cobs_tx.raw_index);
+                    }
+                    i = static_cast<uint16_t>(i + n);
+                    m_cobs_tx.raw_index = static_cast<uint16_t>(m_cobs_tx.raw_index + n);
+                    m_cobs_tx.block_remaining = static_cast<uint_least8_t>(m_cobs_tx.block_remaining - n);
+                    if (m_cobs_tx.block_remaining == 0 && m_cobs_tx.skip_zero)
+                    {
+                        m_cobs_tx.raw_index++;
+                    }
+                }
+                else if (m_cobs_tx.need_block)
+                {
+                    uint_least8_t const length = cobs_block_length(m_cobs_tx.raw_index);
+                    uint16_t const block_end = static_cast<uint16_t>(m_cobs_tx.raw_index + length);
+                    m_cobs_tx.need_block = (block_end < m_nbytes_raw);
+                    m_cobs_tx.skip_zero = (length < COBS_MAX_BLOCK_LENGTH) && m_cobs_tx.need_block; // Stopped by a zero
+                    m_cobs_tx.block_remaining = length;
+                    buffer[i++] = static_cast<unsigned char>(length + 1);
+                    if (length == 0 && m_cobs_tx.skip_zero)
+                    {
+                        m_cobs_tx.raw_index++;
+                    }
+                }
+                else
+                {
+                    buffer[i++] = FRAME_DELIMITER;
+                }
+            }
+
+            m_nbytes_sent += i;
+            return i;
+        }
+
+        unsigned char CommHandler::tx_raw_byte(uint32_t const index) const
+        {
+            uint_least8_t const header_size = tx_header_size();
+            uint32_t const data_end = header_size + m_active_response.data_length;
+            if (index == 0)
+            {
+                return m_active_response.command_id & 0xFFu;
+            }
+            else if (index == 1)
+            {
+                return m_active_response.subfunction_id & 0xFFu;
+            }
+            else if (index == 2)
+            {
+                return m_active_response.response_code & 0xFFu;
+            }
+            else if (index < header_size) // Length, big endian
+            {
+                return static_cast<unsigned char>((m_active_response.data_length >> (8u * (header_size - 1u - index))) & 0xFFu);
+            }
+            else if (index < data_end)
+            {
+                return m_active_response.data[index - header_size];
+            }
+
+            return static_cast<unsigned char>((m_active_response.crc >> (24u - 8u * (index - data_end))) & 0xFFu);
+        }
+
+        uint_least8_t CommHandler::cobs_block_length(uint16_t const raw_index) const
+        {
+            uint_least8_t length = 0;
+            while (length < COBS_MAX_BLOCK_LENGTH && raw_index + length < m_nbytes_raw && tx_raw_byte(raw_index + length) != 0)
+            {
+                length++;
+            }
+            return length;
+        }
+
+        uint16_t CommHandler::cobs_encoded_size(void) const
+        {
+            uint16_t size = 1; // Delimiter
+            uint16_t raw_index = 0;
+            bool need_block = true;
+            while (need_block)
+            {
+                uint_least8_t const length = cobs_block_length(raw_index);
+                uint16_t const block_end = static_cast<uint16_t>(raw_index + length);
+                need_block = (block_end < m_nbytes_raw);
+                size = static_cast<uint16_t>(size + 1u + length);
+                raw_index = static_cast<uint16_t>(block_end + ((length < COBS_MAX_BLOCK_LENGTH && need_block) ? 1u : 0u));
+            }
+            return size;
+        }
+
         // Check if the last request received is a valid "Comm Discover request".
         bool CommHandler::received_discover_request(void) const
         {
@@ -433,6 +630,11 @@ namespace scrutiny
 
         void CommHandler::process(void)
         {
+            if (m_max_bitrate != 0)
+            {
+                refill_tx_tokens(); // Keeps the elapsed time short enough to not wrap
+            }
+
             if (m_session_active)
             {
                 if (m_timebase->has_expired(m_heartbeat_timestamp, SCRUTINY_COMM_HEARTBEAT_TIMEOUT_US * 10))
@@ -467,21 +669,93 @@ namespace scrutiny
                 return 0;
             }
 
-            return m_nbytes_to_send - m_nbytes_sent;
+            uint32_t nbytes_to_send = m_nbytes_to_send - m_nbytes_sent;
+            if (m_max_bitrate != 0)
+            {
+                uint32_t credit_remainder;
+                uint32_t const tokens = compute_tx_tokens(&credit_remainder);
+                if (tokens < nbytes_to_send)
+                {
+                    nbytes_to_send = tokens;
+                }
+            }
+
+            return (nbytes_to_send > 0xFFFFu) ? 0xFFFFu : static_cast<uint16_t>(nbytes_to_send); // The rest of a jumbo frame comes after
+        }
+
+        void CommHandler::set_max_bitrate(uint32_t const bitrate)
+        {
+            m_max_bitrate = bitrate;
+            m_tx_tokens = tx_bucket_size();
+            m_tx_credit_remainder = 0;
+            m_tx_tokens_timestamp = m_timebase->get_timestamp();
+        }
+
+        uint32_t CommHandler::compute_tx_tokens(uint32_t *const credit_remainder) const
+        {
+            SCRUTINY_CONSTEXPR uint32_t CREDIT_PER_BYTE = 8u * 10000000u; // bit*100ns per byte at 1 bit/sec
+            uint32_t const bucket_size = tx_bucket_size();
+
+            // Cannot overflow. (2^32-1)^2 + CREDIT_PER_BYTE < 2^64
+            uint64_t const credit =
+                static_cast<uint64_t>(m_timebase->elapsed_since(m_tx_tokens_timestamp)) * m_max_bitrate + m_tx_credit_remainder;
+            uint64_t const tokens = m_tx_tokens + credit / CREDIT_PER_BYTE;
+            if (tokens >= bucket_size)
+            {
+                *credit_remainder = 0; // Full bucket. What is earned above is lost
+                return bucket_size;
+            }
+
+            *credit_remainder = static_cast<uint32_t>(credit % CREDIT_PER_BYTE);
+            return static_cast<uint32_t>(tokens);
+        }
+
+        void CommHandler::refill_tx_tokens(void)
+        {
+            m_tx_tokens = compute_tx_tokens(&m_tx_credit_remainder);
+            m_tx_tokens_timestamp = m_timebase->get_timestamp();
+        }
+
+        void CommHandler::set_jumbo_tx_buffer(unsigned char *const buffer, uint32_t const buffer_size)
+        {
+            m_jumbo_tx_buffer = buffer;
+            m_jumbo_tx_buffer_size = buffer_size;
+            if (buffer == SCRUTINY_NULL || buffer_size <= m_tx_buffer_size || buffer_size > MAXIMUM_JUMBO_TX_BUFFER_SIZE)
+            {
+                m_jumbo_tx_buffer = SCRUTINY_NULL;
+                m_jumbo_tx_buffer_size = 0;
+            }
+        }
+
+        uint32_t CommHandler::tx_bucket_size(void) const
+        {
+            // A short burst keeps the line rate close to the max bitrate, even for big responses
+            uint64_t const burst_size = static_cast<uint64_t>(m_max_bitrate) * TX_BURST_DURATION_US / (8u * 1000000u);
+            uint32_t const frame_size = jumbo_frames() ? m_jumbo_tx_buffer_size + JUMBO_RESPONSE_OVERHEAD
+                                                       : static_cast<uint32_t>(m_tx_buffer_size) + RESPONSE_OVERHEAD;
+            if (burst_size >= frame_size)
+            {
+                return frame_size;
+            }
+            return (burst_size > TX_BUCKET_MIN_SIZE) ? static_cast<uint32_t>(burst_size) : TX_BUCKET_MIN_SIZE;
         }
 
         void CommHandler::add_crc(Response *const response) const
         {
-            if (response->data_length > m_tx_buffer_size)
+            if (response->data_length > response_max_length())
                 return;
 
-            unsigned char const header[5] = { static_cast<unsigned char>(response->command_id),
+            unsigned char const header[7] = { static_cast<unsigned char>(response->command_id),
                                               static_cast<unsigned char>(response->subfunction_id),
                                               static_cast<unsigned char>(response->response_code),
+                                              static_cast<unsigned char>((response->data_length >> 24) & 0xFF),
+                                              static_cast<unsigned char>((response->data_length >> 16) & 0xFF),
                                               static_cast<unsigned char>((response->data_length >> 8) & 0xFF),
                                               static_cast<unsigned char>(response->data_length & 0xFF) };
 
-            uint32_t const crc = tools::crc32(header, sizeof(header));
+            uint_least8_t const length_size = tx_header_size() - 3u; // Only the 2 last bytes of the length without jumbo frames
+            uint32_t crc = tools::crc32(header, 3);
+            crc = tools::crc32(&header[sizeof(header) - length_size], length_size, crc);
             response->crc = tools::crc32(response->data, response->data_length, crc);
         }
 
@@ -492,6 +766,7 @@ namespace scrutiny
             m_first_heartbeat_received = false;
             m_session_id = 0;
             m_session_active = false;
+            m_session_flags = 0;
             if (m_enabled)
             {
                 m_heartbeat_timestamp = m_timebase->get_timestamp();
@@ -509,6 +784,10 @@ namespace scrutiny
             m_rx_error = RxError::None;
             m_last_rx_timestamp = m_timebase->get_timestamp();
             m_crc = 0;
+            m_rx_framed = framing();
+            m_rx_jumbo = jumbo_frames() && m_jumbo_tx_buffer != SCRUTINY_NULL;
+            m_cobs_rx.remaining = 0;
+            m_cobs_rx.pending_zero = false;
 
             if (m_state == State::Receiving)
             {
@@ -538,6 +817,7 @@ namespace scrutiny
 
             m_session_id = s_session_counter++;
             m_session_active = true;
+            m_session_flags = 0;
             m_first_heartbeat_received = false;
             m_heartbeat_timestamp = m_timebase->get_timestamp();
             reset_rx();
@@ -549,6 +829,7 @@ namespace scrutiny
         {
             m_session_id = 0;
             m_session_active = false;
+            m_session_flags = 0;
             m_first_heartbeat_received = false;
             reset_rx();
             reset_tx();
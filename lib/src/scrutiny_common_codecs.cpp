@@ -12,6 +12,7 @@
 #include <limits.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #if defined(_MSC_VER)
 #pragma warning(disable : 4127) // Condition always true
@@ -161,5 +162,36 @@ namespace scrutiny
             }
             return typesize;
         }
+
+        /// @brief Copies a value in the device byte order. Used when the server asked for native endian values at connection.
+        /// Only meaningful with 8 bits char, the MainHandler never accepts native endian values otherwise
+        uint_least8_t encode_anytype_native_8bits(AnyType const *const val, uint_least8_t const typesize, unsigned char *const buffer)
+        {
+#if CHAR_BIT == 8
+            // AnyType members all start at offset 0. Constant sizes let the compiler turn each copy into a single store.
+            switch (typesize)
+            {
+            case 1:
+                *buffer = val->uint8;
+                break;
+            case 2:
+                memcpy(buffer, &val->uint16, 2);
+                break;
+            case 4:
+                memcpy(buffer, &val->uint32, 4);
+                break;
+#if SCRUTINY_SUPPORT_64BITS
+            case 8:
+                memcpy(buffer, &val->uint64, 8);
+                break;
+#endif
+            default:
+                return 0;
+            }
+            return typesize;
+#else
+            return encode_anytype_big_endian_8bits(val, typesize, buffer);
+#endif
+        }
     } // namespace codecs
 } // namespace scrutiny
@@ -21,10 +21,19 @@ namespace scrutiny
 
     void Config::clear()
     {
-        m_tx_buffer = SCRUTINY_NULL;
-        m_rx_buffer = SCRUTINY_NULL;
-        m_rx_buffer_size = 0;
-        m_tx_buffer_size = 0;
+        for (uint_least8_t i = 0; i < SCRUTINY_COMM_CHANNEL_COUNT; i++)
+        {
+            m_channels[i].rx_buffer = SCRUTINY_NULL;
+            m_channels[i].tx_buffer = SCRUTINY_NULL;
+            m_channels[i].rx_buffer_size = 0;
+            m_channels[i].tx_buffer_size = 0;
+            m_channels[i].jumbo_tx_buffer = SCRUTINY_NULL;
+            m_channels[i].jumbo_tx_buffer_size = 0;
+            m_channels[i].rx_fifo_buffer = SCRUTINY_NULL;
+            m_channels[i].tx_fifo_buffer = SCRUTINY_NULL;
+            m_channels[i].rx_fifo_size = 0;
+            m_channels[i].tx_fifo_size = 0;
+        }
 #if SCRUTINY_SUPPORT_PROTECTED_REGIONS
         m_forbidden_address_ranges = SCRUTINY_NULL;
         m_forbidden_range_count = 0;
@@ -33,11 +42,23 @@ namespace scrutiny
 #endif
         m_rpvs = SCRUTINY_NULL;
         m_rpv_count = 0;
+        m_static_rpvs = false;
+        m_config_fingerprint = 0;
+        m_config_fingerprint_set = false;
         m_rpv_read_callback = SCRUTINY_NULL;
+        m_rpv_bulk_read_callback = SCRUTINY_NULL;
         m_rpv_write_callback = SCRUTINY_NULL;
         display_name = "";
         max_bitrate = 0;
+        enforce_max_bitrate = false;
         m_user_command_callback = SCRUTINY_NULL;
+        m_async_user_command_callback = SCRUTINY_NULL;
+        m_staging_buffer = SCRUTINY_NULL;
+        m_staging_buffer_size = 0;
+        m_compression_buffer = SCRUTINY_NULL;
+        m_compression_buffer_size = 0;
+        m_watched_blocks = SCRUTINY_NULL;
+        m_watched_block_count = 0;
         session_counter_seed = 0;
         memory_write_enable = true;
         m_loops = SCRUTINY_NULL;
@@ -47,15 +68,74 @@ namespace scrutiny
         m_datalogger_buffer = SCRUTINY_NULL;
         m_datalogger_buffer_size = 0;
         m_datalogger_trigger_callback = SCRUTINY_NULL;
+        m_datalogger_storage.write = SCRUTINY_NULL;
+        m_datalogger_storage.read = SCRUTINY_NULL;
+        m_datalogger_storage.cache = SCRUTINY_NULL;
+        m_datalogger_storage.cache_size = 0;
+#endif
+#if SCRUTINY_ENABLE_STATISTICS
+        m_statistics_channels = SCRUTINY_NULL;
+        m_statistics_channel_count = 0;
 #endif
     }
 
     void Config::set_buffers(unsigned char *rx_buffer, uint16_t const rx_buffer_size, unsigned char *tx_buffer, uint16_t const tx_buffer_size)
     {
-        m_rx_buffer = rx_buffer;
-        m_rx_buffer_size = rx_buffer_size;
-        m_tx_buffer = tx_buffer;
-        m_tx_buffer_size = tx_buffer_size;
+        set_channel_buffers(0, rx_buffer, rx_buffer_size, tx_buffer, tx_buffer_size);
+    }
+
+    void Config::set_channel_buffers(
+        uint_least8_t const channel,
+        unsigned char *rx_buffer,
+        uint16_t const rx_buffer_size,
+        unsigned char *tx_buffer,
+        uint16_t const tx_buffer_size)
+    {
+        if (channel >= SCRUTINY_COMM_CHANNEL_COUNT)
+        {
+            return;
+        }
+        m_channels[channel].rx_buffer = rx_buffer;
+        m_channels[channel].rx_buffer_size = rx_buffer_size;
+        m_channels[channel].tx_buffer = tx_buffer;
+        m_channels[channel].tx_buffer_size = tx_buffer_size;
+    }
+
+    void Config::set_jumbo_tx_buffer(unsigned char *jumbo_tx_buffer, uint32_t const jumbo_tx_buffer_size)
+    {
+        set_channel_jumbo_tx_buffer(0, jumbo_tx_buffer, jumbo_tx_buffer_size);
+    }
+
+    void Config::set_channel_jumbo_tx_buffer(uint_least8_t const channel, unsigned char *jumbo_tx_buffer, uint32_t const jumbo_tx_buffer_size)
+    {
+        if (channel >= SCRUTINY_COMM_CHANNEL_COUNT)
+        {
+            return;
+        }
+        m_channels[channel].jumbo_tx_buffer = jumbo_tx_buffer;
+        m_channels[channel].jumbo_tx_buffer_size = jumbo_tx_buffer_size;
+    }
+
+    void Config::set_fifos(unsigned char *rx_fifo_buffer, uint16_t const rx_fifo_size, unsigned char *tx_fifo_buffer, uint16_t const tx_fifo_size)
+    {
+        set_channel_fifos(0, rx_fifo_buffer, rx_fifo_size, tx_fifo_buffer, tx_fifo_size);
+    }
+
+    void Config::set_channel_fifos(
+        uint_least8_t const channel,
+        unsigned char *rx_fifo_buffer,
+        uint16_t const rx_fifo_size,
+        unsigned char *tx_fifo_buffer,
+        uint16_t const tx_fifo_size)
+    {
+        if (channel >= SCRUTINY_COMM_CHANNEL_COUNT)
+        {
+            return;
+        }
+        m_channels[channel].rx_fifo_buffer = rx_fifo_buffer;
+        m_channels[channel].rx_fifo_size = rx_fifo_size;
+        m_channels[channel].tx_fifo_buffer = tx_fifo_buffer;
+        m_channels[channel].tx_fifo_size = tx_fifo_size;
     }
 
 #if SCRUTINY_SUPPORT_PROTECTED_REGIONS
@@ -81,6 +161,17 @@ namespace scrutiny
         m_rpv_count = nbr;
         m_rpv_read_callback = rd_cb;
         m_rpv_write_callback = wr_cb;
+        m_static_rpvs = false;
+    }
+
+    void Config::set_static_published_values(
+        RuntimePublishedValue const *const array,
+        uint16_t const nbr,
+        RpvReadCallback const rd_cb,
+        RpvWriteCallback const wr_cb)
+    {
+        set_published_values(array, nbr, rd_cb, wr_cb);
+        m_static_rpvs = true;
     }
 
     void Config::set_loops(LoopHandler **loops, uint_least8_t loop_count)
@@ -94,6 +185,23 @@ namespace scrutiny
     {
         m_datalogger_buffer = buffer;
         m_datalogger_buffer_size = buffer_size;
+        m_datalogger_storage.write = SCRUTINY_NULL;
+        m_datalogger_storage.read = SCRUTINY_NULL;
+    }
+
+    void Config::set_datalogging_external_storage(
+        datalogging::storage_write_callback_t write_callback,
+        datalogging::storage_read_callback_t read_callback,
+        datalogging::buffer_size_t const storage_size,
+        unsigned char *cache,
+        uint16_t const cache_size)
+    {
+        m_datalogger_buffer = SCRUTINY_NULL;
+        m_datalogger_buffer_size = storage_size;
+        m_datalogger_storage.write = write_callback;
+        m_datalogger_storage.read = read_callback;
+        m_datalogger_storage.cache = cache;
+        m_datalogger_storage.cache_size = cache_size;
     }
 
     bool Config::has_at_least_one_loop_with_datalogging(void) const
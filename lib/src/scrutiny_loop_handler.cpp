@@ -19,11 +19,14 @@ namespace scrutiny
     {
         m_main2loop_msg.clear();
         m_loop2main_msg.clear();
+        m_main_handler = main_handler;
 #if SCRUTINY_ENABLE_DATALOGGING
         m_datalogger_data_acquired = false;
         m_datalogger = main_handler->datalogger();
-#else
-        static_cast<void>(main_handler);
+#endif
+#if SCRUTINY_ENABLE_STATISTICS
+        m_statistics = main_handler->statistics();
+        m_statistics_running = false;
 #endif
         return Status::SUCCESS;
     }
@@ -59,6 +62,15 @@ namespace scrutiny
                     m_datalogger->disarm_trigger();
                 }
                 break;
+            case Main2LoopMessageID::DATALOGGER_RELEASE_ACQUISITION:
+                if (owns_datalogger())
+                {
+                    m_datalogger->release_acquisition();
+                }
+                // Acknowledge even if not owner. The main handler waits for it before trusting the status updates again
+                msg_out.message_id = Loop2MainMessageID::DATALOGGER_ACQUISITION_RELEASED;
+                m_loop2main_msg.send(msg_out);
+                break;
             case Main2LoopMessageID::RELEASE_DATALOGGER_OWNERSHIP:
                 if (owns_datalogger())
                 {
@@ -68,11 +80,39 @@ namespace scrutiny
                 }
                 break;
 #endif
+#if SCRUTINY_ENABLE_STATISTICS
+            case Main2LoopMessageID::STATISTICS_START:
+                m_statistics->reset();
+                m_statistics_running = true;
+                break;
+            case Main2LoopMessageID::STATISTICS_STOP:
+                m_statistics_running = false;
+                msg_out.message_id = Loop2MainMessageID::STATISTICS_STOPPED;
+                m_loop2main_msg.send(msg_out);
+                break;
+            case Main2LoopMessageID::STATISTICS_SNAPSHOT:
+                m_statistics->take_snapshot();
+                msg_out.message_id = Loop2MainMessageID::STATISTICS_SNAPSHOT_TAKEN;
+                m_loop2main_msg.send(msg_out);
+                break;
+#endif
+            case Main2LoopMessageID::PROCESS_STAGED_OPERATION:
+                m_main_handler->execute_staged_operation(this);
+                msg_out.message_id = Loop2MainMessageID::STAGED_OPERATION_DONE;
+                m_loop2main_msg.send(msg_out);
+                break;
             default:
                 break;
             }
         }
 
+#if SCRUTINY_ENABLE_STATISTICS
+        if (m_statistics_running)
+        {
+            m_statistics->process(this);
+        }
+#endif
+
 #if SCRUTINY_ENABLE_DATALOGGING
         if (owns_datalogger())
         {
@@ -90,6 +130,7 @@ namespace scrutiny
                 {
                     msg_out.message_id = Loop2MainMessageID::DATALOGGER_STATUS_UPDATE;
                     msg_out.data.datalogger_status_update.state = m_datalogger->get_state();
+                    msg_out.data.datalogger_status_update.acquisition_available = m_datalogger->acquisition_available();
                     if (msg_out.data.datalogger_status_update.state == datalogging::DataLogger::State::Triggered)
                     {
                         // write counter gets reset on trigger
@@ -21,13 +21,18 @@ namespace scrutiny
     MainHandler::MainHandler(void) :
         m_codec(),
         m_config(),
-        m_comm_handler(),
+        m_channels(),
+        m_active_channel(0),
         m_timebase(),
         m_process_again_timestamp(0),
-        m_processing_request(false),
-        m_disconnect_pending(false),
         m_enabled(false),
-        m_process_again_timestamp_taken(false)
+        m_config_fingerprint(0),
+        m_process_again_timestamp_taken(false),
+        m_watched_blocks_channel(0),
+        m_read_changed_sequence(0),
+        m_compressor(),
+        m_compressing_response(false),
+        m_staged_operation()
 #if SCRUTINY_ENABLE_DATALOGGING
         ,
         m_datalogging()
@@ -37,27 +42,55 @@ namespace scrutiny
 
     Status::eStatus MainHandler::init(Config const *const config)
     {
-        m_processing_request = false;
-        m_disconnect_pending = false;
         m_process_again_timestamp_taken = false;
+        m_compressing_response = false;
+        m_compressor.reset();
+        m_active_channel = 0;
         m_config = *config;
 
-        m_comm_handler.init(
-            m_config.m_rx_buffer,
-            m_config.m_rx_buffer_size,
-            m_config.m_tx_buffer,
-            m_config.m_tx_buffer_size,
-            &m_timebase,
-            m_config.session_counter_seed);
+        m_staged_operation.request.reset();
+        m_staged_operation.response.reset();
+        m_staged_operation.response.data = m_config.m_staging_buffer;
+        m_staged_operation.response.data_max_length = m_config.m_staging_buffer_size;
+        m_staged_operation.loop = SCRUTINY_NULL;
+        m_staged_operation.subfunction = protocol::MemoryControl::Subfunction::ReadSnapshot;
+        m_staged_operation.state = StagedOperationState::Idle;
+        m_staged_operation.success = false;
+        m_staged_operation.stale = false;
+        m_staged_operation.native_endian = false;
+        m_watched_blocks_channel = 0;
+        m_read_changed_sequence = 0;
+        invalidate_watched_blocks();
+
+        for (uint_least8_t i = 0; i < SCRUTINY_COMM_CHANNEL_COUNT; i++)
+        {
+            // Channels without buffers are left disabled by their comm handler
+            m_channels[i].processing_request = false;
+            m_channels[i].disconnect_pending = false;
+            m_channels[i].comm_handler.init(
+                m_config.m_channels[i].rx_buffer,
+                m_config.m_channels[i].rx_buffer_size,
+                m_config.m_channels[i].tx_buffer,
+                m_config.m_channels[i].tx_buffer_size,
+                &m_timebase,
+                m_config.session_counter_seed);
+            m_channels[i].comm_handler.set_max_bitrate(m_config.enforce_max_bitrate ? m_config.max_bitrate : 0);
+            m_channels[i].comm_handler.set_jumbo_tx_buffer(m_config.m_channels[i].jumbo_tx_buffer, m_config.m_channels[i].jumbo_tx_buffer_size);
+            m_channels[i].rx_fifo.init(m_config.m_channels[i].rx_fifo_buffer, m_config.m_channels[i].rx_fifo_size);
+            m_channels[i].tx_fifo.init(m_config.m_channels[i].tx_fifo_buffer, m_config.m_channels[i].tx_fifo_size);
+        }
 
         if (check_config() != Status::SUCCESS)
         {
-            m_comm_handler.disable();
+            for (uint_least8_t i = 0; i < SCRUTINY_COMM_CHANNEL_COUNT; i++)
+            {
+                m_channels[i].comm_handler.disable();
+            }
             return Status::ERROR;
         }
 
         // If there's an init error with the comm handler, we disable as well.
-        if (!m_comm_handler.is_enabled())
+        if (!m_channels[0].comm_handler.is_enabled())
         {
             m_enabled = false;
             return Status::ERROR;
@@ -71,12 +104,26 @@ namespace scrutiny
             }
         }
 
+        m_config_fingerprint = m_config.is_config_fingerprint_set() ? m_config.get_config_fingerprint() : compute_config_fingerprint();
+
 #if SCRUTINY_ENABLE_DATALOGGING
-        Status::eStatus const datalog_init_status = m_datalogging.datalogger.init(
-            this,
-            m_config.m_datalogger_buffer,
-            m_config.m_datalogger_buffer_size,
-            m_config.m_datalogger_trigger_callback);
+        Status::eStatus datalog_init_status;
+        if (m_config.m_datalogger_storage.write != SCRUTINY_NULL_FN_PTR(datalogging::storage_write_callback_t))
+        {
+            datalog_init_status = m_datalogging.datalogger.init(
+                this,
+                &m_config.m_datalogger_storage,
+                m_config.m_datalogger_buffer_size,
+                m_config.m_datalogger_trigger_callback);
+        }
+        else
+        {
+            datalog_init_status = m_datalogging.datalogger.init(
+                this,
+                m_config.m_datalogger_buffer,
+                m_config.m_datalogger_buffer_size,
+                m_config.m_datalogger_trigger_callback);
+        }
 
         if (datalog_init_status != Status::SUCCESS)
         {
@@ -91,28 +138,47 @@ namespace scrutiny
         m_datalogging.pending_ownership_release = false;
         m_datalogging.request_disarm_trigger = false;
         m_datalogging.reading_in_progress = false;
+        m_datalogging.request_release_acquisition = false;
+        m_datalogging.pending_acquisition_release = false;
         m_datalogging.read_acquisition_rolling_counter = 0;
 
         m_datalogging.threadsafe_data.datalogger_state = m_datalogging.datalogger.get_state();
+        m_datalogging.threadsafe_data.acquisition_available = false;
         m_datalogging.threadsafe_data.bytes_to_acquire_from_trigger_to_completion = 0;
         m_datalogging.threadsafe_data.write_counter_since_trigger = 0;
 #endif
+
+#if SCRUTINY_ENABLE_STATISTICS
+        m_statistics.engine.init(this, m_config.m_statistics_channels, m_config.m_statistics_channel_count);
+        m_statistics.owner = SCRUTINY_NULL;
+        m_statistics.stop_requested = false;
+        m_statistics.snapshot = StagedOperationState::Idle;
+#endif
         return Status::SUCCESS;
     }
 
     Status::eStatus MainHandler::check_config()
     {
         m_enabled = true;
-        if (m_config.m_rx_buffer == SCRUTINY_NULL || m_config.m_rx_buffer_size < protocol::MINIMUM_RX_BUFFER_SIZE ||
-            m_config.m_rx_buffer_size > protocol::MAXIMUM_RX_BUFFER_SIZE)
+        for (uint_least8_t i = 0; i < SCRUTINY_COMM_CHANNEL_COUNT; i++)
         {
-            m_enabled = false;
-        }
+            Config::CommChannelBuffers const &buffers = m_config.m_channels[i];
+            if (i > 0 && buffers.rx_buffer == SCRUTINY_NULL && buffers.tx_buffer == SCRUTINY_NULL)
+            {
+                continue; // Unused additional channel
+            }
 
-        if (m_config.m_tx_buffer == SCRUTINY_NULL || m_config.m_tx_buffer_size < protocol::MINIMUM_TX_BUFFER_SIZE ||
-            m_config.m_tx_buffer_size > protocol::MAXIMUM_TX_BUFFER_SIZE)
-        {
-            m_enabled = false;
+            if (buffers.rx_buffer == SCRUTINY_NULL || buffers.rx_buffer_size < protocol::MINIMUM_RX_BUFFER_SIZE ||
+                buffers.rx_buffer_size > protocol::MAXIMUM_RX_BUFFER_SIZE)
+            {
+                m_enabled = false;
+            }
+
+            if (buffers.tx_buffer == SCRUTINY_NULL || buffers.tx_buffer_size < protocol::MINIMUM_TX_BUFFER_SIZE ||
+                buffers.tx_buffer_size > protocol::MAXIMUM_TX_BUFFER_SIZE)
+            {
+                m_enabled = false;
+            }
         }
 
         for (uint32_t i = 0; i < m_config.m_rpv_count; i++)
@@ -121,11 +187,86 @@ namespace scrutiny
             {
                 m_enabled = false;
             }
+
+            // get_rpv() does a binary search on a static table. Nothing forces the table to go through SCRUTINY_STATIC_CHECK_RPV_TABLE
+            if (m_config.is_static_published_values() && i > 0 && m_config.m_rpvs[i - 1].id >= m_config.m_rpvs[i].id)
+            {
+                m_enabled = false;
+            }
         }
 
         return (m_enabled) ? Status::SUCCESS : Status::ERROR;
     }
 
+    uint32_t MainHandler::compute_config_fingerprint(void) const
+    {
+        // Each definition is encoded the way it is sent to the server, so the fingerprint does not depend on
+        // the struct layout of the target. Lengths are hashed to avoid ambiguity between consecutive tables.
+        unsigned char buf[2 * sizeof(uintptr_t) + 8];
+        uint32_t crc = 0;
+
+        uint16_t const rpv_count = m_config.get_rpv_count();
+        RuntimePublishedValue const *const rpvs = m_config.get_rpvs_array();
+        codecs::encode_16_bits_big_endian_8bits(rpv_count, buf);
+        crc = tools::crc32(buf, 2, crc);
+        for (uint16_t i = 0; i < rpv_count; i++)
+        {
+            codecs::encode_16_bits_big_endian_8bits(rpvs[i].id, &buf[0]);
+            codecs::encode_8_bits_8bits(static_cast<uint_least8_t>(rpvs[i].type), &buf[2]);
+            crc = tools::crc32(buf, 3, crc);
+        }
+
+        codecs::encode_8_bits_8bits(m_config.m_loop_count, buf);
+        crc = tools::crc32(buf, 1, crc);
+        for (uint_least8_t i = 0; i < m_config.m_loop_count; i++)
+        {
+            LoopHandler const *const loop = m_config.m_loops[i];
+            uint32_t const timestep = (loop->loop_type() == LoopType::FIXED_FREQ) ? loop->get_timestep_100ns() : 0;
+#if SCRUTINY_ENABLE_DATALOGGING
+            bool const datalogging = loop->datalogging_allowed();
+#else
+            bool const datalogging = false;
+#endif
+            uint_least8_t const name_length = static_cast<uint_least8_t>(tools::strnlen(loop->get_name(), protocol::MAX_LOOP_NAME_LENGTH));
+            codecs::encode_8_bits_8bits(static_cast<uint_least8_t>(loop->loop_type()), &buf[0]);
+            codecs::encode_8_bits_8bits(static_cast<uint_least8_t>(datalogging ? 1 : 0), &buf[1]);
+            codecs::encode_32_bits_big_endian_8bits(timestep, &buf[2]);
+            codecs::encode_8_bits_8bits(name_length, &buf[6]);
+            crc = tools::crc32(buf, 7, crc);
+
+            // The name is sent one 8 bits character per byte. Hashed by chunks as it can be longer than buf
+            char const *const name = loop->get_name();
+            uint_least8_t chunk_length = 0;
+            for (uint_least8_t j = 0; j < name_length; j++)
+            {
+                codecs::encode_8_bits_8bits(static_cast<uint_least8_t>(name[j]), &buf[chunk_length++]);
+                if (chunk_length == sizeof(buf) || j == name_length - 1)
+                {
+                    crc = tools::crc32(buf, chunk_length, crc);
+                    chunk_length = 0;
+                }
+            }
+        }
+
+#if SCRUTINY_SUPPORT_PROTECTED_REGIONS
+        for (uint_least8_t type = 0; type < 2; type++)
+        {
+            bool const readonly = (type == protocol::GetInfo::MemoryRegionType::ReadOnly);
+            uint_least8_t const count = readonly ? m_config.readonly_ranges_count() : m_config.forbidden_ranges_count();
+            AddressRange const *const ranges = readonly ? m_config.readonly_ranges() : m_config.forbidden_ranges();
+            codecs::encode_8_bits_8bits(count, buf);
+            crc = tools::crc32(buf, 1, crc);
+            for (uint_least8_t i = 0; i < count; i++)
+            {
+                uint_least8_t size = codecs::encode_address_big_endian_8bits(ranges[i].start, &buf[0]);
+                size += codecs::encode_address_big_endian_8bits(ranges[i].end, &buf[size]);
+                crc = tools::crc32(buf, size, crc);
+            }
+        }
+#endif
+        return crc;
+    }
+
 #if SCRUTINY_ENABLE_DATALOGGING
 
     bool MainHandler::fetch_variable(void const *const addr, VariableType::eVariableType const variable_type, AnyType *const val) const
@@ -309,12 +450,20 @@ namespace scrutiny
             m_datalogging.threadsafe_data.bytes_to_acquire_from_trigger_to_completion =
                 msg->data.datalogger_status_update.bytes_to_acquire_from_trigger_to_completion;
             m_datalogging.threadsafe_data.write_counter_since_trigger = msg->data.datalogger_status_update.write_counter_since_trigger;
-            if (m_datalogging.threadsafe_data.datalogger_state != datalogging::DataLogger::State::AcquisitionCompleted)
+            // A status sent before the owner processed a release would still tell that the released acquisition is available.
+            m_datalogging.threadsafe_data.acquisition_available =
+                msg->data.datalogger_status_update.acquisition_available && !m_datalogging.pending_acquisition_release;
+            if (!m_datalogging.threadsafe_data.acquisition_available)
             {
                 m_datalogging.reading_in_progress = false;
             }
             break;
         }
+        case LoopHandler::Loop2MainMessageID::DATALOGGER_ACQUISITION_RELEASED:
+        {
+            m_datalogging.pending_acquisition_release = false;
+            break;
+        }
         default:
             break;
         }
@@ -331,6 +480,7 @@ namespace scrutiny
         {
             // No owner, can read directly. Otherwise will be updated by an IPC message
             m_datalogging.threadsafe_data.datalogger_state = m_datalogging.datalogger.get_state();
+            m_datalogging.threadsafe_data.acquisition_available = m_datalogging.datalogger.acquisition_available();
 
             if (m_datalogging.new_owner != SCRUTINY_NULL) // We need to give ownership to someone else
             {
@@ -347,6 +497,8 @@ namespace scrutiny
             // No message from loop that can move these back to false.
             m_datalogging.request_arm_trigger = false;
             m_datalogging.request_disarm_trigger = false;
+            m_datalogging.request_release_acquisition = false;
+            m_datalogging.pending_acquisition_release = false;
         }
         else
         {
@@ -360,6 +512,12 @@ namespace scrutiny
                     m_datalogging.request_ownership_release = false;
                     m_datalogging.pending_ownership_release = true;
                 }
+                else if (m_datalogging.request_release_acquisition)
+                {
+                    msg.message_id = LoopHandler::Main2LoopMessageID::DATALOGGER_RELEASE_ACQUISITION;
+                    m_datalogging.owner->ipc_main2loop()->send(msg);
+                    m_datalogging.request_release_acquisition = false;
+                }
                 else if (m_datalogging.request_arm_trigger)
                 {
                     msg.message_id = LoopHandler::Main2LoopMessageID::DATALOGGER_ARM_TRIGGER;
@@ -390,9 +548,26 @@ namespace scrutiny
             if (loop->ipc_loop2main()->has_content())
             {
                 LoopHandler::Loop2MainMessage msg = loop->ipc_loop2main()->pop();
-                static_cast<void>(msg);
+                if (msg.message_id == LoopHandler::Loop2MainMessageID::STAGED_OPERATION_DONE)
+                {
+                    if (loop == m_staged_operation.loop && m_staged_operation.state == StagedOperationState::Requested)
+                    {
+                        m_staged_operation.state = StagedOperationState::Done;
+                    }
+                }
+#if SCRUTINY_ENABLE_STATISTICS
+                else if (
+                    msg.message_id == LoopHandler::Loop2MainMessageID::STATISTICS_STOPPED ||
+                    msg.message_id == LoopHandler::Loop2MainMessageID::STATISTICS_SNAPSHOT_TAKEN)
+                {
+                    process_statistics_loop_msg(loop, &msg);
+                }
+#endif
 #if SCRUTINY_ENABLE_DATALOGGING
-                process_datalogging_loop_msg(loop, &msg);
+                else
+                {
+                    process_datalogging_loop_msg(loop, &msg);
+                }
 #endif
             }
         }
@@ -402,59 +577,50 @@ namespace scrutiny
     {
         if (!m_enabled)
         {
-            m_processing_request = false;
-            m_disconnect_pending = false;
-            m_comm_handler.reset();
+            for (uint_least8_t i = 0; i < SCRUTINY_COMM_CHANNEL_COUNT; i++)
+            {
+                m_channels[i].processing_request = false;
+                m_channels[i].disconnect_pending = false;
+                m_channels[i].comm_handler.reset();
+            }
+            m_compressing_response = false;
 #if SCRUTINY_ENABLE_DATALOGGING
             m_datalogging.datalogger.reset();
 #endif
             return;
         }
         m_timebase.step(timestep_100ns);
-        m_comm_handler.process();
+        for (uint_least8_t i = 0; i < SCRUTINY_COMM_CHANNEL_COUNT; i++)
+        {
+            drain_rx_fifo(i);
+            m_channels[i].comm_handler.process();
+        }
         process_loops();
 #if SCRUTINY_ENABLE_DATALOGGING
         process_datalogging_logic();
 #endif
 
-        if (m_comm_handler.request_received() && !m_processing_request)
+        // Requests are processed one at a time, channels taking turns. A request that returns ProcessAgain or
+        // whose response is being compressed keeps its channel active, and the other channels wait, until it completes.
+        for (uint_least8_t i = 0; i < SCRUTINY_COMM_CHANNEL_COUNT; i++)
         {
-            protocol::Response *response = m_comm_handler.prepare_response();
-            process_request(m_comm_handler.get_request(), response);
-
-            if (static_cast<protocol::ResponseCode::eResponseCode>(response->response_code) == protocol::ResponseCode::ProcessAgain)
-            {
-                m_processing_request = false;
-                if (!m_process_again_timestamp_taken)
-                {
-                    m_process_again_timestamp = m_timebase.get_timestamp();
-                    m_process_again_timestamp_taken = true;
-                }
-                else
-                {
-                    if (m_timebase.has_expired(m_process_again_timestamp, SCRUTINY_REQUEST_MAX_PROCESS_TIME_US * 10))
-                    {
-                        // Set only response code. All other fields are set in process_request()
-                        response->response_code = static_cast<uint_least8_t>(protocol::ResponseCode::FailureToProceed);
-                        m_comm_handler.send_response(response);
-                        m_processing_request = true;
-                    }
-                }
-                // comm handler will stay in standby until we process the request. Data in rx buffer is guaranteed to stay valid until then
-            }
-            else if (static_cast<protocol::ResponseCode::eResponseCode>(response->response_code) == protocol::ResponseCode::NoResponseToSend)
+            if (!m_process_again_timestamp_taken && !m_compressing_response)
             {
-                m_processing_request = true;
-                // Will not be transmitting, therefore automatically wait for next request below
+                m_active_channel = static_cast<uint_least8_t>((m_active_channel + 1u) % SCRUTINY_COMM_CHANNEL_COUNT);
             }
-            else
+
+            process_active_channel();
+            if (m_process_again_timestamp_taken || m_compressing_response)
             {
-                m_processing_request = true;
-                m_comm_handler.send_response(response);
+                break;
             }
         }
 
-        check_finished_sending();
+        for (uint_least8_t i = 0; i < SCRUTINY_COMM_CHANNEL_COUNT; i++)
+        {
+            fill_tx_fifo(i);
+            check_finished_sending(i);
+        }
 
         // Some commands affect loops and datalogging, so we reprocess right away
         process_loops();
@@ -463,43 +629,219 @@ namespace scrutiny
 #endif
     }
 
-    void MainHandler::check_finished_sending(void)
+    void MainHandler::process_active_channel(void)
+    {
+        CommChannel *const channel = &m_channels[m_active_channel];
+        if (!channel->comm_handler.request_received())
+        {
+            m_process_again_timestamp_taken = false; // The comm handler dropped a pending request. The channel is released
+            m_compressing_response = false;
+            return;
+        }
+
+        if (m_compressing_response)
+        {
+            compress_active_response();
+            return;
+        }
+
+        if (channel->processing_request)
+        {
+            return;
+        }
+
+        protocol::Response *response = channel->comm_handler.prepare_response();
+        process_request(channel->comm_handler.get_request(), response);
+
+        if (static_cast<protocol::ResponseCode::eResponseCode>(response->response_code) == protocol::ResponseCode::ProcessAgain)
+        {
+            if (!m_process_again_timestamp_taken)
+            {
+                m_process_again_timestamp = m_timebase.get_timestamp();
+                m_process_again_timestamp_taken = true;
+            }
+            else
+            {
+                if (m_timebase.has_expired(m_process_again_timestamp, SCRUTINY_REQUEST_MAX_PROCESS_TIME_US * 10))
+                {
+                    // Set only response code. All other fields are set in process_request()
+                    response->response_code = static_cast<uint_least8_t>(protocol::ResponseCode::FailureToProceed);
+                    channel->comm_handler.send_response(response);
+                    channel->processing_request = true;
+                    m_process_again_timestamp_taken = false;
+                }
+            }
+            // comm handler will stay in standby until we process the request. Data in rx buffer is guaranteed to stay valid until then
+        }
+        else if (static_cast<protocol::ResponseCode::eResponseCode>(response->response_code) == protocol::ResponseCode::NoResponseToSend)
+        {
+            channel->processing_request = true;
+            m_process_again_timestamp_taken = false;
+            // Will not be transmitting, therefore automatically wait for next request below
+        }
+        else if (response->response_code == protocol::ResponseCode::OK && active_comm()->compression() && is_compressible_response(response))
+        {
+            // The compression work is bounded per call. The response is sent once compressed
+            m_process_again_timestamp_taken = false;
+            m_compressor.init(response, m_config.m_compression_buffer, m_config.m_compression_buffer_size);
+            m_compressing_response = true;
+            compress_active_response();
+        }
+        else
+        {
+            channel->processing_request = true;
+            m_process_again_timestamp_taken = false;
+            channel->comm_handler.send_response(response);
+        }
+    }
+
+    void MainHandler::compress_active_response(void)
+    {
+        if (m_compressor.process(SCRUTINY_COMPRESSION_ITEMS_PER_PROCESS))
+        {
+            CommChannel *const channel = &m_channels[m_active_channel];
+            m_compressing_response = false;
+            channel->processing_request = true;
+            channel->comm_handler.send_response(m_compressor.response());
+        }
+    }
+
+    void MainHandler::check_finished_sending(uint_least8_t const channel_index)
     {
-        if (m_processing_request)
+        CommChannel *const channel = &m_channels[channel_index];
+        if (channel->processing_request)
         {
-            if (!m_comm_handler.transmitting()) // Will be false if NoResponseToSend or if finished transmitting
+            if (!channel->comm_handler.transmitting()) // Will be false if NoResponseToSend or if finished transmitting
             {
-                m_comm_handler.wait_next_request(); // Allow reception of next request
-                m_processing_request = false;
-                m_process_again_timestamp_taken = false;
+                channel->comm_handler.wait_next_request(); // Allow reception of next request
+                channel->processing_request = false;
 
-                if (m_disconnect_pending)
+                if (channel->disconnect_pending)
                 {
-                    m_comm_handler.disconnect();
-                    m_disconnect_pending = false;
+                    channel->comm_handler.disconnect();
+                    channel->disconnect_pending = false;
                 }
             }
         }
     }
 
+    void MainHandler::drain_rx_fifo(uint_least8_t const channel_index)
+    {
+        CommChannel *const channel = &m_channels[channel_index];
+        if (!channel->rx_fifo.is_set())
+        {
+            return;
+        }
+
+        // The comm handler reads the bytes where the producer wrote them. The data wraps around the storage at most once
+        for (uint_least8_t i = 0; i < 2; i++)
+        {
+            uint16_t len;
+            unsigned char const *const data = channel->rx_fifo.read_region(&len);
+            if (len == 0)
+            {
+                break;
+            }
+            channel->comm_handler.receive_data(data, len);
+            channel->rx_fifo.commit_read(len);
+        }
+    }
+
+    void MainHandler::fill_tx_fifo(uint_least8_t const channel_index)
+    {
+        CommChannel *const channel = &m_channels[channel_index];
+        if (!channel->tx_fifo.is_set())
+        {
+            return;
+        }
+
+        // The comm handler writes directly in the storage of the FIFO. The free space wraps around the storage at most once
+        for (uint_least8_t i = 0; i < 2; i++)
+        {
+            uint16_t len;
+            unsigned char *const region = channel->tx_fifo.write_region(&len);
+            if (len == 0 || channel->comm_handler.data_to_send() == 0)
+            {
+                break;
+            }
+            channel->tx_fifo.commit_write(channel->comm_handler.pop_data(region, len));
+        }
+    }
+
     bool MainHandler::get_rpv(uint16_t const id, RuntimePublishedValue *const rpv) const
     {
         uint16_t const rpv_count = m_config.get_rpv_count();
-        bool found = false;
-        for (uint16_t i = 0; i < rpv_count; i++) // if unset this count will be 0
+        RuntimePublishedValue const *const rpvs = m_config.get_rpvs_array();
+        int32_t index = -1;
+        if (m_config.is_static_published_values()) // Sorted by ID. Checked by init()
         {
-            if (m_config.get_rpvs_array()[i].id == id)
+            uint16_t low = 0;
+            uint16_t high = rpv_count;
+            while (low < high)
             {
-                found = true;
-                if (rpv != SCRUTINY_NULL)
+                uint16_t const mid = static_cast<uint16_t>(low + (high - low) / 2);
+                if (rpvs[mid].id < id)
                 {
-                    *rpv = m_config.get_rpvs_array()[i];
+                    low = static_cast<uint16_t>(mid + 1);
+                }
+                else
+                {
+                    high = mid;
+                }
+            }
+            if (low < rpv_count && rpvs[low].id == id)
+            {
+                index = low;
+            }
+        }
+        else
+        {
+            for (uint16_t i = 0; i < rpv_count; i++) // if unset this count will be 0
+            {
+                if (rpvs[i].id == id)
+                {
+                    index = i;
+                    break;
                 }
-                break;
             }
         }
 
-        return found;
+        if (index >= 0 && rpv != SCRUTINY_NULL)
+        {
+            *rpv = rpvs[index];
+        }
+
+        return index >= 0;
+    }
+
+    bool MainHandler::read_rpv(RuntimePublishedValue const rpv, AnyType *const outval, LoopHandler *const caller) const
+    {
+        if (m_config.get_rpv_read_callback() != SCRUTINY_NULL_FN_PTR(RpvReadCallback))
+        {
+            return m_config.get_rpv_read_callback()(rpv, outval, caller);
+        }
+        return m_config.get_rpv_bulk_read_callback()(&rpv, outval, 1, caller);
+    }
+
+    bool MainHandler::read_rpvs(
+        RuntimePublishedValue const *const rpvs,
+        AnyType *const outvals,
+        uint16_t const count,
+        LoopHandler *const caller) const
+    {
+        if (m_config.get_rpv_bulk_read_callback() != SCRUTINY_NULL_FN_PTR(RpvBulkReadCallback))
+        {
+            return m_config.get_rpv_bulk_read_callback()(rpvs, outvals, count, caller);
+        }
+
+        for (uint16_t i = 0; i < count; i++)
+        {
+            if (!m_config.get_rpv_read_callback()(rpvs[i], &outvals[i], caller))
+            {
+                return false;
+            }
+        }
+        return true;
     }
 
     VariableType::eVariableType MainHandler::get_rpv_type(uint16_t const id) const
@@ -541,6 +883,13 @@ namespace scrutiny
             break;
 #endif
 
+#if SCRUTINY_ENABLE_STATISTICS
+            // ============= [Statistics] ===========
+        case protocol::CommandId::Statistics:
+            code = process_statistics(request, response);
+            break;
+#endif
+
             // ============= [UserCommand] ===========
         case protocol::CommandId::UserCommand:
             code = process_user_command(request, response);
@@ -559,6 +908,24 @@ namespace scrutiny
         }
     }
 
+    bool MainHandler::is_compressible_response(protocol::Response const *const response) const
+    {
+        // Only the bulk data is worth compressing. Memory dumps and acquisitions are mostly zeros and slowly varying values
+        if (response->command_id == protocol::CommandId::MemoryControl)
+        {
+            return response->subfunction_id == protocol::MemoryControl::Subfunction::Read ||
+                   response->subfunction_id == protocol::MemoryControl::Subfunction::ReadSnapshot ||
+                   response->subfunction_id == protocol::MemoryControl::Subfunction::ReadChanged;
+        }
+#if SCRUTINY_ENABLE_DATALOGGING
+        if (response->command_id == protocol::CommandId::DataLogControl)
+        {
+            return response->subfunction_id == protocol::DataLogControl::Subfunction::ReadAcquisition;
+        }
+#endif
+        return false;
+    }
+
     // ============= [GetInfo] ============
     protocol::ResponseCode::eResponseCode MainHandler::process_get_info(protocol::Request const *const request, protocol::Response *const response)
     {
@@ -608,6 +975,11 @@ namespace scrutiny
                 protocol::ResponseData::GetInfo::GetLoopDefinition response_data;
             } get_loop_def;
 
+            struct
+            {
+                protocol::ResponseData::GetInfo::GetConfigFingerprint response_data;
+            } get_config_fingerprint;
+
         } stack;
 
         protocol::ResponseCode::eResponseCode code = protocol::ResponseCode::FailureToProceed;
@@ -639,12 +1011,21 @@ namespace scrutiny
 #else
             stack.get_supported_features.response_data.datalogging = false;
 #endif
-            stack.get_supported_features.response_data.user_command = m_config.is_user_command_callback_set();
+#if SCRUTINY_ENABLE_STATISTICS
+            stack.get_supported_features.response_data.statistics = m_config.is_statistics_configured();
+#else
+            stack.get_supported_features.response_data.statistics = false;
+#endif
+            stack.get_supported_features.response_data.user_command =
+                m_config.is_user_command_callback_set() || m_config.is_async_user_command_callback_set();
 #if SCRUTINY_SUPPORT_64BITS
             stack.get_supported_features.response_data._64bits = true;
 #else
             stack.get_supported_features.response_data._64bits = false;
 #endif
+            stack.get_supported_features.response_data.native_endian = native_endian_supported();
+            stack.get_supported_features.response_data.compression = m_config.is_compression_buffer_set();
+            stack.get_supported_features.response_data.memory_watch = m_config.is_watched_blocks_set();
 
             code = m_codec.encode_response_supported_features(&stack.get_supported_features.response_data, response);
             break;
@@ -742,7 +1123,7 @@ namespace scrutiny
                 break;
             }
 
-            stack.get_prv_def.response_encoder = m_codec.encode_response_get_rpv_definition(response, m_comm_handler.tx_buffer_size());
+            stack.get_prv_def.response_encoder = m_codec.encode_response_get_rpv_definition(response, active_comm()->tx_buffer_size());
 
             if (stack.get_prv_def.request_data.start_index >= m_config.get_rpv_count())
             {
@@ -812,6 +1193,13 @@ namespace scrutiny
             break;
         }
 
+        case protocol::GetInfo::Subfunction::GetConfigFingerprint:
+        {
+            stack.get_config_fingerprint.response_data.fingerprint = m_config_fingerprint;
+            code = m_codec.encode_response_get_config_fingerprint(&stack.get_config_fingerprint.response_data, response);
+            break;
+        }
+
         default:
         {
             code = protocol::ResponseCode::UnsupportedFeature;
@@ -885,20 +1273,20 @@ namespace scrutiny
             if (code != protocol::ResponseCode::OK)
                 break;
 
-            if (stack.heartbeat.request_data.session_id != m_comm_handler.get_session_id())
+            if (stack.heartbeat.request_data.session_id != active_comm()->get_session_id())
             {
                 code = protocol::ResponseCode::InvalidRequest;
                 break;
             }
 
-            bool const success = m_comm_handler.heartbeat(stack.heartbeat.request_data.challenge);
+            bool const success = active_comm()->heartbeat(stack.heartbeat.request_data.challenge);
             if (!success)
             {
                 code = protocol::ResponseCode::InvalidRequest;
                 break;
             }
 
-            stack.heartbeat.response_data.session_id = m_comm_handler.get_session_id();
+            stack.heartbeat.response_data.session_id = active_comm()->get_session_id();
             stack.heartbeat.response_data.challenge_response = ~stack.heartbeat.request_data.challenge;
 
             code = m_codec.encode_response_comm_heartbeat(&stack.heartbeat.response_data, response);
@@ -908,13 +1296,14 @@ namespace scrutiny
             // =========== [GetParams] ==========
         case protocol::CommControl::Subfunction::GetParams:
         {
-            stack.get_params.response_data.data_tx_buffer_size = m_config.m_tx_buffer_size;
-            stack.get_params.response_data.data_rx_buffer_size = m_config.m_rx_buffer_size;
+            stack.get_params.response_data.data_tx_buffer_size = active_comm()->tx_buffer_size();
+            stack.get_params.response_data.data_rx_buffer_size = active_comm()->rx_buffer_size();
             stack.get_params.response_data.max_bitrate = m_config.max_bitrate;
             stack.get_params.response_data.comm_rx_timeout = SCRUTINY_COMM_RX_TIMEOUT_US;
             stack.get_params.response_data.heartbeat_timeout = SCRUTINY_COMM_HEARTBEAT_TIMEOUT_US;
             stack.get_params.response_data.address_size = SIZEOF_8BITS(void *);
             stack.get_params.response_data.char_bit = CHAR_BIT;
+            stack.get_params.response_data.jumbo_tx_buffer_size = active_comm()->jumbo_tx_buffer_size();
             code = m_codec.encode_response_comm_get_params(&stack.get_params.response_data, response);
             break;
         }
@@ -927,19 +1316,45 @@ namespace scrutiny
                 break;
             }
 
-            if (m_comm_handler.is_connected())
+            if (active_comm()->is_connected())
             {
                 code = protocol::ResponseCode::Busy;
                 break;
             }
 
-            if (m_comm_handler.connect() == false)
+            if (active_comm()->connect() == false)
             {
                 code = protocol::ResponseCode::FailureToProceed;
                 break;
             }
 
-            stack.connect.response_data.session_id = m_comm_handler.get_session_id();
+            // Unknown flags are dropped. The server knows what got accepted from the flags sent back.
+            stack.connect.response_data.flags = 0;
+            if (native_endian_supported() && (stack.connect.request_data.flags & protocol::CommControl::ConnectFlags::NativeEndian))
+            {
+                stack.connect.response_data.flags |= protocol::CommControl::ConnectFlags::NativeEndian;
+            }
+            if (m_config.is_compression_buffer_set() && (stack.connect.request_data.flags & protocol::CommControl::ConnectFlags::Compression))
+            {
+                stack.connect.response_data.flags |= protocol::CommControl::ConnectFlags::Compression;
+            }
+            if (active_comm()->tx_buffer_size() <= protocol::FRAMING_MAX_TX_BUFFER_SIZE &&
+                (stack.connect.request_data.flags & protocol::CommControl::ConnectFlags::Framing))
+            {
+                stack.connect.response_data.flags |= protocol::CommControl::ConnectFlags::Framing;
+            }
+            // The COBS encoding counts with 16 bits. Both cannot be used together
+            if (active_comm()->jumbo_tx_buffer_size() != 0 &&
+                (stack.connect.response_data.flags & protocol::CommControl::ConnectFlags::Framing) == 0 &&
+                (stack.connect.request_data.flags & protocol::CommControl::ConnectFlags::JumboFrames))
+            {
+                stack.connect.response_data.flags |= protocol::CommControl::ConnectFlags::JumboFrames;
+            }
+            active_comm()->set_session_flags(stack.connect.response_data.flags);
+            invalidate_watched_blocks(); // A new session has not received anything yet
+
+            stack.connect.response_data.has_flags = stack.connect.request_data.has_flags;
+            stack.connect.response_data.session_id = active_comm()->get_session_id();
             memcpy(stack.connect.response_data.magic, protocol::CommControl::CONNECT_MAGIC, sizeof(protocol::CommControl::CONNECT_MAGIC));
             code = m_codec.encode_response_comm_connect(&stack.connect.response_data, response);
             break;
@@ -952,11 +1367,11 @@ namespace scrutiny
             if (code != protocol::ResponseCode::OK)
                 break;
 
-            if (m_comm_handler.is_connected())
+            if (active_comm()->is_connected())
             {
-                if (m_comm_handler.get_session_id() == stack.disconnect.request_data.session_id)
+                if (active_comm()->get_session_id() == stack.disconnect.request_data.session_id)
                 {
-                    m_disconnect_pending = true;
+                    m_channels[m_active_channel].disconnect_pending = true;
                 }
                 else
                 {
@@ -1009,9 +1424,10 @@ namespace scrutiny
                 protocol::ReadRPVRequestParser *readrpv_parser;
                 protocol::ReadRPVResponseEncoder *readrpv_encoder;
 
-                RuntimePublishedValue rpv;
-                scrutiny::AnyType v;
+                RuntimePublishedValue rpvs[SCRUTINY_READ_RPV_CHUNK_SIZE];
+                scrutiny::AnyType values[SCRUTINY_READ_RPV_CHUNK_SIZE];
                 uint16_t id;
+                uint_least8_t count;
             } read_rpv;
 
             struct
@@ -1032,7 +1448,7 @@ namespace scrutiny
             code = protocol::ResponseCode::OK;
 
             stack.read_mem.readmem_parser = m_codec.decode_request_memory_control_read(request);
-            stack.read_mem.readmem_encoder = m_codec.encode_response_memory_control_read(response, m_comm_handler.tx_buffer_size());
+            stack.read_mem.readmem_encoder = m_codec.encode_response_memory_control_read(response, active_comm()->response_max_length());
 
             // We avoid playing in memory unless we are 100% sure the request is good.
             if (!stack.read_mem.readmem_parser->is_valid())
@@ -1041,7 +1457,7 @@ namespace scrutiny
                 break;
             }
 
-            if (stack.read_mem.readmem_parser->required_tx_buffer_size() > m_comm_handler.tx_buffer_size())
+            if (stack.read_mem.readmem_parser->required_tx_buffer_size() > active_comm()->response_max_length())
             {
                 code = protocol::ResponseCode::Overflow;
                 break;
@@ -1089,14 +1505,14 @@ namespace scrutiny
             }
 
             stack.write_mem.writemem_parser = m_codec.decode_request_memory_control_write(request, masked);
-            stack.write_mem.writemem_encoder = m_codec.encode_response_memory_control_write(response, m_comm_handler.tx_buffer_size());
+            stack.write_mem.writemem_encoder = m_codec.encode_response_memory_control_write(response, active_comm()->tx_buffer_size());
             if (!stack.write_mem.writemem_parser->is_valid())
             {
                 code = protocol::ResponseCode::InvalidRequest;
                 break;
             }
 
-            if (stack.write_mem.writemem_parser->required_tx_buffer_size() > m_comm_handler.tx_buffer_size())
+            if (stack.write_mem.writemem_parser->required_tx_buffer_size() > active_comm()->tx_buffer_size())
             {
                 code = protocol::ResponseCode::Overflow;
                 break;
@@ -1127,43 +1543,7 @@ namespace scrutiny
                 stack.write_mem.writemem_encoder->write(&stack.write_mem.block);
                 // We don't check overflow here as we rely on the request parser to be right on the required buffer size.
 
-                if (!masked)
-                {
-                    tools::memcpy_compress_from_8bits_native(
-                        stack.write_mem.block.start_address,
-                        stack.write_mem.block.source_data,
-                        stack.write_mem.block.length);
-                }
-                else
-                {
-                    for (uint16_t i = 0; i < stack.write_mem.block.length_char(); i++)
-                    {
-                        unsigned char temp;
-                        temp = stack.write_mem.block.start_address[i];
-#if CHAR_BIT == 8
-                        temp |= (stack.write_mem.block.source_data[i] & stack.write_mem.block.mask[i]);    // Bit to 1
-                        temp &= (stack.write_mem.block.source_data[i] | (~stack.write_mem.block.mask[i])); // Bit to 0
-#elif CHAR_BIT == 16
-                        unsigned char val16bits;
-                        unsigned char mask16bits;
-                        if (tools::is_little_endian())
-                        {
-                            val16bits = codecs::decode_16_bits_little_endian_8bits(&stack.write_mem.block.source_data[2 * i]);
-                            mask16bits = codecs::decode_16_bits_little_endian_8bits(&stack.write_mem.block.mask[2 * i]);
-                        }
-                        else
-                        {
-                            val16bits = codecs::decode_16_bits_big_endian_8bits(&stack.write_mem.block.source_data[2 * i]);
-                            mask16bits = codecs::decode_16_bits_big_endian_8bits(&stack.write_mem.block.mask[2 * i]);
-                        }
-                        temp |= (val16bits & mask16bits);    // Bit to 1
-                        temp &= (val16bits | (~mask16bits)); // Bit to 0
-#else
-#error
-#endif
-                        stack.write_mem.block.start_address[i] = temp;
-                    }
-                }
+                write_memory_block(&stack.write_mem.block, masked);
             }
             break;
         }
@@ -1179,7 +1559,8 @@ namespace scrutiny
             }
 
             stack.read_rpv.readrpv_parser = m_codec.decode_request_memory_control_read_rpv(request);
-            stack.read_rpv.readrpv_encoder = m_codec.encode_response_memory_control_read_rpv(response, m_comm_handler.tx_buffer_size());
+            stack.read_rpv.readrpv_encoder =
+                m_codec.encode_response_memory_control_read_rpv(response, active_comm()->tx_buffer_size(), active_comm()->native_endian());
 
             if (!stack.read_rpv.readrpv_parser->is_valid())
             {
@@ -1187,7 +1568,9 @@ namespace scrutiny
                 break;
             }
 
-            while (!stack.read_rpv.readrpv_parser->finished())
+            // RPVs are read by chunks so that a bulk read callback can fetch many values in a single call.
+            stack.read_rpv.count = 0;
+            while (code == protocol::ResponseCode::OK && !stack.read_rpv.readrpv_parser->finished())
             {
                 bool const ok_to_process = stack.read_rpv.readrpv_parser->next(&stack.read_rpv.id);
 
@@ -1199,27 +1582,35 @@ namespace scrutiny
 
                 if (ok_to_process)
                 {
-                    bool const rpv_found = get_rpv(stack.read_rpv.id, &stack.read_rpv.rpv);
+                    bool const rpv_found = get_rpv(stack.read_rpv.id, &stack.read_rpv.rpvs[stack.read_rpv.count]);
                     if (!rpv_found)
                     {
                         code = protocol::ResponseCode::FailureToProceed;
                         break;
                     }
+                    stack.read_rpv.count++;
+                }
 
-                    bool const callback_success = m_config.get_rpv_read_callback()(stack.read_rpv.rpv, &stack.read_rpv.v, SCRUTINY_NULL);
+                if (stack.read_rpv.count == SCRUTINY_READ_RPV_CHUNK_SIZE || (stack.read_rpv.count > 0 && stack.read_rpv.readrpv_parser->finished()))
+                {
+                    bool const callback_success = read_rpvs(stack.read_rpv.rpvs, stack.read_rpv.values, stack.read_rpv.count, SCRUTINY_NULL);
                     if (!callback_success)
                     {
                         code = protocol::ResponseCode::FailureToProceed;
                         break;
                     }
 
-                    stack.read_rpv.readrpv_encoder->write(&stack.read_rpv.rpv, stack.read_rpv.v);
-
-                    if (stack.read_rpv.readrpv_encoder->overflow())
+                    for (uint_fast8_t i = 0; i < stack.read_rpv.count; i++)
                     {
-                        code = protocol::ResponseCode::Overflow;
-                        break;
+                        stack.read_rpv.readrpv_encoder->write(&stack.read_rpv.rpvs[i], stack.read_rpv.values[i]);
+
+                        if (stack.read_rpv.readrpv_encoder->overflow())
+                        {
+                            code = protocol::ResponseCode::Overflow;
+                            break;
+                        }
                     }
+                    stack.read_rpv.count = 0;
                 }
             }
             break;
@@ -1235,7 +1626,7 @@ namespace scrutiny
             }
 
             stack.write_rpv.writerpv_parser = m_codec.decode_request_memory_control_write_rpv(request, this);
-            stack.write_rpv.writerpv_encoder = m_codec.encode_response_memory_control_write_rpv(response, m_comm_handler.tx_buffer_size());
+            stack.write_rpv.writerpv_encoder = m_codec.encode_response_memory_control_write_rpv(response, active_comm()->tx_buffer_size());
 
             if (!stack.write_rpv.writerpv_parser->is_valid())
             {
@@ -1277,6 +1668,24 @@ namespace scrutiny
             break;
         }
 
+            // =========== [Snapshot reads / Deferred writes] ==========
+        case protocol::MemoryControl::Subfunction::ReadSnapshot:        // fall through
+        case protocol::MemoryControl::Subfunction::ReadRPVSnapshot:     // fall through
+        case protocol::MemoryControl::Subfunction::WriteDeferred:       // fall through
+        case protocol::MemoryControl::Subfunction::WriteMaskedDeferred: // fall through
+        case protocol::MemoryControl::Subfunction::WriteRPVDeferred:
+        {
+            code = process_staged_operation(request, response);
+            break;
+        }
+
+            // =========== [ReadChanged] ==========
+        case protocol::MemoryControl::Subfunction::ReadChanged:
+        {
+            code = process_read_changed(request, response);
+            break;
+        }
+
             // =================================
         default:
         {
@@ -1288,22 +1697,604 @@ namespace scrutiny
         return code;
     }
 
-#if SCRUTINY_SUPPORT_PROTECTED_REGIONS
-    bool MainHandler::touches_forbidden_region(void const *const addr_start, size_t const length) const
+    protocol::ResponseCode::eResponseCode MainHandler::process_read_changed(
+        protocol::Request const *const request,
+        protocol::Response *const response)
     {
-        if (!m_config.is_forbidden_address_range_set())
+        if (!m_config.is_watched_blocks_set())
         {
-            return false;
+            return protocol::ResponseCode::UnsupportedFeature;
         }
 
-        uintptr_t const block_start = reinterpret_cast<uintptr_t>(addr_start);
-        uintptr_t const block_end = block_start + length - 1;
-
-        for (unsigned int i = 0; i < m_config.forbidden_ranges_count(); i++)
+        // The block states are relative to what a single server received
+        if (m_watched_blocks_channel != m_active_channel)
         {
-            AddressRange const &range = m_config.forbidden_ranges()[i];
+            invalidate_watched_blocks();
+            m_watched_blocks_channel = m_active_channel;
+        }
 
-            if (block_start <= reinterpret_cast<uintptr_t>(range.end) && block_end >= reinterpret_cast<uintptr_t>(range.start))
+        // A request with no block lets the server resynchronize, for instance after losing a response.
+        if (request->data_length == 0)
+        {
+            invalidate_watched_blocks();
+            response->data_length = 0;
+            return protocol::ResponseCode::OK;
+        }
+
+        // The hashes of the blocks sent in a response are committed only once the server echoes its sequence number.
+        // A lost response is not acknowledged and its blocks are sent again.
+        bool const acknowledged = (request->data[0] == m_read_changed_sequence);
+        for (uint16_t i = 0; i < m_config.m_watched_block_count; i++)
+        {
+            WatchedMemoryBlock *const watched = &m_config.m_watched_blocks[i];
+            if (watched->pending && acknowledged)
+            {
+                watched->hash = watched->pending_hash;
+                watched->valid = 1;
+            }
+            watched->pending = 0;
+        }
+        m_read_changed_sequence = static_cast<uint_least8_t>((m_read_changed_sequence + 1u) & 0xFFu); // Wraps like the 8 bits on the wire
+
+        protocol::Request subrequest = *request;
+        subrequest.data = &request->data[1];
+        subrequest.data_length = static_cast<uint16_t>(request->data_length - 1);
+        protocol::Response subresponse = *response;
+        subresponse.data = &response->data[1];
+        uint32_t const max_length = active_comm()->response_max_length() - 1;
+
+        protocol::ResponseCode::eResponseCode code = protocol::ResponseCode::OK;
+        MemoryBlock8Bits block;
+        protocol::ReadMemoryBlocksRequestParser *const parser = m_codec.decode_request_memory_control_read(&subrequest);
+        protocol::ReadMemoryBlocksResponseEncoder *const encoder = m_codec.encode_response_memory_control_read(&subresponse, max_length);
+
+        if (!parser->is_valid())
+        {
+            return protocol::ResponseCode::InvalidRequest;
+        }
+
+        if (parser->required_tx_buffer_size() > max_length)
+        {
+            return protocol::ResponseCode::Overflow;
+        }
+
+        uint16_t block_index = 0;
+        while (!parser->finished())
+        {
+            parser->next(&block);
+            if (!parser->is_valid())
+            {
+                code = protocol::ResponseCode::InvalidRequest;
+                break;
+            }
+#if SCRUTINY_SUPPORT_PROTECTED_REGIONS
+            if (touches_forbidden_region(&block))
+            {
+                code = protocol::ResponseCode::Forbidden;
+                break;
+            }
+#endif
+            unsigned char *const data = encoder->reserve(&block);
+            if (encoder->overflow())
+            {
+                code = protocol::ResponseCode::Overflow;
+                break;
+            }
+            tools::memcpy_dilate_8bits_native(data, block.start_address, block.length);
+
+            // The hash is computed on the response data, which has 8 bits per char whatever the device is.
+            if (block_index < m_config.m_watched_block_count)
+            {
+                WatchedMemoryBlock *const watched = &m_config.m_watched_blocks[block_index];
+                uint32_t const hash = tools::crc32(data, block.length);
+                if (watched->start_address != block.start_address || watched->length != block.length)
+                {
+                    watched->start_address = block.start_address;
+                    watched->length = block.length;
+                    watched->valid = 0;
+                }
+
+                if (watched->valid && watched->hash == hash)
+                {
+                    encoder->discard_last();
+                }
+                else
+                {
+                    watched->pending_hash = hash;
+                    watched->pending = 1;
+                }
+            }
+            block_index++;
+        }
+
+        if (code != protocol::ResponseCode::OK)
+        {
+            for (uint16_t i = 0; i < m_config.m_watched_block_count; i++)
+            {
+                m_config.m_watched_blocks[i].pending = 0; // The server gets none of the changed blocks
+            }
+            return code;
+        }
+
+        response->data[0] = static_cast<unsigned char>(m_read_changed_sequence);
+        response->data_length = subresponse.data_length + 1;
+        return code;
+    }
+
+    void MainHandler::invalidate_watched_blocks(void)
+    {
+        if (!m_config.is_watched_blocks_set())
+        {
+            return;
+        }
+
+        for (uint16_t i = 0; i < m_config.m_watched_block_count; i++)
+        {
+            m_config.m_watched_blocks[i].valid = 0;
+            m_config.m_watched_blocks[i].pending = 0;
+        }
+    }
+
+    void MainHandler::write_memory_block(MemoryBlock8Bits const *const block, bool const masked) const
+    {
+        if (!masked)
+        {
+            tools::memcpy_compress_from_8bits_native(block->start_address, block->source_data, block->length);
+        }
+        else
+        {
+            tools::masked_write_from_8bits_native(block->start_address, block->source_data, block->mask, block->length);
+        }
+    }
+
+    protocol::ResponseCode::eResponseCode MainHandler::process_staged_operation(
+        protocol::Request const *const request,
+        protocol::Response *const response)
+    {
+        protocol::MemoryControl::Subfunction::eSubfunction const subfunction =
+            static_cast<protocol::MemoryControl::Subfunction::eSubfunction>(request->subfunction_id);
+
+        if (!m_config.is_staging_buffer_set())
+        {
+            return protocol::ResponseCode::UnsupportedFeature;
+        }
+
+        if (subfunction == protocol::MemoryControl::Subfunction::ReadRPVSnapshot && !m_config.is_read_published_values_configured())
+        {
+            return protocol::ResponseCode::UnsupportedFeature;
+        }
+
+        if (subfunction == protocol::MemoryControl::Subfunction::WriteRPVDeferred && !m_config.is_write_published_values_configured())
+        {
+            return protocol::ResponseCode::UnsupportedFeature;
+        }
+
+        if ((subfunction == protocol::MemoryControl::Subfunction::WriteDeferred ||
+             subfunction == protocol::MemoryControl::Subfunction::WriteMaskedDeferred) &&
+            m_config.memory_write_enable == false)
+        {
+            return protocol::ResponseCode::Forbidden;
+        }
+
+        // On the first call for a request, anything in progress was started by a request that timed out.
+        // The loop may still be using the staging buffer, so we wait for it before starting over.
+        if (!m_process_again_timestamp_taken)
+        {
+            m_staged_operation.stale = (m_staged_operation.state != StagedOperationState::Idle);
+        }
+
+        if (m_staged_operation.state == StagedOperationState::Requested)
+        {
+            return protocol::ResponseCode::ProcessAgain;
+        }
+
+        if (m_staged_operation.state == StagedOperationState::Done)
+        {
+            m_staged_operation.state = StagedOperationState::Idle;
+            if (!m_staged_operation.stale)
+            {
+                if (!m_staged_operation.success)
+                {
+                    return protocol::ResponseCode::FailureToProceed;
+                }
+                return encode_staged_operation_response(response);
+            }
+            m_staged_operation.stale = false;
+        }
+
+        // Idle. First byte is the loop ID, the rest is a regular Read, ReadRPV, Write, WriteMasked or WriteRPV request.
+        if (request->data_length < 1)
+        {
+            return protocol::ResponseCode::InvalidRequest;
+        }
+
+        uint_least8_t const loop_id = request->data[0];
+        if (loop_id >= m_config.m_loop_count)
+        {
+            return protocol::ResponseCode::FailureToProceed;
+        }
+
+        LoopHandler *const loop = m_config.m_loops[loop_id];
+        if (loop->ipc_main2loop()->has_content())
+        {
+            return protocol::ResponseCode::ProcessAgain; // The loop has not processed the previous message yet.
+        }
+
+        protocol::Request subrequest = *request;
+        subrequest.data = &request->data[1];
+        subrequest.data_length = static_cast<uint16_t>(request->data_length - 1);
+
+        protocol::ResponseCode::eResponseCode const code = stage_operation(&subrequest, response);
+        if (code != protocol::ResponseCode::OK)
+        {
+            return code;
+        }
+
+        m_staged_operation.loop = loop;
+        m_staged_operation.success = false;
+        m_staged_operation.state = StagedOperationState::Requested;
+        LoopHandler::Main2LoopMessage msg;
+        msg.message_id = LoopHandler::Main2LoopMessageID::PROCESS_STAGED_OPERATION;
+        loop->ipc_main2loop()->send(msg);
+        return protocol::ResponseCode::ProcessAgain;
+    }
+
+    protocol::ResponseCode::eResponseCode MainHandler::stage_operation(protocol::Request const *const request, protocol::Response *const response)
+    {
+        // Everything is validated here so that the loop only has to apply the operation.
+        // The staging buffer content must fit in the Tx buffer once the operation is done.
+        uint16_t const max_size = SCRUTINY_MIN(m_config.m_staging_buffer_size, active_comm()->tx_buffer_size());
+        m_staged_operation.subfunction = static_cast<protocol::MemoryControl::Subfunction::eSubfunction>(request->subfunction_id);
+        m_staged_operation.native_endian = active_comm()->native_endian();
+        m_staged_operation.response.reset();
+        bool copy_request = false;
+
+        switch (m_staged_operation.subfunction)
+        {
+        case protocol::MemoryControl::Subfunction::ReadSnapshot:
+        {
+            // The response is laid out as if it was a Read response, without reading the values.
+            MemoryBlock8Bits block;
+            protocol::ReadMemoryBlocksRequestParser *const parser = m_codec.decode_request_memory_control_read(request);
+            protocol::ReadMemoryBlocksResponseEncoder *const encoder =
+                m_codec.encode_response_memory_control_read(&m_staged_operation.response, max_size);
+
+            if (!parser->is_valid())
+            {
+                return protocol::ResponseCode::InvalidRequest;
+            }
+
+            while (!parser->finished())
+            {
+                parser->next(&block);
+                if (!parser->is_valid())
+                {
+                    return protocol::ResponseCode::InvalidRequest;
+                }
+#if SCRUTINY_SUPPORT_PROTECTED_REGIONS
+                if (touches_forbidden_region(&block))
+                {
+                    return protocol::ResponseCode::Forbidden;
+                }
+#endif
+                encoder->reserve(&block);
+                if (encoder->overflow())
+                {
+                    return protocol::ResponseCode::Overflow;
+                }
+            }
+            break;
+        }
+
+        case protocol::MemoryControl::Subfunction::ReadRPVSnapshot:
+        {
+            // The response is laid out as if it was a ReadRPV response, with all values set to 0.
+            uint16_t id;
+            RuntimePublishedValue rpv;
+            AnyType zero;
+            tools::set_biggest_uint(zero, 0);
+            protocol::ReadRPVRequestParser *const parser = m_codec.decode_request_memory_control_read_rpv(request);
+            protocol::ReadRPVResponseEncoder *const encoder =
+                m_codec.encode_response_memory_control_read_rpv(&m_staged_operation.response, max_size);
+
+            if (!parser->is_valid())
+            {
+                return protocol::ResponseCode::InvalidRequest;
+            }
+
+            while (!parser->finished())
+            {
+                bool const ok_to_process = parser->next(&id);
+                if (!parser->is_valid())
+                {
+                    return protocol::ResponseCode::InvalidRequest;
+                }
+
+                if (ok_to_process)
+                {
+                    if (!get_rpv(id, &rpv))
+                    {
+                        return protocol::ResponseCode::FailureToProceed;
+                    }
+
+                    encoder->write(&rpv, zero);
+                    if (encoder->overflow())
+                    {
+                        return protocol::ResponseCode::Overflow;
+                    }
+                }
+            }
+            break;
+        }
+
+        case protocol::MemoryControl::Subfunction::WriteDeferred: // fall through
+        case protocol::MemoryControl::Subfunction::WriteMaskedDeferred:
+        {
+            bool const masked = m_staged_operation.subfunction == protocol::MemoryControl::Subfunction::WriteMaskedDeferred;
+            MemoryBlock8Bits block;
+            protocol::WriteMemoryBlocksRequestParser *const parser = m_codec.decode_request_memory_control_write(request, masked);
+            if (!parser->is_valid())
+            {
+                return protocol::ResponseCode::InvalidRequest;
+            }
+
+            if (parser->required_tx_buffer_size() > active_comm()->tx_buffer_size())
+            {
+                return protocol::ResponseCode::Overflow;
+            }
+
+            while (!parser->finished())
+            {
+                parser->next(&block);
+                if (!parser->is_valid())
+                {
+                    return protocol::ResponseCode::InvalidRequest;
+                }
+#if SCRUTINY_SUPPORT_PROTECTED_REGIONS
+                if (touches_forbidden_region(&block) || touches_readonly_region(&block))
+                {
+                    return protocol::ResponseCode::Forbidden;
+                }
+#endif
+            }
+            copy_request = true;
+            break;
+        }
+
+        case protocol::MemoryControl::Subfunction::WriteRPVDeferred:
+        {
+            RuntimePublishedValue rpv;
+            AnyType v;
+            protocol::WriteRPVRequestParser *const parser = m_codec.decode_request_memory_control_write_rpv(request, this);
+            protocol::WriteRPVResponseEncoder *const encoder = m_codec.encode_response_memory_control_write_rpv(response, max_size);
+            if (!parser->is_valid())
+            {
+                return protocol::ResponseCode::InvalidRequest;
+            }
+
+            while (!parser->finished())
+            {
+                bool const ok_to_process = parser->next(&rpv, &v);
+                if (!parser->is_valid())
+                {
+                    return protocol::ResponseCode::InvalidRequest;
+                }
+
+                if (ok_to_process)
+                {
+                    encoder->write(&rpv); // Only to validate the response size. Encoded again once the values are written.
+                    if (encoder->overflow())
+                    {
+                        return protocol::ResponseCode::Overflow;
+                    }
+                }
+            }
+            copy_request = true;
+            break;
+        }
+
+        default:
+        {
+            return protocol::ResponseCode::UnsupportedFeature;
+        }
+        }
+
+        // Writes are applied from a copy of the request. The Rx buffer may be reused if the request times out.
+        if (copy_request)
+        {
+            if (request->data_length > m_config.m_staging_buffer_size)
+            {
+                return protocol::ResponseCode::Overflow;
+            }
+            memcpy(m_config.m_staging_buffer, request->data, request->data_length);
+            m_staged_operation.request = *request;
+            m_staged_operation.request.data = m_config.m_staging_buffer;
+        }
+
+        return protocol::ResponseCode::OK;
+    }
+
+    protocol::ResponseCode::eResponseCode MainHandler::encode_staged_operation_response(protocol::Response *const response)
+    {
+        if (m_staged_operation.subfunction == protocol::MemoryControl::Subfunction::ReadSnapshot ||
+            m_staged_operation.subfunction == protocol::MemoryControl::Subfunction::ReadRPVSnapshot)
+        {
+            memcpy(response->data, m_staged_operation.response.data, m_staged_operation.response.data_length);
+            response->data_length = m_staged_operation.response.data_length;
+        }
+        else if (m_staged_operation.subfunction == protocol::MemoryControl::Subfunction::WriteRPVDeferred)
+        {
+            RuntimePublishedValue rpv;
+            AnyType v;
+            protocol::WriteRPVRequestParser *const parser =
+                m_codec.decode_request_memory_control_write_rpv(&m_staged_operation.request, this);
+            protocol::WriteRPVResponseEncoder *const encoder =
+                m_codec.encode_response_memory_control_write_rpv(response, active_comm()->tx_buffer_size());
+            while (!parser->finished() && parser->is_valid())
+            {
+                if (parser->next(&rpv, &v))
+                {
+                    encoder->write(&rpv);
+                }
+            }
+        }
+        else
+        {
+            MemoryBlock8Bits block;
+            bool const masked = m_staged_operation.subfunction == protocol::MemoryControl::Subfunction::WriteMaskedDeferred;
+            protocol::WriteMemoryBlocksRequestParser *const parser =
+                m_codec.decode_request_memory_control_write(&m_staged_operation.request, masked);
+            protocol::WriteMemoryBlocksResponseEncoder *const encoder =
+                m_codec.encode_response_memory_control_write(response, active_comm()->tx_buffer_size());
+            while (!parser->finished() && parser->is_valid())
+            {
+                parser->next(&block);
+                encoder->write(&block);
+            }
+        }
+
+        return protocol::ResponseCode::OK;
+    }
+
+    void MainHandler::execute_staged_operation(LoopHandler *const caller)
+    {
+        // Called from the loop. The operation has been validated by the Main Handler.
+        // Local parsers are used because the ones in the codec belong to the Main Handler.
+        bool success = true;
+
+        switch (m_staged_operation.subfunction)
+        {
+        case protocol::MemoryControl::Subfunction::ReadSnapshot:
+        {
+            // Walks the response laid out by the Main Handler and fills the data of each block.
+            unsigned char *const data = m_staged_operation.response.data;
+            uint16_t const length = m_staged_operation.response.data_length;
+            uint16_t cursor = 0;
+            while (cursor < length)
+            {
+                uintptr_t addr;
+                cursor += codecs::decode_address_big_endian_8bits(&data[cursor], &addr);
+                uint16_t const block_length = codecs::decode_16_bits_big_endian_8bits(&data[cursor]);
+                cursor += 2;
+                tools::memcpy_dilate_8bits_native(&data[cursor], reinterpret_cast<void const *>(addr), block_length);
+                cursor += block_length;
+            }
+            break;
+        }
+
+        case protocol::MemoryControl::Subfunction::ReadRPVSnapshot:
+        {
+            // Walks the response laid out by the Main Handler and fills the value of each RPV.
+            unsigned char *const data = m_staged_operation.response.data;
+            uint16_t const length = m_staged_operation.response.data_length;
+            uint16_t cursor = 0;
+            RuntimePublishedValue rpvs[SCRUTINY_READ_RPV_CHUNK_SIZE];
+            AnyType values[SCRUTINY_READ_RPV_CHUNK_SIZE];
+            uint16_t positions[SCRUTINY_READ_RPV_CHUNK_SIZE];
+            uint_least8_t count = 0;
+            while (cursor < length)
+            {
+                get_rpv(codecs::decode_16_bits_big_endian_8bits(&data[cursor]), &rpvs[count]); // Validated by the Main Handler
+                positions[count] = static_cast<uint16_t>(cursor + 2);
+                cursor = static_cast<uint16_t>(cursor + 2 + tools::get_type_size_8bits(rpvs[count].type));
+                count++;
+
+                if (count == SCRUTINY_READ_RPV_CHUNK_SIZE || cursor >= length)
+                {
+                    if (read_rpvs(rpvs, values, count, caller))
+                    {
+                        for (uint_fast8_t i = 0; i < count; i++)
+                        {
+                            uint_least8_t const typesize = tools::get_type_size_8bits(rpvs[i].type);
+                            if (m_staged_operation.native_endian)
+                            {
+                                codecs::encode_anytype_native_8bits(&values[i], typesize, &data[positions[i]]);
+                            }
+                            else
+                            {
+                                codecs::encode_anytype_big_endian_8bits(&values[i], typesize, &data[positions[i]]);
+                            }
+                        }
+                    }
+                    else
+                    {
+                        success = false;
+                    }
+                    count = 0;
+                }
+            }
+            break;
+        }
+
+        case protocol::MemoryControl::Subfunction::WriteDeferred: // fall through
+        case protocol::MemoryControl::Subfunction::WriteMaskedDeferred:
+        {
+            MemoryBlock8Bits block;
+            bool const masked = m_staged_operation.subfunction == protocol::MemoryControl::Subfunction::WriteMaskedDeferred;
+            protocol::WriteMemoryBlocksRequestParser parser;
+            parser.init(&m_staged_operation.request, masked);
+            while (!parser.finished() && parser.is_valid())
+            {
+                parser.next(&block);
+                write_memory_block(&block, masked);
+            }
+            break;
+        }
+
+        case protocol::MemoryControl::Subfunction::WriteRPVDeferred:
+        {
+            RuntimePublishedValue rpv;
+            AnyType v;
+            protocol::WriteRPVRequestParser parser;
+            // The whole batch is parsed before the first value is written so that the task never sees part of a request.
+            parser.init(&m_staged_operation.request, this);
+            while (!parser.finished() && parser.is_valid())
+            {
+                parser.next(&rpv, &v);
+            }
+            if (!parser.is_valid())
+            {
+                success = false;
+                break;
+            }
+
+            // A value refused by the callback does not stop the others. See RpvWriteCallback
+            parser.init(&m_staged_operation.request, this);
+            while (!parser.finished())
+            {
+                parser.next(&rpv, &v);
+                if (!m_config.get_rpv_write_callback()(rpv, &v, caller))
+                {
+                    success = false;
+                }
+            }
+            break;
+        }
+
+        default:
+            success = false;
+            break;
+        }
+
+        m_staged_operation.success = success;
+    }
+
+#if SCRUTINY_SUPPORT_PROTECTED_REGIONS
+    bool MainHandler::touches_forbidden_region(void const *const addr_start, size_t const length) const
+    {
+        if (!m_config.is_forbidden_address_range_set())
+        {
+            return false;
+        }
+
+        uintptr_t const block_start = reinterpret_cast<uintptr_t>(addr_start);
+        uintptr_t const block_end = block_start + length - 1;
+
+        for (unsigned int i = 0; i < m_config.forbidden_ranges_count(); i++)
+        {
+            AddressRange const &range = m_config.forbidden_ranges()[i];
+
+            if (block_start <= reinterpret_cast<uintptr_t>(range.end) && block_end >= reinterpret_cast<uintptr_t>(range.start))
             {
                 return true;
             }
@@ -1338,7 +2329,39 @@ namespace scrutiny
     {
         protocol::ResponseCode::eResponseCode code = protocol::ResponseCode::FailureToProceed;
 
-        if (m_config.is_user_command_callback_set())
+        if (m_config.is_async_user_command_callback_set())
+        {
+            uint16_t response_data_length = 0;
+            // The request stays in the rx buffer while we return ProcessAgain. A new request is one that has not been deferred yet
+            UserCommandStatus::eUserCommandStatus const status =
+                static_cast<UserCommandStatus::eUserCommandStatus>(m_config.get_async_user_command_callback()(
+                    request->subfunction_id,
+                    request->data,
+                    request->data_length,
+                    response->data,
+                    &response_data_length,
+                    active_comm()->tx_buffer_size(),
+                    m_process_again_timestamp_taken ? 0u : 1u));
+
+            if (status == UserCommandStatus::PENDING)
+            {
+                code = protocol::ResponseCode::ProcessAgain;
+            }
+            else if (status != UserCommandStatus::DONE)
+            {
+                code = protocol::ResponseCode::FailureToProceed;
+            }
+            else if (response_data_length > active_comm()->tx_buffer_size())
+            {
+                code = protocol::ResponseCode::Overflow;
+            }
+            else
+            {
+                response->data_length = response_data_length;
+                code = protocol::ResponseCode::OK;
+            }
+        }
+        else if (m_config.is_user_command_callback_set())
         {
             uint16_t response_data_length = 0;
             // Calling user callback;
@@ -1348,8 +2371,8 @@ namespace scrutiny
                 request->data_length,
                 response->data,
                 &response_data_length,
-                m_comm_handler.tx_buffer_size());
-            if (response_data_length > m_comm_handler.tx_buffer_size())
+                active_comm()->tx_buffer_size());
+            if (response_data_length > active_comm()->tx_buffer_size())
             {
                 code = protocol::ResponseCode::Overflow;
             }
@@ -1399,6 +2422,11 @@ namespace scrutiny
                 protocol::ResponseData::DataLogControl::ReadAcquisition response_data;
             } read_acquisition;
 
+            struct
+            {
+                protocol::ResponseData::DataLogControl::GetTimeAxis response_data;
+            } get_time_axis;
+
         } stack;
 
         if (!m_config.is_datalogging_configured())
@@ -1505,6 +2533,19 @@ namespace scrutiny
                         code = protocol::ResponseCode::Forbidden;
                         break;
                     }
+#endif
+                }
+                else if (config->items_to_log[i].common.type == datalogging::LoggableType::MemoryBit)
+                {
+#if SCRUTINY_SUPPORT_PROTECTED_REGIONS
+                    // The library needs to access the full type, even if bitsize is small.
+                    if (touches_forbidden_region(
+                            config->items_to_log[i].memorybit.address,
+                            tools::get_type_size_char(config->items_to_log[i].memorybit.datatype)))
+                    {
+                        code = protocol::ResponseCode::Forbidden;
+                        break;
+                    }
 #endif
                 }
                 else if (config->items_to_log[i].common.type == datalogging::LoggableType::Rpv)
@@ -1515,6 +2556,15 @@ namespace scrutiny
                         break;
                     }
                 }
+                else if (config->items_to_log[i].common.type == datalogging::LoggableType::ImplicitTime)
+                {
+                    // The time axis can only be rebuilt if the loop period is known.
+                    if (m_config.m_loops[stack.configure.request_data.loop_id]->loop_type() != LoopType::FIXED_FREQ)
+                    {
+                        code = protocol::ResponseCode::FailureToProceed;
+                        break;
+                    }
+                }
             }
 
             if (code != protocol::ResponseCode::OK)
@@ -1611,6 +2661,7 @@ namespace scrutiny
             stack.get_acq_metadata.response_data.number_of_points = reader->get_entry_count();
             stack.get_acq_metadata.response_data.data_size = reader->get_total_size_char();
             stack.get_acq_metadata.response_data.points_after_trigger = m_datalogging.datalogger.log_points_after_trigger();
+            stack.get_acq_metadata.response_data.config = m_datalogging.datalogger.config();
             code = m_codec.encode_response_datalogging_get_acquisition_metadata(&stack.get_acq_metadata.response_data, response);
             break;
         }
@@ -1661,6 +2712,47 @@ namespace scrutiny
             break;
         }
 
+        case protocol::DataLogControl::Subfunction::GetTimeAxis:
+        {
+            if (m_datalogging.owner == SCRUTINY_NULL || !datalogging_data_available())
+            {
+                code = protocol::ResponseCode::FailureToProceed;
+                break;
+            }
+
+            datalogging::DataEncoder const *const encoder = m_datalogging.datalogger.get_encoder();
+            if (!encoder->implicit_time())
+            {
+                code = protocol::ResponseCode::FailureToProceed; // The acquisition has a measured time signal, or no time at all
+                break;
+            }
+
+            stack.get_time_axis.response_data.timestep_100ns = m_datalogging.owner->get_timestep_100ns();
+            stack.get_time_axis.response_data.decimation = m_datalogging.datalogger.config()->decimation;
+            stack.get_time_axis.response_data.trigger_timestamp = m_datalogging.datalogger.get_trigger_timestamp();
+            stack.get_time_axis.response_data.first_entry_counter = encoder->get_first_entry_counter();
+            stack.get_time_axis.response_data.encoder = encoder;
+            code = m_codec.encode_response_datalogging_get_time_axis(&stack.get_time_axis.response_data, response);
+            break;
+        }
+
+        case protocol::DataLogControl::Subfunction::ReleaseAcquisition:
+        {
+            if (m_datalogging.owner == SCRUTINY_NULL || !m_datalogging.datalogger.double_buffering() || !datalogging_data_available())
+            {
+                code = protocol::ResponseCode::FailureToProceed;
+                break;
+            }
+
+            // The half being read is given back to the owner. No more read until it publishes the next acquisition.
+            m_datalogging.request_release_acquisition = true;
+            m_datalogging.pending_acquisition_release = true;
+            m_datalogging.threadsafe_data.acquisition_available = false;
+            m_datalogging.reading_in_progress = false;
+            code = protocol::ResponseCode::OK;
+            break;
+        }
+
         case protocol::DataLogControl::Subfunction::ResetDatalogger:
         {
             if (m_datalogging.owner != SCRUTINY_NULL)
@@ -1697,4 +2789,218 @@ namespace scrutiny
     }
 #endif
 
+#if SCRUTINY_ENABLE_STATISTICS
+    void MainHandler::process_statistics_loop_msg(LoopHandler *const sender, LoopHandler::Loop2MainMessage *const msg)
+    {
+        if (sender != m_statistics.owner)
+        {
+            return;
+        }
+
+        switch (msg->message_id)
+        {
+        case LoopHandler::Loop2MainMessageID::STATISTICS_STOPPED:
+        {
+            m_statistics.owner = SCRUTINY_NULL;
+            m_statistics.stop_requested = false;
+            m_statistics.snapshot = StagedOperationState::Idle;
+            break;
+        }
+        case LoopHandler::Loop2MainMessageID::STATISTICS_SNAPSHOT_TAKEN:
+        {
+            if (m_statistics.snapshot == StagedOperationState::Requested)
+            {
+                m_statistics.snapshot = StagedOperationState::Done;
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    // ============= [Statistics] ============
+    protocol::ResponseCode::eResponseCode MainHandler::process_statistics(protocol::Request const *const request, protocol::Response *const response)
+    {
+        union
+        {
+            struct
+            {
+                protocol::ResponseData::Statistics::GetSetup response_data;
+            } get_setup;
+
+            struct
+            {
+                protocol::RequestData::Statistics::Configure request_data;
+            } configure;
+        } stack;
+
+        if (!m_config.is_statistics_configured())
+        {
+            return protocol::ResponseCode::UnsupportedFeature;
+        }
+
+        protocol::ResponseCode::eResponseCode code = protocol::ResponseCode::FailureToProceed;
+        switch (static_cast<protocol::Statistics::Subfunction::eSubfunction>(request->subfunction_id))
+        {
+        case protocol::Statistics::Subfunction::GetSetup:
+        {
+            stack.get_setup.response_data.channel_count = m_statistics.engine.capacity();
+            stack.get_setup.response_data.max_bin_count = statistics::MAX_BINS;
+            code = m_codec.encode_response_statistics_get_setup(&stack.get_setup.response_data, response);
+            break;
+        }
+        case protocol::Statistics::Subfunction::Configure:
+        {
+            // The channels are written by the loop running the statistics. Stop it before touching them.
+            if (m_statistics.owner != SCRUTINY_NULL)
+            {
+                if (!m_statistics.stop_requested && !m_statistics.owner->ipc_main2loop()->has_content())
+                {
+                    LoopHandler::Main2LoopMessage msg;
+                    msg.message_id = LoopHandler::Main2LoopMessageID::STATISTICS_STOP;
+                    m_statistics.owner->ipc_main2loop()->send(msg);
+                    m_statistics.stop_requested = true;
+                }
+                code = protocol::ResponseCode::ProcessAgain;
+                break;
+            }
+
+            m_statistics.engine.configure(0);
+            code = m_codec.decode_statistics_configure_request(
+                request,
+                &stack.configure.request_data,
+                m_statistics.engine.channels(),
+                m_statistics.engine.capacity());
+            if (code != protocol::ResponseCode::OK)
+            {
+                break;
+            }
+
+            if (stack.configure.request_data.channel_count == 0) // Only stops the statistics
+            {
+                break;
+            }
+
+            if (stack.configure.request_data.loop_id >= m_config.m_loop_count)
+            {
+                code = protocol::ResponseCode::FailureToProceed;
+                break;
+            }
+
+            LoopHandler *const loop = m_config.m_loops[stack.configure.request_data.loop_id];
+            if (!loop->datalogging_allowed())
+            {
+                code = protocol::ResponseCode::Forbidden;
+                break;
+            }
+
+            for (uint_fast8_t i = 0; i < stack.configure.request_data.channel_count; i++)
+            {
+                datalogging::Operand const *const operand = &m_statistics.engine.channel(static_cast<uint_least8_t>(i))->operand;
+                if (operand->common.type == datalogging::OperandType::Var)
+                {
+#if SCRUTINY_SUPPORT_PROTECTED_REGIONS
+                    if (touches_forbidden_region(operand->var.addr, tools::get_type_size_char(operand->var.datatype)))
+                    {
+                        code = protocol::ResponseCode::Forbidden;
+                        break;
+                    }
+#endif
+                }
+                else if (operand->common.type == datalogging::OperandType::VarBit)
+                {
+#if SCRUTINY_SUPPORT_PROTECTED_REGIONS
+                    // The library needs to access the full type, even if bitsize is small.
+                    if (touches_forbidden_region(operand->varbit.addr, tools::get_type_size_char(operand->varbit.datatype)))
+                    {
+                        code = protocol::ResponseCode::Forbidden;
+                        break;
+                    }
+#endif
+                }
+                else if (operand->common.type == datalogging::OperandType::Rpv)
+                {
+                    if (!m_config.is_read_published_values_configured() || !rpv_exists(operand->rpv.id))
+                    {
+                        code = protocol::ResponseCode::FailureToProceed;
+                        break;
+                    }
+                }
+            }
+
+            if (code != protocol::ResponseCode::OK)
+            {
+                break;
+            }
+
+            if (loop->ipc_main2loop()->has_content())
+            {
+                code = protocol::ResponseCode::ProcessAgain;
+                break;
+            }
+
+            m_statistics.engine.configure(stack.configure.request_data.channel_count);
+            LoopHandler::Main2LoopMessage msg;
+            msg.message_id = LoopHandler::Main2LoopMessageID::STATISTICS_START;
+            loop->ipc_main2loop()->send(msg);
+            m_statistics.owner = loop;
+            m_statistics.snapshot = StagedOperationState::Idle;
+            break;
+        }
+        case protocol::Statistics::Subfunction::Read:
+        {
+            if (m_statistics.owner == SCRUTINY_NULL || m_statistics.stop_requested)
+            {
+                code = protocol::ResponseCode::FailureToProceed;
+                break;
+            }
+
+            if (!m_process_again_timestamp_taken && m_statistics.snapshot == StagedOperationState::Done)
+            {
+                m_statistics.snapshot = StagedOperationState::Idle; // Left there by a request that timed out. Too old to be sent.
+            }
+
+            if (m_statistics.snapshot == StagedOperationState::Idle)
+            {
+                if (!m_statistics.owner->ipc_main2loop()->has_content())
+                {
+                    LoopHandler::Main2LoopMessage msg;
+                    msg.message_id = LoopHandler::Main2LoopMessageID::STATISTICS_SNAPSHOT;
+                    m_statistics.owner->ipc_main2loop()->send(msg);
+                    m_statistics.snapshot = StagedOperationState::Requested;
+                }
+                code = protocol::ResponseCode::ProcessAgain;
+                break;
+            }
+
+            if (m_statistics.snapshot == StagedOperationState::Requested)
+            {
+                code = protocol::ResponseCode::ProcessAgain;
+                break;
+            }
+
+            m_statistics.snapshot = StagedOperationState::Idle;
+            code = m_codec.encode_response_statistics_read(&m_statistics.engine, response);
+            break;
+        }
+        default:
+        {
+            code = protocol::ResponseCode::UnsupportedFeature;
+        }
+        }
+
+        if (static_cast<protocol::Statistics::Subfunction::eSubfunction>(request->subfunction_id) ==
+            protocol::Statistics::Subfunction::Configure)
+        {
+            if (code != protocol::ResponseCode::OK && code != protocol::ResponseCode::ProcessAgain)
+            {
+                m_statistics.engine.configure(0);
+            }
+        }
+
+        return code;
+    }
+#endif
+
 } // namespace scrutiny
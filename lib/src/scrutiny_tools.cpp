@@ -7,10 +7,12 @@
 //    Copyright (c) 2021 Scrutiny Debugger
 
 #include "scrutiny_tools.hpp"
+#include "scrutiny_common_codecs.hpp"
 #include "scrutiny_setup.hpp"
 #include "scrutiny_types.hpp"
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 namespace scrutiny
 {
@@ -154,5 +156,100 @@ namespace scrutiny
             return ~crc;
         }
 
+        void masked_write_from_8bits_native(void *const dst, void const *const src, void const *const mask, size_t const nb_8bits)
+        {
+            unsigned char *const d = static_cast<unsigned char *>(dst);
+            unsigned char const *const s = static_cast<unsigned char const *>(src);
+            unsigned char const *const m = static_cast<unsigned char const *>(mask);
+#if CHAR_BIT == 8
+            // Bytes up to the first aligned word of the destination, then a read-modify-write of whole words, then the remaining bytes.
+            // Source and mask may be unaligned and are read with memcpy.
+            size_t const misalignment = static_cast<size_t>(reinterpret_cast<uintptr_t>(d) % sizeof(uintptr_t));
+            size_t const head = SCRUTINY_MIN(misalignment == 0 ? 0 : sizeof(uintptr_t) - misalignment, nb_8bits);
+            size_t i = 0;
+            for (; i < head; i++)
+            {
+                d[i] = static_cast<unsigned char>((d[i] & ~m[i]) | (s[i] & m[i]));
+            }
+
+            for (; i + sizeof(uintptr_t) <= nb_8bits; i += sizeof(uintptr_t))
+            {
+                uintptr_t dst_word;
+                uintptr_t src_word;
+                uintptr_t mask_word;
+                memcpy(&dst_word, &d[i], sizeof(uintptr_t));
+                memcpy(&src_word, &s[i], sizeof(uintptr_t));
+                memcpy(&mask_word, &m[i], sizeof(uintptr_t));
+                dst_word = (dst_word & ~mask_word) | (src_word & mask_word);
+                memcpy(&d[i], &dst_word, sizeof(uintptr_t));
+            }
+
+            for (; i < nb_8bits; i++)
+            {
+                d[i] = static_cast<unsigned char>((d[i] & ~m[i]) | (s[i] & m[i]));
+            }
+#elif CHAR_BIT == 16
+            bool const little_endian = is_little_endian();
+            for (size_t i = 0; i < (nb_8bits >> 1); i++)
+            {
+                unsigned char const val16bits = little_endian ? codecs::decode_16_bits_little_endian_8bits(&s[2 * i])
+                                                              : codecs::decode_16_bits_big_endian_8bits(&s[2 * i]);
+                unsigned char const mask16bits = little_endian ? codecs::decode_16_bits_little_endian_8bits(&m[2 * i])
+                                                               : codecs::decode_16_bits_big_endian_8bits(&m[2 * i]);
+                d[i] = (d[i] & ~mask16bits) | (val16bits & mask16bits);
+            }
+#else
+#error
+#endif
+        }
+
+        uint16_t float32_to_float16(float const val)
+        {
+            SCRUTINY_STATIC_ASSERT(sizeof(float) == sizeof(uint32_t), "Expect float to be 32 bits");
+            uint32_t bits;
+            memcpy(&bits, &val, sizeof(uint32_t));
+
+            uint16_t const sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+            uint32_t const exponent = (bits >> 23) & 0xFFu;
+            uint32_t mantissa = bits & 0x7FFFFFu;
+
+            if (exponent == 0xFFu) // Inf or NaN. NaN stays a quiet NaN
+            {
+                return static_cast<uint16_t>(sign | 0x7C00u | ((mantissa != 0) ? 0x200u : 0u));
+            }
+
+            int_fast16_t const half_exponent = static_cast<int_fast16_t>(exponent) - 127 + 15;
+            if (half_exponent >= 0x1F)
+            {
+                return static_cast<uint16_t>(sign | 0x7C00u); // Overflow
+            }
+
+            uint_fast8_t shift = 13;
+            uint32_t half = 0;
+            if (half_exponent <= 0) // Subnormal half
+            {
+                if (half_exponent < -10)
+                {
+                    return sign; // Underflow
+                }
+                mantissa |= 0x800000u; // Implicit leading 1
+                shift = static_cast<uint_fast8_t>(14 - half_exponent);
+            }
+            else
+            {
+                half = static_cast<uint32_t>(half_exponent) << 10;
+            }
+
+            half |= mantissa >> shift;
+            uint32_t const remainder = mantissa & ((1u << shift) - 1u);
+            uint32_t const halfway = 1u << (shift - 1u);
+            if (remainder > halfway || (remainder == halfway && (half & 1u)))
+            {
+                half++; // Carry can go in the exponent. This gives the right result, including overflow to infinity
+            }
+
+            return static_cast<uint16_t>(sign | half);
+        }
+
     } // namespace tools
 } // namespace scrutiny
@@ -0,0 +1,116 @@
+//    scrutiny_statistics.cpp
+//        The implementation of the statistics engine that summarizes values in a loop instead of logging them
+//
+//   - License : MIT - See LICENSE file
+//   - Project : Scrutiny Debugger (github.com/scrutinydebugger/scrutiny-embedded)
+//
+//    Copyright (c) 2021 Scrutiny Debugger
+
+#include "statistics/scrutiny_statistics.hpp"
+#include "datalogging/scrutiny_datalogging.hpp"
+#include "scrutiny_main_handler.hpp"
+#include "scrutiny_setup.hpp"
+#include <string.h>
+
+#if SCRUTINY_ENABLE_STATISTICS == 0
+#error "Not enabled"
+#endif
+
+namespace scrutiny
+{
+    namespace statistics
+    {
+        void StatisticsEngine::init(MainHandler const *const main_handler, Channel *const channels, uint_least8_t const capacity)
+        {
+            m_main_handler = main_handler;
+            m_channels = channels;
+            m_capacity = (channels == SCRUTINY_NULL) ? 0 : capacity;
+            m_channel_count = 0;
+        }
+
+        void StatisticsEngine::configure(uint_least8_t const channel_count)
+        {
+            m_channel_count = SCRUTINY_MIN(channel_count, m_capacity);
+        }
+
+        void StatisticsEngine::reset(void)
+        {
+            for (uint_least8_t i = 0; i < m_channel_count; i++)
+            {
+                memset(&m_channels[i].live, 0, sizeof(m_channels[i].live));
+            }
+        }
+
+        void StatisticsEngine::process(LoopHandler *const caller)
+        {
+            for (uint_least8_t i = 0; i < m_channel_count; i++)
+            {
+                AnyValAndTypePair val_type_pair;
+                if (!datalogging::fetch_operand(m_main_handler, &m_channels[i].operand, &val_type_pair, caller))
+                {
+                    continue;
+                }
+
+                float_biggest_t const val = datalogging::read_as_biggest_float(val_type_pair.val, val_type_pair.valtype);
+                if (val == val) // NaN are not part of any statistics
+                {
+                    update(&m_channels[i], val);
+                }
+            }
+        }
+
+        void StatisticsEngine::take_snapshot(void)
+        {
+            for (uint_least8_t i = 0; i < m_channel_count; i++)
+            {
+                m_channels[i].snapshot = m_channels[i].live;
+            }
+        }
+
+        void StatisticsEngine::update(Channel *const channel, float_biggest_t const val)
+        {
+            Accumulator *const acc = &channel->live;
+            float_biggest_t const square = val * val;
+            if (acc->count == 0)
+            {
+                acc->count = 1;
+                acc->min = val;
+                acc->max = val;
+                acc->mean = val;
+                acc->mean_square = square;
+            }
+            else
+            {
+                if (acc->count < 0xFFFFFFFFu)
+                {
+                    acc->count++;
+                }
+                acc->min = (val < acc->min) ? val : acc->min;
+                acc->max = (val > acc->max) ? val : acc->max;
+                // Incremental means. Summing the samples would lose the small values once the sum is big.
+                acc->mean += (val - acc->mean) / static_cast<float_biggest_t>(acc->count);
+                acc->mean_square += (square - acc->mean_square) / static_cast<float_biggest_t>(acc->count);
+            }
+
+            if (channel->bin_count > 0)
+            {
+                float_biggest_t const position = (val - channel->histogram_min) * static_cast<float_biggest_t>(channel->bin_count) /
+                                                 (channel->histogram_max - channel->histogram_min);
+                uint_least8_t bin = 0;
+                if (position >= static_cast<float_biggest_t>(channel->bin_count))
+                {
+                    bin = static_cast<uint_least8_t>(channel->bin_count - 1);
+                }
+                else if (position > 0)
+                {
+                    bin = static_cast<uint_least8_t>(position);
+                }
+
+                if (acc->bins[bin] < 0xFFFFFFFFu)
+                {
+                    acc->bins[bin]++;
+                }
+            }
+        }
+    } // namespace statistics
+} // namespace scrutiny
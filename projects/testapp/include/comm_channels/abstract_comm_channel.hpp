@@ -20,6 +20,7 @@ class AbstractCommChannel
     virtual void stop() = 0;
     virtual void send(uint8_t const *buffer, int len) = 0;
     virtual int receive(uint8_t *buffer, int len) = 0;
+    virtual int pollable_fd() const { return -1; } // File descriptor that becomes readable when data is received. -1 if none
 };
 
 #endif // ___ABSTRACT_COMM_CHANNEL_H___
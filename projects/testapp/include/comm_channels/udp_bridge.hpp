@@ -50,6 +50,9 @@ class UdpBridge : public AbstractCommChannel
     virtual void stop();
     virtual void send(uint8_t const *buffer, int len) { send(buffer, len, 0); }
     virtual int receive(uint8_t *buffer, int len) { return receive(buffer, len, 0); }
+#if !SCRUTINY_BUILD_WINDOWS
+    virtual int pollable_fd() const { return m_sock; }
+#endif
 
     void set_nonblocking();
     static void throw_system_error(char const *msg);
@@ -0,0 +1,92 @@
+//    posix_host_runtime.hpp
+//        Runs a MainHandler and its loops on a Linux host. The communication channel is waited with epoll
+//        and each loop runs in its own thread, paced by a timerfd
+//
+//   - License : MIT - See LICENSE file
+//   - Project : Scrutiny Debugger (github.com/scrutinydebugger/scrutiny-embedded)
+//
+//    Copyright (c) 2021 Scrutiny Debugger
+
+#ifndef ___POSIX_HOST_RUNTIME_H___
+#define ___POSIX_HOST_RUNTIME_H___
+
+#if !defined(__linux__)
+#error "This file can only be compiled under Linux"
+#endif
+
+#include "abstract_comm_channel.hpp"
+#include "scrutiny.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <time.h>
+#include <vector>
+
+class PosixHostRuntime
+{
+  public:
+    typedef void (*LoopTask)(void);
+
+    PosixHostRuntime(scrutiny::MainHandler *main_handler, AbstractCommChannel *channel);
+    ~PosixHostRuntime();
+    PosixHostRuntime(PosixHostRuntime const &) = delete;
+    PosixHostRuntime &operator=(PosixHostRuntime const &) = delete;
+
+    /// Runs a loop in its own thread at the rate given by its timestep. The task, if any, is called right before each process().
+    /// A timestep shorter than MIN_PERIOD_US runs at MIN_PERIOD_US
+    void add_loop(scrutiny::FixedFrequencyLoopHandler *loop, LoopTask task = nullptr);
+    /// Runs a loop in its own thread, woken every period_us (at least MIN_PERIOD_US). The timestep given to process() is the measured time
+    void add_loop(scrutiny::VariableFrequencyLoopHandler *loop, uint32_t period_us, LoopTask task = nullptr);
+    /// Prints the data exchanged with the server
+    void set_verbose(bool verbose) { m_verbose = verbose; }
+    /// Mutex held while printing, shared with the application so that lines printed by other threads are not interleaved. Can be nullptr
+    void set_console_mutex(std::mutex *mutex) { m_console_mutex = mutex; }
+
+    /// Serves the channel until stop() is called. The channel must be started. Throws std::system_error on failure
+    void run();
+    /// Makes run() return. Can be called from any thread or from a signal handler
+    void stop();
+
+    static void throw_system_error(const std::string &msg);
+
+    static constexpr uint32_t MIN_PERIOD_US = 1; // A zero period would disarm the timerfd and the loop would never run
+
+  private:
+    static constexpr int IDLE_TIMEOUT_MS = 10; // Wake up period of the MainHandler when there's no request in progress
+    static constexpr int BUSY_TIMEOUT_MS = 1;  // Wake up period of the MainHandler while a request is processed or a response is throttled
+
+    struct LoopThread
+    {
+        scrutiny::FixedFrequencyLoopHandler *fixed_freq_loop;       // nullptr for a variable frequency loop
+        scrutiny::VariableFrequencyLoopHandler *variable_freq_loop; // nullptr for a fixed frequency loop
+        uint32_t period_us;                                         // Timer period
+        LoopTask task;                                              // Called before each process(). Can be nullptr
+        int timer_fd;                                               // timerfd that wakes the thread
+        std::thread thread;                                         // The thread running the loop
+    };
+
+    void run_loop(LoopThread *loop);
+    void start_loops();
+    void stop_loops();
+    void close_fds();
+    void service_channel(uint8_t *buffer, uint16_t buffer_size);
+    void print_data(char const *direction, uint8_t const *data, int len) const;
+    static uint32_t elapsed_100ns(timespec *last);
+
+    scrutiny::MainHandler *m_main_handler;
+    AbstractCommChannel *m_channel;
+    std::vector<std::unique_ptr<LoopThread>> m_loops;
+    std::atomic<bool> m_stop_requested;
+    bool m_verbose;
+    std::mutex *m_console_mutex;
+    int m_epoll_fd;
+    int m_wakeup_fd; // eventfd written by stop()
+    timespec m_start_time;
+    timespec m_last_process_time;
+};
+
+#endif // ___POSIX_HOST_RUNTIME_H___
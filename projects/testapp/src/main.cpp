@@ -25,10 +25,15 @@ using SerialPortBridge = WinSerialPortBridge;
 using SerialPortBridge = NixSerialPortBridge;
 #endif
 
+#if defined(__linux__)
+#include "posix_host_runtime.hpp"
+#endif
+
 #include <algorithm>
 #include <chrono>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
 #include <stdint.h>
 #include <thread>
 
@@ -107,10 +112,13 @@ struct
     double rpv_id_3001;
 #endif
 } rpvStorage;
+std::mutex rpvStorageMutex; // The RPVs are accessed by the MainHandler and by the loops, each one possibly in its own thread
+std::mutex consoleMutex;    // Keeps the lines printed by different threads from being interleaved
 
 bool TestAppRPVReadCallback(const scrutiny::RuntimePublishedValue rpv, scrutiny::AnyType *outval, scrutiny::LoopHandler *const caller)
 {
     static_cast<void>(caller);
+    std::lock_guard<std::mutex> lock(rpvStorageMutex);
     bool ok = true;
     if (rpv.id == 0x1000)
     {
@@ -181,6 +189,7 @@ bool TestAppRPVReadCallback(const scrutiny::RuntimePublishedValue rpv, scrutiny:
 bool TestAppRPVWriteCallback(const scrutiny::RuntimePublishedValue rpv, scrutiny::AnyType const *inval, scrutiny::LoopHandler *const caller)
 {
     static_cast<void>(caller);
+    std::lock_guard<std::mutex> lock(rpvStorageMutex);
     bool ok = true;
     if (rpv.id == 0x1000)
     {
@@ -290,9 +299,12 @@ void process_interactive_data()
     static_cast<void>(counter); // suppress unused variable error
     static_cast<void>(step);    // suppress unused variable error
 
-    if (rpvStorage.rpv_id_5000)
     {
-        rpvStorage.rpv_id_5001 += step;
+        std::lock_guard<std::mutex> lock(rpvStorageMutex);
+        if (rpvStorage.rpv_id_5000)
+        {
+            rpvStorage.rpv_id_5001 += step;
+        }
     }
 
     if (enable)
@@ -303,6 +315,7 @@ void process_interactive_data()
 
 void datalogging_callback()
 {
+    std::lock_guard<std::mutex> lock(consoleMutex);
     std::cout << "Graph Triggered!" << std::endl;
 }
 
@@ -314,12 +327,14 @@ void my_user_command(
     uint16_t *response_data_length,
     uint16_t const response_max_data_length)
 {
+    std::unique_lock<std::mutex> lock(consoleMutex);
     std::cout << "User command: Subfunction #" << static_cast<unsigned int>(subfunction) << " with " << request_data_length << " data bytes: ";
     for (uint32_t i = 0; i < request_data_length; i++)
     {
         std::cout << hex << setw(2) << setfill('0') << static_cast<uint32_t>(request_data[i]);
     }
     std::cout << std::endl;
+    lock.unlock();
 
     if (response_max_data_length < 1)
     {
@@ -372,8 +387,6 @@ void my_user_command(
 
 void process_scrutiny_lib(AbstractCommChannel *channel)
 {
-    uint8_t buffer[1024];
-    SCRUTINY_STATIC_ASSERT(sizeof(buffer) <= 0xFFFF, "Scrutiny expect a buffer smaller than 16 bits");
     scrutiny::MainHandler scrutiny_handler;
     scrutiny::Config config;
     scrutiny::VariableFrequencyLoopHandler vf_loop("Variable freq loop");
@@ -395,6 +408,25 @@ void process_scrutiny_lib(AbstractCommChannel *channel)
     config.session_counter_seed = 0xdeadbeef;
     scrutiny_handler.init(&config);
 
+#if defined(__linux__)
+    // The channel wakes the MainHandler and each loop runs in its own thread at its real rate
+    PosixHostRuntime runtime(&scrutiny_handler, channel);
+    runtime.add_loop(&ff_loop, process_interactive_data);
+    runtime.add_loop(&vf_loop, 10000);
+    runtime.set_console_mutex(&consoleMutex);
+
+    try
+    {
+        channel->start();
+        runtime.run();
+    }
+    catch (std::exception const &e)
+    {
+        cerr << e.what() << endl;
+    }
+#else
+    uint8_t buffer[1024];
+    SCRUTINY_STATIC_ASSERT(sizeof(buffer) <= 0xFFFF, "Scrutiny expect a buffer smaller than 16 bits");
     chrono::time_point<chrono::steady_clock> start_timestamp, last_timestamp, now_timestamp;
     start_timestamp = chrono::steady_clock::now();
     last_timestamp = chrono::steady_clock::now();
@@ -457,6 +489,7 @@ void process_scrutiny_lib(AbstractCommChannel *channel)
     {
         cerr << e.what() << endl;
     }
+#endif
 
     channel->stop();
 }
@@ -0,0 +1,300 @@
+//    posix_host_runtime.cpp
+//        Runs a MainHandler and its loops on a Linux host. The communication channel is waited with epoll
+//        and each loop runs in its own thread, paced by a timerfd
+//
+//   - License : MIT - See LICENSE file
+//   - Project : Scrutiny Debugger (github.com/scrutinydebugger/scrutiny-embedded)
+//
+//    Copyright (c) 2021 Scrutiny Debugger
+
+#include "posix_host_runtime.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <stdint.h>
+#include <string>
+#include <system_error>
+
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+constexpr uint32_t PosixHostRuntime::MIN_PERIOD_US;
+
+PosixHostRuntime::PosixHostRuntime(scrutiny::MainHandler *main_handler, AbstractCommChannel *channel) :
+    m_main_handler(main_handler),
+    m_channel(channel),
+    m_loops(),
+    m_stop_requested(false),
+    m_verbose(true),
+    m_console_mutex(nullptr),
+    m_epoll_fd(-1),
+    m_wakeup_fd(-1),
+    m_start_time(),
+    m_last_process_time()
+{
+}
+
+PosixHostRuntime::~PosixHostRuntime()
+{
+    stop_loops();
+}
+
+void PosixHostRuntime::add_loop(scrutiny::FixedFrequencyLoopHandler *loop, LoopTask task)
+{
+    std::unique_ptr<LoopThread> loop_thread(new LoopThread());
+    loop_thread->fixed_freq_loop = loop;
+    loop_thread->variable_freq_loop = nullptr;
+    loop_thread->period_us = std::max(loop->get_timestep_100ns() / 10, MIN_PERIOD_US);
+    loop_thread->task = task;
+    loop_thread->timer_fd = -1;
+    m_loops.push_back(std::move(loop_thread));
+}
+
+void PosixHostRuntime::add_loop(scrutiny::VariableFrequencyLoopHandler *loop, uint32_t period_us, LoopTask task)
+{
+    std::unique_ptr<LoopThread> loop_thread(new LoopThread());
+    loop_thread->fixed_freq_loop = nullptr;
+    loop_thread->variable_freq_loop = loop;
+    loop_thread->period_us = std::max(period_us, MIN_PERIOD_US);
+    loop_thread->task = task;
+    loop_thread->timer_fd = -1;
+    m_loops.push_back(std::move(loop_thread));
+}
+
+void PosixHostRuntime::run()
+{
+    uint8_t buffer[1024];
+    SCRUTINY_STATIC_ASSERT(sizeof(buffer) <= 0xFFFF, "Scrutiny expect a buffer smaller than 16 bits");
+
+    m_stop_requested = false;
+    m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    m_wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_epoll_fd < 0 || m_wakeup_fd < 0)
+    {
+        close_fds();
+        throw_system_error("Cannot create the runtime file descriptors");
+    }
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = m_wakeup_fd;
+    if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_wakeup_fd, &event) != 0)
+    {
+        close_fds();
+        throw_system_error("Cannot watch the wakeup event");
+    }
+
+    // Channels without a file descriptor are served at the idle rate
+    int const channel_fd = m_channel->pollable_fd();
+    if (channel_fd >= 0)
+    {
+        event.data.fd = channel_fd;
+        if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, channel_fd, &event) != 0)
+        {
+            close_fds();
+            throw_system_error("Cannot watch the communication channel");
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &m_start_time);
+    m_last_process_time = m_start_time;
+
+    try
+    {
+        start_loops();
+        while (!m_stop_requested)
+        {
+            // The MainHandler only needs to tick often while a request is in progress: ProcessAgain, throttled transmission.
+            // Otherwise, a received request wakes it up right away
+            bool const busy = m_main_handler->comm()->request_received() || m_main_handler->data_to_send() > 0;
+            epoll_event events[2];
+            int const n = epoll_wait(m_epoll_fd, events, sizeof(events) / sizeof(events[0]), busy ? BUSY_TIMEOUT_MS : IDLE_TIMEOUT_MS);
+            if (n < 0 && errno != EINTR)
+            {
+                throw_system_error("epoll_wait failed");
+            }
+
+            service_channel(buffer, sizeof(buffer));
+        }
+    }
+    catch (...)
+    {
+        stop_loops();
+        close_fds();
+        throw;
+    }
+
+    stop_loops();
+    close_fds();
+}
+
+void PosixHostRuntime::close_fds()
+{
+    if (m_epoll_fd >= 0)
+    {
+        close(m_epoll_fd);
+    }
+    if (m_wakeup_fd >= 0)
+    {
+        close(m_wakeup_fd);
+    }
+    m_epoll_fd = -1;
+    m_wakeup_fd = -1;
+}
+
+void PosixHostRuntime::stop()
+{
+    m_stop_requested = true;
+    if (m_wakeup_fd >= 0)
+    {
+        uint64_t const value = 1;
+        ssize_t const ret = write(m_wakeup_fd, &value, sizeof(value)); // Async signal safe
+        static_cast<void>(ret);
+    }
+}
+
+void PosixHostRuntime::service_channel(uint8_t *buffer, uint16_t buffer_size)
+{
+    // Everything that arrived since the last wake up. Each UDP datagram is read separately
+    int len_received;
+    while ((len_received = m_channel->receive(buffer, buffer_size)) > 0) // Non-blocking
+    {
+        print_data("in: ", buffer, len_received);
+        m_main_handler->receive_data(buffer, static_cast<uint16_t>(len_received));
+    }
+
+    m_main_handler->process(elapsed_100ns(&m_last_process_time));
+
+    // The MainHandler limits what it gives when max_bitrate is enforced. The rest is sent at a next wake up
+    uint16_t data_to_send = m_main_handler->data_to_send();
+    data_to_send = (data_to_send < buffer_size) ? data_to_send : buffer_size;
+    if (data_to_send > 0)
+    {
+        data_to_send = m_main_handler->pop_data(buffer, data_to_send);
+        m_channel->send(buffer, data_to_send);
+        print_data("out:", buffer, data_to_send);
+    }
+}
+
+void PosixHostRuntime::start_loops()
+{
+    // Timers are created before any thread starts so that a failure can be thrown in the caller thread
+    for (size_t i = 0; i < m_loops.size(); i++)
+    {
+        LoopThread *const loop = m_loops[i].get();
+        loop->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+        if (loop->timer_fd < 0)
+        {
+            throw_system_error("timerfd_create failed");
+        }
+
+        itimerspec spec = {};
+        spec.it_interval.tv_sec = loop->period_us / 1000000;
+        spec.it_interval.tv_nsec = static_cast<long>(loop->period_us % 1000000) * 1000;
+        spec.it_value = spec.it_interval;
+        if (timerfd_settime(loop->timer_fd, 0, &spec, nullptr) != 0)
+        {
+            throw_system_error("timerfd_settime failed");
+        }
+    }
+
+    for (size_t i = 0; i < m_loops.size(); i++)
+    {
+        m_loops[i]->thread = std::thread(&PosixHostRuntime::run_loop, this, m_loops[i].get());
+    }
+}
+
+void PosixHostRuntime::stop_loops()
+{
+    m_stop_requested = true;
+    for (size_t i = 0; i < m_loops.size(); i++)
+    {
+        LoopThread *const loop = m_loops[i].get();
+        if (loop->thread.joinable())
+        {
+            loop->thread.join(); // Returns within a timer period
+        }
+        if (loop->timer_fd >= 0)
+        {
+            close(loop->timer_fd);
+            loop->timer_fd = -1;
+        }
+    }
+}
+
+void PosixHostRuntime::run_loop(LoopThread *loop)
+{
+    timespec last_time;
+    clock_gettime(CLOCK_MONOTONIC, &last_time);
+    while (!m_stop_requested)
+    {
+        uint64_t expirations = 0;
+        if (read(loop->timer_fd, &expirations, sizeof(expirations)) != static_cast<ssize_t>(sizeof(expirations)))
+        {
+            continue; // Interrupted by a signal
+        }
+
+        if (loop->fixed_freq_loop != nullptr)
+        {
+            // Missed periods are caught up so that the loop runs at its nominal rate on average
+            for (uint64_t i = 0; i < expirations; i++)
+            {
+                if (loop->task != nullptr)
+                {
+                    loop->task();
+                }
+                loop->fixed_freq_loop->process();
+            }
+        }
+        else
+        {
+            if (loop->task != nullptr)
+            {
+                loop->task();
+            }
+            loop->variable_freq_loop->process(elapsed_100ns(&last_time));
+        }
+    }
+}
+
+void PosixHostRuntime::print_data(char const *direction, uint8_t const *data, int len) const
+{
+    if (!m_verbose)
+    {
+        return;
+    }
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    uint32_t const time_since_start_us =
+        static_cast<uint32_t>((now.tv_sec - m_start_time.tv_sec) * 1000000 + (now.tv_nsec - m_start_time.tv_nsec) / 1000);
+    std::unique_lock<std::mutex> lock;
+    if (m_console_mutex != nullptr)
+    {
+        lock = std::unique_lock<std::mutex>(*m_console_mutex);
+    }
+    std::cout << std::dec << std::setw(0) << time_since_start_us << "  " << direction << " (" << std::setw(2) << std::setfill(' ') << len
+              << ")  ";
+    for (int i = 0; i < len; i++)
+    {
+        std::cout << std::hex << std::setw(2) << std::setfill('0') << static_cast<uint32_t>(data[i]);
+    }
+    std::cout << std::endl;
+}
+
+uint32_t PosixHostRuntime::elapsed_100ns(timespec *last)
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t const elapsed_ns = static_cast<int64_t>(now.tv_sec - last->tv_sec) * 1000000000 + (now.tv_nsec - last->tv_nsec);
+    *last = now;
+    return static_cast<uint32_t>(elapsed_ns / 100);
+}
+
+void PosixHostRuntime::throw_system_error(const std::string &msg)
+{
+    throw std::system_error(errno, std::system_category(), msg.c_str());
+}
@@ -15,9 +15,11 @@ BUILD_DIR="$APP_ROOT/build-${BUILD_CONTEXT}"
 mkdir -p "$BUILD_DIR"
 
 SCRUTINY_ENABLE_DATALOGGING=${SCRUTINY_ENABLE_DATALOGGING:-ON}
+SCRUTINY_ENABLE_STATISTICS=${SCRUTINY_ENABLE_STATISTICS:-$SCRUTINY_ENABLE_DATALOGGING}
 SCRUTINY_SUPPORT_64BITS=${SCRUTINY_SUPPORT_64BITS:-ON}
 SCRUTINY_SUPPORT_PROTECTED_REGIONS=${SCRUTINY_SUPPORT_PROTECTED_REGIONS:-ON}
 SCRUTINY_DATALOGGING_BUFFER_32BITS=${SCRUTINY_DATALOGGING_BUFFER_32BITS:-OFF}
+SCRUTINY_COMM_CHANNEL_COUNT=${SCRUTINY_COMM_CHANNEL_COUNT:-1}
 SCRUTINY_BUILD_CWRAPPER=${SCRUTINY_BUILD_CWRAPPER:-ON}
 SCRUTINY_BUILD_TEST=${SCRUTINY_BUILD_TEST:-OFF}
 SCRUTINY_USE_ASAN=${SCRUTINY_USE_ASAN:-OFF}
@@ -34,9 +36,11 @@ cmake -GNinja \
         -DSCRUTINY_BUILD_TESTAPP=$SCRUTINY_BUILD_TESTAPP \
         -DSCRUTINY_BUILD_CWRAPPER=$SCRUTINY_BUILD_CWRAPPER \
         -DSCRUTINY_ENABLE_DATALOGGING=$SCRUTINY_ENABLE_DATALOGGING \
+        -DSCRUTINY_ENABLE_STATISTICS=$SCRUTINY_ENABLE_STATISTICS \
         -DSCRUTINY_SUPPORT_64BITS=$SCRUTINY_SUPPORT_64BITS \
         -DSCRUTINY_SUPPORT_PROTECTED_REGIONS=$SCRUTINY_SUPPORT_PROTECTED_REGIONS \
         -DSCRUTINY_DATALOGGING_BUFFER_32BITS=$SCRUTINY_DATALOGGING_BUFFER_32BITS \
+        -DSCRUTINY_COMM_CHANNEL_COUNT=$SCRUTINY_COMM_CHANNEL_COUNT \
         -DSCRUTINY_CWRAPPER_EXTRACT_CPP_CONSTANTS=$SCRUTINY_CWRAPPER_EXTRACT_CPP_CONSTANTS \
         -DSCRUTINY_TESTAPP_DWARF_VERSION=${SCRUTINY_TESTAPP_DWARF_VERSION} \
         -DCMAKE_CXX_STANDARD=$CMAKE_CXX_STANDARD \
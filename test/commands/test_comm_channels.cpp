@@ -0,0 +1,145 @@
+//    test_comm_channels.cpp
+//        Test a MainHandler serving several communication channels, each with its own buffers and session
+//
+//   - License : MIT - See LICENSE file
+//   - Project : Scrutiny Debugger (github.com/scrutinydebugger/scrutiny-embedded)
+//
+//    Copyright (c) 2021 Scrutiny Debugger
+
+#include "scrutinytest/scrutinytest.hpp"
+#include <cstring>
+
+#include "scrutiny.hpp"
+#include "scrutiny_test.hpp"
+
+#if SCRUTINY_COMM_CHANNEL_COUNT >= 2
+
+static unsigned char _rx_buffer0[128];
+static unsigned char _tx_buffer0[128];
+static unsigned char _rx_buffer1[64];
+static unsigned char _tx_buffer1[96];
+
+class TestCommChannels : public ScrutinyTest
+{
+  protected:
+    scrutiny::MainHandler scrutiny_handler;
+    scrutiny::Config config;
+
+    TestCommChannels() :
+        ScrutinyTest(),
+        scrutiny_handler(),
+        config()
+    {
+    }
+
+    virtual void SetUp()
+    {
+        config.set_buffers(_rx_buffer0, sizeof(_rx_buffer0), _tx_buffer0, sizeof(_tx_buffer0));
+        config.set_channel_buffers(1, _rx_buffer1, sizeof(_rx_buffer1), _tx_buffer1, sizeof(_tx_buffer1));
+        scrutiny_handler.init(&config);
+    }
+
+    void check_get_params_response(uint_least8_t const channel, uint16_t const rx_size, uint16_t const tx_size);
+};
+
+void TestCommChannels::check_get_params_response(uint_least8_t const channel, uint16_t const rx_size, uint16_t const tx_size)
+{
+    unsigned char tx_buffer[64];
+    uint16_t const n_to_read = scrutiny_handler.data_to_send(channel);
+    ASSERT_GT(n_to_read, 9u);
+    ASSERT_LT(n_to_read, sizeof(tx_buffer));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read, channel);
+    ASSERT_IS_PROTOCOL_RESPONSE(tx_buffer, scrutiny::protocol::CommandId::CommControl, 3, scrutiny::protocol::ResponseCode::OK);
+    EXPECT_EQ((tx_buffer[5] << 8) | tx_buffer[6], rx_size);
+    EXPECT_EQ((tx_buffer[7] << 8) | tx_buffer[8], tx_size);
+}
+
+TEST_F(TestCommChannels, IndependentSessions)
+{
+    EXPECT_TRUE(scrutiny_handler.comm(1)->is_enabled());
+    EXPECT_TRUE(scrutiny_handler.comm(SCRUTINY_COMM_CHANNEL_COUNT) == SCRUTINY_NULL);
+
+    scrutiny_handler.comm(1)->connect();
+    EXPECT_FALSE(scrutiny_handler.comm(0)->is_connected());
+    EXPECT_TRUE(scrutiny_handler.comm(1)->is_connected());
+
+    scrutiny_handler.comm(0)->connect();
+    EXPECT_NE(scrutiny_handler.comm(0)->get_session_id(), scrutiny_handler.comm(1)->get_session_id());
+}
+
+TEST_F(TestCommChannels, ResponseSentOnRequestChannel)
+{
+    unsigned char request_data[8] = { 2, 3, 0, 0 }; // GetParams
+    add_crc(request_data, sizeof(request_data) - 4);
+    scrutiny_handler.comm(0)->connect();
+    scrutiny_handler.comm(1)->connect();
+
+    scrutiny_handler.receive_data(request_data, sizeof(request_data), 1);
+    scrutiny_handler.process(0);
+    EXPECT_EQ(scrutiny_handler.data_to_send(0), 0u);
+    check_get_params_response(1, sizeof(_rx_buffer1), sizeof(_tx_buffer1));
+
+    scrutiny_handler.receive_data(request_data, sizeof(request_data), 0);
+    scrutiny_handler.process(0);
+    EXPECT_EQ(scrutiny_handler.data_to_send(1), 0u);
+    check_get_params_response(0, sizeof(_rx_buffer0), sizeof(_tx_buffer0));
+}
+
+TEST_F(TestCommChannels, SimultaneousRequests)
+{
+    unsigned char request_data[8] = { 2, 3, 0, 0 }; // GetParams
+    add_crc(request_data, sizeof(request_data) - 4);
+    scrutiny_handler.comm(0)->connect();
+    scrutiny_handler.comm(1)->connect();
+
+    // Both channels are served by the same call, while the response of the other is still waiting to be sent
+    scrutiny_handler.receive_data(request_data, sizeof(request_data), 0);
+    scrutiny_handler.receive_data(request_data, sizeof(request_data), 1);
+    scrutiny_handler.process(0);
+    check_get_params_response(1, sizeof(_rx_buffer1), sizeof(_tx_buffer1));
+    check_get_params_response(0, sizeof(_rx_buffer0), sizeof(_tx_buffer0));
+
+    // Channels can be reused right after
+    scrutiny_handler.receive_data(request_data, sizeof(request_data), 1);
+    scrutiny_handler.process(0);
+    check_get_params_response(1, sizeof(_rx_buffer1), sizeof(_tx_buffer1));
+}
+
+TEST_F(TestCommChannels, DisconnectOnlyAffectsItsChannel)
+{
+    scrutiny_handler.comm(0)->connect();
+    scrutiny_handler.comm(1)->connect();
+    uint32_t const session_id = scrutiny_handler.comm(1)->get_session_id();
+    unsigned char request_data[8 + 4] = { 2, 5, 0, 4 };
+    request_data[4] = static_cast<unsigned char>((session_id >> 24) & 0xFF);
+    request_data[5] = static_cast<unsigned char>((session_id >> 16) & 0xFF);
+    request_data[6] = static_cast<unsigned char>((session_id >> 8) & 0xFF);
+    request_data[7] = static_cast<unsigned char>((session_id >> 0) & 0xFF);
+    add_crc(request_data, sizeof(request_data) - 4);
+
+    unsigned char tx_buffer[32];
+    scrutiny_handler.receive_data(request_data, sizeof(request_data), 1);
+    scrutiny_handler.process(0);
+    uint16_t const n_to_read = scrutiny_handler.data_to_send(1);
+    ASSERT_GT(n_to_read, 0u);
+    ASSERT_LT(n_to_read, sizeof(tx_buffer));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read, 1);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, scrutiny::protocol::CommandId::CommControl, 5, scrutiny::protocol::ResponseCode::OK);
+
+    EXPECT_FALSE(scrutiny_handler.comm(1)->is_connected());
+    EXPECT_TRUE(scrutiny_handler.comm(0)->is_connected());
+}
+
+TEST_F(TestCommChannels, UnusedChannelIsDisabled)
+{
+    config.set_channel_buffers(1, SCRUTINY_NULL, 0, SCRUTINY_NULL, 0);
+    EXPECT_EQ(scrutiny_handler.init(&config), scrutiny::Status::SUCCESS);
+    EXPECT_TRUE(scrutiny_handler.comm(0)->is_enabled());
+    EXPECT_FALSE(scrutiny_handler.comm(1)->is_enabled());
+
+    // A channel with invalid buffers is a configuration error
+    config.set_channel_buffers(1, _rx_buffer1, 8, _tx_buffer1, sizeof(_tx_buffer1));
+    EXPECT_EQ(scrutiny_handler.init(&config), scrutiny::Status::ERROR);
+}
+
+#endif
@@ -250,6 +250,195 @@ TEST_F(TestCommControl, TestConnect)
     ASSERT_TRUE(scrutiny_handler.comm()->is_connected());
 }
 
+TEST_F(TestCommControl, TestConnectWithFlags)
+{
+    // Asks for native endian values and an unknown flag. Only what is supported is sent back.
+    unsigned char request_data[8 + 5] = { 2, 4, 0, 5 };
+    std::memcpy(&request_data[4], scrutiny::protocol::CommControl::CONNECT_MAGIC, sizeof(scrutiny::protocol::CommControl::CONNECT_MAGIC));
+    request_data[8] = scrutiny::protocol::CommControl::ConnectFlags::NativeEndian | 0x80;
+    add_crc(request_data, sizeof(request_data) - 4);
+
+    bool const native_endian = CHAR_BIT == 8 && scrutiny::tools::is_little_endian();
+    unsigned char tx_buffer[32];
+    unsigned char expected_response[9 + 4 + 4 + 1] = { 0x82, 4, 0, 0, 9 };
+    std::memcpy(&expected_response[5], scrutiny::protocol::CommControl::CONNECT_MAGIC, sizeof(scrutiny::protocol::CommControl::CONNECT_MAGIC));
+
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    scrutiny_handler.process(0);
+
+    uint16_t n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_LT(n_to_read, sizeof(tx_buffer));
+    EXPECT_EQ(n_to_read, sizeof(expected_response));
+    uint16_t nread = scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    EXPECT_EQ(nread, n_to_read);
+
+    uint32_t session_id = scrutiny_handler.comm()->get_session_id();
+    expected_response[9] = (session_id >> 24) & 0xFF;
+    expected_response[10] = (session_id >> 16) & 0xFF;
+    expected_response[11] = (session_id >> 8) & 0xFF;
+    expected_response[12] = (session_id >> 0) & 0xFF;
+    expected_response[13] = native_endian ? scrutiny::protocol::CommControl::ConnectFlags::NativeEndian : 0;
+    add_crc(expected_response, sizeof(expected_response) - 4);
+
+    ASSERT_BUF_EQ(tx_buffer, expected_response, sizeof(expected_response));
+    ASSERT_TRUE(scrutiny_handler.comm()->is_connected());
+    EXPECT_EQ(scrutiny_handler.comm()->native_endian(), native_endian);
+
+    // The choice belongs to the session
+    scrutiny_handler.comm()->disconnect();
+    EXPECT_FALSE(scrutiny_handler.comm()->native_endian());
+    scrutiny_handler.comm()->connect();
+    EXPECT_FALSE(scrutiny_handler.comm()->native_endian());
+}
+
+TEST_F(TestCommControl, TestConnectWithFraming)
+{
+    unsigned char request_data[8 + 5] = { 2, 4, 0, 5 };
+    std::memcpy(&request_data[4], scrutiny::protocol::CommControl::CONNECT_MAGIC, sizeof(scrutiny::protocol::CommControl::CONNECT_MAGIC));
+    request_data[8] = scrutiny::protocol::CommControl::ConnectFlags::Framing;
+    add_crc(request_data, sizeof(request_data) - 4);
+
+    // The connect response is not framed. The server learns from it that framing is accepted
+    unsigned char tx_buffer[32];
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    scrutiny_handler.process(0);
+    uint16_t n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_EQ(n_to_read, 9u + 4u + 4u + 1u);
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    scrutiny_handler.process(0);
+    EXPECT_EQ(tx_buffer[0], 0x82);
+    EXPECT_EQ(tx_buffer[13], scrutiny::protocol::CommControl::ConnectFlags::Framing);
+    ASSERT_TRUE(scrutiny_handler.comm()->framing());
+
+    // Following frames are framed, both ways
+    unsigned char get_version[8] = { 1, 1, 0, 0 };
+    add_crc(get_version, sizeof(get_version) - 4);
+    unsigned char framed_request[sizeof(get_version) + 2];
+    uint16_t const framed_request_size = cobs_encode(get_version, sizeof(get_version), framed_request);
+    scrutiny_handler.receive_data(framed_request, framed_request_size);
+    scrutiny_handler.process(0);
+
+    unsigned char expected_response[9 + 2] = { 0x81, 1, 0, 0, 2, 1, 0 };
+    add_crc(expected_response, sizeof(expected_response) - 4);
+    n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_GT(n_to_read, sizeof(expected_response));
+    ASSERT_LE(n_to_read, sizeof(tx_buffer));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    unsigned char decoded[32];
+    ASSERT_EQ(cobs_decode(tx_buffer, n_to_read, decoded), sizeof(expected_response));
+    EXPECT_BUF_EQ(decoded, expected_response, sizeof(expected_response));
+}
+
+TEST_F(TestCommControl, TestConnectWithJumboFrames)
+{
+    static unsigned char jumbo_tx_buffer[0x20000];
+    static unsigned char memory[0xC000];
+    static unsigned char tx_buffer[sizeof(jumbo_tx_buffer) + scrutiny::protocol::JUMBO_RESPONSE_OVERHEAD];
+    for (uint32_t i = 0; i < sizeof(memory); i++)
+    {
+        memory[i] = static_cast<unsigned char>((i * 7) & 0xFF);
+    }
+    config.set_jumbo_tx_buffer(jumbo_tx_buffer, sizeof(jumbo_tx_buffer));
+    scrutiny_handler.init(&config);
+
+    // The size of the jumbo buffer comes after the regular parameters
+    unsigned char get_params[8] = { 2, 3, 0, 0 };
+    add_crc(get_params, sizeof(get_params) - 4);
+    scrutiny_handler.comm()->connect();
+    scrutiny_handler.receive_data(get_params, sizeof(get_params));
+    scrutiny_handler.process(0);
+    uint16_t n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_EQ(n_to_read, 9u + 18u + 4u);
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    scrutiny_handler.process(0);
+    EXPECT_EQ(tx_buffer[4], 18u + 4u);
+    EXPECT_EQ(scrutiny::codecs::decode_32_bits_big_endian_8bits(&tx_buffer[5 + 18]), sizeof(jumbo_tx_buffer));
+    scrutiny_handler.comm()->disconnect();
+
+    // Not together with framing
+    unsigned char connect[8 + 5] = { 2, 4, 0, 5 };
+    std::memcpy(&connect[4], scrutiny::protocol::CommControl::CONNECT_MAGIC, sizeof(scrutiny::protocol::CommControl::CONNECT_MAGIC));
+    connect[8] = scrutiny::protocol::CommControl::ConnectFlags::JumboFrames | scrutiny::protocol::CommControl::ConnectFlags::Framing;
+    add_crc(connect, sizeof(connect) - 4);
+    scrutiny_handler.receive_data(connect, sizeof(connect));
+    scrutiny_handler.process(0);
+    n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_EQ(n_to_read, 9u + 4u + 4u + 1u);
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    scrutiny_handler.process(0);
+    EXPECT_EQ(tx_buffer[13], scrutiny::protocol::CommControl::ConnectFlags::Framing);
+    EXPECT_FALSE(scrutiny_handler.comm()->jumbo_frames());
+    scrutiny_handler.comm()->disconnect();
+
+    // The connect response is a regular frame. The server learns from it that jumbo frames are accepted
+    connect[8] = scrutiny::protocol::CommControl::ConnectFlags::JumboFrames;
+    add_crc(connect, sizeof(connect) - 4);
+    scrutiny_handler.receive_data(connect, sizeof(connect));
+    scrutiny_handler.process(0);
+    n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_EQ(n_to_read, 9u + 4u + 4u + 1u);
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    scrutiny_handler.process(0);
+    EXPECT_EQ(tx_buffer[13], scrutiny::protocol::CommControl::ConnectFlags::JumboFrames);
+    ASSERT_TRUE(scrutiny_handler.comm()->jumbo_frames());
+
+    // Two blocks that cannot fit a regular frame together
+    SCRUTINY_CONSTEXPR uint32_t addr_size = SIZEOF_8BITS(uintptr_t);
+    unsigned char read_request[8 + 2 * (addr_size + 2)] = { 3, 1, 0, 2 * (addr_size + 2) };
+    unsigned int index = 4;
+    for (unsigned int i = 0; i < 2; i++)
+    {
+        index += encode_addr(&read_request[index], memory);
+        read_request[index++] = (sizeof(memory) >> 8) & 0xFF;
+        read_request[index++] = (sizeof(memory) >> 0) & 0xFF;
+    }
+    add_crc(read_request, sizeof(read_request) - 4);
+    scrutiny_handler.receive_data(read_request, sizeof(read_request));
+    scrutiny_handler.process(0);
+
+    uint32_t const datalen = 2 * (addr_size + 2 + sizeof(memory));
+    uint32_t total_read = 0;
+    while (scrutiny_handler.data_to_send() > 0)
+    {
+        n_to_read = scrutiny_handler.data_to_send();
+        ASSERT_LE(total_read + n_to_read, sizeof(tx_buffer));
+        total_read += scrutiny_handler.pop_data(&tx_buffer[total_read], n_to_read);
+    }
+    ASSERT_EQ(total_read, datalen + scrutiny::protocol::JUMBO_RESPONSE_OVERHEAD);
+    EXPECT_EQ(tx_buffer[0], 0x83);
+    EXPECT_EQ(tx_buffer[1], 1u);
+    EXPECT_EQ(tx_buffer[2], 0u);
+    EXPECT_EQ(scrutiny::codecs::decode_32_bits_big_endian_8bits(&tx_buffer[3]), datalen);
+    EXPECT_EQ(scrutiny::codecs::decode_32_bits_big_endian_8bits(&tx_buffer[7 + datalen]), scrutiny::tools::crc32(tx_buffer, 7 + datalen));
+    index = 7;
+    for (unsigned int i = 0; i < 2; i++)
+    {
+        index += addr_size + 2;
+        ASSERT_BUF_EQ(&tx_buffer[index], memory, sizeof(memory));
+        index += sizeof(memory);
+    }
+}
+
+TEST_F(TestCommControl, TestConnectBadLength)
+{
+    unsigned char request_data[8 + 6] = { 2, 4, 0, 6 };
+    std::memcpy(&request_data[4], scrutiny::protocol::CommControl::CONNECT_MAGIC, sizeof(scrutiny::protocol::CommControl::CONNECT_MAGIC));
+    add_crc(request_data, sizeof(request_data) - 4);
+
+    unsigned char tx_buffer[32];
+    unsigned char expected_response[9] = { 0x82, 4, scrutiny::protocol::ResponseCode::InvalidRequest, 0, 0 };
+    add_crc(expected_response, sizeof(expected_response) - 4);
+
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    scrutiny_handler.process(0);
+
+    uint16_t n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_EQ(n_to_read, sizeof(expected_response));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    ASSERT_BUF_EQ(tx_buffer, expected_response, sizeof(expected_response));
+    EXPECT_FALSE(scrutiny_handler.comm()->is_connected());
+}
+
 TEST_F(TestCommControl, TestDisconnect)
 {
     scrutiny_handler.comm()->connect();
@@ -0,0 +1,127 @@
+//    test_comm_fifos.cpp
+//        Test the byte FIFOs placed between the interrupts and the MainHandler communication stream
+//
+//   - License : MIT - See LICENSE file
+//   - Project : Scrutiny Debugger (github.com/scrutinydebugger/scrutiny-embedded)
+//
+//    Copyright (c) 2021 Scrutiny Debugger
+
+#include "scrutinytest/scrutinytest.hpp"
+#include <cstring>
+
+#include "scrutiny.hpp"
+#include "scrutiny_test.hpp"
+
+static unsigned char _rx_buffer[128];
+static unsigned char _tx_buffer[128];
+static unsigned char _rx_fifo[11];
+static unsigned char _tx_fifo[16];
+
+class TestCommFifos : public ScrutinyTest
+{
+  protected:
+    scrutiny::MainHandler scrutiny_handler;
+    scrutiny::Config config;
+
+    TestCommFifos() :
+        ScrutinyTest(),
+        scrutiny_handler(),
+        config()
+    {
+    }
+
+    virtual void SetUp()
+    {
+        config.set_buffers(_rx_buffer, sizeof(_rx_buffer), _tx_buffer, sizeof(_tx_buffer));
+        config.set_fifos(_rx_fifo, sizeof(_rx_fifo), _tx_fifo, sizeof(_tx_fifo));
+        scrutiny_handler.init(&config);
+        scrutiny_handler.comm()->connect();
+    }
+
+    uint16_t read_response(unsigned char *const buffer, uint16_t const max_len);
+};
+
+// Calls process() until the Tx FIFO stays empty, just like an interrupt would empty it between the calls
+uint16_t TestCommFifos::read_response(unsigned char *const buffer, uint16_t const max_len)
+{
+    uint16_t total = 0;
+    for (int i = 0; i < 100; i++)
+    {
+        scrutiny_handler.process(0);
+        uint16_t const n = scrutiny_handler.tx_fifo()->read(&buffer[total], static_cast<uint16_t>(max_len - total));
+        if (n == 0)
+        {
+            break;
+        }
+        total = static_cast<uint16_t>(total + n);
+    }
+    return total;
+}
+
+TEST_F(TestCommFifos, RequestAndResponseThroughFifos)
+{
+    unsigned char request_data[8] = { 2, 3, 0, 0 }; // GetParams
+    add_crc(request_data, sizeof(request_data) - 4);
+    unsigned char tx_buffer[64];
+
+    EXPECT_TRUE(scrutiny_handler.rx_fifo(SCRUTINY_COMM_CHANNEL_COUNT) == SCRUTINY_NULL);
+    EXPECT_TRUE(scrutiny_handler.tx_fifo(SCRUTINY_COMM_CHANNEL_COUNT) == SCRUTINY_NULL);
+
+    // Twice, so the indexes of the Rx FIFO wrap around its storage
+    for (int iteration = 0; iteration < 2; iteration++)
+    {
+        // Bytes pushed one by one, like a UART interrupt
+        for (unsigned int i = 0; i < sizeof(request_data); i++)
+        {
+            ASSERT_TRUE(scrutiny_handler.rx_fifo()->push(request_data[i]));
+        }
+
+        memset(tx_buffer, 0, sizeof(tx_buffer));
+        uint16_t const n = read_response(tx_buffer, sizeof(tx_buffer));
+        ASSERT_GT(n, sizeof(_tx_fifo)); // Needed more than one fill of the Tx FIFO
+        ASSERT_IS_PROTOCOL_RESPONSE(tx_buffer, scrutiny::protocol::CommandId::CommControl, 3, scrutiny::protocol::ResponseCode::OK);
+        EXPECT_EQ((tx_buffer[5] << 8) | tx_buffer[6], sizeof(_rx_buffer));
+        EXPECT_EQ((tx_buffer[7] << 8) | tx_buffer[8], sizeof(_tx_buffer));
+        EXPECT_EQ(scrutiny_handler.data_to_send(), 0u);
+        EXPECT_EQ(scrutiny_handler.rx_fifo()->count(), 0u);
+    }
+}
+
+TEST_F(TestCommFifos, ResponseLeftInTxFifo)
+{
+    unsigned char request_data[8] = { 2, 3, 0, 0 }; // GetParams
+    add_crc(request_data, sizeof(request_data) - 4);
+
+    ASSERT_EQ(scrutiny_handler.rx_fifo()->write(request_data, sizeof(request_data)), sizeof(request_data));
+    scrutiny_handler.process(0);
+    EXPECT_EQ(scrutiny_handler.tx_fifo()->count(), sizeof(_tx_fifo) - 1);
+    uint16_t const remaining = scrutiny_handler.data_to_send();
+    EXPECT_GT(remaining, 0u);
+
+    // Nobody empties the Tx FIFO. The response waits
+    scrutiny_handler.process(0);
+    scrutiny_handler.process(0);
+    EXPECT_EQ(scrutiny_handler.tx_fifo()->count(), sizeof(_tx_fifo) - 1);
+    EXPECT_EQ(scrutiny_handler.data_to_send(), remaining);
+    EXPECT_TRUE(scrutiny_handler.comm()->transmitting());
+}
+
+TEST_F(TestCommFifos, NoFifoByDefault)
+{
+    scrutiny::Config config2;
+    scrutiny::MainHandler handler2;
+    config2.set_buffers(_rx_buffer, sizeof(_rx_buffer), _tx_buffer, sizeof(_tx_buffer));
+    handler2.init(&config2);
+    handler2.comm()->connect();
+
+    EXPECT_FALSE(handler2.rx_fifo()->is_set());
+    EXPECT_FALSE(handler2.tx_fifo()->is_set());
+    EXPECT_FALSE(handler2.rx_fifo()->push(0));
+
+    // The stream is used directly
+    unsigned char request_data[8] = { 2, 3, 0, 0 }; // GetParams
+    add_crc(request_data, sizeof(request_data) - 4);
+    handler2.receive_data(request_data, sizeof(request_data));
+    handler2.process(0);
+    EXPECT_GT(handler2.data_to_send(), 0u);
+}
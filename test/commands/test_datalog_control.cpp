@@ -248,6 +248,7 @@ uint16_t TestDatalogControl::encode_datalogger_config(
         switch (dlconfig->items_to_log[item_index].common.type)
         {
         case datalogging::LoggableType::Time:
+        case datalogging::LoggableType::ImplicitTime:
             break;
         case datalogging::LoggableType::Memory:
             if (cursor + 1 + SIZEOF_8BITS(void *) >= max_size)
@@ -264,9 +265,93 @@ uint16_t TestDatalogControl::encode_datalogger_config(
             }
             cursor += codecs::encode_16_bits_big_endian_8bits(dlconfig->items_to_log[item_index].rpv.id, &buffer[cursor]);
             break;
+        case datalogging::LoggableType::MemoryBit:
+            if (cursor + 3 + SIZEOF_8BITS(void *) >= max_size)
+            {
+                return 0;
+            }
+            cursor += codecs::encode_8_bits_8bits(static_cast<unsigned char>(dlconfig->items_to_log[item_index].memorybit.datatype), &buffer[cursor]);
+            cursor += codecs::encode_address_big_endian_8bits(dlconfig->items_to_log[item_index].memorybit.address, &buffer[cursor]);
+            cursor += codecs::encode_8_bits_8bits(dlconfig->items_to_log[item_index].memorybit.bitoffset, &buffer[cursor]);
+            cursor += codecs::encode_8_bits_8bits(dlconfig->items_to_log[item_index].memorybit.bitsize, &buffer[cursor]);
+            break;
+        }
+    }
+
+    bool item_decimation = false;
+    for (uint32_t i = 0; i < dlconfig->items_count && i < SCRUTINY_DATALOGGING_MAX_SIGNAL; i++)
+    {
+        item_decimation = item_decimation || (dlconfig->items_options[i].decimation > 1);
+    }
+
+    if (item_decimation)
+    {
+        if (cursor + 1 + 2 * dlconfig->items_count >= max_size)
+        {
+            return 0;
+        }
+        uint_least8_t const extension_id = static_cast<uint_least8_t>(protocol::DataLogControl::ConfigureExtension::ItemDecimation);
+        cursor += codecs::encode_8_bits_8bits(extension_id, &buffer[cursor]);
+        for (uint32_t i = 0; i < dlconfig->items_count; i++)
+        {
+            cursor += codecs::encode_16_bits_big_endian_8bits(dlconfig->items_options[i].decimation, &buffer[cursor]);
+        }
+    }
+
+    bool item_reduction = false;
+    for (uint32_t i = 0; i < dlconfig->items_count && i < SCRUTINY_DATALOGGING_MAX_SIGNAL; i++)
+    {
+        item_reduction = item_reduction || (dlconfig->items_options[i].reduction != datalogging::ReductionMode::Last);
+    }
+
+    if (item_reduction)
+    {
+        if (cursor + 1 + 2 * dlconfig->items_count >= max_size)
+        {
+            return 0;
+        }
+        uint_least8_t const extension_id = static_cast<uint_least8_t>(protocol::DataLogControl::ConfigureExtension::ItemReduction);
+        cursor += codecs::encode_8_bits_8bits(extension_id, &buffer[cursor]);
+        for (uint32_t i = 0; i < dlconfig->items_count; i++)
+        {
+            buffer[cursor++] = static_cast<uint8_t>(dlconfig->items_options[i].reduction);
+            buffer[cursor++] = static_cast<uint8_t>(dlconfig->items_options[i].datatype);
+        }
+    }
+
+    bool item_storage = false;
+    for (uint32_t i = 0; i < dlconfig->items_count && i < SCRUTINY_DATALOGGING_MAX_SIGNAL; i++)
+    {
+        item_storage = item_storage || (dlconfig->items_options[i].storage != datalogging::StorageFormat::Native);
+    }
+
+    if (item_storage)
+    {
+        if (cursor + 1 + 10 * dlconfig->items_count >= max_size)
+        {
+            return 0;
+        }
+        uint_least8_t const extension_id = static_cast<uint_least8_t>(protocol::DataLogControl::ConfigureExtension::ItemStorage);
+        cursor += codecs::encode_8_bits_8bits(extension_id, &buffer[cursor]);
+        for (uint32_t i = 0; i < dlconfig->items_count; i++)
+        {
+            buffer[cursor++] = static_cast<uint8_t>(dlconfig->items_options[i].storage);
+            buffer[cursor++] = static_cast<uint8_t>(dlconfig->items_options[i].datatype);
+            cursor += codecs::encode_float_big_endian_8bits(dlconfig->items_options[i].scale, &buffer[cursor]);
+            cursor += codecs::encode_float_big_endian_8bits(dlconfig->items_options[i].offset, &buffer[cursor]);
         }
     }
 
+    if (dlconfig->double_buffering)
+    {
+        if (cursor + 1 >= max_size)
+        {
+            return 0;
+        }
+        uint_least8_t const extension_id = static_cast<uint_least8_t>(protocol::DataLogControl::ConfigureExtension::DoubleBuffering);
+        cursor += codecs::encode_8_bits_8bits(extension_id, &buffer[cursor]);
+    }
+
     return cursor;
 }
 
@@ -463,6 +548,167 @@ TEST_F(TestDatalogControl, TestBadDecimation)
     test_configure(loop_id, 0, refconfig, protocol::ResponseCode::InvalidRequest);
 }
 
+TEST_F(TestDatalogControl, TestConfigureItemDecimation)
+{
+    datalogging::Configuration refconfig = get_valid_reference_configuration();
+    refconfig.items_options[1].decimation = 10;
+    refconfig.items_options[2].decimation = 3;
+    test_configure(0, 0, refconfig, protocol::ResponseCode::OK);
+
+    datalogging::Configuration const *dlconfig = scrutiny_handler.datalogger()->config();
+    EXPECT_EQ(dlconfig->items_options[0].decimation, 0u);
+    EXPECT_EQ(dlconfig->items_options[1].decimation, 10u);
+    EXPECT_EQ(dlconfig->items_options[2].decimation, 3u);
+    EXPECT_TRUE(scrutiny_handler.datalogger()->get_encoder()->variable_entries());
+}
+
+TEST_F(TestDatalogControl, TestConfigureItemReduction)
+{
+    datalogging::Configuration refconfig = get_valid_reference_configuration();
+    refconfig.items_options[1].reduction = datalogging::ReductionMode::MinMax;
+    refconfig.items_options[1].datatype = VariableType::float32;
+    refconfig.items_options[2].reduction = datalogging::ReductionMode::Mean;
+    test_configure(0, 0, refconfig, protocol::ResponseCode::OK);
+
+    datalogging::Configuration const *dlconfig = scrutiny_handler.datalogger()->config();
+    EXPECT_EQ(dlconfig->items_options[0].reduction, datalogging::ReductionMode::Last);
+    EXPECT_EQ(dlconfig->items_options[1].reduction, datalogging::ReductionMode::MinMax);
+    EXPECT_EQ(dlconfig->items_options[1].datatype, VariableType::float32);
+    EXPECT_EQ(dlconfig->items_options[2].reduction, datalogging::ReductionMode::Mean);
+    EXPECT_TRUE(scrutiny_handler.datalogger()->get_encoder()->reductions_enabled());
+}
+
+TEST_F(TestDatalogControl, TestConfigureBadItemReduction)
+{
+    datalogging::Configuration refconfig;
+
+    refconfig = get_valid_reference_configuration();
+    refconfig.items_options[0].reduction = datalogging::ReductionMode::Mean; // Time cannot be reduced
+    test_configure(0, 0, refconfig, protocol::ResponseCode::InvalidRequest, true, "Time item");
+
+    refconfig = get_valid_reference_configuration();
+    refconfig.items_options[1].reduction = datalogging::ReductionMode::Mean; // Memory item without a datatype
+    test_configure(0, 0, refconfig, protocol::ResponseCode::InvalidRequest, true, "No datatype");
+
+    refconfig = get_valid_reference_configuration();
+    refconfig.items_options[1].reduction = datalogging::ReductionMode::Mean;
+    refconfig.items_options[1].datatype = VariableType::uint16; // Size mismatch
+    test_configure(0, 0, refconfig, protocol::ResponseCode::InvalidRequest, true, "Size mismatch");
+
+    refconfig = get_valid_reference_configuration();
+    refconfig.items_options[1].reduction = datalogging::ReductionMode::Mean;
+    refconfig.items_options[1].datatype = VariableType::boolean32; // No mean on booleans
+    test_configure(0, 0, refconfig, protocol::ResponseCode::InvalidRequest, true, "Boolean mean");
+
+    refconfig = get_valid_reference_configuration();
+    refconfig.items_options[2].reduction = static_cast<datalogging::ReductionMode::eReductionMode>(0x7F);
+    test_configure(0, 0, refconfig, protocol::ResponseCode::InvalidRequest, true, "Unknown mode");
+}
+
+TEST_F(TestDatalogControl, TestConfigureMemoryBit)
+{
+    datalogging::Configuration refconfig = get_valid_reference_configuration();
+    refconfig.items_count = 4;
+    refconfig.items_to_log[3].common.type = datalogging::LoggableType::MemoryBit;
+    refconfig.items_to_log[3].memorybit.address = &m_some_var_logged1;
+    refconfig.items_to_log[3].memorybit.datatype = VariableType::uint32;
+    refconfig.items_to_log[3].memorybit.bitoffset = 5;
+    refconfig.items_to_log[3].memorybit.bitsize = 3;
+    test_configure(0, 0, refconfig, protocol::ResponseCode::OK);
+
+    datalogging::Configuration const *dlconfig = scrutiny_handler.datalogger()->config();
+    ASSERT_EQ(dlconfig->items_count, 4u);
+    EXPECT_EQ(dlconfig->items_to_log[3].common.type, datalogging::LoggableType::MemoryBit);
+    EXPECT_EQ(dlconfig->items_to_log[3].memorybit.address, &m_some_var_logged1);
+    EXPECT_EQ(dlconfig->items_to_log[3].memorybit.datatype, VariableType::uint32);
+    EXPECT_EQ(dlconfig->items_to_log[3].memorybit.bitoffset, 5u);
+    EXPECT_EQ(dlconfig->items_to_log[3].memorybit.bitsize, 3u);
+    EXPECT_TRUE(scrutiny_handler.datalogger()->get_encoder()->packed_bits());
+}
+
+TEST_F(TestDatalogControl, TestConfigureBadMemoryBit)
+{
+    datalogging::Configuration refconfig = get_valid_reference_configuration();
+    refconfig.items_to_log[1].common.type = datalogging::LoggableType::MemoryBit;
+    refconfig.items_to_log[1].memorybit.address = &m_some_var_logged1;
+
+    refconfig.items_to_log[1].memorybit.datatype = VariableType::float32;
+    refconfig.items_to_log[1].memorybit.bitoffset = 0;
+    refconfig.items_to_log[1].memorybit.bitsize = 1;
+    test_configure(0, 0, refconfig, protocol::ResponseCode::InvalidRequest, true, "Float");
+
+    refconfig.items_to_log[1].memorybit.datatype = VariableType::uint32;
+    refconfig.items_to_log[1].memorybit.bitoffset = 0;
+    refconfig.items_to_log[1].memorybit.bitsize = 0;
+    test_configure(0, 0, refconfig, protocol::ResponseCode::InvalidRequest, true, "No bits");
+
+    refconfig.items_to_log[1].memorybit.datatype = VariableType::uint32;
+    refconfig.items_to_log[1].memorybit.bitoffset = 30;
+    refconfig.items_to_log[1].memorybit.bitsize = 3;
+    test_configure(0, 0, refconfig, protocol::ResponseCode::InvalidRequest, true, "Too many bits");
+}
+
+TEST_F(TestDatalogControl, TestConfigureBadExtension)
+{
+    datalogging::Configuration refconfig = get_valid_reference_configuration();
+    unsigned char request_data[256] = { 5, 2 };
+    unsigned char tx_buffer[32];
+
+    uint16_t const config_size = encode_datalogger_config(0, 0, &refconfig, &request_data[4], sizeof(request_data) - 16);
+    ASSERT_GT(config_size, 0);
+
+    uint_least8_t const extensions[2] = { 0xFF, protocol::DataLogControl::ConfigureExtension::ItemDecimation };
+    for (uint_fast8_t i = 0; i < sizeof(extensions); i++)
+    {
+        // Unknown block or a block with missing data
+        uint16_t const payload_size = config_size + 2;
+        request_data[4 + config_size] = extensions[i];
+        request_data[4 + config_size + 1] = 0;
+        request_data[2] = (payload_size >> 8) & 0xFF;
+        request_data[3] = payload_size & 0xFF;
+        add_crc(request_data, 4 + payload_size);
+
+        scrutiny_handler.receive_data(request_data, payload_size + 8);
+        scrutiny_handler.process(0);
+
+        uint16_t n_to_read = scrutiny_handler.data_to_send();
+        ASSERT_LT(n_to_read, sizeof(tx_buffer));
+        scrutiny_handler.pop_data(tx_buffer, n_to_read);
+        scrutiny_handler.process(0);
+        EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, protocol::CommandId::DataLogControl, 2, protocol::ResponseCode::InvalidRequest);
+    }
+}
+
+TEST_F(TestDatalogControl, TestConfigureReductionAndStorageDatatypesMustAgree)
+{
+    datalogging::Configuration refconfig = get_valid_reference_configuration();
+    refconfig.items_options[1].reduction = datalogging::ReductionMode::Mean;
+    refconfig.items_options[1].storage = datalogging::StorageFormat::Float16;
+    refconfig.items_options[1].datatype = VariableType::float32;
+    test_configure(0, 0, refconfig, protocol::ResponseCode::OK, true, "Same datatype");
+
+    unsigned char request_data[256] = { 5, 2 };
+    unsigned char tx_buffer[32];
+    uint16_t const payload_size = encode_datalogger_config(0, 0, &refconfig, &request_data[4], sizeof(request_data) - 16);
+    ASSERT_GT(payload_size, 0);
+
+    // The ItemStorage block is the last one. Give item 1 another datatype than in the ItemReduction block
+    uint16_t const storage_datatype_index = 4 + payload_size - refconfig.items_count * 10u + 1u * 10u + 1u;
+    ASSERT_EQ(request_data[storage_datatype_index], static_cast<uint8_t>(VariableType::float32));
+    request_data[storage_datatype_index] = static_cast<uint8_t>(VariableType::sint32);
+    request_data[2] = (payload_size >> 8) & 0xFF;
+    request_data[3] = payload_size & 0xFF;
+    add_crc(request_data, 4 + payload_size);
+
+    scrutiny_handler.receive_data(request_data, payload_size + 8);
+    scrutiny_handler.process(0);
+    uint16_t n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_LT(n_to_read, sizeof(tx_buffer));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    scrutiny_handler.process(0);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, protocol::CommandId::DataLogControl, 2, protocol::ResponseCode::InvalidRequest);
+}
+
 TEST_F(TestDatalogControl, TestConfigureBadOperands)
 {
 
@@ -593,6 +839,15 @@ TEST_F(TestDatalogControl, TestConfigureLoggableBadRPV)
     test_configure(loop_id, 0, refconfig, protocol::ResponseCode::FailureToProceed);
 }
 
+TEST_F(TestDatalogControl, TestConfigureImplicitTimeRequiresFixedFreq)
+{
+    datalogging::Configuration refconfig = get_valid_reference_configuration();
+    refconfig.items_to_log[0].common.type = datalogging::LoggableType::ImplicitTime;
+
+    test_configure(1, 0, refconfig, protocol::ResponseCode::FailureToProceed, true, "Variable freq loop"); // Loop 1 is variable freq
+    test_configure(0, 0, refconfig, protocol::ResponseCode::OK, true, "Fixed freq loop");
+}
+
 TEST_F(TestDatalogControl, TestOwnerMechanism)
 {
     ASSERT_FALSE(fixed_freq_loop.owns_datalogger());
@@ -912,6 +1167,302 @@ TEST_F(TestDatalogControl, TestGetAcquisitionMetadata)
     EXPECT_BUF_EQ(tx_buffer, expected_response, sizeof(expected_response));
 }
 
+TEST_F(TestDatalogControl, TestReleaseAcquisitionDoubleBuffering)
+{
+    unsigned char tx_buffer[32] = { 0 };
+    uint16_t n_to_read = 0;
+    unsigned char request_data[8] = { 5, 10, 0, 0 };
+    add_crc(request_data, sizeof(request_data) - 4);
+
+    datalogging::Configuration refconfig = get_valid_reference_configuration();
+    refconfig.decimation = 1;
+    refconfig.double_buffering = true;
+    test_configure(0, 0xabcd, refconfig, protocol::ResponseCode::OK); // Assign to Loop 0 (Fixed freq)
+    fixed_freq_loop.process();                                        // Accept ownership
+    scrutiny_handler.process(0);
+    EXPECT_TRUE(scrutiny_handler.datalogger()->double_buffering());
+
+    // Nothing to release yet
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    scrutiny_handler.process(0);
+    n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_GT(n_to_read, 0);
+    ASSERT_LT(n_to_read, sizeof(tx_buffer));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    scrutiny_handler.process(0);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, protocol::CommandId::DataLogControl, 10, protocol::ResponseCode::FailureToProceed);
+
+    scrutiny_handler.datalogger()->arm_trigger();
+    scrutiny_handler.datalogger()->force_trigger();
+    for (uint32_t i = 0; i < sizeof(dlbuffer) / 4; i++)
+    {
+        fixed_freq_loop.process();
+        scrutiny_handler.process(1);
+        if (scrutiny_handler.datalogging_data_available())
+        {
+            break;
+        }
+    }
+    ASSERT_TRUE(scrutiny_handler.datalogging_data_available());
+    // The datalogger rearmed itself in the other half of the buffer
+    EXPECT_EQ(scrutiny_handler.datalogger()->get_state(), datalogging::DataLogger::State::Armed);
+    uint16_t const first_acquisition_id = scrutiny_handler.datalogger()->get_acquisition_id();
+
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    scrutiny_handler.process(0);
+    n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_GT(n_to_read, 0);
+    ASSERT_LT(n_to_read, sizeof(tx_buffer));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    scrutiny_handler.process(0);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, protocol::CommandId::DataLogControl, 10, protocol::ResponseCode::OK);
+    EXPECT_FALSE(scrutiny_handler.datalogging_data_available());
+
+    // The 2nd acquisition gets published once the loop has handled the release.
+    scrutiny_handler.datalogger()->force_trigger();
+    for (uint32_t i = 0; i < sizeof(dlbuffer) / 4; i++)
+    {
+        fixed_freq_loop.process();
+        scrutiny_handler.process(1);
+        if (scrutiny_handler.datalogging_data_available())
+        {
+            break;
+        }
+    }
+    ASSERT_TRUE(scrutiny_handler.datalogging_data_available());
+    EXPECT_EQ(scrutiny_handler.datalogger()->get_acquisition_id(), static_cast<uint16_t>(first_acquisition_id + 1));
+}
+
+TEST_F(TestDatalogControl, TestReleaseAcquisitionNoDoubleBuffering)
+{
+    unsigned char tx_buffer[32] = { 0 };
+    datalogging::Configuration refconfig = get_valid_reference_configuration();
+    test_configure(0, 0xabcd, refconfig, protocol::ResponseCode::OK); // Assign to Loop 0 (Fixed freq)
+    fixed_freq_loop.process();                                        // Accept ownership
+    scrutiny_handler.process(0);
+    EXPECT_FALSE(scrutiny_handler.datalogger()->double_buffering());
+
+    unsigned char request_data[8] = { 5, 10, 0, 0 };
+    add_crc(request_data, sizeof(request_data) - 4);
+
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    scrutiny_handler.process(0);
+    uint16_t const n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_GT(n_to_read, 0);
+    ASSERT_LT(n_to_read, sizeof(tx_buffer));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    scrutiny_handler.process(0);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, protocol::CommandId::DataLogControl, 10, protocol::ResponseCode::FailureToProceed);
+}
+
+TEST_F(TestDatalogControl, TestConfigureBadItemStorage)
+{
+    datalogging::Configuration refconfig;
+
+    refconfig = get_valid_reference_configuration();
+    refconfig.items_options[0].storage = datalogging::StorageFormat::Float16; // Time cannot be converted
+    test_configure(0, 0, refconfig, protocol::ResponseCode::InvalidRequest, true, "Time item");
+
+    refconfig = get_valid_reference_configuration();
+    refconfig.items_options[1].storage = datalogging::StorageFormat::Float16;
+    refconfig.items_options[1].datatype = VariableType::uint32; // Only float can be converted
+    test_configure(0, 0, refconfig, protocol::ResponseCode::InvalidRequest, true, "Integer");
+
+    refconfig = get_valid_reference_configuration();
+    refconfig.items_options[2].storage = datalogging::StorageFormat::ScaledInt16;
+    refconfig.items_options[2].scale = 0; // Would divide by 0
+    test_configure(0, 0, refconfig, protocol::ResponseCode::InvalidRequest, true, "No scale");
+
+    refconfig = get_valid_reference_configuration();
+    refconfig.items_options[2].storage = static_cast<datalogging::StorageFormat::eStorageFormat>(0x7F);
+    test_configure(0, 0, refconfig, protocol::ResponseCode::InvalidRequest, true, "Unknown format");
+}
+
+TEST_F(TestDatalogControl, TestGetAcquisitionMetadataWithStorageFormat)
+{
+    unsigned char tx_buffer[64] = { 0 };
+    uint16_t n_to_read = 0;
+
+    datalogging::Configuration refconfig = get_valid_reference_configuration();
+    refconfig.decimation = 1;
+    refconfig.items_options[1].storage = datalogging::StorageFormat::Float16;
+    refconfig.items_options[1].datatype = VariableType::float32;
+    refconfig.items_options[2].storage = datalogging::StorageFormat::ScaledInt16;
+    refconfig.items_options[2].scale = 0.5f;
+    refconfig.items_options[2].offset = -10.0f;
+    test_configure(0, 0xabcd, refconfig, protocol::ResponseCode::OK);
+    EXPECT_TRUE(scrutiny_handler.datalogger()->get_encoder()->converted_items());
+    fixed_freq_loop.process(); // Accept ownership
+    scrutiny_handler.process(0);
+
+    scrutiny_handler.datalogger()->arm_trigger();
+    scrutiny_handler.datalogger()->force_trigger();
+    for (uint32_t i = 0; i < sizeof(dlbuffer) / 4; i++)
+    {
+        fixed_freq_loop.process();
+        scrutiny_handler.process(1);
+        if (scrutiny_handler.datalogger()->data_acquired())
+        {
+            break;
+        }
+    }
+    ASSERT_TRUE(scrutiny_handler.datalogger()->data_acquired());
+    fixed_freq_loop.process();
+    scrutiny_handler.process(1);
+
+    unsigned char request_data[8] = { 5, 6, 0, 0 };
+    add_crc(request_data, sizeof(request_data) - 4);
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    scrutiny_handler.process(0);
+    n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_LT(n_to_read, sizeof(tx_buffer));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    ASSERT_IS_PROTOCOL_RESPONSE(tx_buffer, protocol::CommandId::DataLogControl, 6, protocol::ResponseCode::OK);
+
+    datalogging::DataReader *reader = scrutiny_handler.datalogger()->get_reader();
+    reader->reset();
+
+    // Time (4 bytes) + 2 items of 16 bits instead of 2 items of 32 bits.
+    EXPECT_EQ(reader->get_total_size_8bits(), reader->get_entry_count() * (4 + 2 + 2));
+
+    unsigned char expected_response[9 + 16 + 1 + 2 * 10] = { 0x85, 6, 0, 0, 16 + 1 + 2 * 10 };
+    uint16_t cursor = 5;
+    cursor += codecs::encode_16_bits_big_endian_8bits(scrutiny_handler.datalogger()->get_acquisition_id(), &expected_response[cursor]);
+    cursor += codecs::encode_16_bits_big_endian_8bits((uint16_t)0xabcd, &expected_response[cursor]);
+    cursor += codecs::encode_32_bits_big_endian_8bits((uint32_t)reader->get_entry_count(), &expected_response[cursor]);
+    cursor += codecs::encode_32_bits_big_endian_8bits((uint32_t)reader->get_total_size_char(), &expected_response[cursor]);
+    cursor +=
+        codecs::encode_32_bits_big_endian_8bits((uint32_t)scrutiny_handler.datalogger()->log_points_after_trigger(), &expected_response[cursor]);
+    expected_response[cursor++] = 2; // Number of converted items
+    expected_response[cursor++] = 1; // Item index
+    expected_response[cursor++] = datalogging::StorageFormat::Float16;
+    cursor += codecs::encode_float_big_endian_8bits(0.0f, &expected_response[cursor]);
+    cursor += codecs::encode_float_big_endian_8bits(0.0f, &expected_response[cursor]);
+    expected_response[cursor++] = 2; // Item index
+    expected_response[cursor++] = datalogging::StorageFormat::ScaledInt16;
+    cursor += codecs::encode_float_big_endian_8bits(0.5f, &expected_response[cursor]);
+    cursor += codecs::encode_float_big_endian_8bits(-10.0f, &expected_response[cursor]);
+    add_crc(expected_response, sizeof(expected_response) - 4);
+
+    EXPECT_BUF_EQ(tx_buffer, expected_response, sizeof(expected_response));
+}
+
+TEST_F(TestDatalogControl, TestGetTimeAxis)
+{
+    unsigned char tx_buffer[128] = { 0 };
+    uint16_t n_to_read = 0;
+
+    datalogging::Configuration refconfig = get_valid_reference_configuration();
+    refconfig.decimation = 2;
+    refconfig.items_to_log[0].common.type = datalogging::LoggableType::ImplicitTime;
+    test_configure(0, 0xabcd, refconfig, protocol::ResponseCode::OK); // Assign to Loop 0 (Fixed freq)
+    fixed_freq_loop.process();                                        // Accept ownership
+    scrutiny_handler.process(0);
+
+    unsigned char request_data[8] = { 5, 9, 0, 0 };
+    add_crc(request_data, sizeof(request_data) - 4);
+
+    // No acquisition yet
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    scrutiny_handler.process(0);
+    n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_GT(n_to_read, 0);
+    ASSERT_LT(n_to_read, sizeof(tx_buffer));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    scrutiny_handler.process(0);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, protocol::CommandId::DataLogControl, 9, protocol::ResponseCode::FailureToProceed);
+
+    scrutiny_handler.datalogger()->arm_trigger();
+    scrutiny_handler.datalogger()->force_trigger();
+    for (uint32_t i = 0; i < sizeof(dlbuffer) * 2; i++)
+    {
+        fixed_freq_loop.process();
+        scrutiny_handler.process(1);
+        if (scrutiny_handler.datalogger()->data_acquired())
+        {
+            break;
+        }
+    }
+    ASSERT_TRUE(scrutiny_handler.datalogger()->data_acquired());
+    fixed_freq_loop.process();
+    scrutiny_handler.process(1);
+
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    scrutiny_handler.process(0);
+    n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_GT(n_to_read, 0);
+    ASSERT_LT(n_to_read, sizeof(tx_buffer));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    ASSERT_IS_PROTOCOL_RESPONSE(tx_buffer, protocol::CommandId::DataLogControl, 9, protocol::ResponseCode::OK);
+
+    datalogging::DataEncoder const *encoder = scrutiny_handler.datalogger()->get_encoder();
+    uint_least8_t const checkpoint_count = encoder->get_time_checkpoint_count();
+    ASSERT_GT(checkpoint_count, 0u);
+
+    unsigned char expected_response[sizeof(tx_buffer)] = { 0x85, 9, 0 };
+    uint16_t const datalen = 4 + 2 + 4 + 4 + 1 + checkpoint_count * 8;
+    ASSERT_EQ(n_to_read, datalen + 9);
+    uint16_t cursor = 3;
+    cursor += codecs::encode_16_bits_big_endian_8bits(datalen, &expected_response[cursor]);
+    cursor += codecs::encode_32_bits_big_endian_8bits(FIXED_FREQ_LOOP_TIMESTEP_US, &expected_response[cursor]);
+    cursor += codecs::encode_16_bits_big_endian_8bits(static_cast<uint16_t>(2), &expected_response[cursor]);
+    cursor += codecs::encode_32_bits_big_endian_8bits(scrutiny_handler.datalogger()->get_trigger_timestamp(), &expected_response[cursor]);
+    cursor += codecs::encode_32_bits_big_endian_8bits(encoder->get_first_entry_counter(), &expected_response[cursor]);
+    cursor += codecs::encode_8_bits_8bits(checkpoint_count, &expected_response[cursor]);
+    for (uint_least8_t i = 0; i < checkpoint_count; i++)
+    {
+        datalogging::TimeCheckpoint const checkpoint = encoder->get_time_checkpoint(i);
+        // Loop runs at a fixed rate with decimation=2. Checkpoints must agree with the implicit time axis.
+        EXPECT_EQ(
+            checkpoint.timestamp - encoder->get_time_checkpoint(0).timestamp,
+            (checkpoint.entry_counter - encoder->get_time_checkpoint(0).entry_counter) * 2 * FIXED_FREQ_LOOP_TIMESTEP_US);
+        cursor += codecs::encode_32_bits_big_endian_8bits(checkpoint.entry_counter, &expected_response[cursor]);
+        cursor += codecs::encode_32_bits_big_endian_8bits(checkpoint.timestamp, &expected_response[cursor]);
+    }
+    add_crc(expected_response, cursor);
+
+    EXPECT_BUF_EQ(tx_buffer, expected_response, n_to_read);
+}
+
+TEST_F(TestDatalogControl, TestGetTimeAxisNoImplicitTime)
+{
+    unsigned char tx_buffer[32] = { 0 };
+    uint16_t n_to_read = 0;
+
+    datalogging::Configuration refconfig = get_valid_reference_configuration(); // No ImplicitTime item
+    refconfig.decimation = 2;
+    test_configure(0, 0xabcd, refconfig, protocol::ResponseCode::OK);            // Assign to Loop 0 (Fixed freq)
+    fixed_freq_loop.process();                                                   // Accept ownership
+    scrutiny_handler.process(0);
+
+    scrutiny_handler.datalogger()->arm_trigger();
+    scrutiny_handler.datalogger()->force_trigger();
+    for (uint32_t i = 0; i < sizeof(dlbuffer) * 2; i++)
+    {
+        fixed_freq_loop.process();
+        scrutiny_handler.process(1);
+        if (scrutiny_handler.datalogger()->data_acquired())
+        {
+            break;
+        }
+    }
+    ASSERT_TRUE(scrutiny_handler.datalogger()->data_acquired());
+    ASSERT_FALSE(scrutiny_handler.datalogger()->get_encoder()->implicit_time());
+    fixed_freq_loop.process();
+    scrutiny_handler.process(1);
+
+    // The acquisition is available, but has no implicit time axis to describe
+    unsigned char request_data[8] = { 5, 9, 0, 0 };
+    add_crc(request_data, sizeof(request_data) - 4);
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    scrutiny_handler.process(0);
+    n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_GT(n_to_read, 0);
+    ASSERT_LT(n_to_read, sizeof(tx_buffer));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, protocol::CommandId::DataLogControl, 9, protocol::ResponseCode::FailureToProceed);
+}
+
 TEST_F(TestDatalogControl, TestReadAcquisitionNoDataAvailable)
 {
     unsigned char tx_buffer[32] = { 0 };
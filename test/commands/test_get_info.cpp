@@ -423,6 +423,8 @@ TEST_F(TestGetInfo, TestSupportedFeatures)
 
         config.memory_write_enable = (i == 0) ? true : false;
         config.set_user_command_callback((i == 0) ? SCRUTINY_NULL : dummy_callback);
+        scrutiny::WatchedMemoryBlock watched_blocks[1];
+        config.set_watched_blocks((i == 0) ? SCRUTINY_NULL : watched_blocks, 1);
 #if SCRUTINY_ENABLE_DATALOGGING
         unsigned char dl_buffer[128];
         config.set_datalogging_buffers(dl_buffer, sizeof(dl_buffer));
@@ -459,6 +461,16 @@ TEST_F(TestGetInfo, TestSupportedFeatures)
         expected_response[5] |= 0x10;
 #endif
 
+        if (CHAR_BIT == 8 && scrutiny::tools::is_little_endian())
+        {
+            expected_response[5] |= 0x08; // Native endian values
+        }
+
+        if (config.is_watched_blocks_set())
+        {
+            expected_response[5] |= 0x02; // Memory change detection
+        }
+
         add_crc(expected_response, sizeof(expected_response) - 4);
 
         scrutiny_handler.receive_data(request_data, sizeof(request_data));
@@ -667,3 +679,78 @@ TEST_F(TestGetInfo, TestGetLoopDefinitionOOBId)
     scrutiny_handler.pop_data(tx_buffer, n_to_read);
     ASSERT_IS_PROTOCOL_RESPONSE(tx_buffer, cmd, subfn, failure);
 }
+
+TEST_F(TestGetInfo, TestGetConfigFingerprint)
+{
+    unsigned char tx_buffer[32];
+
+    unsigned char request_data[8] = { 1, 10, 0, 0 };
+    add_crc(request_data, sizeof(request_data) - 4);
+
+    uint32_t const fingerprint = scrutiny_handler.config_fingerprint();
+    unsigned char expected_response[9 + 4] = { 0x81, 10, 0, 0, 4 };
+    expected_response[5] = static_cast<unsigned char>((fingerprint >> 24) & 0xFF);
+    expected_response[6] = static_cast<unsigned char>((fingerprint >> 16) & 0xFF);
+    expected_response[7] = static_cast<unsigned char>((fingerprint >> 8) & 0xFF);
+    expected_response[8] = static_cast<unsigned char>((fingerprint >> 0) & 0xFF);
+    add_crc(expected_response, sizeof(expected_response) - 4);
+
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    scrutiny_handler.process(0);
+
+    uint16_t n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_LT(n_to_read, sizeof(tx_buffer));
+    ASSERT_GT(n_to_read, 0);
+
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    EXPECT_BUF_EQ(tx_buffer, expected_response, sizeof(expected_response));
+}
+
+TEST_F(TestGetInfo, TestConfigFingerprintFollowsDefinitions)
+{
+    scrutiny::RuntimePublishedValue rpvs[2] = { { 0x1000, scrutiny::VariableType::uint32 }, { 0x1001, scrutiny::VariableType::float32 } };
+    config.set_published_values(rpvs, 2, SCRUTINY_NULL);
+    scrutiny_handler.init(&config);
+    uint32_t const reference = scrutiny_handler.config_fingerprint();
+
+    // Same definitions, same fingerprint
+    scrutiny_handler.init(&config);
+    EXPECT_EQ(scrutiny_handler.config_fingerprint(), reference);
+
+    // RPV type changed
+    rpvs[1].type = scrutiny::VariableType::sint32;
+    scrutiny_handler.init(&config);
+    EXPECT_NE(scrutiny_handler.config_fingerprint(), reference);
+    rpvs[1].type = scrutiny::VariableType::float32;
+
+    // Loop removed
+    config.set_loops(loops, 2);
+    scrutiny_handler.init(&config);
+    EXPECT_NE(scrutiny_handler.config_fingerprint(), reference);
+    config.set_loops(loops, 3);
+
+    // Loop renamed. Names longer than the hashing buffer (but not truncated) differ only by their last character
+    scrutiny::VariableFrequencyLoopHandler long_name_loop1("Loop name longer than buf #1");
+    scrutiny::VariableFrequencyLoopHandler long_name_loop2("Loop name longer than buf #2");
+    loops[1] = &long_name_loop1;
+    scrutiny_handler.init(&config);
+    uint32_t const long_name_fingerprint = scrutiny_handler.config_fingerprint();
+    EXPECT_NE(long_name_fingerprint, reference);
+    loops[1] = &long_name_loop2;
+    scrutiny_handler.init(&config);
+    EXPECT_NE(scrutiny_handler.config_fingerprint(), long_name_fingerprint);
+    loops[1] = &variable_freq_loop;
+
+#if SCRUTINY_SUPPORT_PROTECTED_REGIONS
+    // Protected region added
+    uint32_t var;
+    scrutiny::AddressRange const ranges[1] = { scrutiny::tools::make_address_range(&var, sizeof(var)) };
+    config.set_readonly_address_range(ranges, 1);
+    scrutiny_handler.init(&config);
+    EXPECT_NE(scrutiny_handler.config_fingerprint(), reference);
+    config.set_readonly_address_range(SCRUTINY_NULL, 0);
+#endif
+
+    scrutiny_handler.init(&config);
+    EXPECT_EQ(scrutiny_handler.config_fingerprint(), reference);
+}
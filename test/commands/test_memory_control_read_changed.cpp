@@ -0,0 +1,233 @@
+//    test_memory_control_read_changed.cpp
+//        Test the MemoryControl ReadChanged service that only sends the memory blocks that changed since the previous read
+//
+//   - License : MIT - See LICENSE file
+//   - Project : Scrutiny Debugger (github.com/scrutinydebugger/scrutiny-embedded)
+//
+//    Copyright (c) 2021 Scrutiny Debugger
+
+#include "scrutiny.hpp"
+#include "scrutiny_test.hpp"
+#include "scrutinytest/scrutinytest.hpp"
+#include <cstring>
+
+static unsigned char _rx_buffer[128];
+static unsigned char _tx_buffer[128];
+
+class TestMemoryControlReadChanged : public ScrutinyTest
+{
+  protected:
+    scrutiny::Timebase tb;
+    scrutiny::MainHandler scrutiny_handler;
+    scrutiny::Config config;
+    scrutiny::WatchedMemoryBlock watched_blocks[2];
+
+    unsigned char buf1[4];
+    unsigned char buf2[6];
+    unsigned char buf3[2];
+    uint8_t last_sequence; // Sequence number of the last response received, echoed in the next request
+
+    TestMemoryControlReadChanged() :
+        ScrutinyTest(),
+        tb(),
+        scrutiny_handler(),
+        config(),
+        last_sequence(0)
+    {
+    }
+
+    virtual void SetUp()
+    {
+        memset(buf1, 0x11, sizeof(buf1));
+        memset(buf2, 0x22, sizeof(buf2));
+        memset(buf3, 0x33, sizeof(buf3));
+        config.set_buffers(_rx_buffer, sizeof(_rx_buffer), _tx_buffer, sizeof(_tx_buffer));
+        config.set_watched_blocks(watched_blocks, sizeof(watched_blocks) / sizeof(watched_blocks[0]));
+        scrutiny_handler.init(&config);
+        scrutiny_handler.comm()->connect();
+    }
+
+    /// @brief Sends a ReadChanged request for buf1, buf2 and buf3 and returns which of them were in the response.
+    /// The content of the response blocks is validated against the memory. A lost response is not acknowledged by the next request.
+    void read_changed(bool *const in_response, scrutiny::protocol::ResponseCode::eResponseCode const expected_code, bool const response_lost)
+    {
+        unsigned char *const buffers[3] = { buf1, buf2, buf3 };
+        uint16_t const sizes[3] = { SIZEOF_8BITS(buf1), SIZEOF_8BITS(buf2), SIZEOF_8BITS(buf3) };
+        SCRUTINY_CONSTEXPR uint32_t addr_size = SIZEOF_8BITS(uintptr_t);
+        SCRUTINY_CONSTEXPR uint16_t request_datalen = 1 + 3 * (addr_size + 2);
+
+        unsigned char request_data[8 + request_datalen] = { 3, 11, 0, request_datalen, last_sequence };
+        unsigned int index = 5;
+        for (unsigned int i = 0; i < 3; i++)
+        {
+            index += encode_addr(&request_data[index], buffers[i]);
+            request_data[index++] = (sizes[i] >> 8) & 0xFF;
+            request_data[index++] = (sizes[i] >> 0) & 0xFF;
+        }
+        add_crc(request_data, sizeof(request_data) - 4);
+
+        scrutiny_handler.receive_data(request_data, sizeof(request_data));
+        scrutiny_handler.process(0);
+
+        unsigned char tx_buffer[128];
+        uint16_t const n_to_read = scrutiny_handler.data_to_send();
+        ASSERT_GE(n_to_read, 10u);
+        ASSERT_LE(n_to_read, sizeof(tx_buffer));
+        scrutiny_handler.pop_data(tx_buffer, n_to_read);
+        scrutiny_handler.process(0);
+        ASSERT_IS_PROTOCOL_RESPONSE(tx_buffer, scrutiny::protocol::CommandId::MemoryControl, 11, expected_code);
+
+        uint16_t const datalen = static_cast<uint16_t>((tx_buffer[3] << 8) | tx_buffer[4]);
+        ASSERT_EQ(n_to_read, 9u + datalen);
+        if (!response_lost)
+        {
+            last_sequence = tx_buffer[5];
+        }
+
+        // Blocks come in the request order, after the sequence number
+        index = 6;
+        for (unsigned int i = 0; i < 3; i++)
+        {
+            unsigned char expected_header[addr_size + 2];
+            encode_addr(expected_header, buffers[i]);
+            expected_header[addr_size] = (sizes[i] >> 8) & 0xFF;
+            expected_header[addr_size + 1] = (sizes[i] >> 0) & 0xFF;
+            in_response[i] = (index < 5u + datalen) && memcmp(&tx_buffer[index], expected_header, sizeof(expected_header)) == 0;
+            if (in_response[i])
+            {
+                unsigned char expected_data[16];
+                scrutiny::tools::memcpy_dilate_8bits_native(expected_data, buffers[i], sizes[i]);
+                EXPECT_BUF_EQ(&tx_buffer[index + sizeof(expected_header)], expected_data, sizes[i]);
+                index += sizeof(expected_header) + sizes[i];
+            }
+        }
+        EXPECT_EQ(index, 5u + datalen);
+    }
+
+    void read_changed(bool *const in_response) { read_changed(in_response, scrutiny::protocol::ResponseCode::OK, false); }
+
+    void send_empty_request(void)
+    {
+        unsigned char request_data[8] = { 3, 11, 0, 0 };
+        add_crc(request_data, sizeof(request_data) - 4);
+        scrutiny_handler.receive_data(request_data, sizeof(request_data));
+        scrutiny_handler.process(0);
+
+        unsigned char tx_buffer[16];
+        uint16_t const n_to_read = scrutiny_handler.data_to_send();
+        ASSERT_EQ(n_to_read, 9u);
+        scrutiny_handler.pop_data(tx_buffer, n_to_read);
+        scrutiny_handler.process(0);
+        ASSERT_IS_PROTOCOL_RESPONSE(tx_buffer, scrutiny::protocol::CommandId::MemoryControl, 11, scrutiny::protocol::ResponseCode::OK);
+    }
+};
+
+TEST_F(TestMemoryControlReadChanged, OnlyChangedBlocksAreSent)
+{
+    bool in_response[3];
+
+    read_changed(in_response); // Everything is new
+    EXPECT_TRUE(in_response[0]);
+    EXPECT_TRUE(in_response[1]);
+    EXPECT_TRUE(in_response[2]);
+
+    read_changed(in_response);
+    EXPECT_FALSE(in_response[0]);
+    EXPECT_FALSE(in_response[1]);
+    EXPECT_TRUE(in_response[2]); // Not tracked. The table has 2 entries
+
+    buf2[3] = 0x55;
+    read_changed(in_response);
+    EXPECT_FALSE(in_response[0]);
+    EXPECT_TRUE(in_response[1]);
+    EXPECT_TRUE(in_response[2]);
+
+    read_changed(in_response);
+    EXPECT_FALSE(in_response[0]);
+    EXPECT_FALSE(in_response[1]);
+    EXPECT_TRUE(in_response[2]);
+}
+
+TEST_F(TestMemoryControlReadChanged, EmptyRequestResynchronize)
+{
+    bool in_response[3];
+
+    read_changed(in_response);
+    read_changed(in_response);
+    EXPECT_FALSE(in_response[0]);
+    EXPECT_FALSE(in_response[1]);
+
+    send_empty_request();
+    read_changed(in_response);
+    EXPECT_TRUE(in_response[0]);
+    EXPECT_TRUE(in_response[1]);
+    EXPECT_TRUE(in_response[2]);
+}
+
+TEST_F(TestMemoryControlReadChanged, LostResponseIsSentAgain)
+{
+    bool in_response[3];
+
+    read_changed(in_response);
+    read_changed(in_response);
+    EXPECT_FALSE(in_response[0]);
+    EXPECT_FALSE(in_response[1]);
+
+    buf2[0] = 0x55;
+    read_changed(in_response, scrutiny::protocol::ResponseCode::OK, true);
+    EXPECT_FALSE(in_response[0]);
+    EXPECT_TRUE(in_response[1]);
+
+    read_changed(in_response); // The previous response was not acknowledged
+    EXPECT_FALSE(in_response[0]);
+    EXPECT_TRUE(in_response[1]);
+
+    read_changed(in_response);
+    EXPECT_FALSE(in_response[0]);
+    EXPECT_FALSE(in_response[1]);
+}
+
+TEST_F(TestMemoryControlReadChanged, SequenceNumberWrapsAt8Bits)
+{
+    bool in_response[3];
+
+    read_changed(in_response);
+    for (unsigned int i = 0; i < 0x100u; i++)
+    {
+        read_changed(in_response);
+        EXPECT_FALSE(in_response[0]) << "i=" << i;
+        EXPECT_FALSE(in_response[1]) << "i=" << i;
+    }
+    EXPECT_EQ(last_sequence, 1u); // 257 responses
+
+    buf1[0] = 0x55;
+    read_changed(in_response); // The acknowledgment still works after the wrap
+    EXPECT_TRUE(in_response[0]);
+    EXPECT_FALSE(in_response[1]);
+}
+
+TEST_F(TestMemoryControlReadChanged, NotSupportedWithoutTable)
+{
+    scrutiny::Config no_watch_config;
+    no_watch_config.set_buffers(_rx_buffer, sizeof(_rx_buffer), _tx_buffer, sizeof(_tx_buffer));
+    EXPECT_FALSE(no_watch_config.is_watched_blocks_set());
+    EXPECT_TRUE(config.is_watched_blocks_set());
+    scrutiny_handler.init(&no_watch_config);
+    scrutiny_handler.comm()->connect();
+
+    unsigned char tx_buffer[16];
+    unsigned char request_data[8] = { 3, 11, 0, 0 };
+    add_crc(request_data, sizeof(request_data) - 4);
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    scrutiny_handler.process(0);
+
+    uint16_t const n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_EQ(n_to_read, 9u);
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    ASSERT_IS_PROTOCOL_RESPONSE(
+        tx_buffer,
+        scrutiny::protocol::CommandId::MemoryControl,
+        11,
+        scrutiny::protocol::ResponseCode::UnsupportedFeature);
+}
+
@@ -117,6 +117,24 @@ static bool rpv_read_callback(scrutiny::RuntimePublishedValue rpv, scrutiny::Any
     return true;
 }
 
+static unsigned int bulk_read_call_count = 0;
+static bool rpv_bulk_read_callback(
+    scrutiny::RuntimePublishedValue const *rpvs,
+    scrutiny::AnyType *outvals,
+    uint16_t const count,
+    scrutiny::LoopHandler *const caller)
+{
+    bulk_read_call_count++;
+    for (uint16_t i = 0; i < count; i++)
+    {
+        if (!rpv_read_callback(rpvs[i], &outvals[i], caller))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 struct AllTypeResult
 {
 
@@ -254,6 +272,40 @@ TEST_F(TestMemoryControlRPV, TestReadSingleRPV)
     ASSERT_BUF_EQ(tx_buffer, expected_response, sizeof(expected_response));
 }
 
+TEST_F(TestMemoryControlRPV, TestReadRPVNativeEndian)
+{
+    if (!(CHAR_BIT == 8 && scrutiny::tools::is_little_endian()))
+    {
+        return; // Big endian devices never accept native endian values. Already the protocol byte order
+    }
+    unsigned char tx_buffer[32];
+
+    scrutiny::RuntimePublishedValue rpvs[2] = { { 0x1122, scrutiny::VariableType::uint32 }, { 0x5566, scrutiny::VariableType::uint16 } };
+
+    config.set_published_values(rpvs, sizeof(rpvs) / sizeof(rpvs[0]), rpv_read_callback);
+    scrutiny_handler.init(&config);
+    scrutiny_handler.comm()->connect();
+    scrutiny_handler.comm()->set_session_flags(scrutiny::protocol::CommControl::ConnectFlags::NativeEndian);
+
+    unsigned char request_data[8 + 4] = { 3, 4, 0, 4, 0x11, 0x22, 0x55, 0x66 };
+    add_crc(request_data, sizeof(request_data) - 4);
+
+    // IDs stay big endian, values are little endian
+    unsigned char expected_response[9 + 6 + 4] = { 0x83, 4, 0, 0, 6 + 4, 0x11, 0x22, 0x78, 0x56, 0x34, 0x12, 0x55, 0x66, 0xcd, 0xab };
+    add_crc(expected_response, sizeof(expected_response) - 4);
+
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    scrutiny_handler.process(0);
+
+    uint16_t n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_LT(n_to_read, sizeof(tx_buffer));
+    EXPECT_EQ(n_to_read, sizeof(expected_response));
+
+    uint16_t nread = scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    EXPECT_EQ(nread, n_to_read);
+    ASSERT_BUF_EQ(tx_buffer, expected_response, sizeof(expected_response));
+}
+
 /*
     Try to read 3 RPV. Validate that we receive the right value for each of them
 */
@@ -293,6 +345,51 @@ TEST_F(TestMemoryControlRPV, TestReadMultipleRPV)
     ASSERT_BUF_EQ(tx_buffer, expected_response, sizeof(expected_response));
 }
 
+/*
+    Read more RPVs than what is read per callback call, with only a bulk read callback. Values are fetched by chunks
+*/
+TEST_F(TestMemoryControlRPV, TestReadMultipleRPVBulkCallback)
+{
+    unsigned char tx_buffer[128];
+    uint16_t const nbrpv = 10;
+
+    scrutiny::RuntimePublishedValue rpvs[3] = { { 0x1122, scrutiny::VariableType::uint32 },
+                                                { 0x3344, scrutiny::VariableType::float32 },
+                                                { 0x5566, scrutiny::VariableType::uint16 } };
+
+    config.set_published_values(rpvs, sizeof(rpvs) / sizeof(rpvs[0]));
+    config.set_rpv_bulk_read_callback(rpv_bulk_read_callback);
+    EXPECT_TRUE(config.is_read_published_values_configured());
+    scrutiny_handler.init(&config);
+    scrutiny_handler.comm()->connect();
+
+    unsigned char request_data[8 + nbrpv * 2] = { 3, 4, 0, nbrpv * 2 };
+    unsigned char expected_response[9 + nbrpv * 6] = { 0x83, 4, 0, 0, nbrpv * 6 };
+    for (uint16_t i = 0; i < nbrpv; i++)
+    {
+        unsigned char const id[2] = { 0x11, 0x22 };
+        unsigned char const value[4] = { 0x12, 0x34, 0x56, 0x78 };
+        memcpy(&request_data[4 + 2 * i], id, sizeof(id));
+        memcpy(&expected_response[5 + 6 * i], id, sizeof(id));
+        memcpy(&expected_response[5 + 6 * i + 2], value, sizeof(value));
+    }
+    add_crc(request_data, sizeof(request_data) - 4);
+    add_crc(expected_response, sizeof(expected_response) - 4);
+
+    bulk_read_call_count = 0;
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    scrutiny_handler.process(0);
+
+    uint16_t n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_LT(n_to_read, sizeof(tx_buffer));
+    EXPECT_EQ(n_to_read, sizeof(expected_response));
+
+    uint16_t nread = scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    EXPECT_EQ(nread, n_to_read);
+    ASSERT_BUF_EQ(tx_buffer, expected_response, sizeof(expected_response));
+    EXPECT_EQ(bulk_read_call_count, (nbrpv + SCRUTINY_READ_RPV_CHUNK_SIZE - 1) / SCRUTINY_READ_RPV_CHUNK_SIZE);
+}
+
 /*
     Try to read a RPV of each type. Validate encoding is good
 */
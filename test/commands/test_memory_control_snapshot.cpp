@@ -0,0 +1,459 @@
+//    test_memory_control_snapshot.cpp
+//        Test the snapshot reads and deferred writes of the memory control command. Values are copied by a loop at its next iteration
+//
+//   - License : MIT - See LICENSE file
+//   - Project : Scrutiny Debugger (github.com/scrutinydebugger/scrutiny-embedded)
+//
+//    Copyright (c) 2021 Scrutiny Debugger
+
+#include "scrutiny.hpp"
+#include "scrutiny_test.hpp"
+#include "scrutinytest/scrutinytest.hpp"
+#include <climits>
+#include <cstring>
+
+static unsigned char _rx_buffer[128];
+static unsigned char _tx_buffer[128];
+static unsigned char _staging_buffer[64];
+
+static uint32_t snapshot_rpv_value = 0;
+static scrutiny::LoopHandler *snapshot_rpv_caller = SCRUTINY_NULL;
+static uint32_t deferred_rpv_value = 0;
+static scrutiny::LoopHandler *deferred_rpv_caller = SCRUTINY_NULL;
+
+static bool rpv_read_callback(scrutiny::RuntimePublishedValue rpv, scrutiny::AnyType *outval, scrutiny::LoopHandler *const caller)
+{
+    snapshot_rpv_caller = caller;
+    if (rpv.id == 0x1122 && rpv.type == scrutiny::VariableType::uint32)
+    {
+        outval->uint32 = snapshot_rpv_value;
+    }
+    else if (rpv.id == 0x3344 && rpv.type == scrutiny::VariableType::uint16)
+    {
+        outval->uint16 = static_cast<uint16_t>(snapshot_rpv_value);
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+static bool rpv_write_callback(scrutiny::RuntimePublishedValue rpv, scrutiny::AnyType const *inval, scrutiny::LoopHandler *const caller)
+{
+    deferred_rpv_caller = caller;
+    if (rpv.id == 0x1122 && rpv.type == scrutiny::VariableType::uint32)
+    {
+        deferred_rpv_value = inval->uint32;
+        return true;
+    }
+    return false;
+}
+
+class TestMemoryControlSnapshot : public ScrutinyTest
+{
+  protected:
+    scrutiny::MainHandler scrutiny_handler;
+    scrutiny::Config config;
+    scrutiny::FixedFrequencyLoopHandler loop;
+    scrutiny::LoopHandler *loops[1];
+    scrutiny::RuntimePublishedValue rpvs[2];
+
+    TestMemoryControlSnapshot() :
+        ScrutinyTest(),
+        scrutiny_handler(),
+        config(),
+        loop(100)
+    {
+        rpvs[0].id = 0x1122;
+        rpvs[0].type = scrutiny::VariableType::uint32;
+        rpvs[1].id = 0x3344;
+        rpvs[1].type = scrutiny::VariableType::uint16;
+    }
+
+    virtual void SetUp()
+    {
+        loops[0] = &loop;
+        config.set_buffers(_rx_buffer, sizeof(_rx_buffer), _tx_buffer, sizeof(_tx_buffer));
+        config.set_loops(loops, 1);
+        config.set_published_values(rpvs, 2, rpv_read_callback, rpv_write_callback);
+        config.set_staging_buffer(_staging_buffer, sizeof(_staging_buffer));
+        scrutiny_handler.init(&config);
+        scrutiny_handler.comm()->connect();
+        snapshot_rpv_caller = SCRUTINY_NULL;
+        deferred_rpv_caller = SCRUTINY_NULL;
+        deferred_rpv_value = 0;
+    }
+
+    uint16_t make_read_snapshot_request(unsigned char *buffer, uint_least8_t loop_id, void *addr, uint16_t size_8bits);
+};
+
+uint16_t TestMemoryControlSnapshot::make_read_snapshot_request(
+    unsigned char *buffer,
+    uint_least8_t loop_id,
+    void *addr,
+    uint16_t size_8bits)
+{
+    SCRUTINY_CONSTEXPR uint16_t addr_size = SIZEOF_8BITS(uintptr_t);
+    buffer[0] = 3;
+    buffer[1] = 6;
+    buffer[2] = 0;
+    buffer[3] = 1 + addr_size + 2;
+    unsigned int index = 4;
+    buffer[index++] = loop_id;
+    index += encode_addr(&buffer[index], addr);
+    buffer[index++] = static_cast<unsigned char>((size_8bits >> 8) & 0xFF);
+    buffer[index++] = static_cast<unsigned char>((size_8bits >> 0) & 0xFF);
+    add_crc(buffer, static_cast<uint16_t>(index));
+    return static_cast<uint16_t>(index + 4);
+}
+
+TEST_F(TestMemoryControlSnapshot, TestReadSnapshotCopiedByLoop)
+{
+    unsigned char tx_buffer[64];
+    uint32_t var = 0x11111111;
+    unsigned char request_data[8 + 1 + SIZEOF_8BITS(uintptr_t) + 2];
+    uint16_t const request_size = make_read_snapshot_request(request_data, 0, &var, SIZEOF_8BITS(var));
+    ASSERT_EQ(request_size, sizeof(request_data));
+
+    scrutiny_handler.receive_data(request_data, request_size);
+    scrutiny_handler.process(0);
+    EXPECT_EQ(scrutiny_handler.data_to_send(), 0u); // Waiting on the loop
+
+    var = 0x22222222; // Value seen by the loop
+    loop.process();
+    var = 0x33333333;
+    scrutiny_handler.process(0);
+
+    SCRUTINY_CONSTEXPR uint16_t datalen = SIZEOF_8BITS(uintptr_t) + 2 + SIZEOF_8BITS(var);
+    unsigned char expected_response[9 + datalen] = { 0x83, 6, 0, 0, datalen };
+    unsigned int index = 5;
+    index += encode_addr(&expected_response[index], &var);
+    expected_response[index++] = 0;
+    expected_response[index++] = SIZEOF_8BITS(var);
+    uint32_t const expected_value = 0x22222222;
+    scrutiny::tools::memcpy_dilate_8bits_native(&expected_response[index], &expected_value, SIZEOF_8BITS(var));
+    add_crc(expected_response, sizeof(expected_response) - 4);
+
+    uint16_t const n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_EQ(n_to_read, sizeof(expected_response));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    EXPECT_BUF_EQ(tx_buffer, expected_response, sizeof(expected_response));
+}
+
+TEST_F(TestMemoryControlSnapshot, TestReadRPVSnapshotReadByLoop)
+{
+    unsigned char tx_buffer[64];
+    unsigned char request_data[8 + 1 + 4] = { 3, 7, 0, 5, 0, 0x11, 0x22, 0x33, 0x44 };
+    add_crc(request_data, sizeof(request_data) - 4);
+
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    snapshot_rpv_value = 0xAABBCCDD;
+    scrutiny_handler.process(0);
+    EXPECT_EQ(scrutiny_handler.data_to_send(), 0u);
+    EXPECT_TRUE(snapshot_rpv_caller == SCRUTINY_NULL); // Nothing read in the main handler
+
+    loop.process();
+    scrutiny_handler.process(0);
+    EXPECT_TRUE(snapshot_rpv_caller == &loop);
+
+    unsigned char expected_response[9 + 6 + 4] = { 0x83, 7, 0, 0, 10, 0x11, 0x22, 0xAA, 0xBB, 0xCC, 0xDD, 0x33, 0x44, 0xCC, 0xDD };
+    add_crc(expected_response, sizeof(expected_response) - 4);
+
+    uint16_t const n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_EQ(n_to_read, sizeof(expected_response));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    EXPECT_BUF_EQ(tx_buffer, expected_response, sizeof(expected_response));
+}
+
+TEST_F(TestMemoryControlSnapshot, TestReadRPVSnapshotNativeEndian)
+{
+    if (!(CHAR_BIT == 8 && scrutiny::tools::is_little_endian()))
+    {
+        return; // Big endian devices never accept native endian values. Already the protocol byte order
+    }
+
+    unsigned char tx_buffer[64];
+    unsigned char request_data[8 + 1 + 2] = { 3, 7, 0, 3, 0, 0x11, 0x22 };
+    add_crc(request_data, sizeof(request_data) - 4);
+
+    scrutiny_handler.comm()->set_session_flags(scrutiny::protocol::CommControl::ConnectFlags::NativeEndian);
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    snapshot_rpv_value = 0xAABBCCDD;
+    scrutiny_handler.process(0);
+    loop.process();
+    scrutiny_handler.process(0);
+
+    unsigned char expected_response[9 + 6] = { 0x83, 7, 0, 0, 6, 0x11, 0x22, 0xDD, 0xCC, 0xBB, 0xAA };
+    add_crc(expected_response, sizeof(expected_response) - 4);
+
+    uint16_t const n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_EQ(n_to_read, sizeof(expected_response));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    EXPECT_BUF_EQ(tx_buffer, expected_response, sizeof(expected_response));
+}
+
+TEST_F(TestMemoryControlSnapshot, TestReadRPVSnapshotCallbackFailure)
+{
+    unsigned char tx_buffer[32];
+    unsigned char request_data[8 + 1 + 2] = { 3, 7, 0, 3, 0, 0x11, 0x22 };
+    add_crc(request_data, sizeof(request_data) - 4);
+
+    rpvs[0].type = scrutiny::VariableType::uint16; // The callback refuses this type
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    scrutiny_handler.process(0);
+    loop.process();
+    scrutiny_handler.process(0);
+
+    uint16_t const n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_GT(n_to_read, 0u);
+    ASSERT_LT(n_to_read, sizeof(tx_buffer));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, scrutiny::protocol::CommandId::MemoryControl, 7, scrutiny::protocol::ResponseCode::FailureToProceed);
+}
+
+TEST_F(TestMemoryControlSnapshot, TestReadSnapshotErrors)
+{
+    unsigned char tx_buffer[32];
+    uint32_t var = 0;
+    unsigned char request_data[8 + 1 + SIZEOF_8BITS(uintptr_t) + 2];
+    scrutiny::protocol::CommandId::eCommandId const cmd = scrutiny::protocol::CommandId::MemoryControl;
+
+    // Bad loop ID
+    uint16_t request_size = make_read_snapshot_request(request_data, 1, &var, SIZEOF_8BITS(var));
+    scrutiny_handler.receive_data(request_data, request_size);
+    scrutiny_handler.process(0);
+    uint16_t n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_GT(n_to_read, 0u);
+    ASSERT_LT(n_to_read, sizeof(tx_buffer));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    scrutiny_handler.process(0);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, cmd, 6, scrutiny::protocol::ResponseCode::FailureToProceed);
+
+    // Does not fit in the staging buffer
+    request_size = make_read_snapshot_request(request_data, 0, _rx_buffer, sizeof(_staging_buffer));
+    scrutiny_handler.receive_data(request_data, request_size);
+    scrutiny_handler.process(0);
+    n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_GT(n_to_read, 0u);
+    ASSERT_LT(n_to_read, sizeof(tx_buffer));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    scrutiny_handler.process(0);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, cmd, 6, scrutiny::protocol::ResponseCode::Overflow);
+
+    // No staging buffer
+    config.set_staging_buffer(SCRUTINY_NULL, 0);
+    scrutiny_handler.init(&config);
+    scrutiny_handler.comm()->connect();
+    request_size = make_read_snapshot_request(request_data, 0, &var, SIZEOF_8BITS(var));
+    scrutiny_handler.receive_data(request_data, request_size);
+    scrutiny_handler.process(0);
+    n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_GT(n_to_read, 0u);
+    ASSERT_LT(n_to_read, sizeof(tx_buffer));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, cmd, 6, scrutiny::protocol::ResponseCode::UnsupportedFeature);
+}
+
+TEST_F(TestMemoryControlSnapshot, TestStaleSnapshotIsDropped)
+{
+    unsigned char tx_buffer[64];
+    uint32_t var1 = 0x11111111;
+    uint32_t var2 = 0x22222222;
+    unsigned char request_data[8 + 1 + SIZEOF_8BITS(uintptr_t) + 2];
+
+    // The loop does not run. The request times out.
+    uint16_t const request_size = make_read_snapshot_request(request_data, 0, &var1, SIZEOF_8BITS(var1));
+    scrutiny_handler.receive_data(request_data, request_size);
+    scrutiny_handler.process(0);
+    EXPECT_EQ(scrutiny_handler.data_to_send(), 0u);
+    scrutiny_handler.process(SCRUTINY_REQUEST_MAX_PROCESS_TIME_US * 10 * 10 + 1);
+    uint16_t n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_GT(n_to_read, 0u);
+    ASSERT_LT(n_to_read, sizeof(tx_buffer));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    scrutiny_handler.process(0);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, scrutiny::protocol::CommandId::MemoryControl, 6, scrutiny::protocol::ResponseCode::FailureToProceed);
+
+    // The next request waits for the old snapshot to complete, then takes its own.
+    make_read_snapshot_request(request_data, 0, &var2, SIZEOF_8BITS(var2));
+    scrutiny_handler.receive_data(request_data, request_size);
+    scrutiny_handler.process(0);
+    EXPECT_EQ(scrutiny_handler.data_to_send(), 0u);
+    loop.process(); // Takes the stale snapshot
+    scrutiny_handler.process(0);
+    EXPECT_EQ(scrutiny_handler.data_to_send(), 0u);
+    loop.process(); // Takes the new snapshot
+    scrutiny_handler.process(0);
+
+    SCRUTINY_CONSTEXPR uint16_t datalen = SIZEOF_8BITS(uintptr_t) + 2 + SIZEOF_8BITS(var2);
+    unsigned char expected_response[9 + datalen] = { 0x83, 6, 0, 0, datalen };
+    unsigned int index = 5;
+    index += encode_addr(&expected_response[index], &var2);
+    expected_response[index++] = 0;
+    expected_response[index++] = SIZEOF_8BITS(var2);
+    scrutiny::tools::memcpy_dilate_8bits_native(&expected_response[index], &var2, SIZEOF_8BITS(var2));
+    add_crc(expected_response, sizeof(expected_response) - 4);
+
+    n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_EQ(n_to_read, sizeof(expected_response));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    EXPECT_BUF_EQ(tx_buffer, expected_response, sizeof(expected_response));
+}
+
+TEST_F(TestMemoryControlSnapshot, TestWriteDeferredWrittenByLoop)
+{
+    unsigned char tx_buffer[64];
+    uint32_t var = 0x11111111;
+    uint32_t const new_value = 0xAABBCCDD;
+    SCRUTINY_CONSTEXPR uint16_t addr_size = SIZEOF_8BITS(uintptr_t);
+    unsigned char request_data[8 + 1 + addr_size + 2 + SIZEOF_8BITS(var)] = { 3, 8, 0, 1 + addr_size + 2 + SIZEOF_8BITS(var), 0 };
+    unsigned int index = 5;
+    index += encode_addr(&request_data[index], &var);
+    request_data[index++] = 0;
+    request_data[index++] = SIZEOF_8BITS(var);
+    scrutiny::tools::memcpy_dilate_8bits_native(&request_data[index], &new_value, SIZEOF_8BITS(var));
+    add_crc(request_data, sizeof(request_data) - 4);
+
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    scrutiny_handler.process(0);
+    EXPECT_EQ(scrutiny_handler.data_to_send(), 0u); // Waiting on the loop
+    EXPECT_EQ(var, 0x11111111u);                    // Not written by the main handler
+
+    loop.process();
+    EXPECT_EQ(var, new_value);
+    scrutiny_handler.process(0);
+
+    SCRUTINY_CONSTEXPR uint16_t datalen = addr_size + 2;
+    unsigned char expected_response[9 + datalen] = { 0x83, 8, 0, 0, datalen };
+    index = 5;
+    index += encode_addr(&expected_response[index], &var);
+    expected_response[index++] = 0;
+    expected_response[index++] = SIZEOF_8BITS(var);
+    add_crc(expected_response, sizeof(expected_response) - 4);
+
+    uint16_t const n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_EQ(n_to_read, sizeof(expected_response));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    EXPECT_BUF_EQ(tx_buffer, expected_response, sizeof(expected_response));
+}
+
+TEST_F(TestMemoryControlSnapshot, TestWriteMaskedDeferredWrittenByLoop)
+{
+    unsigned char tx_buffer[64];
+    uint8_t var = 0x0F;
+    SCRUTINY_CONSTEXPR uint16_t addr_size = SIZEOF_8BITS(uintptr_t);
+    unsigned char request_data[8 + 1 + addr_size + 2 + 2] = { 3, 9, 0, 1 + addr_size + 2 + 2, 0 };
+    unsigned int index = 5;
+    index += encode_addr(&request_data[index], &var);
+    request_data[index++] = 0;
+    request_data[index++] = 1;
+    request_data[index++] = 0xF0; // Data
+    request_data[index++] = 0x3C; // Mask
+    add_crc(request_data, sizeof(request_data) - 4);
+
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    scrutiny_handler.process(0);
+    EXPECT_EQ(var, 0x0F);
+    loop.process();
+    EXPECT_EQ(var, 0x33);
+    scrutiny_handler.process(0);
+
+    uint16_t const n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_GT(n_to_read, 0u);
+    ASSERT_LT(n_to_read, sizeof(tx_buffer));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, scrutiny::protocol::CommandId::MemoryControl, 9, scrutiny::protocol::ResponseCode::OK);
+}
+
+TEST_F(TestMemoryControlSnapshot, TestWriteRPVDeferredWrittenByLoop)
+{
+    unsigned char tx_buffer[64];
+    unsigned char request_data[8 + 1 + 6] = { 3, 10, 0, 7, 0, 0x11, 0x22, 0xAA, 0xBB, 0xCC, 0xDD };
+    add_crc(request_data, sizeof(request_data) - 4);
+
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    scrutiny_handler.process(0);
+    EXPECT_EQ(scrutiny_handler.data_to_send(), 0u);
+    EXPECT_TRUE(deferred_rpv_caller == SCRUTINY_NULL); // Nothing written in the main handler
+
+    loop.process();
+    EXPECT_TRUE(deferred_rpv_caller == &loop);
+    EXPECT_EQ(deferred_rpv_value, 0xAABBCCDDu);
+    scrutiny_handler.process(0);
+
+    unsigned char expected_response[9 + 3] = { 0x83, 10, 0, 0, 3, 0x11, 0x22, 4 };
+    add_crc(expected_response, sizeof(expected_response) - 4);
+
+    uint16_t const n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_EQ(n_to_read, sizeof(expected_response));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    EXPECT_BUF_EQ(tx_buffer, expected_response, sizeof(expected_response));
+}
+
+TEST_F(TestMemoryControlSnapshot, TestWriteRPVDeferredRefusedValue)
+{
+    unsigned char tx_buffer[64];
+    // 0x3344 is refused by the write callback. 0x1122 is written nonetheless
+    unsigned char request_data[8 + 1 + 4 + 6] = { 3, 10, 0, 11, 0, 0x33, 0x44, 0x12, 0x34, 0x11, 0x22, 0xAA, 0xBB, 0xCC, 0xDD };
+    add_crc(request_data, sizeof(request_data) - 4);
+
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    scrutiny_handler.process(0);
+    EXPECT_EQ(scrutiny_handler.data_to_send(), 0u);
+
+    loop.process();
+    EXPECT_EQ(deferred_rpv_value, 0xAABBCCDDu);
+    scrutiny_handler.process(0);
+
+    uint16_t const n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_GT(n_to_read, 0u);
+    ASSERT_LT(n_to_read, sizeof(tx_buffer));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, scrutiny::protocol::CommandId::MemoryControl, 10, scrutiny::protocol::ResponseCode::FailureToProceed);
+}
+
+TEST_F(TestMemoryControlSnapshot, TestWriteDeferredErrors)
+{
+    unsigned char tx_buffer[32];
+    uint32_t var = 0x11111111;
+    SCRUTINY_CONSTEXPR uint16_t addr_size = SIZEOF_8BITS(uintptr_t);
+    unsigned char request_data[8 + 1 + addr_size + 2 + SIZEOF_8BITS(var)] = { 3, 8, 0, 1 + addr_size + 2 + SIZEOF_8BITS(var), 0 };
+    unsigned int index = 5;
+    index += encode_addr(&request_data[index], &var);
+    request_data[index++] = 0;
+    request_data[index++] = SIZEOF_8BITS(var);
+    add_crc(request_data, sizeof(request_data) - 4);
+    scrutiny::protocol::CommandId::eCommandId const cmd = scrutiny::protocol::CommandId::MemoryControl;
+
+    // Memory write disabled
+    config.memory_write_enable = false;
+    scrutiny_handler.init(&config);
+    scrutiny_handler.comm()->connect();
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    scrutiny_handler.process(0);
+    uint16_t n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_GT(n_to_read, 0u);
+    ASSERT_LT(n_to_read, sizeof(tx_buffer));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    scrutiny_handler.process(0);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, cmd, 8, scrutiny::protocol::ResponseCode::Forbidden);
+    loop.process();
+    EXPECT_EQ(var, 0x11111111u);
+
+    // Truncated data
+    config.memory_write_enable = true;
+    scrutiny_handler.init(&config);
+    scrutiny_handler.comm()->connect();
+    request_data[3]--;
+    add_crc(request_data, sizeof(request_data) - 5);
+    scrutiny_handler.receive_data(request_data, sizeof(request_data) - 1);
+    scrutiny_handler.process(0);
+    n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_GT(n_to_read, 0u);
+    ASSERT_LT(n_to_read, sizeof(tx_buffer));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, cmd, 8, scrutiny::protocol::ResponseCode::InvalidRequest);
+    loop.process();
+    EXPECT_EQ(var, 0x11111111u);
+}
@@ -0,0 +1,323 @@
+//    test_payload_compression.cpp
+//        Test the compression of the response payloads negotiated at connection
+//
+//   - License : MIT - See LICENSE file
+//   - Project : Scrutiny Debugger (github.com/scrutinydebugger/scrutiny-embedded)
+//
+//    Copyright (c) 2021 Scrutiny Debugger
+
+#include "scrutiny.hpp"
+#include "scrutiny_test.hpp"
+#include "scrutinytest/scrutinytest.hpp"
+#include <cstring>
+
+static unsigned char _rx_buffer[128];
+static unsigned char _tx_buffer[256];
+static unsigned char _compression_buffer[256];
+
+/// @brief Reference decoder, as implemented by the server
+static uint16_t decompress(unsigned char const *src, uint16_t const length, unsigned char *dst, uint16_t const max_size)
+{
+    uint16_t in = 0;
+    uint16_t out = 0;
+    while (in < length)
+    {
+        uint_least8_t const flags = src[in++];
+        for (uint_least8_t item = 0; item < 8 && in < length; item++)
+        {
+            if (flags & (1u << item))
+            {
+                uint16_t const offset = static_cast<uint16_t>(src[in] + 1);
+                uint16_t const match_length = static_cast<uint16_t>(src[in + 1] + scrutiny::protocol::COMPRESSION_MIN_MATCH);
+                in = static_cast<uint16_t>(in + 2);
+                if (offset > out || out + match_length > max_size)
+                {
+                    return 0;
+                }
+                for (uint16_t i = 0; i < match_length; i++, out++)
+                {
+                    dst[out] = dst[out - offset];
+                }
+            }
+            else
+            {
+                if (out >= max_size)
+                {
+                    return 0;
+                }
+                dst[out++] = src[in++];
+            }
+        }
+    }
+    return out;
+}
+
+class TestPayloadCompression : public ScrutinyTest
+{
+  protected:
+    scrutiny::Timebase tb;
+    scrutiny::MainHandler scrutiny_handler;
+    scrutiny::Config config;
+
+    TestPayloadCompression() :
+        ScrutinyTest(),
+        tb(),
+        scrutiny_handler(),
+        config()
+    {
+    }
+
+    virtual void SetUp()
+    {
+        config.set_buffers(_rx_buffer, sizeof(_rx_buffer), _tx_buffer, sizeof(_tx_buffer));
+        config.set_compression_buffer(_compression_buffer, sizeof(_compression_buffer));
+        scrutiny_handler.init(&config);
+    }
+
+    /// @brief Compresses the whole payload of a response, a few items at a time like the MainHandler does
+    bool compress(scrutiny::protocol::Response *const response, unsigned char *const work_buffer, uint16_t const work_buffer_size)
+    {
+        scrutiny::protocol::PayloadCompressor compressor;
+        compressor.init(response, work_buffer, work_buffer_size);
+        for (uint16_t i = 0; i <= response->data_length && !compressor.finished(); i++)
+        {
+            compressor.process(8);
+        }
+        EXPECT_TRUE(compressor.finished());
+        return compressor.compressed();
+    }
+
+    void check_round_trip(unsigned char const *data, uint16_t const length, bool const expect_compressed)
+    {
+        unsigned char payload[256];
+        unsigned char decompressed[256];
+        ASSERT_LE(length, sizeof(payload));
+        memcpy(payload, data, length);
+
+        scrutiny::protocol::Response response;
+        response.reset();
+        response.subfunction_id = 1;
+        response.data = payload;
+        response.data_max_length = sizeof(payload);
+        response.data_length = length;
+
+        bool const compressed = compress(&response, _compression_buffer, sizeof(_compression_buffer));
+        EXPECT_EQ(compressed, expect_compressed);
+        if (compressed)
+        {
+            EXPECT_LT(response.data_length, length);
+            EXPECT_EQ(response.subfunction_id, 1u | scrutiny::protocol::COMPRESSED_PAYLOAD_FLAG);
+            uint16_t const size = decompress(payload, response.data_length, decompressed, sizeof(decompressed));
+            ASSERT_EQ(size, length);
+            EXPECT_BUF_EQ(decompressed, data, length);
+        }
+        else
+        {
+            EXPECT_EQ(response.data_length, length);
+            EXPECT_EQ(response.subfunction_id, 1u);
+            EXPECT_BUF_EQ(payload, data, length);
+        }
+    }
+
+    void connect(uint_least8_t const flags)
+    {
+        unsigned char request_data[8 + 5] = { 2, 4, 0, 5 };
+        memcpy(&request_data[4], scrutiny::protocol::CommControl::CONNECT_MAGIC, sizeof(scrutiny::protocol::CommControl::CONNECT_MAGIC));
+        request_data[8] = flags;
+        add_crc(request_data, sizeof(request_data) - 4);
+        scrutiny_handler.receive_data(request_data, sizeof(request_data));
+        scrutiny_handler.process(0);
+
+        unsigned char tx_buffer[32];
+        uint16_t const n_to_read = scrutiny_handler.data_to_send();
+        ASSERT_EQ(n_to_read, 9u + 4u + 4u + 1u);
+        scrutiny_handler.pop_data(tx_buffer, n_to_read);
+        scrutiny_handler.process(0);
+    }
+};
+
+TEST_F(TestPayloadCompression, RoundTripCompressible)
+{
+    unsigned char data[200];
+
+    memset(data, 0, sizeof(data));
+    check_round_trip(data, sizeof(data), true);
+
+    // Slowly varying values
+    for (uint16_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = static_cast<unsigned char>((i / 16) & 0xFF);
+    }
+    check_round_trip(data, sizeof(data), true);
+
+    // Repeated pattern, longer than the longest match
+    for (uint16_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = static_cast<unsigned char>((i % 5) * 17);
+    }
+    check_round_trip(data, sizeof(data), true);
+
+    // Random block repeated far back in the window. Found by walking the hash chains
+    uint32_t seed = 0x12345678;
+    for (uint16_t i = 0; i < sizeof(data); i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        data[i] = (i < 90) ? static_cast<unsigned char>((seed >> 16) & 0xFF) : data[i - 90];
+    }
+    check_round_trip(data, sizeof(data), true);
+}
+
+TEST_F(TestPayloadCompression, IncompressibleLeftUntouched)
+{
+    unsigned char data[200];
+    uint32_t seed = 0x12345678;
+    for (uint16_t i = 0; i < sizeof(data); i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        data[i] = static_cast<unsigned char>((seed >> 16) & 0xFF);
+    }
+    check_round_trip(data, sizeof(data), false);
+
+    check_round_trip(data, 1, false);
+    check_round_trip(data, 0, false);
+
+    // Compressible, but bigger than the work buffer once compressed
+    memset(data, 0, sizeof(data));
+    unsigned char payload[sizeof(data)];
+    memcpy(payload, data, sizeof(data));
+    scrutiny::protocol::Response response;
+    response.reset();
+    response.data = payload;
+    response.data_length = sizeof(payload);
+    EXPECT_FALSE(compress(&response, _compression_buffer, 2));
+    EXPECT_EQ(response.data_length, sizeof(payload));
+    EXPECT_EQ(response.subfunction_id, 0u);
+}
+
+TEST_F(TestPayloadCompression, MemoryReadCompressedWhenNegotiated)
+{
+    unsigned char mem[128];
+    memset(mem, 0, sizeof(mem));
+    mem[0] = 0x55;
+    mem[100] = 0xAA;
+
+    SCRUTINY_CONSTEXPR uint32_t addr_size = SIZEOF_8BITS(uintptr_t);
+    SCRUTINY_CONSTEXPR uint16_t data_size_8bits = SIZEOF_8BITS(mem);
+    unsigned char request_data[8 + addr_size + 2] = { 3, 1, 0, addr_size + 2 };
+    unsigned int index = 4;
+    index += encode_addr(&request_data[index], mem);
+    request_data[index++] = (data_size_8bits >> 8) & 0xFF;
+    request_data[index++] = (data_size_8bits >> 0) & 0xFF;
+    add_crc(request_data, sizeof(request_data) - 4);
+
+    unsigned char expected_payload[addr_size + 2 + data_size_8bits];
+    index = encode_addr(expected_payload, mem);
+    expected_payload[index++] = (data_size_8bits >> 8) & 0xFF;
+    expected_payload[index++] = (data_size_8bits >> 0) & 0xFF;
+    scrutiny::tools::memcpy_dilate_8bits_native(&expected_payload[index], mem, data_size_8bits);
+
+    for (unsigned int i = 0; i < 2; i++)
+    {
+        bool const compression = (i == 1);
+        scrutiny_handler.init(&config);
+        connect(compression ? scrutiny::protocol::CommControl::ConnectFlags::Compression : 0);
+        ASSERT_TRUE(scrutiny_handler.comm()->is_connected());
+        EXPECT_EQ(scrutiny_handler.comm()->compression(), compression);
+
+        scrutiny_handler.receive_data(request_data, sizeof(request_data));
+        scrutiny_handler.process(0);
+
+        unsigned char tx_buffer[256];
+        uint16_t const n_to_read = scrutiny_handler.data_to_send();
+        ASSERT_GT(n_to_read, 9u);
+        ASSERT_LE(n_to_read, sizeof(tx_buffer));
+        scrutiny_handler.pop_data(tx_buffer, n_to_read);
+        scrutiny_handler.process(0);
+
+        uint16_t const datalen = static_cast<uint16_t>((tx_buffer[3] << 8) | tx_buffer[4]);
+        EXPECT_EQ(tx_buffer[0], 0x83);
+        EXPECT_EQ(tx_buffer[2], 0);
+        ASSERT_EQ(n_to_read, 9u + datalen);
+        if (compression)
+        {
+            EXPECT_EQ(tx_buffer[1], 1u | scrutiny::protocol::COMPRESSED_PAYLOAD_FLAG);
+            EXPECT_LT(datalen, sizeof(expected_payload));
+            unsigned char payload[sizeof(expected_payload)];
+            ASSERT_EQ(decompress(&tx_buffer[5], datalen, payload, sizeof(payload)), sizeof(expected_payload));
+            EXPECT_BUF_EQ(payload, expected_payload, sizeof(expected_payload));
+        }
+        else
+        {
+            EXPECT_EQ(tx_buffer[1], 1u);
+            ASSERT_EQ(datalen, sizeof(expected_payload));
+            EXPECT_BUF_EQ(&tx_buffer[5], expected_payload, sizeof(expected_payload));
+        }
+    }
+}
+
+TEST_F(TestPayloadCompression, CompressionSpreadOverProcessCalls)
+{
+    unsigned char mem[160];
+    for (uint16_t i = 0; i < sizeof(mem); i++)
+    {
+        mem[i] = static_cast<unsigned char>(i / 4); // One literal and one match every 4 bytes
+    }
+
+    SCRUTINY_CONSTEXPR uint32_t addr_size = SIZEOF_8BITS(uintptr_t);
+    SCRUTINY_CONSTEXPR uint16_t data_size_8bits = SIZEOF_8BITS(mem);
+    unsigned char request_data[8 + addr_size + 2] = { 3, 1, 0, addr_size + 2 };
+    unsigned int index = 4;
+    index += encode_addr(&request_data[index], mem);
+    request_data[index++] = (data_size_8bits >> 8) & 0xFF;
+    request_data[index++] = (data_size_8bits >> 0) & 0xFF;
+    add_crc(request_data, sizeof(request_data) - 4);
+
+    unsigned char expected_payload[addr_size + 2 + data_size_8bits];
+    index = encode_addr(expected_payload, mem);
+    expected_payload[index++] = (data_size_8bits >> 8) & 0xFF;
+    expected_payload[index++] = (data_size_8bits >> 0) & 0xFF;
+    scrutiny::tools::memcpy_dilate_8bits_native(&expected_payload[index], mem, data_size_8bits);
+
+    connect(scrutiny::protocol::CommControl::ConnectFlags::Compression);
+    ASSERT_TRUE(scrutiny_handler.comm()->compression());
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+
+    unsigned int process_count = 0;
+    while (scrutiny_handler.data_to_send() == 0 && process_count < 100)
+    {
+        scrutiny_handler.process(0);
+        process_count++;
+    }
+    if (SCRUTINY_COMPRESSION_ITEMS_PER_PROCESS < data_size_8bits / 2) // Number of items encoded
+    {
+        EXPECT_GT(process_count, 1u);
+    }
+    EXPECT_LT(process_count, 100u);
+
+    unsigned char tx_buffer[256];
+    uint16_t const n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_GT(n_to_read, 9u);
+    ASSERT_LE(n_to_read, sizeof(tx_buffer));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    scrutiny_handler.process(0);
+
+    uint16_t const datalen = static_cast<uint16_t>((tx_buffer[3] << 8) | tx_buffer[4]);
+    EXPECT_EQ(tx_buffer[1], 1u | scrutiny::protocol::COMPRESSED_PAYLOAD_FLAG);
+    ASSERT_EQ(n_to_read, 9u + datalen);
+    unsigned char payload[sizeof(expected_payload)];
+    ASSERT_EQ(decompress(&tx_buffer[5], datalen, payload, sizeof(payload)), sizeof(expected_payload));
+    EXPECT_BUF_EQ(payload, expected_payload, sizeof(expected_payload));
+}
+
+TEST_F(TestPayloadCompression, NotOfferedWithoutBuffer)
+{
+    scrutiny::Config no_compression_config;
+    no_compression_config.set_buffers(_rx_buffer, sizeof(_rx_buffer), _tx_buffer, sizeof(_tx_buffer));
+    EXPECT_FALSE(no_compression_config.is_compression_buffer_set());
+    EXPECT_TRUE(config.is_compression_buffer_set());
+    scrutiny_handler.init(&no_compression_config);
+
+    connect(scrutiny::protocol::CommControl::ConnectFlags::Compression);
+    ASSERT_TRUE(scrutiny_handler.comm()->is_connected());
+    EXPECT_FALSE(scrutiny_handler.comm()->compression());
+}
@@ -0,0 +1,298 @@
+//    test_statistics.cpp
+//        Test the Statistics command that runs the on-target statistics engine in a loop
+//
+//   - License : MIT - See LICENSE file
+//   - Project : Scrutiny Debugger (github.com/scrutinydebugger/scrutiny-embedded)
+//
+//    Copyright (c) 2021 Scrutiny Debugger
+
+#include "scrutiny.hpp"
+#include "scrutiny_test.hpp"
+#include "scrutinytest/scrutinytest.hpp"
+#include <cstring>
+
+static unsigned char _rx_buffer[128];
+static unsigned char _tx_buffer[256];
+
+#if SCRUTINY_ENABLE_STATISTICS
+static scrutiny::statistics::Channel _statistics_channels[2];
+#endif
+
+class TestStatistics : public ScrutinyTest
+{
+  protected:
+    scrutiny::MainHandler scrutiny_handler;
+    scrutiny::Config config;
+    scrutiny::FixedFrequencyLoopHandler loop;
+    scrutiny::FixedFrequencyLoopHandler loop_no_datalogging;
+    scrutiny::LoopHandler *loops[2];
+    unsigned char tx_buffer[256];
+
+    TestStatistics() :
+        ScrutinyTest(),
+        scrutiny_handler(),
+        config(),
+        loop(100),
+        loop_no_datalogging(100)
+    {
+    }
+
+    virtual void SetUp()
+    {
+        loops[0] = &loop;
+        loops[1] = &loop_no_datalogging;
+        config.set_buffers(_rx_buffer, sizeof(_rx_buffer), _tx_buffer, sizeof(_tx_buffer));
+        config.set_loops(loops, 2);
+#if SCRUTINY_ENABLE_STATISTICS
+        loop_no_datalogging.allow_datalogging(false);
+        config.set_statistics_channels(_statistics_channels, 2);
+#endif
+        scrutiny_handler.init(&config);
+        scrutiny_handler.comm()->connect();
+    }
+
+    /// @brief Sends a request and returns the size of the response. 0 if no response is ready
+    uint16_t send_request(unsigned char *request, uint16_t const size)
+    {
+        scrutiny_handler.receive_data(request, size);
+        scrutiny_handler.process(0);
+        uint16_t const n_to_read = scrutiny_handler.data_to_send();
+        if (n_to_read > 0)
+        {
+            scrutiny_handler.pop_data(tx_buffer, n_to_read);
+            scrutiny_handler.process(0);
+        }
+        return n_to_read;
+    }
+
+    /// @brief Reads the response that was not ready when the request was sent
+    uint16_t read_pending_response()
+    {
+        scrutiny_handler.process(0);
+        uint16_t const n_to_read = scrutiny_handler.data_to_send();
+        if (n_to_read > 0)
+        {
+            scrutiny_handler.pop_data(tx_buffer, n_to_read);
+            scrutiny_handler.process(0);
+        }
+        return n_to_read;
+    }
+
+#if SCRUTINY_ENABLE_STATISTICS
+    /// @brief Builds a Configure request with one channel per variable, each monitoring a float32
+    uint16_t make_configure_request(
+        unsigned char *buffer,
+        uint_least8_t const loop_id,
+        float **vars,
+        uint_least8_t const var_count,
+        uint_least8_t const bin_count,
+        float const histogram_min,
+        float const histogram_max)
+    {
+        buffer[0] = 6;
+        buffer[1] = 2;
+        unsigned int index = 4;
+        buffer[index++] = loop_id;
+        buffer[index++] = var_count;
+        for (uint_least8_t i = 0; i < var_count; i++)
+        {
+            buffer[index++] = scrutiny::datalogging::OperandType::Var;
+            buffer[index++] = scrutiny::VariableType::float32;
+            index += encode_addr(&buffer[index], vars[i]);
+            buffer[index++] = bin_count;
+            index += scrutiny::codecs::encode_float_big_endian_8bits(histogram_min, &buffer[index]);
+            index += scrutiny::codecs::encode_float_big_endian_8bits(histogram_max, &buffer[index]);
+        }
+        buffer[2] = static_cast<unsigned char>(((index - 4) >> 8) & 0xFF);
+        buffer[3] = static_cast<unsigned char>((index - 4) & 0xFF);
+        add_crc(buffer, static_cast<uint16_t>(index));
+        return static_cast<uint16_t>(index + 4);
+    }
+#endif
+};
+
+#if SCRUTINY_ENABLE_STATISTICS
+
+TEST_F(TestStatistics, TestGetSetup)
+{
+    unsigned char request_data[8] = { 6, 1, 0, 0 };
+    add_crc(request_data, sizeof(request_data) - 4);
+
+    unsigned char expected_response[9 + 2] = { 0x86, 1, 0, 0, 2, 2, scrutiny::statistics::MAX_BINS };
+    add_crc(expected_response, sizeof(expected_response) - 4);
+
+    ASSERT_EQ(send_request(request_data, sizeof(request_data)), sizeof(expected_response));
+    EXPECT_BUF_EQ(tx_buffer, expected_response, sizeof(expected_response));
+}
+
+TEST_F(TestStatistics, TestUnsupportedWithoutChannels)
+{
+    scrutiny::Config no_statistics_config;
+    no_statistics_config.set_buffers(_rx_buffer, sizeof(_rx_buffer), _tx_buffer, sizeof(_tx_buffer));
+    no_statistics_config.set_loops(loops, 2);
+    scrutiny_handler.init(&no_statistics_config);
+    scrutiny_handler.comm()->connect();
+
+    scrutiny::protocol::ResponseCode::eResponseCode const failure = scrutiny::protocol::ResponseCode::UnsupportedFeature;
+    for (unsigned char subfn = 1; subfn <= 3; subfn++)
+    {
+        unsigned char request_data[8] = { 6, subfn, 0, 0 };
+        add_crc(request_data, sizeof(request_data) - 4);
+        ASSERT_EQ(send_request(request_data, sizeof(request_data)), 9u);
+        EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, scrutiny::protocol::CommandId::Statistics, subfn, failure);
+    }
+}
+
+TEST_F(TestStatistics, TestConfigureAndRead)
+{
+    float var1 = 0;
+    float var2 = 0;
+    float *vars[2] = { &var1, &var2 };
+    unsigned char request_data[64];
+    uint16_t const request_size = make_configure_request(request_data, 0, vars, 2, 4, 0.0f, 4.0f);
+    ASSERT_EQ(send_request(request_data, request_size), 9u);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, scrutiny::protocol::CommandId::Statistics, 2, scrutiny::protocol::ResponseCode::OK);
+
+    // Values out of the histogram range are counted in the first and last bins
+    float const values[5] = { 0.5f, 1.5f, 3.5f, 10.0f, -1.0f };
+    for (unsigned int i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+    {
+        var1 = values[i];
+        var2 = 2.0f;
+        loop.process();
+    }
+
+    unsigned char read_request[8] = { 6, 3, 0, 0 };
+    add_crc(read_request, sizeof(read_request) - 4);
+    EXPECT_EQ(send_request(read_request, sizeof(read_request)), 0u); // Waiting on the snapshot
+    var1 = 100.0f;                                                    // Not part of the snapshot
+    loop.process();
+    SCRUTINY_CONSTEXPR uint16_t channel_size = 4 + 4 * 4 + 1 + 4 * 4;
+    SCRUTINY_CONSTEXPR uint16_t datalen = 1 + 2 * channel_size;
+    ASSERT_EQ(read_pending_response(), 9u + datalen);
+    ASSERT_IS_PROTOCOL_RESPONSE(tx_buffer, scrutiny::protocol::CommandId::Statistics, 3, scrutiny::protocol::ResponseCode::OK);
+    EXPECT_EQ((tx_buffer[3] << 8) | tx_buffer[4], datalen);
+
+    unsigned char const *data = &tx_buffer[5];
+    EXPECT_EQ(data[0], 2u);
+
+    unsigned char const *channel = &data[1];
+    EXPECT_EQ(scrutiny::codecs::decode_32_bits_big_endian_8bits(&channel[0]), 5u);
+    EXPECT_EQ(scrutiny::codecs::decode_float_big_endian_8bits(&channel[4]), -1.0f);
+    EXPECT_EQ(scrutiny::codecs::decode_float_big_endian_8bits(&channel[8]), 10.0f);
+    EXPECT_NEAR(scrutiny::codecs::decode_float_big_endian_8bits(&channel[12]), 2.9f, 1e-5f);
+    EXPECT_NEAR(scrutiny::codecs::decode_float_big_endian_8bits(&channel[16]), 23.15f, 1e-4f); // Mean square. The server takes the root
+    EXPECT_EQ(channel[20], 4u);
+    EXPECT_EQ(scrutiny::codecs::decode_32_bits_big_endian_8bits(&channel[21]), 2u);
+    EXPECT_EQ(scrutiny::codecs::decode_32_bits_big_endian_8bits(&channel[25]), 1u);
+    EXPECT_EQ(scrutiny::codecs::decode_32_bits_big_endian_8bits(&channel[29]), 0u);
+    EXPECT_EQ(scrutiny::codecs::decode_32_bits_big_endian_8bits(&channel[33]), 2u);
+
+    channel = &data[1 + channel_size];
+    EXPECT_EQ(scrutiny::codecs::decode_32_bits_big_endian_8bits(&channel[0]), 5u);
+    EXPECT_EQ(scrutiny::codecs::decode_float_big_endian_8bits(&channel[4]), 2.0f);
+    EXPECT_EQ(scrutiny::codecs::decode_float_big_endian_8bits(&channel[8]), 2.0f);
+    EXPECT_EQ(scrutiny::codecs::decode_float_big_endian_8bits(&channel[12]), 2.0f);
+    EXPECT_EQ(scrutiny::codecs::decode_float_big_endian_8bits(&channel[16]), 4.0f);
+    EXPECT_EQ(channel[20], 4u);
+    EXPECT_EQ(scrutiny::codecs::decode_32_bits_big_endian_8bits(&channel[29]), 5u); // 2.0 is the start of the third bin
+
+    // Statistics keep running after a read
+    var1 = 1.0f;
+    loop.process();
+    EXPECT_EQ(send_request(read_request, sizeof(read_request)), 0u);
+    loop.process();
+    ASSERT_EQ(read_pending_response(), 9u + datalen);
+    EXPECT_EQ(scrutiny::codecs::decode_32_bits_big_endian_8bits(&tx_buffer[5 + 1]), 7u);
+}
+
+TEST_F(TestStatistics, TestReconfigureStopsTheLoop)
+{
+    float var = 1.0f;
+    float *vars[1] = { &var };
+    unsigned char request_data[64];
+    uint16_t request_size = make_configure_request(request_data, 0, vars, 1, 0, 0.0f, 0.0f);
+    ASSERT_EQ(send_request(request_data, request_size), 9u);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, scrutiny::protocol::CommandId::Statistics, 2, scrutiny::protocol::ResponseCode::OK);
+    loop.process();
+    EXPECT_TRUE(loop.runs_statistics());
+
+    // Waits for the loop to stop before writing the channels
+    EXPECT_EQ(send_request(request_data, request_size), 0u);
+    loop.process();
+    EXPECT_FALSE(loop.runs_statistics());
+    ASSERT_EQ(read_pending_response(), 9u);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, scrutiny::protocol::CommandId::Statistics, 2, scrutiny::protocol::ResponseCode::OK);
+    loop.process();
+    EXPECT_TRUE(loop.runs_statistics());
+
+    // No channel only stops the statistics
+    request_size = make_configure_request(request_data, 0, vars, 0, 0, 0.0f, 0.0f);
+    EXPECT_EQ(send_request(request_data, request_size), 0u);
+    loop.process();
+    ASSERT_EQ(read_pending_response(), 9u);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, scrutiny::protocol::CommandId::Statistics, 2, scrutiny::protocol::ResponseCode::OK);
+    EXPECT_FALSE(loop.runs_statistics());
+
+    unsigned char read_request[8] = { 6, 3, 0, 0 };
+    add_crc(read_request, sizeof(read_request) - 4);
+    ASSERT_EQ(send_request(read_request, sizeof(read_request)), 9u);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, scrutiny::protocol::CommandId::Statistics, 3, scrutiny::protocol::ResponseCode::FailureToProceed);
+}
+
+TEST_F(TestStatistics, TestConfigureErrors)
+{
+    float var = 1.0f;
+    float *vars[2] = { &var, &var };
+    unsigned char request_data[64];
+    uint16_t request_size;
+
+    request_size = make_configure_request(request_data, 1, vars, 1, 0, 0.0f, 0.0f);
+    ASSERT_EQ(send_request(request_data, request_size), 9u);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, scrutiny::protocol::CommandId::Statistics, 2, scrutiny::protocol::ResponseCode::Forbidden);
+
+    request_size = make_configure_request(request_data, 2, vars, 1, 0, 0.0f, 0.0f);
+    ASSERT_EQ(send_request(request_data, request_size), 9u);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, scrutiny::protocol::CommandId::Statistics, 2, scrutiny::protocol::ResponseCode::FailureToProceed);
+
+    request_size = make_configure_request(request_data, 0, vars, 1, scrutiny::statistics::MAX_BINS + 1, 0.0f, 1.0f);
+    ASSERT_EQ(send_request(request_data, request_size), 9u);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, scrutiny::protocol::CommandId::Statistics, 2, scrutiny::protocol::ResponseCode::Overflow);
+
+    request_size = make_configure_request(request_data, 0, vars, 1, 4, 1.0f, 1.0f); // Empty histogram range
+    ASSERT_EQ(send_request(request_data, request_size), 9u);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, scrutiny::protocol::CommandId::Statistics, 2, scrutiny::protocol::ResponseCode::InvalidRequest);
+
+    request_size = make_configure_request(request_data, 0, vars, 1, 0, 0.0f, 0.0f);
+    request_data[6] = scrutiny::datalogging::OperandType::Literal; // Nothing to monitor
+    add_crc(request_data, static_cast<uint16_t>(request_size - 4));
+    ASSERT_EQ(send_request(request_data, request_size), 9u);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, scrutiny::protocol::CommandId::Statistics, 2, scrutiny::protocol::ResponseCode::InvalidRequest);
+
+    unsigned char too_many_channels[8 + 2] = { 6, 2, 0, 2, 0, 3 };
+    add_crc(too_many_channels, sizeof(too_many_channels) - 4);
+    ASSERT_EQ(send_request(too_many_channels, sizeof(too_many_channels)), 9u);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, scrutiny::protocol::CommandId::Statistics, 2, scrutiny::protocol::ResponseCode::Overflow);
+
+    unsigned char read_request[8] = { 6, 3, 0, 0 };
+    add_crc(read_request, sizeof(read_request) - 4);
+    ASSERT_EQ(send_request(read_request, sizeof(read_request)), 9u);
+    EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, scrutiny::protocol::CommandId::Statistics, 3, scrutiny::protocol::ResponseCode::FailureToProceed);
+    EXPECT_FALSE(loop.runs_statistics());
+}
+
+#else
+
+TEST_F(TestStatistics, TestUnsupported)
+{
+    scrutiny::protocol::ResponseCode::eResponseCode const failure = scrutiny::protocol::ResponseCode::UnsupportedFeature;
+    for (unsigned char subfn = 1; subfn <= 3; subfn++)
+    {
+        unsigned char request_data[8] = { 6, subfn, 0, 0 };
+        add_crc(request_data, sizeof(request_data) - 4);
+        ASSERT_EQ(send_request(request_data, sizeof(request_data)), 9u);
+        EXPECT_IS_PROTOCOL_RESPONSE(tx_buffer, scrutiny::protocol::CommandId::Statistics, subfn, failure);
+    }
+}
+
+#endif
@@ -159,3 +159,137 @@ TEST_F(TestUserCommand, TestNoCallback)
     scrutiny_handler.pop_data(tx_buffer, n_to_read);
     ASSERT_IS_PROTOCOL_RESPONSE(tx_buffer, cmd, 0, code);
 }
+
+struct AsyncCallbackData
+{
+    unsigned int call_count;
+    unsigned int new_request_count;
+    unsigned int pending_calls; // Number of calls that return PENDING before the command is done
+    scrutiny::UserCommandStatus::eUserCommandStatus final_status;
+};
+
+static AsyncCallbackData async_callback_data;
+scrutiny::ctypes::scrutiny_c_user_command_status_e my_async_callback(
+    uint_least8_t const subfunction,
+    unsigned char const *request_data,
+    uint16_t const request_data_length,
+    unsigned char *response_data,
+    uint16_t *response_data_length,
+    uint16_t const response_max_data_length,
+    uint_least8_t const new_request)
+{
+    (void)request_data;             // Silence unused parameters warning
+    (void)request_data_length;      // Silence unused parameters warning
+    (void)response_max_data_length; // Silence unused parameters warning
+    async_callback_data.call_count++;
+    if (new_request)
+    {
+        async_callback_data.new_request_count++;
+    }
+
+    if (async_callback_data.call_count <= async_callback_data.pending_calls)
+    {
+        return scrutiny::ctypes::SCRUTINY_C_USER_COMMAND_PENDING;
+    }
+
+    response_data[0] = subfunction;
+    response_data[1] = static_cast<unsigned char>(async_callback_data.call_count);
+    *response_data_length = 2;
+    return static_cast<scrutiny::ctypes::scrutiny_c_user_command_status_e>(async_callback_data.final_status);
+}
+
+TEST_F(TestUserCommand, TestAsyncCommandCompletesLater)
+{
+    unsigned char tx_buffer[32];
+    async_callback_data.call_count = 0;
+    async_callback_data.new_request_count = 0;
+    async_callback_data.pending_calls = 3;
+    async_callback_data.final_status = scrutiny::UserCommandStatus::DONE;
+    config.set_user_command_callback(my_callback1); // The asynchronous callback has precedence
+    config.set_async_user_command_callback(my_async_callback);
+    scrutiny_handler.init(&config);
+    scrutiny_handler.comm()->connect();
+
+    unsigned char request_data[8 + 1] = { 4, 0x55, 0, 1, 0x12 };
+    add_crc(request_data, sizeof(request_data) - 4);
+
+    unsigned char expected_response[9 + 2] = { 0x84, 0x55, 0, 0, 2, 0x55, 4 };
+    add_crc(expected_response, sizeof(expected_response) - 4);
+
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    for (unsigned int i = 0; i < async_callback_data.pending_calls; i++)
+    {
+        scrutiny_handler.process(1000);
+        EXPECT_EQ(scrutiny_handler.data_to_send(), 0u);
+    }
+    scrutiny_handler.process(1000);
+    EXPECT_EQ(async_callback_data.call_count, 4u);
+    EXPECT_EQ(async_callback_data.new_request_count, 1u);
+
+    uint16_t n_to_read = scrutiny_handler.data_to_send();
+    ASSERT_EQ(n_to_read, sizeof(expected_response));
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    EXPECT_BUF_EQ(tx_buffer, expected_response, sizeof(expected_response));
+}
+
+TEST_F(TestUserCommand, TestAsyncCommandFailure)
+{
+    const scrutiny::protocol::CommandId::eCommandId cmd = scrutiny::protocol::CommandId::UserCommand;
+    const scrutiny::protocol::ResponseCode::eResponseCode code = scrutiny::protocol::ResponseCode::FailureToProceed;
+
+    unsigned char tx_buffer[32];
+    async_callback_data.call_count = 0;
+    async_callback_data.new_request_count = 0;
+    async_callback_data.pending_calls = 1;
+    async_callback_data.final_status = scrutiny::UserCommandStatus::FAILED;
+    config.set_async_user_command_callback(my_async_callback);
+    scrutiny_handler.init(&config);
+    scrutiny_handler.comm()->connect();
+
+    unsigned char request_data[8] = { 4, 0, 0, 0 };
+    add_crc(request_data, sizeof(request_data) - 4);
+
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    scrutiny_handler.process(0);
+    EXPECT_EQ(scrutiny_handler.data_to_send(), 0u);
+    scrutiny_handler.process(0);
+
+    uint16_t n_to_read = scrutiny_handler.data_to_send();
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    ASSERT_IS_PROTOCOL_RESPONSE(tx_buffer, cmd, 0, code);
+}
+
+TEST_F(TestUserCommand, TestAsyncCommandTimeout)
+{
+    const scrutiny::protocol::CommandId::eCommandId cmd = scrutiny::protocol::CommandId::UserCommand;
+    const scrutiny::protocol::ResponseCode::eResponseCode code = scrutiny::protocol::ResponseCode::FailureToProceed;
+
+    unsigned char tx_buffer[32];
+    async_callback_data.call_count = 0;
+    async_callback_data.new_request_count = 0;
+    async_callback_data.pending_calls = 0xFFFFFFFF; // Never completes
+    async_callback_data.final_status = scrutiny::UserCommandStatus::DONE;
+    config.set_async_user_command_callback(my_async_callback);
+    scrutiny_handler.init(&config);
+    scrutiny_handler.comm()->connect();
+
+    unsigned char request_data[8] = { 4, 0, 0, 0 };
+    add_crc(request_data, sizeof(request_data) - 4);
+
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    scrutiny_handler.process(0);
+    scrutiny_handler.process(SCRUTINY_REQUEST_MAX_PROCESS_TIME_US * 10 - 1);
+    EXPECT_EQ(scrutiny_handler.data_to_send(), 0u);
+    scrutiny_handler.process(1);
+
+    uint16_t n_to_read = scrutiny_handler.data_to_send();
+    scrutiny_handler.pop_data(tx_buffer, n_to_read);
+    ASSERT_IS_PROTOCOL_RESPONSE(tx_buffer, cmd, 0, code);
+    scrutiny_handler.process(0);
+
+    // The next request is seen as a new one by the callback
+    EXPECT_EQ(async_callback_data.new_request_count, 1u);
+    scrutiny_handler.receive_data(request_data, sizeof(request_data));
+    scrutiny_handler.process(0);
+    EXPECT_EQ(async_callback_data.new_request_count, 2u);
+}
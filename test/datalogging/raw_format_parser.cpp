@@ -58,6 +58,10 @@ unsigned char *RawFormatParser::get_parsed_data_location(uint16_t entry_index, u
     }
     for (uint16_t j = 0; j < item_index; j++)
     {
+        if (m_config->items_to_log[j].common.type == scrutiny::datalogging::LoggableType::ImplicitTime)
+        {
+            continue; // Not stored
+        }
         uint16_t size = get_item_size_char(j);
         if (size == 0)
         {
@@ -86,6 +90,10 @@ uint16_t RawFormatParser::get_entry_size_char()
     uint16_t entry_size_char = 0;
     for (uint16_t i = 0; i < m_config->items_count; i++)
     {
+        if (m_config->items_to_log[i].common.type == scrutiny::datalogging::LoggableType::ImplicitTime)
+        {
+            continue; // Not stored
+        }
         uint16_t elem_size_char = get_item_size_char(i);
 
         if (elem_size_char == 0)
@@ -132,6 +140,10 @@ void RawFormatParser::parse(uint32_t entry_count)
     {
         for (uint16_t j = 0; j < m_config->items_count; j++)
         {
+            if (m_config->items_to_log[j].common.type == scrutiny::datalogging::LoggableType::ImplicitTime)
+            {
+                continue; // Not stored
+            }
             uint16_t elem_size_char = get_item_size_char(j);
             unsigned char *dst_ptr = get_parsed_data_location(i, j);
 
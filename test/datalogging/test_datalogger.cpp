@@ -301,6 +301,138 @@ TEST_F(TestDatalogger, BasicAcquisition)
     CHECK_CANARIES;
 }
 
+TEST_F(TestDatalogger, ReducedAcquisition)
+{
+    float my_var = 0.0;
+
+    datalogging::Configuration dlconfig;
+    dlconfig.items_count = 1;
+    dlconfig.items_to_log[0].common.type = datalogging::LoggableType::Memory;
+    dlconfig.items_to_log[0].memory.size = sizeof(my_var);
+    dlconfig.items_to_log[0].memory.address = &my_var;
+    dlconfig.items_options[0].reduction = datalogging::ReductionMode::Mean;
+    dlconfig.items_options[0].datatype = VariableType::float32;
+    dlconfig.decimation = 4;
+    dlconfig.timeout_100ns = 0;
+    dlconfig.probe_location = 0;
+    dlconfig.trigger.hold_time_100ns = 0;
+    dlconfig.trigger.condition = datalogging::SupportedTriggerConditions::AlwaysTrue;
+    dlconfig.trigger.operand_count = 0;
+
+    datalogger.config()->copy_from(&dlconfig);
+    datalogger.configure(&tb);
+    ASSERT_TRUE(datalogger.config_valid());
+    datalogger.arm_trigger();
+
+    for (unsigned int i = 0; i < 1000 && !datalogger.data_acquired(); i++)
+    {
+        datalogger.process();
+        tb.step(100);
+        my_var += 1.0f;
+    }
+    ASSERT_TRUE(datalogger.data_acquired());
+    CHECK_CANARIES;
+
+    // Each entry is the mean of 4 consecutive values, which always ends with .5. Logging the last value would give an integer.
+    datalogging::DataReader *reader = datalogger.get_encoder()->get_reader();
+    reader->reset();
+    uint32_t const entry_count = reader->get_entry_count();
+    ASSERT_GT(entry_count, 2u);
+    ASSERT_EQ(reader->read_dilate_8bits(output_buffer.data, sizeof(output_buffer.data)), entry_count * sizeof(float) * (CHAR_BIT / 8));
+
+    float previous = 0;
+    for (uint32_t i = 0; i < entry_count; i++)
+    {
+        float mean;
+        SCRUTINY_CONSTEXPR size_t entry_size_8bits = sizeof(float) * (CHAR_BIT / 8);
+        scrutiny::tools::memcpy_compress_from_8bits_native(&mean, &output_buffer.data[i * entry_size_8bits], entry_size_8bits);
+        EXPECT_EQ(mean - static_cast<float>(static_cast<int32_t>(mean)), 0.5f) << "entry=" << i;
+        if (i > 0)
+        {
+            EXPECT_EQ(mean - previous, 4.0f) << "entry=" << i;
+        }
+        previous = mean;
+    }
+}
+
+TEST_F(TestDatalogger, DoubleBuffering)
+{
+    uint32_t my_var = 0;
+
+    datalogging::Configuration dlconfig;
+    dlconfig.items_count = 1;
+    dlconfig.items_to_log[0].common.type = datalogging::LoggableType::Memory;
+    dlconfig.items_to_log[0].memory.size = sizeof(my_var);
+    dlconfig.items_to_log[0].memory.address = &my_var;
+    dlconfig.decimation = 1;
+    dlconfig.timeout_100ns = 0;
+    dlconfig.probe_location = 0;
+    dlconfig.trigger.hold_time_100ns = 0;
+    dlconfig.trigger.condition = datalogging::SupportedTriggerConditions::AlwaysTrue;
+    dlconfig.trigger.operand_count = 0;
+    dlconfig.double_buffering = true;
+
+    datalogger.config()->copy_from(&dlconfig);
+    datalogger.configure(&tb);
+    ASSERT_TRUE(datalogger.config_valid());
+    EXPECT_TRUE(datalogger.double_buffering());
+    EXPECT_EQ(datalogger.get_encoder()->get_buffer_size(), sizeof(dlbuffer.data) / 2);
+    datalogger.arm_trigger();
+
+    SCRUTINY_CONSTEXPR uint32_t max_entries = sizeof(dlbuffer.data) / 2 / sizeof(my_var);
+    uint16_t const first_acquisition_id = datalogger.get_acquisition_id();
+    for (unsigned int i = 0; i < 1000 && !datalogger.acquisition_available(); i++)
+    {
+        datalogger.process();
+        my_var++;
+    }
+    ASSERT_TRUE(datalogger.acquisition_available());
+    EXPECT_EQ(datalogger.get_acquisition_id(), static_cast<uint16_t>(first_acquisition_id + 1));
+    // The datalogger rearmed by itself in the other half.
+    EXPECT_EQ(datalogger.get_state(), datalogging::DataLogger::State::Armed);
+    uint32_t const first_acquisition_last_value = my_var - 1;
+
+    // Second acquisition fills the other half while the first one stays available
+    for (unsigned int i = 0; i < 1000 && !datalogger.data_acquired(); i++)
+    {
+        datalogger.process();
+        my_var++;
+    }
+    ASSERT_TRUE(datalogger.data_acquired());
+    uint32_t const second_acquisition_last_value = my_var - 1;
+    datalogger.process(); // Nothing more is logged. Both halves are full
+    EXPECT_TRUE(datalogger.data_acquired());
+    datalogger.arm_trigger(); // Cannot discard an acquisition that has not been read
+    EXPECT_TRUE(datalogger.data_acquired());
+    EXPECT_EQ(datalogger.get_acquisition_id(), static_cast<uint16_t>(first_acquisition_id + 1));
+
+    datalogging::DataReader *reader = datalogger.get_reader();
+    reader->reset();
+    ASSERT_EQ(reader->get_entry_count(), max_entries);
+    ASSERT_EQ(reader->read_dilate_8bits(output_buffer.data, sizeof(output_buffer.data)), max_entries * sizeof(my_var) * (CHAR_BIT / 8));
+    uint32_t last_value;
+    tools::memcpy_compress_from_8bits_native(&last_value, &output_buffer.data[(max_entries - 1) * sizeof(my_var) * (CHAR_BIT / 8)], sizeof(my_var));
+    EXPECT_EQ(last_value, first_acquisition_last_value);
+
+    // Releasing the first acquisition publishes the second one and starts a third one in the freed half
+    datalogger.release_acquisition();
+    EXPECT_TRUE(datalogger.acquisition_available());
+    EXPECT_EQ(datalogger.get_state(), datalogging::DataLogger::State::Armed);
+    EXPECT_EQ(datalogger.get_acquisition_id(), static_cast<uint16_t>(first_acquisition_id + 2));
+    datalogger.process();
+
+    reader = datalogger.get_reader();
+    reader->reset();
+    ASSERT_EQ(reader->get_entry_count(), max_entries);
+    ASSERT_EQ(reader->read_dilate_8bits(output_buffer.data, sizeof(output_buffer.data)), max_entries * sizeof(my_var) * (CHAR_BIT / 8));
+    tools::memcpy_compress_from_8bits_native(&last_value, &output_buffer.data[(max_entries - 1) * sizeof(my_var) * (CHAR_BIT / 8)], sizeof(my_var));
+    EXPECT_EQ(last_value, second_acquisition_last_value);
+
+    datalogger.release_acquisition();
+    EXPECT_FALSE(datalogger.acquisition_available());
+    CHECK_CANARIES;
+}
+
 TEST_F(TestDatalogger, ComplexAcquisition)
 {
 // Static to spare the stack a bit
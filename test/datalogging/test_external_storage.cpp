@@ -0,0 +1,277 @@
+//    test_external_storage.cpp
+//        Test suite for the datalogging external storage. Uses a file as a stand-in for an external memory
+//
+//   - License : MIT - See LICENSE file
+//   - Project : Scrutiny Debugger (github.com/scrutinydebugger/scrutiny-embedded)
+//
+//    Copyright (c) 2021 Scrutiny Debugger
+
+#include "scrutinytest/scrutinytest.hpp"
+
+#include "scrutiny.hpp"
+#include "scrutiny_test.hpp"
+#include <stdio.h>
+
+#if SCRUTINY_DATALOGGING_ENCODING == SCRUTINY_DATALOGGING_ENCODING_RAW
+
+using namespace scrutiny;
+
+static unsigned char _rx_buffer[128];
+static unsigned char _tx_buffer[128];
+
+static FILE *storage_file = SCRUTINY_NULL;
+static unsigned int storage_write_count = 0;
+
+static void file_storage_write(datalogging::buffer_size_t const address, unsigned char const *data, datalogging::buffer_size_t const size)
+{
+    storage_write_count++;
+    fseek(storage_file, static_cast<long>(address), SEEK_SET);
+    fwrite(data, 1, size, storage_file);
+}
+
+static void file_storage_read(datalogging::buffer_size_t const address, unsigned char *data, datalogging::buffer_size_t const size)
+{
+    fseek(storage_file, static_cast<long>(address), SEEK_SET);
+    size_t const nread = fread(data, 1, size, storage_file);
+    static_cast<void>(nread);
+}
+
+class TestExternalStorage : public ScrutinyTest
+{
+  protected:
+    MainHandler scrutiny_handler;
+    Config config;
+    datalogging::Configuration dlconfig;
+    datalogging::RawFormatEncoder encoder;
+    datalogging::RawFormatEncoder reference_encoder;
+    datalogging::ExternalStorage storage;
+    unsigned char cache[32];
+
+    TestExternalStorage() :
+        ScrutinyTest(),
+        scrutiny_handler(),
+        config(),
+        dlconfig(),
+        encoder(),
+        reference_encoder()
+    {
+    }
+
+    virtual void SetUp()
+    {
+        config.set_buffers(_rx_buffer, sizeof(_rx_buffer), _tx_buffer, sizeof(_tx_buffer));
+        scrutiny_handler.init(&config);
+
+        storage_file = tmpfile();
+        storage_write_count = 0;
+        storage.write = file_storage_write;
+        storage.read = file_storage_read;
+        storage.cache = cache;
+        storage.cache_size = sizeof(cache);
+    }
+
+    virtual void TearDown()
+    {
+        if (storage_file != SCRUTINY_NULL)
+        {
+            fclose(storage_file);
+            storage_file = SCRUTINY_NULL;
+        }
+    }
+};
+
+TEST_F(TestExternalStorage, SameDataAsInternalBuffer)
+{
+    ASSERT_TRUE(storage_file != SCRUTINY_NULL);
+    Timebase timebase;
+    unsigned char reference_buffer[100];
+    uint32_t var1;
+    uint16_t var2;
+
+    dlconfig.items_count = 3;
+    dlconfig.items_to_log[0].common.type = datalogging::LoggableType::Memory;
+    dlconfig.items_to_log[0].memory.size = sizeof(var1);
+    dlconfig.items_to_log[0].memory.address = &var1;
+    dlconfig.items_to_log[1].common.type = datalogging::LoggableType::Memory;
+    dlconfig.items_to_log[1].memory.size = sizeof(var2);
+    dlconfig.items_to_log[1].memory.address = &var2;
+    dlconfig.items_to_log[2].common.type = datalogging::LoggableType::Time;
+
+    encoder.init(&scrutiny_handler, &dlconfig, &storage, sizeof(reference_buffer));
+    reference_encoder.init(&scrutiny_handler, &dlconfig, reference_buffer, sizeof(reference_buffer));
+    encoder.set_timebase(&timebase);
+    reference_encoder.set_timebase(&timebase);
+    ASSERT_FALSE(encoder.error());
+    ASSERT_FALSE(reference_encoder.error());
+    EXPECT_TRUE(encoder.external_storage());
+    EXPECT_FALSE(reference_encoder.external_storage());
+
+    // Goes around the buffer a few times
+    unsigned int const entry_count = 37;
+    for (unsigned int i = 0; i < entry_count; i++)
+    {
+        var1 = 0x11111111u * i;
+        var2 = static_cast<uint16_t>(0x2222u + i);
+        encoder.encode_next_entry(SCRUTINY_NULL);
+        reference_encoder.encode_next_entry(SCRUTINY_NULL);
+        timebase.step(100);
+    }
+    encoder.flush();
+    ASSERT_FALSE(encoder.error());
+
+    // 10 bytes entries in a 32 bytes cache : The writes are grouped when the entries are contiguous
+    EXPECT_LT(storage_write_count, entry_count);
+    EXPECT_GT(storage_write_count, entry_count / 3);
+
+    EXPECT_EQ(encoder.get_entry_count(), reference_encoder.get_entry_count());
+    EXPECT_EQ(encoder.get_read_cursor(), reference_encoder.get_read_cursor());
+    EXPECT_EQ(encoder.get_write_cursor(), reference_encoder.get_write_cursor());
+
+    datalogging::RawFormatReader *reader = encoder.get_reader();
+    datalogging::RawFormatReader *reference_reader = reference_encoder.get_reader();
+    reader->reset();
+    reference_reader->reset();
+    ASSERT_EQ(reader->get_total_size_8bits(), reference_reader->get_total_size_8bits());
+
+    unsigned char expected[sizeof(reference_buffer) * (CHAR_BIT / 8)];
+    unsigned char data[sizeof(reference_buffer) * (CHAR_BIT / 8)];
+    datalogging::buffer_size_t const expected_size = reference_reader->read_dilate_8bits(expected, sizeof(expected));
+    EXPECT_TRUE(reference_reader->finished());
+
+    // Read with a chunk size that does not match the cache size.
+    datalogging::buffer_size_t size = 0;
+    while (!reader->finished() && size < sizeof(data))
+    {
+        datalogging::buffer_size_t const chunk_size = SCRUTINY_MIN(static_cast<datalogging::buffer_size_t>(24), sizeof(data) - size);
+        size += reader->read_dilate_8bits(&data[size], chunk_size);
+    }
+    EXPECT_TRUE(reader->finished());
+    ASSERT_EQ(size, expected_size);
+    EXPECT_BUF_EQ(data, expected, size);
+}
+
+TEST_F(TestExternalStorage, CacheSmallerThanEntryIsError)
+{
+    uint32_t var1[3];
+
+    dlconfig.items_count = 3;
+    for (uint_fast8_t i = 0; i < 3; i++)
+    {
+        dlconfig.items_to_log[i].common.type = datalogging::LoggableType::Memory;
+        dlconfig.items_to_log[i].memory.size = sizeof(var1[i]);
+        dlconfig.items_to_log[i].memory.address = &var1[i];
+    }
+
+    storage.cache_size = 3 * sizeof(var1[0]) - 1;
+    encoder.init(&scrutiny_handler, &dlconfig, &storage, 100);
+    EXPECT_TRUE(encoder.error());
+
+    storage.cache_size = 3 * sizeof(var1[0]);
+    encoder.init(&scrutiny_handler, &dlconfig, &storage, 100);
+    EXPECT_FALSE(encoder.error());
+
+    storage.read = SCRUTINY_NULL_FN_PTR(datalogging::storage_read_callback_t);
+    encoder.init(&scrutiny_handler, &dlconfig, &storage, 100);
+    EXPECT_TRUE(encoder.error());
+}
+
+TEST_F(TestExternalStorage, DataloggerFlushesOnCompletion)
+{
+    Timebase tb;
+    uint32_t logged_var = 0;
+    datalogging::DataLogger datalogger;
+    datalogger.init(&scrutiny_handler, &storage, 200);
+
+    datalogging::Configuration *dlconfig = datalogger.config();
+    dlconfig->items_count = 1;
+    dlconfig->items_to_log[0].common.type = datalogging::LoggableType::Memory;
+    dlconfig->items_to_log[0].memory.size = sizeof(logged_var);
+    dlconfig->items_to_log[0].memory.address = &logged_var;
+    dlconfig->decimation = 1;
+    dlconfig->timeout_100ns = 0;
+    dlconfig->probe_location = 128;
+    dlconfig->trigger.hold_time_100ns = 0;
+    dlconfig->trigger.operand_count = 0;
+    dlconfig->trigger.condition = datalogging::SupportedTriggerConditions::AlwaysTrue;
+    datalogger.configure(&tb);
+    ASSERT_TRUE(datalogger.config_valid());
+    datalogger.arm_trigger();
+
+    for (unsigned int i = 0; i < 100 && !datalogger.data_acquired(); i++)
+    {
+        logged_var = i;
+        datalogger.process();
+        tb.step(100);
+    }
+    ASSERT_TRUE(datalogger.data_acquired());
+    EXPECT_GT(storage_write_count, 0u);
+
+    // Entries are read back in order from the file. Each one holds the loop counter
+    datalogging::DataReader *reader = datalogger.get_reader();
+    reader->reset();
+    datalogging::buffer_size_t const entry_count = reader->get_entry_count();
+    ASSERT_GT(entry_count, 0u);
+    unsigned char data[200 * (CHAR_BIT / 8)];
+    datalogging::buffer_size_t const size = reader->read_dilate_8bits(data, sizeof(data));
+    ASSERT_EQ(size, entry_count * sizeof(logged_var) * (CHAR_BIT / 8));
+    EXPECT_TRUE(reader->finished());
+
+    for (datalogging::buffer_size_t i = 0; i < entry_count; i++)
+    {
+        unsigned char expected[sizeof(logged_var) * (CHAR_BIT / 8)];
+        uint32_t const expected_value = logged_var - (entry_count - 1 - i);
+        tools::memcpy_dilate_8bits_native(expected, &expected_value, sizeof(expected));
+        EXPECT_BUF_EQ(&data[i * sizeof(expected)], expected, sizeof(expected)) << "i=" << i;
+    }
+}
+
+TEST_F(TestExternalStorage, DoubleBufferingIsRefused)
+{
+    // The storage would otherwise be read back by the server while the next acquisition is being written
+    Timebase tb;
+    uint32_t logged_var = 0;
+    datalogging::DataLogger datalogger;
+    datalogger.init(&scrutiny_handler, &storage, 200);
+
+    datalogging::Configuration *dlconfig = datalogger.config();
+    dlconfig->items_count = 1;
+    dlconfig->items_to_log[0].common.type = datalogging::LoggableType::Memory;
+    dlconfig->items_to_log[0].memory.size = sizeof(logged_var);
+    dlconfig->items_to_log[0].memory.address = &logged_var;
+    dlconfig->decimation = 1;
+    dlconfig->timeout_100ns = 0;
+    dlconfig->probe_location = 128;
+    dlconfig->trigger.hold_time_100ns = 0;
+    dlconfig->trigger.operand_count = 0;
+    dlconfig->trigger.condition = datalogging::SupportedTriggerConditions::AlwaysTrue;
+    dlconfig->double_buffering = true;
+    datalogger.configure(&tb);
+    EXPECT_FALSE(datalogger.config_valid());
+    EXPECT_FALSE(datalogger.double_buffering());
+
+    dlconfig->double_buffering = false;
+    datalogger.configure(&tb);
+    EXPECT_TRUE(datalogger.config_valid());
+    EXPECT_FALSE(datalogger.double_buffering());
+}
+
+TEST_F(TestExternalStorage, ConfiguredThroughMainHandler)
+{
+    Config dlconfig_handler;
+    dlconfig_handler.set_buffers(_rx_buffer, sizeof(_rx_buffer), _tx_buffer, sizeof(_tx_buffer));
+    EXPECT_FALSE(dlconfig_handler.is_datalogging_configured());
+    dlconfig_handler.set_datalogging_external_storage(file_storage_write, file_storage_read, 1000, cache, sizeof(cache));
+    EXPECT_TRUE(dlconfig_handler.is_datalogging_configured());
+
+    MainHandler handler;
+    handler.init(&dlconfig_handler);
+    EXPECT_TRUE(handler.datalogger()->get_encoder()->external_storage());
+
+    unsigned char buffer[32];
+    dlconfig_handler.set_datalogging_buffers(buffer, sizeof(buffer));
+    EXPECT_TRUE(dlconfig_handler.is_datalogging_configured());
+    handler.init(&dlconfig_handler);
+    EXPECT_FALSE(handler.datalogger()->get_encoder()->external_storage());
+}
+
+#endif
@@ -33,6 +33,35 @@ static bool rpv_read_callback_always_fail(scrutiny::RuntimePublishedValue rpv, s
     return false;
 }
 
+static uint16_t reduced_rpv_value = 0;
+static bool rpv_read_callback_reduced(scrutiny::RuntimePublishedValue rpv, scrutiny::AnyType *outval, scrutiny::LoopHandler *const caller)
+{
+    static_cast<void>(caller);
+    if (rpv.id != 0x1234 || rpv.type != scrutiny::VariableType::uint16)
+    {
+        return false;
+    }
+    outval->uint16 = reduced_rpv_value;
+    return true;
+}
+
+static unsigned int bulk_read_call_count = 0;
+static bool rpv_bulk_read_callback(
+    scrutiny::RuntimePublishedValue const *rpvs,
+    scrutiny::AnyType *outvals,
+    uint16_t const count,
+    scrutiny::LoopHandler *const caller)
+{
+    static_cast<void>(caller);
+    bulk_read_call_count++;
+    for (uint16_t i = 0; i < count; i++)
+    {
+        outvals[i].uint32 = 0;
+        outvals[i].uint16 = static_cast<uint16_t>(rpvs[i].id + 1);
+    }
+    return true;
+}
+
 class TestRawEncoder : public ScrutinyTest
 {
   protected:
@@ -204,6 +233,52 @@ TEST_F(TestRawEncoder, RpvCallbackFailureZerosEntry)
     CHECK_CANARIES;
 }
 
+TEST_F(TestRawEncoder, RpvBulkRead)
+{
+    Timebase timebase;
+    unsigned char compare_buf[2 + 4 + 2];
+    unsigned char dst_buffer[sizeof(compare_buf)];
+    uint32_t var1 = 0x12345678;
+    RuntimePublishedValue rpvs[2];
+    rpvs[0].id = 0x1000;
+    rpvs[0].type = VariableType::uint16;
+    rpvs[1].id = 0x2000;
+    rpvs[1].type = VariableType::uint16;
+
+    // No single read callback. Every Rpv of the entry must be read in a single call.
+    config.set_published_values(rpvs, 2);
+    config.set_rpv_bulk_read_callback(rpv_bulk_read_callback);
+    scrutiny_handler.init(&config);
+
+    dlconfig.items_count = 3;
+    dlconfig.items_to_log[0].common.type = datalogging::LoggableType::Rpv;
+    dlconfig.items_to_log[0].rpv.id = 0x2000;
+    dlconfig.items_to_log[1].common.type = datalogging::LoggableType::Memory;
+    dlconfig.items_to_log[1].memory.size = sizeof(var1);
+    dlconfig.items_to_log[1].memory.address = &var1;
+    dlconfig.items_to_log[2].common.type = datalogging::LoggableType::Rpv;
+    dlconfig.items_to_log[2].rpv.id = 0x1000;
+
+    encoder.init(&scrutiny_handler, &dlconfig, dlbuffer.data, sizeof(dlbuffer.data));
+    encoder.set_timebase(&timebase);
+    ASSERT_FALSE(encoder.error());
+
+    bulk_read_call_count = 0;
+    encoder.encode_next_entry(SCRUTINY_NULL);
+    EXPECT_EQ(bulk_read_call_count, 1u);
+
+    scrutiny::codecs::encode_16_bits_big_endian_8bits(static_cast<uint16_t>(0x2001), &compare_buf[0]);
+    scrutiny::tools::memcpy_dilate_8bits_native(&compare_buf[2], &var1, 4);
+    scrutiny::codecs::encode_16_bits_big_endian_8bits(static_cast<uint16_t>(0x1001), &compare_buf[6]);
+
+    datalogging::RawFormatReader *reader = encoder.get_reader();
+    reader->reset();
+    ASSERT_EQ(reader->get_total_size_8bits(), sizeof(compare_buf));
+    reader->read_dilate_8bits(dst_buffer, sizeof(dst_buffer));
+    EXPECT_BUF_EQ(dst_buffer, compare_buf, sizeof(compare_buf));
+    CHECK_CANARIES;
+}
+
 TEST_F(TestRawEncoder, BufferTooSmallForSingleEntry)
 {
     uint32_t var1 = 0x12345678;
@@ -224,4 +299,449 @@ TEST_F(TestRawEncoder, BufferTooSmallForSingleEntry)
     EXPECT_TRUE(encoder.error());
 }
 
+TEST_F(TestRawEncoder, ImplicitTimeAxis)
+{
+    Timebase timebase;
+    uint32_t var;
+    SCRUTINY_CONSTEXPR timediff_t timestep = 10;
+
+    dlconfig.items_count = 2;
+    dlconfig.items_to_log[0].common.type = datalogging::LoggableType::Memory;
+    dlconfig.items_to_log[0].memory.size = sizeof(var);
+    dlconfig.items_to_log[0].memory.address = &var;
+    dlconfig.items_to_log[1].common.type = datalogging::LoggableType::ImplicitTime;
+
+    encoder.init(&scrutiny_handler, &dlconfig, dlbuffer.data, sizeof(dlbuffer.data));
+    encoder.set_timebase(&timebase);
+    timebase.reset();
+    ASSERT_FALSE(encoder.error());
+    EXPECT_TRUE(encoder.implicit_time());
+    EXPECT_EQ(encoder.get_time_checkpoint_count(), 0u);
+
+    var = 0;
+    encoder.encode_next_entry(SCRUTINY_NULL);
+    ASSERT_EQ(encoder.get_time_checkpoint_count(), 1u);
+    EXPECT_EQ(encoder.get_time_checkpoint(0).entry_counter, 0u);
+    EXPECT_EQ(encoder.get_time_checkpoint(0).timestamp, 0u);
+
+    // No space taken by the time axis.
+    uint32_t const max_entries = sizeof(dlbuffer.data) / sizeof(var);
+    for (uint32_t i = 1; i < max_entries + max_entries / 2; i++)
+    {
+        timebase.step(timestep);
+        var = i;
+        encoder.encode_next_entry(SCRUTINY_NULL);
+    }
+
+    EXPECT_EQ(encoder.get_entry_count(), max_entries);
+    EXPECT_EQ(encoder.get_reader()->get_total_size_char(), max_entries * sizeof(var));
+    uint32_t const first_entry_counter = encoder.get_first_entry_counter();
+    EXPECT_EQ(first_entry_counter, max_entries / 2);
+
+    uint_least8_t const checkpoint_count = encoder.get_time_checkpoint_count();
+    ASSERT_GE(checkpoint_count, 2u);
+    ASSERT_LE(checkpoint_count, SCRUTINY_DATALOGGING_TIME_CHECKPOINTS);
+    for (uint_least8_t i = 0; i < checkpoint_count; i++)
+    {
+        datalogging::TimeCheckpoint const checkpoint = encoder.get_time_checkpoint(i);
+        EXPECT_GE(checkpoint.entry_counter, first_entry_counter);
+        EXPECT_LT(checkpoint.entry_counter, first_entry_counter + max_entries);
+        EXPECT_EQ(checkpoint.timestamp, checkpoint.entry_counter * timestep);
+        if (i > 0)
+        {
+            EXPECT_GT(checkpoint.entry_counter, encoder.get_time_checkpoint(i - 1).entry_counter);
+        }
+    }
+
+    // First entry in the buffer must be the one identified by first_entry_counter
+    unsigned char dst_buffer[sizeof(var) * (CHAR_BIT / 8)];
+    datalogging::RawFormatReader *reader = encoder.get_reader();
+    reader->reset();
+    ASSERT_EQ(reader->read_dilate_8bits(dst_buffer, sizeof(dst_buffer)), sizeof(dst_buffer));
+    unsigned char expected[sizeof(var) * (CHAR_BIT / 8)];
+    var = first_entry_counter;
+    scrutiny::tools::memcpy_dilate_8bits_native(expected, &var, sizeof(expected));
+    EXPECT_BUF_EQ(dst_buffer, expected, sizeof(expected));
+    CHECK_CANARIES;
+}
+
+TEST_F(TestRawEncoder, ImplicitTimeOnlyIsError)
+{
+    dlconfig.items_count = 1;
+    dlconfig.items_to_log[0].common.type = datalogging::LoggableType::ImplicitTime;
+
+    // Nothing to store in an entry.
+    encoder.init(&scrutiny_handler, &dlconfig, dlbuffer.data, sizeof(dlbuffer.data));
+    EXPECT_TRUE(encoder.error());
+}
+
+TEST_F(TestRawEncoder, PerItemDecimation)
+{
+    Timebase timebase;
+    uint32_t fast_var;
+    uint16_t slow_var;
+    SCRUTINY_CONSTEXPR uint16_t slow_decimation = 4;
+
+    dlconfig.items_count = 2;
+    dlconfig.items_to_log[0].common.type = datalogging::LoggableType::Memory;
+    dlconfig.items_to_log[0].memory.size = sizeof(fast_var);
+    dlconfig.items_to_log[0].memory.address = &fast_var;
+    dlconfig.items_to_log[1].common.type = datalogging::LoggableType::Memory;
+    dlconfig.items_to_log[1].memory.size = sizeof(slow_var);
+    dlconfig.items_to_log[1].memory.address = &slow_var;
+    dlconfig.items_options[1].decimation = slow_decimation;
+
+    encoder.init(&scrutiny_handler, &dlconfig, dlbuffer.data, sizeof(dlbuffer.data));
+    encoder.set_timebase(&timebase);
+    ASSERT_FALSE(encoder.error());
+    ASSERT_TRUE(encoder.variable_entries());
+    uint_least8_t const bitmap_size = encoder.get_presence_bitmap_size();
+    ASSERT_GT(bitmap_size, 0u);
+
+    // Log enough to wrap the buffer a few times.
+    uint32_t const entry_count = 3 * sizeof(dlbuffer.data) / sizeof(fast_var);
+    for (uint32_t i = 0; i < entry_count; i++)
+    {
+        fast_var = i;
+        slow_var = static_cast<uint16_t>(i);
+        encoder.encode_next_entry(SCRUTINY_NULL);
+    }
+    CHECK_CANARIES;
+    ASSERT_TRUE(encoder.buffer_full());
+
+    // Read all the data and walk through each entry using the presence bitmap.
+    static unsigned char data[sizeof(dlbuffer.data) * (CHAR_BIT / 8)];
+    datalogging::RawFormatReader *reader = encoder.get_reader();
+    reader->reset();
+    uint32_t const total_size_8bits = reader->get_total_size_8bits();
+    ASSERT_LE(total_size_8bits, sizeof(data));
+    ASSERT_EQ(reader->read_dilate_8bits(data, sizeof(data)), total_size_8bits);
+    EXPECT_TRUE(reader->finished());
+
+    uint32_t cursor = 0;
+    uint32_t parsed_entries = 0;
+    uint32_t expected_value = entry_count - encoder.get_entry_count();
+    while (cursor < total_size_8bits)
+    {
+        bool const fast_present = (data[cursor] & 0x80) != 0;
+        bool const slow_present = (data[cursor] & 0x40) != 0;
+        cursor += bitmap_size * (CHAR_BIT / 8);
+
+        EXPECT_TRUE(fast_present);
+        EXPECT_EQ(slow_present, (expected_value % slow_decimation) == 0) << "entry=" << expected_value;
+        if (fast_present)
+        {
+            uint32_t v;
+            scrutiny::tools::memcpy_compress_from_8bits_native(&v, &data[cursor], sizeof(v) * (CHAR_BIT / 8));
+            EXPECT_EQ(v, expected_value);
+            cursor += sizeof(fast_var) * (CHAR_BIT / 8);
+        }
+        if (slow_present)
+        {
+            uint16_t v;
+            scrutiny::tools::memcpy_compress_from_8bits_native(&v, &data[cursor], sizeof(v) * (CHAR_BIT / 8));
+            EXPECT_EQ(v, static_cast<uint16_t>(expected_value));
+            cursor += sizeof(slow_var) * (CHAR_BIT / 8);
+        }
+        expected_value++;
+        parsed_entries++;
+    }
+
+    EXPECT_EQ(cursor, total_size_8bits);
+    EXPECT_EQ(parsed_entries, encoder.get_entry_count());
+    EXPECT_EQ(expected_value, entry_count);
+
+    // Decimated items leave room for more entries than a fixed layout would.
+    uint32_t const fixed_layout_max_entries = sizeof(dlbuffer.data) / (bitmap_size + sizeof(fast_var) + sizeof(slow_var));
+    EXPECT_GT(encoder.get_entry_count(), fixed_layout_max_entries);
+}
+
+TEST_F(TestRawEncoder, PackedBits)
+{
+    Timebase timebase;
+    uint32_t word_var;
+    uint8_t flags[10];
+    int16_t bitfield_var;
+
+    dlconfig.items_count = 12;
+    for (unsigned int i = 0; i < sizeof(flags); i++)
+    {
+        dlconfig.items_to_log[i].common.type = datalogging::LoggableType::MemoryBit;
+        dlconfig.items_to_log[i].memorybit.address = &flags[i];
+        dlconfig.items_to_log[i].memorybit.datatype = VariableType::boolean8;
+        dlconfig.items_to_log[i].memorybit.bitoffset = 0;
+        dlconfig.items_to_log[i].memorybit.bitsize = 1;
+    }
+    // Signed 3 bits field in bits 4-6. Bits around must not leak.
+    dlconfig.items_to_log[10].common.type = datalogging::LoggableType::MemoryBit;
+    dlconfig.items_to_log[10].memorybit.address = &bitfield_var;
+    dlconfig.items_to_log[10].memorybit.datatype = VariableType::sint16;
+    dlconfig.items_to_log[10].memorybit.bitoffset = 4;
+    dlconfig.items_to_log[10].memorybit.bitsize = 3;
+    dlconfig.items_to_log[11].common.type = datalogging::LoggableType::Memory;
+    dlconfig.items_to_log[11].memory.address = &word_var;
+    dlconfig.items_to_log[11].memory.size = sizeof(word_var);
+
+    encoder.init(&scrutiny_handler, &dlconfig, dlbuffer.data, sizeof(dlbuffer.data));
+    encoder.set_timebase(&timebase);
+    ASSERT_FALSE(encoder.error());
+    ASSERT_TRUE(encoder.packed_bits());
+
+    // 13 bits takes 2 bytes instead of 10 + 2.
+    uint32_t const entry_size_char = sizeof(word_var) + datalogging::RawFormatEncoder::get_packed_bits_size_char(13);
+
+    memset(flags, 0, sizeof(flags));
+    flags[0] = 1;
+    flags[3] = 1;
+    flags[9] = 1;
+    bitfield_var = static_cast<int16_t>(0xFF8F | (5 << 4)); // 0b101
+    word_var = 0x12345678;
+    encoder.encode_next_entry(SCRUTINY_NULL);
+
+    memset(flags, 1, sizeof(flags));
+    flags[1] = 0;
+    bitfield_var = static_cast<int16_t>(2 << 4); // 0b010
+    word_var = 0xAABBCCDD;
+    encoder.encode_next_entry(SCRUTINY_NULL);
+    CHECK_CANARIES;
+
+    static unsigned char data[sizeof(dlbuffer.data) * (CHAR_BIT / 8)];
+    datalogging::RawFormatReader *reader = encoder.get_reader();
+    reader->reset();
+    ASSERT_EQ(encoder.get_entry_count(), 2u);
+    ASSERT_EQ(reader->get_total_size_char(), 2 * entry_size_char);
+    ASSERT_EQ(reader->read_dilate_8bits(data, sizeof(data)), 2 * entry_size_char * (CHAR_BIT / 8));
+
+    uint32_t word;
+    scrutiny::tools::memcpy_compress_from_8bits_native(&word, &data[0], sizeof(word) * (CHAR_BIT / 8));
+    EXPECT_EQ(word, 0x12345678u);
+    // Flags : 1001000001, bitfield : 101, padding 000
+    EXPECT_EQ(data[sizeof(word) * (CHAR_BIT / 8)], 0x90);
+    EXPECT_EQ(data[sizeof(word) * (CHAR_BIT / 8) + 1], 0x68);
+
+    scrutiny::tools::memcpy_compress_from_8bits_native(&word, &data[entry_size_char * (CHAR_BIT / 8)], sizeof(word) * (CHAR_BIT / 8));
+    EXPECT_EQ(word, 0xAABBCCDDu);
+    // Flags : 1011111111, bitfield : 010, padding 000
+    EXPECT_EQ(data[entry_size_char * (CHAR_BIT / 8) + sizeof(word) * (CHAR_BIT / 8)], 0xBF);
+    EXPECT_EQ(data[entry_size_char * (CHAR_BIT / 8) + sizeof(word) * (CHAR_BIT / 8) + 1], 0xD0);
+}
+
+TEST_F(TestRawEncoder, ItemReduction)
+{
+    Timebase timebase;
+    int16_t mean_var;
+    float minmax_var;
+    RuntimePublishedValue rpvs[1];
+    rpvs[0].id = 0x1234;
+    rpvs[0].type = VariableType::uint16;
+    config.set_published_values(rpvs, 1, rpv_read_callback_reduced);
+    scrutiny_handler.init(&config);
+
+    dlconfig.items_count = 3;
+    dlconfig.items_to_log[0].common.type = datalogging::LoggableType::Memory;
+    dlconfig.items_to_log[0].memory.size = sizeof(mean_var);
+    dlconfig.items_to_log[0].memory.address = &mean_var;
+    dlconfig.items_options[0].reduction = datalogging::ReductionMode::Mean;
+    dlconfig.items_options[0].datatype = VariableType::sint16;
+    dlconfig.items_to_log[1].common.type = datalogging::LoggableType::Memory;
+    dlconfig.items_to_log[1].memory.size = sizeof(minmax_var);
+    dlconfig.items_to_log[1].memory.address = &minmax_var;
+    dlconfig.items_options[1].reduction = datalogging::ReductionMode::MinMax;
+    dlconfig.items_options[1].datatype = VariableType::float32;
+    dlconfig.items_to_log[2].common.type = datalogging::LoggableType::Rpv;
+    dlconfig.items_to_log[2].rpv.id = 0x1234;
+    dlconfig.items_options[2].reduction = datalogging::ReductionMode::Mean;
+
+    encoder.init(&scrutiny_handler, &dlconfig, dlbuffer.data, sizeof(dlbuffer.data));
+    encoder.set_timebase(&timebase);
+    ASSERT_FALSE(encoder.error());
+    ASSERT_TRUE(encoder.reductions_enabled());
+
+    // Window of 4 samples
+    int16_t const mean_samples[4] = { -3, -1, 2, 5 }; // Mean = 0.75
+    float const minmax_samples[4] = { 1.5f, -2.0f, 7.25f, 0.0f };
+    uint16_t const rpv_samples[4] = { 10, 11, 12, 13 }; // Mean = 11.5
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        mean_var = mean_samples[i];
+        minmax_var = minmax_samples[i];
+        reduced_rpv_value = rpv_samples[i];
+        encoder.accumulate(SCRUTINY_NULL);
+    }
+    encoder.encode_next_entry(SCRUTINY_NULL);
+
+    // Window of a single sample
+    mean_var = -7;
+    minmax_var = 3.0f;
+    reduced_rpv_value = 100;
+    encoder.accumulate(SCRUTINY_NULL);
+    mean_var = 1000; // Not accumulated. Must not be logged
+    encoder.encode_next_entry(SCRUTINY_NULL);
+
+    // No call to accumulate(). The current value is logged.
+    mean_var = 42;
+    minmax_var = -1.0f;
+    reduced_rpv_value = 200;
+    encoder.encode_next_entry(SCRUTINY_NULL);
+    CHECK_CANARIES;
+
+    SCRUTINY_CONSTEXPR uint32_t entry_size = sizeof(int16_t) + 2 * sizeof(float) + sizeof(uint16_t);
+    static unsigned char data[sizeof(dlbuffer.data) * (CHAR_BIT / 8)];
+    datalogging::RawFormatReader *reader = encoder.get_reader();
+    reader->reset();
+    ASSERT_EQ(encoder.get_entry_count(), 3u);
+    ASSERT_EQ(reader->get_total_size_char(), 3 * entry_size);
+    ASSERT_EQ(reader->read_dilate_8bits(data, sizeof(data)), 3 * entry_size * (CHAR_BIT / 8));
+
+    int16_t const expected_means[3] = { 1, -7, 42 };
+    float const expected_mins[3] = { -2.0f, 3.0f, -1.0f };
+    float const expected_maxs[3] = { 7.25f, 3.0f, -1.0f };
+    uint16_t const expected_rpv_means[3] = { 12, 100, 200 };
+    uint32_t cursor = 0;
+    for (unsigned int i = 0; i < 3; i++)
+    {
+        int16_t mean;
+        float min;
+        float max;
+        scrutiny::tools::memcpy_compress_from_8bits_native(&mean, &data[cursor], sizeof(mean) * (CHAR_BIT / 8));
+        cursor += sizeof(mean) * (CHAR_BIT / 8);
+        scrutiny::tools::memcpy_compress_from_8bits_native(&min, &data[cursor], sizeof(min) * (CHAR_BIT / 8));
+        cursor += sizeof(min) * (CHAR_BIT / 8);
+        scrutiny::tools::memcpy_compress_from_8bits_native(&max, &data[cursor], sizeof(max) * (CHAR_BIT / 8));
+        cursor += sizeof(max) * (CHAR_BIT / 8);
+        uint16_t const rpv_mean = codecs::decode_16_bits_big_endian_8bits(&data[cursor]);
+        cursor += 2;
+
+        EXPECT_EQ(mean, expected_means[i]) << "entry=" << i;
+        EXPECT_EQ(min, expected_mins[i]) << "entry=" << i;
+        EXPECT_EQ(max, expected_maxs[i]) << "entry=" << i;
+        EXPECT_EQ(rpv_mean, expected_rpv_means[i]) << "entry=" << i;
+    }
+}
+
+static float converted_rpv_value = 0;
+static bool rpv_read_callback_converted(scrutiny::RuntimePublishedValue rpv, scrutiny::AnyType *outval, scrutiny::LoopHandler *const caller)
+{
+    static_cast<void>(caller);
+    if (rpv.id != 0x1234 || rpv.type != scrutiny::VariableType::float32)
+    {
+        return false;
+    }
+    outval->float32 = converted_rpv_value;
+    return true;
+}
+
+TEST_F(TestRawEncoder, StorageFormat)
+{
+    Timebase timebase;
+    float half_var;
+    float minmax_var;
+    RuntimePublishedValue rpvs[1];
+    rpvs[0].id = 0x1234;
+    rpvs[0].type = VariableType::float32;
+    config.set_published_values(rpvs, 1, rpv_read_callback_converted);
+    scrutiny_handler.init(&config);
+
+    dlconfig.items_count = 3;
+    dlconfig.items_to_log[0].common.type = datalogging::LoggableType::Memory;
+    dlconfig.items_to_log[0].memory.size = sizeof(half_var);
+    dlconfig.items_to_log[0].memory.address = &half_var;
+    dlconfig.items_options[0].storage = datalogging::StorageFormat::Float16;
+    dlconfig.items_options[0].datatype = VariableType::float32;
+    dlconfig.items_to_log[1].common.type = datalogging::LoggableType::Rpv;
+    dlconfig.items_to_log[1].rpv.id = 0x1234;
+    dlconfig.items_options[1].storage = datalogging::StorageFormat::ScaledInt16;
+    dlconfig.items_options[1].scale = 0.01f;
+    dlconfig.items_options[1].offset = 100.0f;
+    dlconfig.items_to_log[2].common.type = datalogging::LoggableType::Memory;
+    dlconfig.items_to_log[2].memory.size = sizeof(minmax_var);
+    dlconfig.items_to_log[2].memory.address = &minmax_var;
+    dlconfig.items_options[2].storage = datalogging::StorageFormat::Float16;
+    dlconfig.items_options[2].reduction = datalogging::ReductionMode::MinMax;
+    dlconfig.items_options[2].datatype = VariableType::float32;
+
+    encoder.init(&scrutiny_handler, &dlconfig, dlbuffer.data, sizeof(dlbuffer.data));
+    encoder.set_timebase(&timebase);
+    ASSERT_FALSE(encoder.error());
+    ASSERT_TRUE(encoder.converted_items());
+
+    half_var = 1.0f;
+    converted_rpv_value = 101.5f; // (101.5 - 100) / 0.01 = 150
+    minmax_var = -2.0f;
+    encoder.accumulate(SCRUTINY_NULL);
+    minmax_var = 0.5f;
+    encoder.accumulate(SCRUTINY_NULL);
+    encoder.encode_next_entry(SCRUTINY_NULL);
+
+    half_var = 65504.0f;
+    converted_rpv_value = -400.0f; // Saturates to -32768
+    minmax_var = 3.1415926f;
+    encoder.encode_next_entry(SCRUTINY_NULL);
+    CHECK_CANARIES;
+
+    // Every item takes 16 bits. MinMax takes twice that.
+    SCRUTINY_CONSTEXPR uint32_t entry_size_8bits = 2 + 2 + 4;
+    static unsigned char data[sizeof(dlbuffer.data) * (CHAR_BIT / 8)];
+    datalogging::RawFormatReader *reader = encoder.get_reader();
+    reader->reset();
+    ASSERT_EQ(encoder.get_entry_count(), 2u);
+    ASSERT_EQ(reader->get_total_size_8bits(), 2 * entry_size_8bits);
+    ASSERT_EQ(reader->read_dilate_8bits(data, sizeof(data)), 2 * entry_size_8bits);
+
+    uint16_t const expected_halfs[2] = { 0x3C00, 0x7BFF };
+    int16_t const expected_scaled[2] = { 150, -32768 };
+    uint16_t const expected_mins[2] = { 0xC000, 0x4248 };
+    uint16_t const expected_maxs[2] = { 0x3800, 0x4248 };
+    for (unsigned int i = 0; i < 2; i++)
+    {
+        unsigned char const *entry = &data[i * entry_size_8bits];
+        uint16_t half;
+        uint16_t min;
+        uint16_t max;
+        scrutiny::tools::memcpy_compress_from_8bits_native(&half, &entry[0], sizeof(half) * (CHAR_BIT / 8));
+        int16_t const scaled = static_cast<int16_t>(codecs::decode_16_bits_big_endian_8bits(&entry[2])); // Rpv are big endian
+        scrutiny::tools::memcpy_compress_from_8bits_native(&min, &entry[4], sizeof(min) * (CHAR_BIT / 8));
+        scrutiny::tools::memcpy_compress_from_8bits_native(&max, &entry[6], sizeof(max) * (CHAR_BIT / 8));
+
+        EXPECT_EQ(half, expected_halfs[i]) << "entry=" << i;
+        EXPECT_EQ(scaled, expected_scaled[i]) << "entry=" << i;
+        EXPECT_EQ(min, expected_mins[i]) << "entry=" << i;
+        EXPECT_EQ(max, expected_maxs[i]) << "entry=" << i;
+    }
+}
+
+TEST_F(TestRawEncoder, StorageFormatOnIntegerIsError)
+{
+    Timebase timebase;
+    uint32_t var;
+
+    dlconfig.items_count = 1;
+    dlconfig.items_to_log[0].common.type = datalogging::LoggableType::Memory;
+    dlconfig.items_to_log[0].memory.size = sizeof(var);
+    dlconfig.items_to_log[0].memory.address = &var;
+    dlconfig.items_options[0].storage = datalogging::StorageFormat::Float16;
+    dlconfig.items_options[0].datatype = VariableType::uint32;
+
+    encoder.init(&scrutiny_handler, &dlconfig, dlbuffer.data, sizeof(dlbuffer.data));
+    encoder.set_timebase(&timebase);
+    EXPECT_TRUE(encoder.error());
+}
+
+TEST_F(TestRawEncoder, ItemReductionSizeMismatchIsError)
+{
+    Timebase timebase;
+    uint32_t var;
+
+    dlconfig.items_count = 1;
+    dlconfig.items_to_log[0].common.type = datalogging::LoggableType::Memory;
+    dlconfig.items_to_log[0].memory.size = sizeof(var);
+    dlconfig.items_to_log[0].memory.address = &var;
+    dlconfig.items_options[0].reduction = datalogging::ReductionMode::MinMax;
+    dlconfig.items_options[0].datatype = VariableType::uint16;
+
+    encoder.init(&scrutiny_handler, &dlconfig, dlbuffer.data, sizeof(dlbuffer.data));
+    encoder.set_timebase(&timebase);
+    EXPECT_TRUE(encoder.error());
+}
+
 #endif
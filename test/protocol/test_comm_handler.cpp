@@ -134,3 +134,280 @@ TEST_F(TestCommHandler, TestConnectDisconnectBehaviour)
     comm.receive_data(&dummy_request[sizeof(dummy_request) - 1], 1);
     EXPECT_FALSE(comm.request_received());
 }
+
+TEST_F(TestCommHandler, TestTransmissionPacedByMaxBitrate)
+{
+    unsigned char buf[256];
+    SCRUTINY_CONSTEXPR uint16_t response_size = sizeof(_tx_buffer) + 9;
+    SCRUTINY_CONSTEXPR uint16_t bucket_size = 50; // 5ms at 10000 bytes/sec
+    comm.set_max_bitrate(80000);                  // 10000 bytes/sec. One byte each 1000 x 100ns
+
+    response.command_id = 0x81;
+    response.subfunction_id = 0x02;
+    response.response_code = 0;
+    response.data_length = sizeof(_tx_buffer);
+    std::memset(response.data, 0x55, response.data_length);
+    add_crc(&response);
+
+    // Starts with a full bucket, smaller than a response
+    ASSERT_TRUE(comm.send_response(&response));
+    EXPECT_EQ(comm.data_to_send(), bucket_size);
+    EXPECT_EQ(comm.pop_data(buf, sizeof(buf)), bucket_size);
+    EXPECT_EQ(comm.data_to_send(), 0u);
+    EXPECT_EQ(comm.pop_data(buf, sizeof(buf)), 0u);
+    EXPECT_TRUE(comm.transmitting());
+
+    tb.step(999);
+    EXPECT_EQ(comm.data_to_send(), 0u);
+    tb.step(1);
+    EXPECT_EQ(comm.data_to_send(), 1u);
+    tb.step(9500);
+    EXPECT_EQ(comm.data_to_send(), 10u);
+    EXPECT_EQ(comm.pop_data(buf, sizeof(buf)), 10u);
+    tb.step(500); // The fraction of byte earned before the last read is kept
+    comm.process();
+    EXPECT_EQ(comm.data_to_send(), 1u);
+    EXPECT_EQ(comm.pop_data(buf, sizeof(buf)), 1u);
+
+    // The bucket never holds more than a burst
+    tb.step(0xFFFFFFF);
+    comm.process();
+    EXPECT_EQ(comm.data_to_send(), bucket_size);
+    EXPECT_EQ(comm.pop_data(buf, sizeof(buf)), bucket_size);
+    tb.step(0xFFFFFFF);
+    comm.process();
+    EXPECT_EQ(comm.data_to_send(), response_size - 2 * bucket_size - 11u); // Remaining of the response
+    EXPECT_EQ(comm.pop_data(buf, sizeof(buf)), response_size - 2 * bucket_size - 11u);
+    EXPECT_FALSE(comm.transmitting());
+
+    // At low bitrates, the bucket keeps a minimum size
+    comm.set_max_bitrate(8000);
+    ASSERT_TRUE(comm.send_response(&response));
+    EXPECT_EQ(comm.data_to_send(), scrutiny::protocol::TX_BUCKET_MIN_SIZE);
+    EXPECT_EQ(comm.pop_data(buf, sizeof(buf)), scrutiny::protocol::TX_BUCKET_MIN_SIZE);
+
+    // No pacing
+    comm.set_max_bitrate(0);
+    EXPECT_EQ(comm.data_to_send(), response_size - scrutiny::protocol::TX_BUCKET_MIN_SIZE);
+    EXPECT_EQ(comm.pop_data(buf, sizeof(buf)), response_size - scrutiny::protocol::TX_BUCKET_MIN_SIZE);
+}
+
+TEST_F(TestCommHandler, TestPacingBurstLimitedToSessionFrame)
+{
+    unsigned char jumbo_buffer[256];
+    unsigned char buf[256];
+    SCRUTINY_CONSTEXPR uint16_t response_size = sizeof(_tx_buffer) + 9;
+    comm.set_jumbo_tx_buffer(jumbo_buffer, sizeof(jumbo_buffer)); // Offered, but not negotiated
+    comm.set_max_bitrate(8000000);                                // A 5ms burst is bigger than any frame
+
+    response.command_id = 0x81;
+    response.subfunction_id = 0x02;
+    response.response_code = 0;
+    response.data_length = sizeof(_tx_buffer);
+    std::memset(response.data, 0x55, response.data_length);
+    add_crc(&response);
+
+    tb.step(0xFFFFFFF);
+    comm.process();
+    ASSERT_TRUE(comm.send_response(&response));
+    EXPECT_EQ(comm.pop_data(buf, sizeof(buf)), response_size);
+    ASSERT_TRUE(comm.send_response(&response));
+    EXPECT_EQ(comm.data_to_send(), 0u); // The bucket held a single regular frame, not a jumbo one
+    tb.step(10);
+    EXPECT_EQ(comm.data_to_send(), 1u);
+}
+
+TEST_F(TestCommHandler, TestJumboResponse)
+{
+    unsigned char jumbo_buffer[256];
+    unsigned char buf[256 + scrutiny::protocol::JUMBO_RESPONSE_OVERHEAD];
+
+    // Useless unless bigger than the transmission buffer
+    comm.set_jumbo_tx_buffer(jumbo_buffer, sizeof(_tx_buffer));
+    EXPECT_EQ(comm.jumbo_tx_buffer_size(), 0u);
+    comm.set_jumbo_tx_buffer(jumbo_buffer, sizeof(jumbo_buffer));
+    EXPECT_EQ(comm.jumbo_tx_buffer_size(), sizeof(jumbo_buffer));
+
+    // Applies from the request that follows the connection
+    comm.connect();
+    comm.set_session_flags(scrutiny::protocol::CommControl::ConnectFlags::JumboFrames);
+    EXPECT_EQ(comm.response_max_length(), sizeof(_tx_buffer));
+    comm.wait_next_request();
+    ASSERT_EQ(comm.response_max_length(), sizeof(jumbo_buffer));
+
+    scrutiny::protocol::Response *const jumbo_response = comm.prepare_response();
+    ASSERT_EQ(jumbo_response->data, jumbo_buffer);
+    ASSERT_EQ(jumbo_response->data_max_length, sizeof(jumbo_buffer));
+    jumbo_response->command_id = 1;
+    jumbo_response->subfunction_id = 2;
+    jumbo_response->response_code = 0;
+    jumbo_response->data_length = 200;
+    for (unsigned int i = 0; i < 200; i++)
+    {
+        jumbo_buffer[i] = static_cast<unsigned char>(i);
+    }
+    ASSERT_TRUE(comm.send_response(jumbo_response));
+
+    unsigned char expected_data[7 + 200 + 4] = { 0x81, 2, 0, 0, 0, 0, 200 };
+    memcpy(&expected_data[7], jumbo_buffer, 200);
+    add_crc(expected_data, sizeof(expected_data) - 4);
+    ASSERT_EQ(comm.data_to_send(), sizeof(expected_data));
+    EXPECT_EQ(comm.pop_data(buf, 3), 3u); // Across the header
+    EXPECT_EQ(comm.pop_data(&buf[3], sizeof(buf) - 3), sizeof(expected_data) - 3);
+    EXPECT_BUF_EQ(buf, expected_data, sizeof(expected_data));
+    EXPECT_FALSE(comm.transmitting());
+
+    // Back to regular frames with the next session
+    comm.disconnect();
+    comm.connect();
+    EXPECT_EQ(comm.response_max_length(), sizeof(_tx_buffer));
+    EXPECT_EQ(comm.prepare_response()->data, _tx_buffer);
+}
+
+TEST_F(TestCommHandler, TestFramedRequestAndResponse)
+{
+    // Framing applies from the request that follows the connection
+    comm.connect();
+    comm.set_session_flags(scrutiny::protocol::CommControl::ConnectFlags::Framing);
+    EXPECT_TRUE(comm.framing());
+    comm.wait_next_request();
+
+    // Zeros in the header, the payload and possibly the CRC are stuffed
+    unsigned char request[8 + 4] = { 3, 1, 0, 4, 0x11, 0, 0, 0x22 };
+    add_crc(request, sizeof(request) - 4);
+    unsigned char framed_request[sizeof(request) + 2];
+    uint16_t const framed_request_size = cobs_encode(request, sizeof(request), framed_request);
+    EXPECT_EQ(std::memchr(framed_request, 0, framed_request_size - 1u), static_cast<void *>(SCRUTINY_NULL));
+
+    // Byte per byte, to cross every decoder state
+    for (uint16_t i = 0; i < framed_request_size; i++)
+    {
+        comm.receive_data(&framed_request[i], 1);
+    }
+    ASSERT_TRUE(comm.request_received());
+    scrutiny::protocol::Request const *req = comm.get_request();
+    EXPECT_EQ(req->command_id, 3u);
+    EXPECT_EQ(req->subfunction_id, 1u);
+    ASSERT_EQ(req->data_length, 4u);
+    EXPECT_BUF_EQ(req->data, &request[4], 4);
+
+    response.command_id = 3;
+    response.subfunction_id = 1;
+    response.response_code = 0;
+    response.data_length = 4;
+    std::memcpy(response.data, &request[4], 4);
+    ASSERT_TRUE(comm.send_response(&response));
+
+    unsigned char expected_response[9 + 4] = { 0x83, 1, 0, 0, 4, 0x11, 0, 0, 0x22 };
+    add_crc(expected_response, sizeof(expected_response) - 4);
+    unsigned char expected_framed_response[sizeof(expected_response) + 2];
+    uint16_t const expected_framed_size = cobs_encode(expected_response, sizeof(expected_response), expected_framed_response);
+
+    unsigned char buf[64];
+    uint16_t const n_to_read = comm.data_to_send();
+    ASSERT_EQ(n_to_read, expected_framed_size);
+    for (uint16_t i = 0; i < n_to_read; i++)
+    {
+        ASSERT_EQ(comm.pop_data(&buf[i], 1), 1u);
+    }
+    EXPECT_FALSE(comm.transmitting());
+    EXPECT_BUF_EQ(buf, expected_framed_response, expected_framed_size);
+}
+
+TEST_F(TestCommHandler, TestFramedLongBlocks)
+{
+    // Payloads longer than a COBS block, with and without zeros on the block boundaries
+    static unsigned char rx_buffer[600];
+    static unsigned char tx_buffer[600];
+    static unsigned char payload[600];
+    static unsigned char framed[700];
+    static unsigned char decoded[700];
+    scrutiny::protocol::CommHandler big_comm;
+    big_comm.init(rx_buffer, sizeof(rx_buffer), tx_buffer, sizeof(tx_buffer), &tb);
+    big_comm.connect();
+    big_comm.set_session_flags(scrutiny::protocol::CommControl::ConnectFlags::Framing);
+
+    uint16_t const lengths[] = { 0, 1, 248, 249, 250, 254, 500, 508, 600 };
+    for (unsigned int zeros = 0; zeros < 3; zeros++)
+    {
+        for (unsigned int k = 0; k < sizeof(lengths) / sizeof(lengths[0]); k++)
+        {
+            uint16_t const length = lengths[k];
+            for (uint16_t i = 0; i < length; i++)
+            {
+                payload[i] = static_cast<unsigned char>((i % 200) + 1);
+            }
+            if (zeros == 1 && length > 249)
+            {
+                payload[249] = 0; // Right after the first full block once the header is counted
+            }
+            if (zeros == 2 && length > 0)
+            {
+                payload[length - 1] = 0;
+            }
+
+            big_comm.wait_next_request();
+            unsigned char request[8] = { 1, 1, 0, 0 };
+            add_crc(request, sizeof(request) - 4);
+            uint16_t const framed_request_size = cobs_encode(request, sizeof(request), framed);
+            big_comm.receive_data(framed, framed_request_size);
+            ASSERT_TRUE(big_comm.request_received());
+
+            scrutiny::protocol::Response *const resp = big_comm.prepare_response();
+            resp->command_id = 1;
+            resp->subfunction_id = 1;
+            resp->response_code = 0;
+            resp->data_length = length;
+            std::memcpy(resp->data, payload, length);
+            ASSERT_TRUE(big_comm.send_response(resp));
+
+            uint16_t const n_to_read = big_comm.data_to_send();
+            ASSERT_LE(n_to_read, sizeof(framed));
+            ASSERT_EQ(big_comm.pop_data(framed, 7), 7u); // Does not end on a block boundary
+            ASSERT_EQ(big_comm.pop_data(&framed[7], n_to_read), n_to_read - 7u);
+            EXPECT_FALSE(big_comm.transmitting());
+            EXPECT_EQ(std::memchr(framed, 0, n_to_read - 1u), static_cast<void *>(SCRUTINY_NULL));
+            ASSERT_EQ(cobs_decode(framed, n_to_read, decoded), length + 9u) << "length=" << length << ", zeros=" << zeros;
+            EXPECT_EQ(decoded[0], 0x81);
+            EXPECT_BUF_EQ(&decoded[5], payload, length);
+        }
+    }
+}
+
+TEST_F(TestCommHandler, TestFramedResyncOnDelimiter)
+{
+    comm.connect();
+    comm.set_session_flags(scrutiny::protocol::CommControl::ConnectFlags::Framing);
+    comm.wait_next_request();
+
+    unsigned char request[8 + 2] = { 3, 1, 0, 2, 0x55, 0x66 };
+    add_crc(request, sizeof(request) - 4);
+    unsigned char stream[64];
+    uint16_t const framed_size = cobs_encode(request, sizeof(request), &stream[0]);
+
+    // First frame has a corrupted length that would swallow the next frame without framing
+    uint16_t size = framed_size;
+    std::memcpy(&stream[size], stream, framed_size);
+    stream[4] = 0x40; // Length low byte, after the header code bytes
+    size = static_cast<uint16_t>(size + framed_size);
+
+    comm.receive_data(stream, size); // No wait on the reception timeout
+    ASSERT_TRUE(comm.request_received());
+    EXPECT_EQ(comm.get_request()->data_length, 2u);
+    EXPECT_EQ(comm.get_request()->data[0], 0x55);
+
+    // A truncated frame is dropped on the delimiter
+    comm.wait_next_request();
+    comm.receive_data(stream, 4);
+    comm.receive_data(&stream[framed_size - 1], 1);
+    EXPECT_FALSE(comm.request_received());
+    comm.receive_data(&stream[framed_size], framed_size);
+    EXPECT_TRUE(comm.request_received());
+
+    // Back to unframed frames with the session
+    comm.disconnect();
+    comm.connect();
+    EXPECT_FALSE(comm.framing());
+    comm.receive_data(request, sizeof(request));
+    EXPECT_TRUE(comm.request_received());
+}
@@ -189,6 +189,67 @@ unsigned int ScrutinyTest::encode_addr(unsigned char *buffer, void *addr)
     return addr_size;
 }
 
+/// @brief Reference COBS encoder, as implemented by the server. Output ends with the delimiter
+uint16_t ScrutinyTest::cobs_encode(unsigned char const *src, uint16_t len, unsigned char *dst)
+{
+    uint16_t out = 1;
+    uint16_t code_index = 0;
+    unsigned char code = 1;
+    for (uint16_t i = 0; i < len; i++)
+    {
+        if (src[i] == 0)
+        {
+            dst[code_index] = code;
+            code_index = out++;
+            code = 1;
+        }
+        else
+        {
+            dst[out++] = src[i];
+            code++;
+            if (code == 0xFF && i + 1 < len)
+            {
+                dst[code_index] = code;
+                code_index = out++;
+                code = 1;
+            }
+        }
+    }
+    dst[code_index] = code;
+    dst[out++] = 0;
+    return out;
+}
+
+/// @brief Reference COBS decoder, as implemented by the server. Input ends with the delimiter. Returns 0 on error
+uint16_t ScrutinyTest::cobs_decode(unsigned char const *src, uint16_t len, unsigned char *dst)
+{
+    if (len == 0 || src[len - 1] != 0)
+    {
+        return 0;
+    }
+    len--;
+
+    uint16_t out = 0;
+    uint16_t i = 0;
+    while (i < len)
+    {
+        unsigned char const code = src[i++];
+        if (code == 0 || i + code - 1 > len)
+        {
+            return 0;
+        }
+        for (unsigned char k = 1; k < code; k++)
+        {
+            dst[out++] = src[i++];
+        }
+        if (code != 0xFF && i < len)
+        {
+            dst[out++] = 0;
+        }
+    }
+    return out;
+}
+
 #if defined(_MSC_VER)
 #pragma warning(pop)
 #endif
@@ -130,6 +130,8 @@ class ScrutinyTest : public scrutinytest::TestCase
     void add_crc(scrutiny::protocol::Response *response);
     void fill_buffer_incremental(unsigned char *buffer, uint32_t length);
     unsigned int encode_addr(unsigned char *buffer, void *addr);
+    uint16_t cobs_encode(unsigned char const *src, uint16_t len, unsigned char *dst);
+    uint16_t cobs_decode(unsigned char const *src, uint16_t len, unsigned char *dst);
 
     bool TEST_IS_PROTOCOL_RESPONSE(
         unsigned char *buffer,
@@ -0,0 +1,58 @@
+//    test_float16.cpp
+//        Test the conversion to IEEE-754 half precision float
+//
+//   - License : MIT - See LICENSE file
+//   - Project : Scrutiny Debugger (github.com/scrutinydebugger/scrutiny-embedded)
+//
+//    Copyright (c) 2021 Scrutiny Debugger
+
+#include "scrutinytest/scrutinytest.hpp"
+#include <limits>
+#include <math.h>
+#include <stdint.h>
+
+#include "scrutiny_tools.hpp"
+
+TEST(TestFloat16, TestNormalValues)
+{
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(0.0f), 0x0000u);
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(-0.0f), 0x8000u);
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(1.0f), 0x3C00u);
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(-2.0f), 0xC000u);
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(0.5f), 0x3800u);
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(0.1f), 0x2E66u);
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(3.1415926f), 0x4248u);
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(65504.0f), 0x7BFFu); // Biggest half
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(static_cast<float>(ldexp(1.0, -14))), 0x0400u); // Smallest normal
+}
+
+TEST(TestFloat16, TestRounding)
+{
+    // Ties go to even
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(static_cast<float>(1.0 + ldexp(1.0, -11))), 0x3C00u);
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(static_cast<float>(1.0 + 3 * ldexp(1.0, -11))), 0x3C02u);
+    // Above halfway goes up
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(static_cast<float>(1.0 + ldexp(1.0, -11) + ldexp(1.0, -20))), 0x3C01u);
+    // Carry into the exponent
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(static_cast<float>(2.0 - ldexp(1.0, -12))), 0x4000u);
+}
+
+TEST(TestFloat16, TestSubnormals)
+{
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(static_cast<float>(ldexp(1.0, -24))), 0x0001u);  // Smallest subnormal
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(static_cast<float>(-ldexp(1.0, -24))), 0x8001u); // Smallest negative subnormal
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(static_cast<float>(ldexp(1.0, -25))), 0x0000u);  // Tie goes to even
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(static_cast<float>(1.5 * ldexp(1.0, -25))), 0x0001u);
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(static_cast<float>(ldexp(1.0, -15))), 0x0200u);
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(1e-10f), 0x0000u);
+}
+
+TEST(TestFloat16, TestSpecialValues)
+{
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(65520.0f), 0x7C00u); // Rounds up to infinity
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(1e6f), 0x7C00u);
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(-1e6f), 0xFC00u);
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(std::numeric_limits<float>::infinity()), 0x7C00u);
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(-std::numeric_limits<float>::infinity()), 0xFC00u);
+    EXPECT_EQ(scrutiny::tools::float32_to_float16(std::numeric_limits<float>::quiet_NaN()) & 0x7FFFu, 0x7E00u);
+}
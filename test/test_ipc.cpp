@@ -10,6 +10,7 @@
 #include "scrutinytest/scrutinytest.hpp"
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #if __unix__
 #include <unistd.h>
@@ -20,6 +21,7 @@
 #define TEST_IPC_CPPTHREAD
 #elif defined(_POSIX_THREADS) || defined(_REENTRANT)
 #include <pthread.h>
+#include <sched.h>
 #define TEST_IPC_POSIX_THREAD
 #else
 // Win32 with c++98 ???
@@ -206,3 +208,207 @@ TEST(TestIPC, CheckWithThread)
     EXPECT_GE(my_value, 1000); // Local test > 3.5M
     EXPECT_GE(thread_data.thread_exit_value, 1000);
 }
+
+TEST(TestIPC, ByteFifoBasic)
+{
+    unsigned char storage[8];
+    unsigned char data[8];
+    scrutiny::IPCByteFifo fifo;
+
+    EXPECT_FALSE(fifo.is_set());
+    EXPECT_FALSE(fifo.push(0x11));
+    EXPECT_EQ(fifo.write(data, sizeof(data)), 0u);
+
+    fifo.init(storage, sizeof(storage));
+    ASSERT_TRUE(fifo.is_set());
+    EXPECT_EQ(fifo.count(), 0u);
+    EXPECT_FALSE(fifo.pop(&data[0]));
+
+    // One byte of the storage is left unused
+    for (unsigned char i = 0; i < 7; i++)
+    {
+        EXPECT_TRUE(fifo.push(i));
+    }
+    EXPECT_FALSE(fifo.push(0xFF));
+    EXPECT_EQ(fifo.count(), 7u);
+
+    for (unsigned char i = 0; i < 7; i++)
+    {
+        unsigned char c = 0xFF;
+        EXPECT_TRUE(fifo.pop(&c));
+        EXPECT_EQ(c, i);
+    }
+    EXPECT_FALSE(fifo.pop(&data[0]));
+    EXPECT_EQ(fifo.count(), 0u);
+}
+
+TEST(TestIPC, ByteFifoWrapAround)
+{
+    unsigned char storage[10];
+    unsigned char data[16];
+    unsigned char readback[16];
+    scrutiny::IPCByteFifo fifo;
+    fifo.init(storage, sizeof(storage));
+
+    for (unsigned char i = 0; i < sizeof(data); i++)
+    {
+        data[i] = static_cast<unsigned char>(0x30 + i);
+    }
+
+    // Moves the indexes near the end of the storage
+    EXPECT_EQ(fifo.write(data, 7), 7u);
+    EXPECT_EQ(fifo.read(readback, 7), 7u);
+
+    // The free space is split in 2 regions
+    uint16_t len;
+    unsigned char *region = fifo.write_region(&len);
+    EXPECT_EQ(region, &storage[7]);
+    EXPECT_EQ(len, 3u);
+
+    EXPECT_EQ(fifo.write(data, sizeof(data)), 9u); // Storage size minus one
+    EXPECT_EQ(fifo.count(), 9u);
+    region = fifo.write_region(&len);
+    EXPECT_EQ(len, 0u);
+
+    // The data is split in 2 spans
+    unsigned char const *span = fifo.read_region(&len);
+    EXPECT_EQ(span, &storage[7]);
+    EXPECT_EQ(len, 3u);
+    fifo.commit_read(2);
+    EXPECT_EQ(fifo.count(), 7u);
+
+    memset(readback, 0, sizeof(readback));
+    EXPECT_EQ(fifo.read(readback, sizeof(readback)), 7u);
+    EXPECT_BUF_EQ(readback, &data[2], 7);
+    EXPECT_EQ(fifo.count(), 0u);
+
+    // Region filled in place
+    region = fifo.write_region(&len);
+    ASSERT_GE(len, 2u);
+    region[0] = 0xAB;
+    region[1] = 0xCD;
+    fifo.commit_write(2);
+    EXPECT_EQ(fifo.read(readback, sizeof(readback)), 2u);
+    EXPECT_EQ(readback[0], 0xAB);
+    EXPECT_EQ(readback[1], 0xCD);
+}
+
+static struct
+{
+    scrutiny::IPCByteFifo fifo;
+    unsigned char storage[61]; // Not a divisor of the chunk sizes, so the regions wrap everywhere
+    volatile bool exit;
+    uint32_t written;
+} fifo_thread_data;
+
+static void fifo_yield()
+{
+#if defined(TEST_IPC_CPPTHREAD)
+    std::this_thread::yield();
+#else
+    sched_yield();
+#endif
+}
+
+void fifo_thread_func()
+{
+    unsigned char chunk[23];
+    uint32_t value = 0;
+    uint16_t chunk_size = 1;
+    while (!fifo_thread_data.exit)
+    {
+        for (uint16_t i = 0; i < chunk_size; i++)
+        {
+            chunk[i] = static_cast<unsigned char>((value + i) & 0xFF);
+        }
+        uint16_t const written = fifo_thread_data.fifo.write(chunk, chunk_size);
+        value += written;
+        if (written != chunk_size)
+        {
+            fifo_yield(); // Full. Let the consumer run on a single core machine
+        }
+        chunk_size = static_cast<uint16_t>((chunk_size % sizeof(chunk)) + 1);
+    }
+    fifo_thread_data.written = value;
+}
+
+void *fifo_thread_func_pthread(void *)
+{
+    fifo_thread_func();
+    return NULL;
+}
+
+TEST(TestIPC, ByteFifoCheckWithThread)
+{
+    const int TIMEOUT_SEC = 5;
+    uint32_t const byte_count = 2000000;
+    fifo_thread_data.fifo.init(fifo_thread_data.storage, sizeof(fifo_thread_data.storage));
+    fifo_thread_data.exit = false;
+    fifo_thread_data.written = 0;
+
+#if defined(TEST_IPC_CPPTHREAD)
+    std::thread thread(fifo_thread_func);
+#elif defined(TEST_IPC_POSIX_THREAD)
+    pthread_t thread;
+    ASSERT_EQ(pthread_create(&thread, NULL, fifo_thread_func_pthread, NULL), 0);
+#else
+#error
+#endif
+
+#if SCRUTINY_HAS_CPP11
+    auto t1 = std::chrono::high_resolution_clock::now();
+#else
+    struct timespec t1;
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+#endif
+
+    bool error_found = false;
+    uint32_t received = 0;
+    unsigned char chunk[17];
+    while (received < byte_count && !error_found)
+    {
+        uint16_t const len = fifo_thread_data.fifo.read(chunk, sizeof(chunk));
+        for (uint16_t i = 0; i < len; i++)
+        {
+            if (chunk[i] != static_cast<unsigned char>(received & 0xFF))
+            {
+                error_found = true;
+                break;
+            }
+            received++;
+        }
+        if (len == 0)
+        {
+            fifo_yield(); // Empty. Let the producer run on a single core machine
+        }
+
+#if SCRUTINY_HAS_CPP11
+        if (std::chrono::high_resolution_clock::now() - t1 > std::chrono::seconds(TIMEOUT_SEC))
+        {
+            break;
+        }
+#else
+        struct timespec t2;
+        clock_gettime(CLOCK_MONOTONIC, &t2);
+        double elapsed_secs = double(t2.tv_sec - t1.tv_sec) + double(t2.tv_nsec - t1.tv_nsec) / 1e9;
+        if (elapsed_secs > TIMEOUT_SEC)
+        {
+            break;
+        }
+#endif
+    }
+    fifo_thread_data.exit = true;
+
+#if defined(TEST_IPC_CPPTHREAD)
+    ASSERT_TRUE(thread.joinable());
+    thread.join();
+#elif defined(TEST_IPC_POSIX_THREAD)
+    ASSERT_EQ(pthread_join(thread, NULL), 0);
+#else
+#error
+#endif
+
+    EXPECT_FALSE(error_found) << "At byte #" << received;
+    EXPECT_GE(received, 1000u);
+    EXPECT_GE(fifo_thread_data.written, received);
+}
@@ -0,0 +1,68 @@
+//    test_masked_write.cpp
+//        Test the word-wide masked write against a reference implementation
+//
+//   - License : MIT - See LICENSE file
+//   - Project : Scrutiny Debugger (github.com/scrutinydebugger/scrutiny-embedded)
+//
+//    Copyright (c) 2021 Scrutiny Debugger
+
+#include "scrutinytest/scrutinytest.hpp"
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "scrutiny_tools.hpp"
+
+#if CHAR_BIT == 8
+
+static void reference_masked_write(unsigned char *dst, unsigned char const *src, unsigned char const *mask, size_t const size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        dst[i] = static_cast<unsigned char>(dst[i] | (src[i] & mask[i]));
+        dst[i] = static_cast<unsigned char>(dst[i] & (src[i] | ~mask[i]));
+    }
+}
+
+TEST(TestMaskedWrite, SameAsReferenceAllAlignments)
+{
+    unsigned char src[64 + 8];
+    unsigned char mask[64 + 8];
+    unsigned char initial[64 + 8];
+    unsigned char dst[64 + 8];
+    unsigned char expected[64 + 8];
+
+    uint32_t seed = 0xCAFEBABE;
+    for (size_t i = 0; i < sizeof(src); i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        src[i] = static_cast<unsigned char>((seed >> 8) & 0xFF);
+        mask[i] = static_cast<unsigned char>((seed >> 16) & 0xFF);
+        initial[i] = static_cast<unsigned char>((seed >> 24) & 0xFF);
+    }
+    memset(&mask[16], 0, 16);    // Words left untouched
+    memset(&mask[40], 0xFF, 16); // Words fully written
+    for (size_t i = 56; i < 64; i++)
+    {
+        mask[i] = (i % 2 == 0) ? 0xFF : 0x00; // Words partially written
+    }
+
+    // Every destination alignment, source/mask alignment and size, including sizes smaller than a word
+    for (size_t dst_offset = 0; dst_offset < 8; dst_offset++)
+    {
+        for (size_t src_offset = 0; src_offset < 8; src_offset++)
+        {
+            for (size_t size = 0; size <= 64; size++)
+            {
+                memcpy(dst, initial, sizeof(dst));
+                memcpy(expected, initial, sizeof(expected));
+                scrutiny::tools::masked_write_from_8bits_native(&dst[dst_offset], &src[src_offset], &mask[src_offset], size);
+                reference_masked_write(&expected[dst_offset], &src[src_offset], &mask[src_offset], size);
+                ASSERT_BUF_EQ(dst, expected, sizeof(dst))
+                    << "dst_offset=" << dst_offset << ", src_offset=" << src_offset << ", size=" << size;
+            }
+        }
+    }
+}
+
+#endif
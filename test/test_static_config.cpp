@@ -0,0 +1,116 @@
+//    test_static_config.cpp
+//        Test the compile-time validation of the configuration tables and their use by the MainHandler
+//
+//   - License : MIT - See LICENSE file
+//   - Project : Scrutiny Debugger (github.com/scrutinydebugger/scrutiny-embedded)
+//
+//    Copyright (c) 2021 Scrutiny Debugger
+
+#include "scrutiny.hpp"
+#include "scrutinytest/scrutinytest.hpp"
+
+#if SCRUTINY_HAS_CPP11
+
+static unsigned char _rx_buffer[128];
+static unsigned char _tx_buffer[128];
+
+static constexpr scrutiny::RuntimePublishedValue static_rpvs[] = {
+    { 0x0010, scrutiny::VariableType::uint32 },  { 0x0020, scrutiny::VariableType::float32 }, { 0x0030, scrutiny::VariableType::sint16 },
+    { 0x1000, scrutiny::VariableType::boolean }, { 0x2000, scrutiny::VariableType::uint16 },
+};
+SCRUTINY_STATIC_CHECK_RPV_TABLE(static_rpvs);
+SCRUTINY_STATIC_CHECK_BUFFERS(_rx_buffer, _tx_buffer);
+SCRUTINY_STATIC_CHECK_ADDRESS_RANGE(0x1000, 0x1FFF);
+
+static constexpr scrutiny::RuntimePublishedValue unsorted_rpvs[] = { { 0x0020, scrutiny::VariableType::uint32 },
+                                                                     { 0x0010, scrutiny::VariableType::uint32 } };
+static constexpr scrutiny::RuntimePublishedValue duplicated_rpvs[] = { { 0x0010, scrutiny::VariableType::uint32 },
+                                                                       { 0x0010, scrutiny::VariableType::uint16 } };
+static constexpr scrutiny::RuntimePublishedValue unsupported_rpvs[] = { { 0x0010, scrutiny::VariableType::uint32 },
+                                                                        { 0x0020, scrutiny::VariableType::cfloat32 } };
+
+static_assert(scrutiny::static_config::is_valid_rpv_table(static_rpvs), "");
+static_assert(!scrutiny::static_config::is_valid_rpv_table(unsorted_rpvs), "");
+static_assert(!scrutiny::static_config::is_valid_rpv_table(duplicated_rpvs), "");
+static_assert(!scrutiny::static_config::is_valid_rpv_table(unsupported_rpvs), "");
+static_assert(!scrutiny::static_config::is_valid_address_range(0x2000, 0x1FFF), "");
+static_assert(!scrutiny::static_config::is_valid_rx_buffer_size(8), "");
+
+static bool rpv_read_callback(scrutiny::RuntimePublishedValue rpv, scrutiny::AnyType *outval, scrutiny::LoopHandler *const caller)
+{
+    static_cast<void>(caller);
+    outval->uint32 = rpv.id;
+    return true;
+}
+
+TEST(TestStaticConfig, SupportedTypesMatchRuntimeCheck)
+{
+    for (unsigned int i = 0; i < 0x100; i++)
+    {
+        scrutiny::VariableType::eVariableType const vt = static_cast<scrutiny::VariableType::eVariableType>(i);
+        EXPECT_EQ(scrutiny::static_config::is_supported_type(vt), scrutiny::tools::is_supported_type(vt)) << "type=" << i;
+    }
+}
+
+TEST(TestStaticConfig, MainHandlerUsesStaticTable)
+{
+    scrutiny::Config config;
+    scrutiny::MainHandler scrutiny_handler;
+    config.set_buffers(_rx_buffer, sizeof(_rx_buffer), _tx_buffer, sizeof(_tx_buffer));
+    config.set_static_published_values(static_rpvs, sizeof(static_rpvs) / sizeof(static_rpvs[0]), rpv_read_callback);
+    EXPECT_TRUE(config.is_static_published_values());
+    EXPECT_EQ(scrutiny_handler.init(&config), scrutiny::Status::SUCCESS);
+
+    // Binary search over the sorted table
+    for (unsigned int i = 0; i < sizeof(static_rpvs) / sizeof(static_rpvs[0]); i++)
+    {
+        scrutiny::RuntimePublishedValue rpv;
+        ASSERT_TRUE(scrutiny_handler.get_rpv(static_rpvs[i].id, &rpv)) << "i=" << i;
+        EXPECT_EQ(rpv.id, static_rpvs[i].id);
+        EXPECT_EQ(rpv.type, static_rpvs[i].type);
+    }
+    EXPECT_FALSE(scrutiny_handler.get_rpv(0x0000, SCRUTINY_NULL));
+    EXPECT_FALSE(scrutiny_handler.get_rpv(0x0011, SCRUTINY_NULL));
+    EXPECT_FALSE(scrutiny_handler.get_rpv(0xFFFF, SCRUTINY_NULL));
+
+    // Same fingerprint as the runtime table
+    uint32_t const fingerprint = scrutiny_handler.config_fingerprint();
+    config.set_published_values(static_rpvs, sizeof(static_rpvs) / sizeof(static_rpvs[0]), rpv_read_callback);
+    EXPECT_FALSE(config.is_static_published_values());
+    scrutiny_handler.init(&config);
+    EXPECT_EQ(scrutiny_handler.config_fingerprint(), fingerprint);
+}
+
+TEST(TestStaticConfig, InitRejectsInvalidStaticTable)
+{
+    scrutiny::Config config;
+    scrutiny::MainHandler scrutiny_handler;
+    config.set_buffers(_rx_buffer, sizeof(_rx_buffer), _tx_buffer, sizeof(_tx_buffer));
+
+    // Tables that did not go through SCRUTINY_STATIC_CHECK_RPV_TABLE
+    config.set_static_published_values(unsorted_rpvs, sizeof(unsorted_rpvs) / sizeof(unsorted_rpvs[0]), rpv_read_callback);
+    EXPECT_EQ(scrutiny_handler.init(&config), scrutiny::Status::ERROR);
+    config.set_static_published_values(duplicated_rpvs, sizeof(duplicated_rpvs) / sizeof(duplicated_rpvs[0]), rpv_read_callback);
+    EXPECT_EQ(scrutiny_handler.init(&config), scrutiny::Status::ERROR);
+    config.set_static_published_values(unsupported_rpvs, sizeof(unsupported_rpvs) / sizeof(unsupported_rpvs[0]), rpv_read_callback);
+    EXPECT_EQ(scrutiny_handler.init(&config), scrutiny::Status::ERROR);
+
+    // The same unsorted table is fine when searched linearly
+    config.set_published_values(unsorted_rpvs, sizeof(unsorted_rpvs) / sizeof(unsorted_rpvs[0]), rpv_read_callback);
+    EXPECT_EQ(scrutiny_handler.init(&config), scrutiny::Status::SUCCESS);
+}
+
+TEST(TestStaticConfig, GivenFingerprintIsUsed)
+{
+    scrutiny::Config config;
+    scrutiny::MainHandler scrutiny_handler;
+    config.set_buffers(_rx_buffer, sizeof(_rx_buffer), _tx_buffer, sizeof(_tx_buffer));
+    config.set_static_published_values(static_rpvs, sizeof(static_rpvs) / sizeof(static_rpvs[0]), rpv_read_callback);
+    EXPECT_FALSE(config.is_config_fingerprint_set());
+    config.set_config_fingerprint(0x12345678);
+    EXPECT_TRUE(config.is_config_fingerprint_set());
+    scrutiny_handler.init(&config);
+    EXPECT_EQ(scrutiny_handler.config_fingerprint(), 0x12345678u);
+}
+
+#endif
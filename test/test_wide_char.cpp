@@ -0,0 +1,122 @@
+//    test_wide_char.cpp
+//        Validates the word-at-a-time conversions used with 16 bits char against their reference implementation.
+//        Runs on any host by using uint16_t as the 16 bits element
+//
+//   - License : MIT - See LICENSE file
+//   - Project : Scrutiny Debugger (github.com/scrutinydebugger/scrutiny-embedded)
+//
+//    Copyright (c) 2021 Scrutiny Debugger
+
+#include "scrutinytest/scrutinytest.hpp"
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "scrutiny_tools.hpp"
+
+using namespace scrutiny::tools;
+
+static void fill_random(uint16_t *buffer, size_t const count, uint32_t seed)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        buffer[i] = static_cast<uint16_t>(seed >> 16);
+    }
+}
+
+TEST(TestWideChar, KnownValues)
+{
+    uint16_t const src16[3] = { 0x1122, 0x3344, 0x5566 };
+    uint16_t const dilated_big_endian[6] = { 0x11, 0x22, 0x33, 0x44, 0x55, 0x66 };
+    uint16_t const dilated_little_endian[6] = { 0x22, 0x11, 0x44, 0x33, 0x66, 0x55 };
+    uint16_t dst[6];
+
+    wide_char::dilate_16bits_to_8bits(dst, src16, 6, true);
+    EXPECT_BUF_EQ(dst, dilated_big_endian, sizeof(dilated_big_endian));
+    wide_char::dilate_16bits_to_8bits(dst, src16, 6, false);
+    EXPECT_BUF_EQ(dst, dilated_little_endian, sizeof(dilated_little_endian));
+
+    wide_char::compress_8bits_to_16bits(dst, dilated_big_endian, 6, true);
+    EXPECT_BUF_EQ(dst, src16, sizeof(src16));
+    wide_char::compress_8bits_to_16bits(dst, dilated_little_endian, 6, false);
+    EXPECT_BUF_EQ(dst, src16, sizeof(src16));
+
+    uint16_t const garbage_upper_bits[2] = { 0xAB11, 0xCD22 }; // Only the lower 8 bits are used
+    wide_char::compress_8bits_to_16bits(dst, garbage_upper_bits, 2, true);
+    EXPECT_EQ(dst[0], 0x1122u);
+}
+
+TEST(TestWideChar, SameAsReference)
+{
+    uint16_t src[70];
+    uint16_t dst[70 + 4];
+    uint16_t expected[70 + 4];
+    fill_random(src, sizeof(src) / sizeof(src[0]), 0x1234);
+
+    // Every size, both byte orders and both alignments. The input of the compression has garbage in its upper 8 bits
+    for (size_t offset = 0; offset < 2; offset++)
+    {
+        for (size_t nb_8bits = 0; nb_8bits <= 64; nb_8bits += 2)
+        {
+            for (int big_endian = 0; big_endian < 2; big_endian++)
+            {
+                memset(dst, 0xAA, sizeof(dst));
+                memset(expected, 0xAA, sizeof(expected));
+                wide_char::dilate_16bits_to_8bits(&dst[offset], &src[offset], nb_8bits, big_endian != 0);
+                wide_char::dilate_16bits_to_8bits_reference(&expected[offset], &src[offset], nb_8bits, big_endian != 0);
+                ASSERT_BUF_EQ(dst, expected, sizeof(dst)) << "dilate, nb_8bits=" << nb_8bits << ", big_endian=" << big_endian;
+
+                memset(dst, 0xAA, sizeof(dst));
+                memset(expected, 0xAA, sizeof(expected));
+                wide_char::compress_8bits_to_16bits(&dst[offset], &src[offset], nb_8bits, big_endian != 0);
+                wide_char::compress_8bits_to_16bits_reference(&expected[offset], &src[offset], nb_8bits, big_endian != 0);
+                ASSERT_BUF_EQ(dst, expected, sizeof(dst)) << "compress, nb_8bits=" << nb_8bits << ", big_endian=" << big_endian;
+            }
+        }
+    }
+}
+
+TEST(TestWideChar, Benchmark)
+{
+    static uint16_t src[4096];
+    static uint16_t dst[4096];
+    static uint16_t expected[4096];
+    unsigned int const iterations = 200;
+    clock_t const slack = CLOCKS_PER_SEC / 100; // Keeps the check meaningful when the timings are near the clock resolution
+    fill_random(src, sizeof(src) / sizeof(src[0]), 0x5678);
+
+    clock_t start = clock();
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        wide_char::dilate_16bits_to_8bits_reference(expected, src, sizeof(expected) / sizeof(expected[0]), true);
+    }
+    clock_t const reference_dilate = clock() - start;
+
+    start = clock();
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        wide_char::dilate_16bits_to_8bits(dst, src, sizeof(dst) / sizeof(dst[0]), true);
+    }
+    clock_t const dilate = clock() - start;
+    EXPECT_BUF_EQ(dst, expected, sizeof(dst));
+
+    start = clock();
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        wide_char::compress_8bits_to_16bits_reference(expected, src, sizeof(expected) / sizeof(expected[0]), true);
+    }
+    clock_t const reference_compress = clock() - start;
+
+    start = clock();
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        wide_char::compress_8bits_to_16bits(dst, src, sizeof(dst) / sizeof(dst[0]), true);
+    }
+    clock_t const compress = clock() - start;
+    EXPECT_BUF_EQ(dst, expected, sizeof(dst) / 2);
+
+    // Host timings say little about the 16 bits char targets. Only a gross regression against the reference is caught here
+    EXPECT_LE(dilate, 4 * reference_dilate + slack);
+    EXPECT_LE(compress, 4 * reference_compress + slack);
+}